@@ -384,8 +384,10 @@ dmz::Application::init_runtime () {
       
       Config runtimeData;
 
-      if (!_state.error && !_state.quiet &&
-            !_state.global.lookup_all_config_merged ("dmz.runtime", runtimeData)) {
+      // The runtime config must be looked up even when quiet.
+      if (!_state.error &&
+            !_state.global.lookup_all_config_merged ("dmz.runtime", runtimeData) &&
+            !_state.quiet) {
 
          _state.log.warn << "dmz.runtime not found" << endl;
       }
@@ -3,6 +3,7 @@
 #include <dmzObjectModule.h>
 #include <dmzRuntimeConfig.h>
 #include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeConfigToVector.h>
 #include <dmzRuntimeDefinitions.h>
 #include <dmzRuntimeObjectType.h>
 #include <dmzRuntimePluginFactoryLinkSymbol.h>
@@ -19,6 +20,9 @@
 #include <dmzTypesUUID.h>
 #include <dmzTypesVector.h>
 
+#include <math.h>
+#include <string.h>
+
 /*!
 
 \class dmz::NetExtPacketCodecObjectNative
@@ -32,8 +36,13 @@
       attribute="Attribute Name"
       lnv="True/False"
       lnv-name="Last Network Value Attribute Name"
-   />
+      encoding="Vector and orientation encoding"
+      precision="Fixed point precision"
+   >
+      <origin x="0.0" y="0.0" z="0.0"/>
+   </adapter>
    ...
+   <delta enabled="True/False" keyframe="5.0"/>
 </local-scope>
 \endcode
 Possible types are:
@@ -45,10 +54,46 @@ If the lnv attribute is not set, the lnv attribute name may be explicitly set wi
 the lnv-name attribute. \n \n
 A counter type adapter may also have the following boolean attributes:
 counter, minimum, maximum, and rollover. These attribute determine whether each value
-is encoded/decode in the packet. They default to true.
+is encoded/decode in the packet. They default to true. \n \n
+The position, velocity, acceleration, scale, and vector adapters may set the encoding
+to float64, float32, or fixed. The fixed encoding writes each component as a 32 bit
+integer in steps of \b precision relative to the \b origin. The precision defaults to
+0.01. The orientation adapter may set the encoding to float64, float32, or quaternion.
+The quaternion encoding packs a unit quaternion into 32 bits by writing only its three
+smallest components. The encoding defaults to float64. When quantized, the last network
+value is set to the value the receiver will decode. The sender and the receiver must use
+the same encodings. Codecs with different encodings may be used side by side by mapping
+them to different packet ids in the packet header. \n \n
+If delta encoding is enabled, the encoded value of each adapter is stored for every
+object. Updates then only contain a bit mask of the adapters whose values have changed
+since the last update, followed by the changed values. A delta update is flagged by a
+negative object type size. Since a type size of zero flags a deactivation, objects
+with a network type that is empty or longer than 127 values are not encoded. A full
+update is sent when an object is activated and at least every \b keyframe seconds so
+that late joiners and lossy links still converge.
+Delta updates for unknown objects are ignored. Both the sender and the receiver must use
+the same adapter list. Delta encoding is disabled by default.
 */
 
 //! \cond
+// The type size is written as an Int8 whose sign flags a delta update and whose zero
+// value flags a deactivation.
+static const dmz::Int32 LocalMaxTypeSize (0x7F);
+
+
+static inline void
+local_write_buffer (const char *Buffer, const dmz::Int32 Size, dmz::Marshal &data) {
+
+   const dmz::Int32 Place (data.get_place ());
+
+   if ((Size > 0) && data.set_length (Place + Size)) {
+
+      memcpy (data.get_buffer () + Place, Buffer, Size);
+      data.set_place (Place + Size);
+   }
+}
+
+
 dmz::NetExtPacketCodecObjectNative::NetExtPacketCodecObjectNative (
       const PluginInfo &Info,
       Config &local) :
@@ -61,7 +106,15 @@ dmz::NetExtPacketCodecObjectNative::NetExtPacketCodecObjectNative (
       _lnvHandle (0),
       _objMod (0),
       _attrMod (0),
-      _adapterList (0) {
+      _statsMod (0),
+      _adapterList (0),
+      _adapterCount (0),
+      _delta (False),
+      _keyframeInterval (5.0),
+      _maskSize (0),
+      _mask (0),
+      _offsets (0),
+      _adapterData (ByteOrderBigEndian) {
 
    _init (local);
 }
@@ -69,7 +122,10 @@ dmz::NetExtPacketCodecObjectNative::NetExtPacketCodecObjectNative (
 
 dmz::NetExtPacketCodecObjectNative::~NetExtPacketCodecObjectNative () {
 
+   _objTable.empty ();
    if (_adapterList) { delete _adapterList; _adapterList = 0; }
+   if (_mask) { delete []_mask; _mask = 0; }
+   if (_offsets) { delete []_offsets; _offsets = 0; }
 }
 
 
@@ -103,6 +159,7 @@ dmz::NetExtPacketCodecObjectNative::discover_plugin (
 
       if (!_objMod) { _objMod = ObjectModule::cast (PluginPtr); }
       if (!_attrMod) { _attrMod = NetModuleAttributeMap::cast (PluginPtr); }
+      if (!_statsMod) { _statsMod = NetModuleStats::cast (PluginPtr); }
    }
    else if (Mode == PluginDiscoverRemove) {
 
@@ -112,6 +169,8 @@ dmz::NetExtPacketCodecObjectNative::discover_plugin (
 
          _attrMod = 0;
       }
+
+      if (_statsMod && (_statsMod == NetModuleStats::cast (PluginPtr))) { _statsMod = 0; }
    }
 
    ObjectAttributeAdapter *current (_adapterList);
@@ -130,6 +189,8 @@ dmz::NetExtPacketCodecObjectNative::decode (Unmarshal &data, Boolean &isLoopback
 
    Boolean result (False);
 
+   const Int32 Start (data.get_place ());
+
    UUID uuid;
    data.get_next_uuid (uuid);
 
@@ -139,7 +200,10 @@ dmz::NetExtPacketCodecObjectNative::decode (Unmarshal &data, Boolean &isLoopback
 
       UUID objectID;
       data.get_next_uuid (objectID);
-      const Int32 TypeSize (Int32 (data.get_next_int8 ()));
+      Int32 typeSize (Int32 (data.get_next_int8 ()));
+      const Boolean Delta (typeSize < 0);
+      if (Delta) { typeSize = -typeSize; }
+      const Int32 TypeSize (typeSize);
 
       Handle objectHandle (_objMod->lookup_handle_from_uuid (objectID));
 
@@ -158,7 +222,16 @@ dmz::NetExtPacketCodecObjectNative::decode (Unmarshal &data, Boolean &isLoopback
 
          Boolean activateObject (False);
 
-         if (!objectHandle) {
+         if (Delta) {
+
+            for (Int32 ix = 0; ix < _maskSize; ix++) {
+
+               _mask[ix] = data.get_next_uint8 ();
+            }
+         }
+
+         // A delta update does not hold enough state to create the object.
+         if (!objectHandle && !Delta) {
 
             ObjectType type;
             _attrMod->to_internal_object_type (typeArray, type);
@@ -177,15 +250,39 @@ dmz::NetExtPacketCodecObjectNative::decode (Unmarshal &data, Boolean &isLoopback
             result = True;
 
             ObjectAttributeAdapter *current (_adapterList);
+            Int32 count (0);
 
             while (current) {
 
-               current->decode (objectHandle, data, *_objMod);
+               if (!Delta || (_mask[count >> 3] & (1 << (count & 0x07)))) {
+
+                  const Int32 Place (data.get_place ());
+
+                  current->decode (objectHandle, data, *_objMod);
+
+                  if (_statsMod) {
+
+                     _statsMod->add_adapter_stat (
+                        NetStatsRead,
+                        current->statsHandle,
+                        data.get_place () - Place);
+                  }
+               }
+
                current = current->next;
+               count++;
             }
 
             if (activateObject) { _objMod->activate_object (objectHandle); }
 
+            if (_statsMod) {
+
+               _statsMod->add_object_stat (
+                  NetStatsRead,
+                  _objMod->lookup_object_type (objectHandle),
+                  data.get_place () - Start);
+            }
+
             _objMod->store_time_stamp (objectHandle, _lnvHandle, _time.get_frame_time ());
          }
       }
@@ -209,6 +306,8 @@ dmz::NetExtPacketCodecObjectNative::encode_object (
 
       if (_objMod->lookup_uuid (ObjectHandle, objectID)) {
 
+         const Int32 Start (data.get_place ());
+
          data.set_next_uuid (_SysID);
          data.set_next_uuid (objectID);
 
@@ -216,37 +315,91 @@ dmz::NetExtPacketCodecObjectNative::encode_object (
 
             data.set_next_int8 (0);
             result = True;
+
+            ObjectStruct *obj (_objTable.remove (ObjectHandle));
+            if (obj) { delete obj; obj = 0; }
          }
          else {
 
             const ObjectType Type (_objMod->lookup_object_type (ObjectHandle));
             ArrayUInt32 typeArray;
 
-            if (_attrMod->to_net_object_type (Type, typeArray)) {
+            const Float64 FrameTime (_time.get_frame_time ());
+
+            const Boolean ValidType (
+               _attrMod->to_net_object_type (Type, typeArray) &&
+               (typeArray.get_size () > 0) &&
+               (typeArray.get_size () <= LocalMaxTypeSize));
+
+            if (ValidType) {
+
+               ObjectStruct *obj (_delta ? _objTable.lookup (ObjectHandle) : 0);
+
+               const Boolean Delta (
+                  obj &&
+                  (EncodeMode == NetObjectUpdate) &&
+                  ((FrameTime - obj->keyTime) < _keyframeInterval));
+
+               if (_delta && !obj) {
+
+                  obj = new ObjectStruct (_adapterCount);
+
+                  if (!_objTable.store (ObjectHandle, obj)) { delete obj; obj = 0; }
+               }
 
                const Int32 TypeSize (typeArray.get_size ());
-               data.set_next_int8 (Int8 (TypeSize));
+               data.set_next_int8 (Int8 (Delta ? -TypeSize : TypeSize));
 
                for (Int32 ix = 0; ix < TypeSize; ix++) {
 
                   data.set_next_uint8 (UInt8 (typeArray.get (ix)));
                }
 
-               ObjectAttributeAdapter *current (_adapterList);
+               if (obj) {
+
+                  _encode_adapters (ObjectHandle, Delta, *obj, data);
+                  if (!Delta) { obj->keyTime = FrameTime; }
+               }
+               else {
+
+                  ObjectAttributeAdapter *current (_adapterList);
+
+                  while (current) {
+
+                     const Int32 Place (data.get_place ());
+
+                     current->encode (ObjectHandle, *_objMod, data);
+
+                     if (_statsMod) {
+
+                        _statsMod->add_adapter_stat (
+                           NetStatsWrite,
+                           current->statsHandle,
+                           data.get_place () - Place);
+                     }
+
+                     current = current->next;
+                  }
+               }
 
-               while (current) {
+               if (_statsMod) {
 
-                  current->encode (ObjectHandle, *_objMod, data);
-                  current = current->next;
+                  _statsMod->add_object_stat (
+                     NetStatsWrite,
+                     Type,
+                     data.get_place () - Start);
                }
 
                result = True;
             }
+            else if (EncodeMode == NetObjectActivate) {
 
-            _objMod->store_time_stamp (
-               ObjectHandle,
-               _lnvHandle,
-               _time.get_frame_time ());
+               _log.error << "Unable to encode object of type: " << Type.get_name ()
+                  << ". Network type must have between 1 and " << LocalMaxTypeSize
+                  << " values" << endl;
+            }
+
+            _objMod->store_time_stamp (ObjectHandle, _lnvHandle, FrameTime);
          }
       }
    }
@@ -255,6 +408,92 @@ dmz::NetExtPacketCodecObjectNative::encode_object (
 }
 
 
+// Encodes every adapter into a scratch buffer and then writes either all of the values
+// or only the values that differ from the last encoding of the object.
+void
+dmz::NetExtPacketCodecObjectNative::_encode_adapters (
+      const Handle ObjectHandle,
+      const Boolean Delta,
+      ObjectStruct &obj,
+      Marshal &data) {
+
+   if (_adapterData.get_byte_order () != data.get_byte_order ()) {
+
+      _adapterData = Marshal (data.get_byte_order ());
+   }
+
+   _adapterData.reset ();
+
+   ObjectAttributeAdapter *current (_adapterList);
+   Int32 count (0);
+
+   while (current) {
+
+      _offsets[count] = _adapterData.get_length ();
+      current->encode (ObjectHandle, *_objMod, _adapterData);
+      current = current->next;
+      count++;
+   }
+
+   _offsets[_adapterCount] = _adapterData.get_length ();
+
+   const char *Buffer (_adapterData.get_buffer ());
+   const char *Last (obj.data.get_buffer ());
+
+   if (Delta) {
+
+      for (Int32 ix = 0; ix < _maskSize; ix++) { _mask[ix] = 0; }
+
+      for (Int32 ix = 0; ix < _adapterCount; ix++) {
+
+         const Int32 Size (_offsets[ix + 1] - _offsets[ix]);
+
+         if ((Size != (obj.offsets[ix + 1] - obj.offsets[ix])) ||
+               (Size && memcmp (Buffer + _offsets[ix], Last + obj.offsets[ix], Size))) {
+
+            _mask[ix >> 3] |= UInt8 (1 << (ix & 0x07));
+         }
+      }
+
+      for (Int32 ix = 0; ix < _maskSize; ix++) { data.set_next_uint8 (_mask[ix]); }
+
+      for (Int32 ix = 0; ix < _adapterCount; ix++) {
+
+         if (_mask[ix >> 3] & (1 << (ix & 0x07))) {
+
+            local_write_buffer (
+               Buffer + _offsets[ix],
+               _offsets[ix + 1] - _offsets[ix],
+               data);
+         }
+      }
+   }
+   else { local_write_buffer (Buffer, _offsets[_adapterCount], data); }
+
+   if (_statsMod) {
+
+      current = _adapterList;
+
+      for (Int32 ix = 0; current && (ix < _adapterCount); ix++) {
+
+         if (!Delta || (_mask[ix >> 3] & (1 << (ix & 0x07)))) {
+
+            _statsMod->add_adapter_stat (
+               NetStatsWrite,
+               current->statsHandle,
+               _offsets[ix + 1] - _offsets[ix]);
+         }
+
+         current = current->next;
+      }
+   }
+
+   obj.data = _adapterData;
+
+   for (Int32 ix = 0; ix <= _adapterCount; ix++) { obj.offsets[ix] = _offsets[ix]; }
+}
+
+
 void
 dmz::NetExtPacketCodecObjectNative::_init (Config &local) {
 
@@ -280,9 +519,24 @@ dmz::NetExtPacketCodecObjectNative::_init (Config &local) {
 
             if (current) { current->next = next; current = next; }
             else { _adapterList = current = next; }
+
+            _adapterCount++;
          }
       }
    }
+
+   _delta = config_to_boolean ("delta.enabled", local, _delta);
+   _keyframeInterval = config_to_float64 ("delta.keyframe", local, _keyframeInterval);
+
+   _maskSize = (_adapterCount + 7) >> 3;
+   _mask = new UInt8[_maskSize + 1];
+   _offsets = new Int32[_adapterCount + 1];
+
+   if (_delta) {
+
+      _log.info << "Delta encoding " << _adapterCount << " adapters with a "
+         << _keyframeInterval << " second keyframe interval" << endl;
+   }
 }
 
 
@@ -344,6 +598,283 @@ local_create_lnv_handle (dmz::Config &local, dmz::RuntimeContext *context) {
 }
 
 
+// Encodes a vector either as 64 bit floats, 32 bit floats, or 32 bit fixed point
+// values relative to an origin. The encoded value is returned so that the last network
+// value matches what the receiver decodes.
+class VectorCodec {
+
+   public:
+      VectorCodec (dmz::Config &local);
+
+      void decode (dmz::Unmarshal &data, dmz::Vector &value) const;
+      void encode (dmz::Vector &value, dmz::Marshal &data) const;
+
+   protected:
+      enum EncodingEnum { EncodeFloat64, EncodeFloat32, EncodeFixed };
+
+      EncodingEnum _encoding;
+      dmz::Vector _origin;
+      dmz::Float64 _precision;
+};
+
+
+VectorCodec::VectorCodec (dmz::Config &local) :
+      _encoding (EncodeFloat64),
+      _origin (dmz::config_to_vector ("origin", local)),
+      _precision (dmz::config_to_float64 ("precision", local, 0.01)) {
+
+   const dmz::String Encoding (dmz::config_to_string ("encoding", local).to_lower ());
+
+   if (Encoding == "float32") { _encoding = EncodeFloat32; }
+   else if ((Encoding == "fixed") && (_precision > 0.0)) { _encoding = EncodeFixed; }
+}
+
+
+void
+VectorCodec::decode (dmz::Unmarshal &data, dmz::Vector &value) const {
+
+   if (_encoding == EncodeFixed) {
+
+      const dmz::Float64 X (dmz::Float64 (data.get_next_int32 ()) * _precision);
+      const dmz::Float64 Y (dmz::Float64 (data.get_next_int32 ()) * _precision);
+      const dmz::Float64 Z (dmz::Float64 (data.get_next_int32 ()) * _precision);
+
+      value = _origin + dmz::Vector (X, Y, Z);
+   }
+   else if (_encoding == EncodeFloat32) { data.get_next_vector32 (value); }
+   else { data.get_next_vector (value); }
+}
+
+
+void
+VectorCodec::encode (dmz::Vector &value, dmz::Marshal &data) const {
+
+   if (_encoding == EncodeFixed) {
+
+      const dmz::Vector Offset (value - _origin);
+      dmz::Float64 fixed[3] = { Offset.get_x (), Offset.get_y (), Offset.get_z () };
+
+      for (dmz::Int32 ix = 0; ix < 3; ix++) {
+
+         fixed[ix] = floor ((fixed[ix] / _precision) + 0.5);
+
+         if (fixed[ix] > 2147483647.0) { fixed[ix] = 2147483647.0; }
+         else if (fixed[ix] < -2147483647.0) { fixed[ix] = -2147483647.0; }
+
+         data.set_next_int32 (dmz::Int32 (fixed[ix]));
+      }
+
+      value = _origin + (dmz::Vector (fixed[0], fixed[1], fixed[2]) * _precision);
+   }
+   else if (_encoding == EncodeFloat32) {
+
+      data.set_next_vector32 (value);
+
+      value.set_xyz (
+         dmz::Float32 (value.get_x ()),
+         dmz::Float32 (value.get_y ()),
+         dmz::Float32 (value.get_z ()));
+   }
+   else { data.set_next_vector (value); }
+}
+
+
+// Encodes a matrix either as 64 bit floats, 32 bit floats, or as a quaternion using
+// smallest three compression. The compressed quaternion stores the index of the
+// largest component in two bits and the remaining three components in ten bits each.
+class MatrixCodec {
+
+   public:
+      MatrixCodec (dmz::Config &local);
+
+      void decode (dmz::Unmarshal &data, dmz::Matrix &value) const;
+      void encode (dmz::Matrix &value, dmz::Marshal &data) const;
+
+   protected:
+      enum EncodingEnum { EncodeFloat64, EncodeFloat32, EncodeQuaternion };
+
+      EncodingEnum _encoding;
+};
+
+
+static const dmz::Float64 LocalQuatRange (0.70710678118654752440);
+static const dmz::UInt32 LocalQuatMask (0x3FF);
+static const dmz::Float64 LocalQuatScale (1023.0);
+
+
+static inline void
+local_matrix_to_quat (const dmz::Matrix &Value, dmz::Float64 quat[4]) {
+
+   dmz::Float64 m[9];
+   Value.to_array (m);
+
+   const dmz::Float64 Trace (m[0] + m[4] + m[8]);
+
+   if (Trace > 0.0) {
+
+      const dmz::Float64 S (sqrt (Trace + 1.0) * 2.0);
+      quat[0] = (m[7] - m[5]) / S;
+      quat[1] = (m[2] - m[6]) / S;
+      quat[2] = (m[3] - m[1]) / S;
+      quat[3] = 0.25 * S;
+   }
+   else if ((m[0] > m[4]) && (m[0] > m[8])) {
+
+      const dmz::Float64 S (sqrt (1.0 + m[0] - m[4] - m[8]) * 2.0);
+      quat[0] = 0.25 * S;
+      quat[1] = (m[1] + m[3]) / S;
+      quat[2] = (m[2] + m[6]) / S;
+      quat[3] = (m[7] - m[5]) / S;
+   }
+   else if (m[4] > m[8]) {
+
+      const dmz::Float64 S (sqrt (1.0 + m[4] - m[0] - m[8]) * 2.0);
+      quat[0] = (m[1] + m[3]) / S;
+      quat[1] = 0.25 * S;
+      quat[2] = (m[5] + m[7]) / S;
+      quat[3] = (m[2] - m[6]) / S;
+   }
+   else {
+
+      const dmz::Float64 S (sqrt (1.0 + m[8] - m[0] - m[4]) * 2.0);
+      quat[0] = (m[2] + m[6]) / S;
+      quat[1] = (m[5] + m[7]) / S;
+      quat[2] = 0.25 * S;
+      quat[3] = (m[3] - m[1]) / S;
+   }
+}
+
+
+static inline void
+local_quat_to_matrix (const dmz::Float64 Quat[4], dmz::Matrix &value) {
+
+   const dmz::Float64 X (Quat[0]), Y (Quat[1]), Z (Quat[2]), W (Quat[3]);
+   dmz::Float64 m[9];
+
+   m[0] = 1.0 - (2.0 * ((Y * Y) + (Z * Z)));
+   m[1] = 2.0 * ((X * Y) - (Z * W));
+   m[2] = 2.0 * ((X * Z) + (Y * W));
+   m[3] = 2.0 * ((X * Y) + (Z * W));
+   m[4] = 1.0 - (2.0 * ((X * X) + (Z * Z)));
+   m[5] = 2.0 * ((Y * Z) - (X * W));
+   m[6] = 2.0 * ((X * Z) - (Y * W));
+   m[7] = 2.0 * ((Y * Z) + (X * W));
+   m[8] = 1.0 - (2.0 * ((X * X) + (Y * Y)));
+
+   value.from_array (m);
+}
+
+
+static inline dmz::UInt32
+local_pack_quat (const dmz::Float64 Quat[4]) {
+
+   dmz::Int32 largest (0);
+
+   for (dmz::Int32 ix = 1; ix < 4; ix++) {
+
+      if (fabs (Quat[ix]) > fabs (Quat[largest])) { largest = ix; }
+   }
+
+   // q and -q are the same rotation so the largest component is always positive.
+   const dmz::Float64 Sign (Quat[largest] < 0.0 ? -1.0 : 1.0);
+   dmz::UInt32 result (dmz::UInt32 (largest) << 30);
+   dmz::Int32 shift (20);
+
+   for (dmz::Int32 ix = 0; ix < 4; ix++) {
+
+      if (ix != largest) {
+
+         dmz::Float64 value (
+            (((Quat[ix] * Sign) + LocalQuatRange) / (2.0 * LocalQuatRange)) *
+            LocalQuatScale);
+
+         if (value < 0.0) { value = 0.0; }
+         else if (value > LocalQuatScale) { value = LocalQuatScale; }
+
+         result |= (dmz::UInt32 (floor (value + 0.5)) & LocalQuatMask) << shift;
+         shift -= 10;
+      }
+   }
+
+   return result;
+}
+
+
+static inline void
+local_unpack_quat (const dmz::UInt32 Value, dmz::Float64 quat[4]) {
+
+   const dmz::Int32 Largest (dmz::Int32 (Value >> 30));
+   dmz::Int32 shift (20);
+   dmz::Float64 sum (0.0);
+
+   for (dmz::Int32 ix = 0; ix < 4; ix++) {
+
+      if (ix != Largest) {
+
+         quat[ix] =
+            ((dmz::Float64 ((Value >> shift) & LocalQuatMask) / LocalQuatScale) *
+               (2.0 * LocalQuatRange)) - LocalQuatRange;
+
+         sum += quat[ix] * quat[ix];
+         shift -= 10;
+      }
+   }
+
+   quat[Largest] = sum < 1.0 ? sqrt (1.0 - sum) : 0.0;
+
+   const dmz::Float64 Length (sqrt (sum + (quat[Largest] * quat[Largest])));
+
+   if (Length > 0.0) { for (dmz::Int32 ix = 0; ix < 4; ix++) { quat[ix] /= Length; } }
+}
+
+
+MatrixCodec::MatrixCodec (dmz::Config &local) : _encoding (EncodeFloat64) {
+
+   const dmz::String Encoding (dmz::config_to_string ("encoding", local).to_lower ());
+
+   if (Encoding == "float32") { _encoding = EncodeFloat32; }
+   else if (Encoding == "quaternion") { _encoding = EncodeQuaternion; }
+}
+
+
+void
+MatrixCodec::decode (dmz::Unmarshal &data, dmz::Matrix &value) const {
+
+   if (_encoding == EncodeQuaternion) {
+
+      dmz::Float64 quat[4];
+      local_unpack_quat (data.get_next_uint32 (), quat);
+      local_quat_to_matrix (quat, value);
+   }
+   else if (_encoding == EncodeFloat32) { data.get_next_matrix32 (value); }
+   else { data.get_next_matrix (value); }
+}
+
+
+void
+MatrixCodec::encode (dmz::Matrix &value, dmz::Marshal &data) const {
+
+   if (_encoding == EncodeQuaternion) {
+
+      dmz::Float64 quat[4];
+      local_matrix_to_quat (value, quat);
+      const dmz::UInt32 Packed (local_pack_quat (quat));
+      data.set_next_uint32 (Packed);
+      local_unpack_quat (Packed, quat);
+      local_quat_to_matrix (quat, value);
+   }
+   else if (_encoding == EncodeFloat32) {
+
+      data.set_next_matrix32 (value);
+
+      dmz::Float32 array[9];
+      value.to_array32 (array);
+      value.from_array32 (array);
+   }
+   else { data.set_next_matrix (value); }
+}
+
+
 class SubLink : public Adapter {
 
    public:
@@ -872,7 +1403,8 @@ class Position : public Adapter {
 
    public:
       Position (dmz::Config &local, dmz::RuntimeContext *context) :
-            Adapter (local, context) {;}
+            Adapter (local, context),
+            _codec (local) {;}
 
       virtual void decode (
          const dmz::Handle ObjectHandle,
@@ -883,6 +1415,9 @@ class Position : public Adapter {
          const dmz::Handle ObjectHandle,
          dmz::ObjectModule &objMod,
          dmz::Marshal &data);
+
+   protected:
+      VectorCodec _codec;
 };
 
 
@@ -893,7 +1428,7 @@ Position::decode (
       dmz::ObjectModule &objMod) {
 
    dmz::Vector value;
-   data.get_next_vector (value);
+   _codec.decode (data, value);
    objMod.store_position (ObjectHandle, _AttributeHandle, value);
 
    if (_LNVHandle) { objMod.store_position (ObjectHandle, _LNVHandle, value); }
@@ -908,7 +1443,7 @@ Position::encode (
 
    dmz::Vector value;
    objMod.lookup_position (ObjectHandle, _AttributeHandle, value);
-   data.set_next_vector (value);
+   _codec.encode (value, data);
 
    if (_LNVHandle) { objMod.store_position (ObjectHandle, _LNVHandle, value); }
 }
@@ -918,7 +1453,8 @@ class Orientation : public Adapter {
 
    public:
       Orientation (dmz::Config &local, dmz::RuntimeContext *context) :
-            Adapter (local, context) {;}
+            Adapter (local, context),
+            _codec (local) {;}
 
       virtual void decode (
          const dmz::Handle ObjectHandle,
@@ -929,6 +1465,9 @@ class Orientation : public Adapter {
          const dmz::Handle ObjectHandle,
          dmz::ObjectModule &objMod,
          dmz::Marshal &data);
+
+   protected:
+      MatrixCodec _codec;
 };
 
 
@@ -939,7 +1478,7 @@ Orientation::decode (
       dmz::ObjectModule &objMod) {
 
    dmz::Matrix value;
-   data.get_next_matrix (value);
+   _codec.decode (data, value);
    objMod.store_orientation (ObjectHandle, _AttributeHandle, value);
 
    if (_LNVHandle) { objMod.store_orientation (ObjectHandle, _LNVHandle, value); }
@@ -954,7 +1493,7 @@ Orientation::encode (
 
    dmz::Matrix value;
    objMod.lookup_orientation (ObjectHandle, _AttributeHandle, value);
-   data.set_next_matrix (value);
+   _codec.encode (value, data);
 
    if (_LNVHandle) { objMod.store_orientation (ObjectHandle, _LNVHandle, value); }
 }
@@ -964,7 +1503,8 @@ class Velocity : public Adapter {
 
    public:
       Velocity (dmz::Config &local, dmz::RuntimeContext *context) :
-            Adapter (local, context) {;}
+            Adapter (local, context),
+            _codec (local) {;}
 
       virtual void decode (
          const dmz::Handle ObjectHandle,
@@ -975,6 +1515,9 @@ class Velocity : public Adapter {
          const dmz::Handle ObjectHandle,
          dmz::ObjectModule &objMod,
          dmz::Marshal &data);
+
+   protected:
+      VectorCodec _codec;
 };
 
 
@@ -985,7 +1528,7 @@ Velocity::decode (
       dmz::ObjectModule &objMod) {
 
    dmz::Vector value;
-   data.get_next_vector (value);
+   _codec.decode (data, value);
    objMod.store_velocity (ObjectHandle, _AttributeHandle, value);
 
    if (_LNVHandle) { objMod.store_velocity (ObjectHandle, _LNVHandle, value); }
@@ -1000,7 +1543,7 @@ Velocity::encode (
 
    dmz::Vector value;
    objMod.lookup_velocity (ObjectHandle, _AttributeHandle, value);
-   data.set_next_vector (value);
+   _codec.encode (value, data);
 
    if (_LNVHandle) { objMod.store_velocity (ObjectHandle, _LNVHandle, value); }
 }
@@ -1010,7 +1553,8 @@ class Acceleration : public Adapter {
 
    public:
       Acceleration (dmz::Config &local, dmz::RuntimeContext *context) :
-            Adapter (local, context) {;}
+            Adapter (local, context),
+            _codec (local) {;}
 
       virtual void decode (
          const dmz::Handle ObjectHandle,
@@ -1021,6 +1565,9 @@ class Acceleration : public Adapter {
          const dmz::Handle ObjectHandle,
          dmz::ObjectModule &objMod,
          dmz::Marshal &data);
+
+   protected:
+      VectorCodec _codec;
 };
 
 
@@ -1031,7 +1578,7 @@ Acceleration::decode (
       dmz::ObjectModule &objMod) {
 
    dmz::Vector value;
-   data.get_next_vector (value);
+   _codec.decode (data, value);
    objMod.store_acceleration (ObjectHandle, _AttributeHandle, value);
 
    if (_LNVHandle) { objMod.store_acceleration (ObjectHandle, _LNVHandle, value); }
@@ -1046,7 +1593,7 @@ Acceleration::encode (
 
    dmz::Vector value;
    objMod.lookup_acceleration (ObjectHandle, _AttributeHandle, value);
-   data.set_next_vector (value);
+   _codec.encode (value, data);
 
    if (_LNVHandle) { objMod.store_acceleration (ObjectHandle, _LNVHandle, value); }
 }
@@ -1056,7 +1603,8 @@ class Scale : public Adapter {
 
    public:
       Scale (dmz::Config &local, dmz::RuntimeContext *context) :
-            Adapter (local, context) {;}
+            Adapter (local, context),
+            _codec (local) {;}
 
       virtual void decode (
          const dmz::Handle ObjectHandle,
@@ -1067,6 +1615,9 @@ class Scale : public Adapter {
          const dmz::Handle ObjectHandle,
          dmz::ObjectModule &objMod,
          dmz::Marshal &data);
+
+   protected:
+      VectorCodec _codec;
 };
 
 
@@ -1077,7 +1628,7 @@ Scale::decode (
       dmz::ObjectModule &objMod) {
 
    dmz::Vector value;
-   data.get_next_vector (value);
+   _codec.decode (data, value);
    objMod.store_scale (ObjectHandle, _AttributeHandle, value);
 
    if (_LNVHandle) { objMod.store_scale (ObjectHandle, _LNVHandle, value); }
@@ -1092,7 +1643,7 @@ Scale::encode (
 
    dmz::Vector value;
    objMod.lookup_scale (ObjectHandle, _AttributeHandle, value);
-   data.set_next_vector (value);
+   _codec.encode (value, data);
 
    if (_LNVHandle) { objMod.store_scale (ObjectHandle, _LNVHandle, value); }
 }
@@ -1102,7 +1653,8 @@ class VectorAttr : public Adapter {
 
    public:
       VectorAttr (dmz::Config &local, dmz::RuntimeContext *context) :
-            Adapter (local, context) {;}
+            Adapter (local, context),
+            _codec (local) {;}
 
       virtual void decode (
          const dmz::Handle ObjectHandle,
@@ -1113,6 +1665,9 @@ class VectorAttr : public Adapter {
          const dmz::Handle ObjectHandle,
          dmz::ObjectModule &objMod,
          dmz::Marshal &data);
+
+   protected:
+      VectorCodec _codec;
 };
 
 
@@ -1123,7 +1678,7 @@ VectorAttr::decode (
       dmz::ObjectModule &objMod) {
 
    dmz::Vector value;
-   data.get_next_vector (value);
+   _codec.decode (data, value);
    objMod.store_vector (ObjectHandle, _AttributeHandle, value);
 
    if (_LNVHandle) { objMod.store_vector (ObjectHandle, _LNVHandle, value); }
@@ -1138,7 +1693,7 @@ VectorAttr::encode (
 
    dmz::Vector value;
    objMod.lookup_vector (ObjectHandle, _AttributeHandle, value);
-   data.set_next_vector (value);
+   _codec.encode (value, data);
 
    if (_LNVHandle) { objMod.store_vector (ObjectHandle, _LNVHandle, value); }
 }
@@ -1412,6 +1967,7 @@ dmz::NetExtPacketCodecObjectNative::ObjectAttributeAdapter::ObjectAttributeAdapt
       Config &local,
       RuntimeContext *context) :
       next (0),
+      statsHandle (0),
       _AttributeHandle (local_create_attribute_handle (local, context)),
       _LNVHandle (local_create_lnv_handle (local, context)) {;}
 
@@ -1453,6 +2009,12 @@ dmz::NetExtPacketCodecObjectNative::create_object_adapter (
       log.error << "Unknown object attribute adapter type: " << Type << endl;
    }
 
+   if (result) {
+
+      result->statsHandle = Definitions (context).create_named_handle (
+         Type + ":" + config_to_string ("attribute", local, ObjectAttributeDefaultName));
+   }
+
    return result;
 }
 //! \endcond
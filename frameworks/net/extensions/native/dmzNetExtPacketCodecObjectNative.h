@@ -4,9 +4,12 @@
 #include <dmzNetExtPacketCodec.h>
 #include <dmzObjectModule.h>
 #include <dmzNetModuleAttributeMap.h>
+#include <dmzNetModuleStats.h>
 #include <dmzRuntimeLog.h>
 #include <dmzRuntimePlugin.h>
 #include <dmzRuntimeTime.h>
+#include <dmzSystemMarshal.h>
+#include <dmzTypesHashTableHandleTemplate.h>
 #include <dmzTypesUUID.h>
 
 namespace dmz {
@@ -41,6 +44,7 @@ namespace dmz {
                   Marshal &data) = 0;
 
                ObjectAttributeAdapter *next;
+               Handle statsHandle;
 
             protected:
                const Handle _AttributeHandle;
@@ -73,6 +77,26 @@ namespace dmz {
             Marshal &data);
 
       protected:
+         struct ObjectStruct {
+
+            Float64 keyTime;
+            Int32 *offsets;
+            Marshal data;
+
+            ObjectStruct (const Int32 AdapterCount) :
+                  keyTime (0.0),
+                  offsets (new Int32[AdapterCount + 1]),
+                  data (ByteOrderBigEndian) {;}
+
+            ~ObjectStruct () { delete []offsets; offsets = 0; }
+         };
+
+         void _encode_adapters (
+            const Handle ObjectHandle,
+            const Boolean Delta,
+            ObjectStruct &obj,
+            Marshal &data);
+
          void _init (Config &local);
 
          const UUID _SysID;
@@ -84,7 +108,17 @@ namespace dmz {
 
          ObjectModule *_objMod;
          NetModuleAttributeMap *_attrMod;
+         NetModuleStats *_statsMod;
          ObjectAttributeAdapter *_adapterList;
+         Int32 _adapterCount;
+
+         Boolean _delta;
+         Float64 _keyframeInterval;
+         Int32 _maskSize;
+         UInt8 *_mask;
+         Int32 *_offsets;
+         Marshal _adapterData;
+         HashTableHandleTemplate<ObjectStruct> _objTable;
          //! \endcond
 
       private:
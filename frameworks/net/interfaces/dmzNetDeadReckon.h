@@ -0,0 +1,260 @@
+#ifndef DMZ_NET_DEAD_RECKON_DOT_H
+#define DMZ_NET_DEAD_RECKON_DOT_H
+
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeObjectType.h>
+#include <dmzTypesBase.h>
+#include <dmzTypesMath.h>
+#include <dmzTypesMatrix.h>
+#include <dmzTypesString.h>
+#include <dmzTypesVector.h>
+
+/*!
+
+\file
+\ingroup Net
+\brief Defines the dead reckoning models shared by the local and remote dead reckoning
+plugins.
+\details The same functions are used to decide when a local object needs to be sent and
+to extrapolate a remote object so both sides agree on where an object should be.
+The model of an object is set once in its object type so that the local and remote
+sides can not disagree:
+\code
+<object-type name="Type Name">
+   <net>
+      <dead-reckon model="rotation-acceleration"/>
+   </net>
+</object-type>
+\endcode
+All models work in world coordinates. The angular velocity is a world space vector
+whose direction is the axis of rotation and whose magnitude is the rate of rotation in
+radians per second.
+
+*/
+
+namespace dmz {
+
+//! \addtogroup Net
+//! @{
+
+   //! Dead reckoning model enumeration. Defined in dmzNetDeadReckon.h.
+   enum NetDeadReckonModelEnum {
+      NetDeadReckonStatic,       //!< No extrapolation.
+      NetDeadReckonVelocity,     //!< Constant velocity.
+      NetDeadReckonAcceleration, //!< Constant acceleration.
+      NetDeadReckonRotation,     //!< Constant velocity and angular velocity.
+      NetDeadReckonRotationAcceleration //!< Constant acceleration and angular velocity.
+   };
+
+   //! Angular velocity attribute handle name. Defined in dmzNetDeadReckon.h.
+   const char NetAttributeAngularVelocityName[] = "Object_Angular_Velocity";
+
+   NetDeadReckonModelEnum string_to_net_dead_reckon_model (
+      const String &Value,
+      const NetDeadReckonModelEnum DefaultValue = NetDeadReckonVelocity);
+
+   NetDeadReckonModelEnum lookup_net_dead_reckon_model (
+      const ObjectType &Type,
+      const NetDeadReckonModelEnum DefaultValue = NetDeadReckonVelocity);
+
+   Boolean net_dead_reckon_uses_acceleration (const NetDeadReckonModelEnum Model);
+   Boolean net_dead_reckon_uses_rotation (const NetDeadReckonModelEnum Model);
+
+   Vector net_dead_reckon_position (
+      const NetDeadReckonModelEnum Model,
+      const Vector &Position,
+      const Vector &Velocity,
+      const Vector &Acceleration,
+      const Float64 Time);
+
+   Matrix net_dead_reckon_orientation (
+      const NetDeadReckonModelEnum Model,
+      const Matrix &Orientation,
+      const Vector &AngularVelocity,
+      const Float64 Time);
+};
+
+
+/*!
+
+\brief Converts a String to a dead reckoning model.
+\details Defined in dmzNetDeadReckon.h.
+Accepts "static", "velocity", "acceleration", "rotation", and "rotation-acceleration".
+The DIS names "fpw", "fvw", "rpw", and "rvw" are also accepted.
+\param[in] Value String containing the name of the model.
+\param[in] DefaultValue Model returned if \a Value is not recognized.
+\return Returns the dead reckoning model.
+
+*/
+inline dmz::NetDeadReckonModelEnum
+dmz::string_to_net_dead_reckon_model (
+      const String &Value,
+      const NetDeadReckonModelEnum DefaultValue) {
+
+   NetDeadReckonModelEnum result (DefaultValue);
+
+   const String Name (Value.get_lower ());
+
+   if (Name == "static") { result = NetDeadReckonStatic; }
+   else if ((Name == "velocity") || (Name == "fpw")) { result = NetDeadReckonVelocity; }
+   else if ((Name == "acceleration") || (Name == "fvw")) {
+
+      result = NetDeadReckonAcceleration;
+   }
+   else if ((Name == "rotation") || (Name == "rpw")) { result = NetDeadReckonRotation; }
+   else if ((Name == "rotation-acceleration") || (Name == "rvw")) {
+
+      result = NetDeadReckonRotationAcceleration;
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Looks up the dead reckoning model of an object type.
+\details Defined in dmzNetDeadReckon.h.
+The model is read from the \a net.dead-reckon.model config of the object type. If the
+object type does not define a model, the parent object types are searched.
+\param[in] Type Object type of the object.
+\param[in] DefaultValue Model returned if no model is defined.
+\return Returns the dead reckoning model.
+
+*/
+inline dmz::NetDeadReckonModelEnum
+dmz::lookup_net_dead_reckon_model (
+      const ObjectType &Type,
+      const NetDeadReckonModelEnum DefaultValue) {
+
+   NetDeadReckonModelEnum result (DefaultValue);
+
+   ObjectType current (Type);
+   Boolean found (False);
+
+   while (current && !found) {
+
+      Config model;
+
+      if (current.get_config ().lookup_config ("net.dead-reckon", model)) {
+
+         result = string_to_net_dead_reckon_model (
+            config_to_string ("model", model),
+            DefaultValue);
+
+         found = True;
+      }
+      else { current.become_parent (); }
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Tests if a dead reckoning model uses acceleration.
+\details Defined in dmzNetDeadReckon.h.
+\param[in] Model Dead reckoning model.
+\return Returns dmz::True if the model extrapolates with acceleration.
+
+*/
+inline dmz::Boolean
+dmz::net_dead_reckon_uses_acceleration (const NetDeadReckonModelEnum Model) {
+
+   return (Model == NetDeadReckonAcceleration) ||
+      (Model == NetDeadReckonRotationAcceleration);
+}
+
+
+/*!
+
+\brief Tests if a dead reckoning model extrapolates orientation.
+\details Defined in dmzNetDeadReckon.h.
+\param[in] Model Dead reckoning model.
+\return Returns dmz::True if the model extrapolates with angular velocity.
+
+*/
+inline dmz::Boolean
+dmz::net_dead_reckon_uses_rotation (const NetDeadReckonModelEnum Model) {
+
+   return (Model == NetDeadReckonRotation) ||
+      (Model == NetDeadReckonRotationAcceleration);
+}
+
+
+/*!
+
+\brief Extrapolates a position.
+\details Defined in dmzNetDeadReckon.h.
+\param[in] Model Dead reckoning model.
+\param[in] Position Last known position.
+\param[in] Velocity Last known velocity.
+\param[in] Acceleration Last known acceleration. Ignored unless the model uses it.
+\param[in] Time Seconds since the last known values.
+\return Returns the extrapolated position.
+
+*/
+inline dmz::Vector
+dmz::net_dead_reckon_position (
+      const NetDeadReckonModelEnum Model,
+      const Vector &Position,
+      const Vector &Velocity,
+      const Vector &Acceleration,
+      const Float64 Time) {
+
+   Vector result (Position);
+
+   if (Model != NetDeadReckonStatic) {
+
+      result += Velocity * Time;
+
+      if (net_dead_reckon_uses_acceleration (Model)) {
+
+         result += Acceleration * (0.5 * Time * Time);
+      }
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Extrapolates an orientation.
+\details Defined in dmzNetDeadReckon.h.
+\param[in] Model Dead reckoning model.
+\param[in] Orientation Last known orientation.
+\param[in] AngularVelocity Last known world space angular velocity.
+\param[in] Time Seconds since the last known values.
+\return Returns the extrapolated orientation. The orientation is returned unchanged if
+the model does not use rotation.
+
+*/
+inline dmz::Matrix
+dmz::net_dead_reckon_orientation (
+      const NetDeadReckonModelEnum Model,
+      const Matrix &Orientation,
+      const Vector &AngularVelocity,
+      const Float64 Time) {
+
+   Matrix result (Orientation);
+
+   if (net_dead_reckon_uses_rotation (Model)) {
+
+      const Float64 Rate (AngularVelocity.magnitude ());
+
+      if (!is_zero64 (Rate)) {
+
+         const Matrix Delta (AngularVelocity, Rate * Time);
+         result = Delta * Orientation;
+      }
+   }
+
+   return result;
+}
+
+//! @}
+
+#endif // DMZ_NET_DEAD_RECKON_DOT_H
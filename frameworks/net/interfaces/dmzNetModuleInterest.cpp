@@ -0,0 +1,41 @@
+/*!
+
+\class dmz::NetModuleInterest
+\ingroup Net
+\brief Maps local objects to network channels and filters incoming channels.
+\details A channel is a numeric id for a region of the world. Packets for a local
+object are tagged with the channel of the region the object is in. Packets tagged with a
+channel the host is not subscribed to are dropped before being decoded. Channel zero is
+reserved for packets that should be received by all hosts.
+
+\fn dmz::NetModuleInterest::NetModuleInterest (const PluginInfo &Info)
+\brief Constructor.
+
+\fn dmz::NetModuleInterest::~NetModuleInterest ()
+\brief Destructor.
+
+\fn dmz::NetModuleInterest *dmz::NetModuleInterest::cast (
+const Plugin *PluginPtr,
+const String &PluginName);
+\brief Casts Plugin pointer to an NetModuleInterest.
+\details If the Plugin object implements the NetModuleInterest interface, a pointer to
+the NetModuleInterest interface of the Plugin is returned.
+\param[in] PluginPtr Pointer to the Plugin to cast.
+\param[in] PluginName String containing the name of the desired NetModuleInterest.
+\return Returns pointer to the NetModuleInterest. Returns NULL if the PluginPtr does not
+implement the NetModuleInterest interface or the \a PluginName is not empty
+and not equal to the Plugin's name.
+
+\fn dmz::UInt32 dmz::NetModuleInterest::lookup_object_channel (
+const Handle ObjectHandle)
+\brief Looks up the channel of a local object.
+\param[in] ObjectHandle Handle of the object.
+\return Returns the channel of the region the object is in. Returns zero if the
+object's packets should be received by all hosts.
+
+\fn dmz::Boolean dmz::NetModuleInterest::is_channel_subscribed (const UInt32 Channel)
+\brief Tests if the host is interested in a channel.
+\param[in] Channel Channel to test.
+\return Returns dmz::True if packets tagged with \a Channel should be decoded.
+
+*/
@@ -0,0 +1,63 @@
+#ifndef DMZ_NET_MODULE_INTEREST_DOT_H
+#define DMZ_NET_MODULE_INTEREST_DOT_H
+
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeRTTI.h>
+#include <dmzTypesBase.h>
+
+namespace dmz {
+
+   //! \cond
+   const char NetModuleInterestInterfaceName[] = "NetModuleInterestInterface";
+   //! \endcond
+
+   class NetModuleInterest {
+
+      public:
+         static NetModuleInterest *cast (
+            const Plugin *PluginPtr,
+            const String &PluginName = "");
+
+         // NetModuleInterest Interface
+         virtual UInt32 lookup_object_channel (const Handle ObjectHandle) = 0;
+         virtual Boolean is_channel_subscribed (const UInt32 Channel) = 0;
+
+      protected:
+         NetModuleInterest (const PluginInfo &Info);
+         ~NetModuleInterest ();
+
+      private:
+         NetModuleInterest ();
+         NetModuleInterest (const NetModuleInterest &);
+         NetModuleInterest &operator= (const NetModuleInterest &);
+
+         const PluginInfo &__Info;
+   };
+};
+
+
+inline dmz::NetModuleInterest *
+dmz::NetModuleInterest::cast (const Plugin *PluginPtr, const String &PluginName) {
+
+   return (NetModuleInterest *)lookup_rtti_interface (
+      NetModuleInterestInterfaceName,
+      PluginName,
+      PluginPtr);
+}
+
+
+inline
+dmz::NetModuleInterest::NetModuleInterest (const PluginInfo &Info) :
+      __Info (Info) {
+
+   store_rtti_interface (NetModuleInterestInterfaceName, __Info, (void *)this);
+}
+
+
+inline
+dmz::NetModuleInterest::~NetModuleInterest () {
+
+   remove_rtti_interface (NetModuleInterestInterfaceName, __Info);
+}
+
+#endif // DMZ_NET_MODULE_INTEREST_DOT_H
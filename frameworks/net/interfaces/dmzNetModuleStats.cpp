@@ -0,0 +1,93 @@
+/*!
+
+\class dmz::NetModuleStats
+\ingroup Net
+\brief Aggregates network traffic statistics.
+\details Packet totals and histograms are collected for each direction. The packet
+codecs report the number of bytes used by each object type and by each object attribute
+adapter so the bandwidth used by a type or an attribute may be found. Rates are the
+counts from the last full second. \n \n
+Each histogram has dmz::NetStatsHistogramBins bins and covers a rolling window of time.
+Bin zero of the packet size histogram holds packets smaller than 32 bytes and each
+following bin doubles the limit. Bin zero of the inter-arrival histogram holds packets
+that arrived less than 0.0001 seconds after the previous packet and each following bin
+doubles the limit. The last bin of both histograms holds every larger value.
+
+\fn dmz::NetModuleStats::NetModuleStats (const PluginInfo &Info)
+\brief Constructor.
+
+\fn dmz::NetModuleStats::~NetModuleStats ()
+\brief Destructor.
+
+\fn dmz::NetModuleStats *dmz::NetModuleStats::cast (
+const Plugin *PluginPtr,
+const String &PluginName);
+\brief Casts Plugin pointer to an NetModuleStats.
+\details If the Plugin object implements the NetModuleStats interface, a pointer to
+the NetModuleStats interface of the Plugin is returned.
+\param[in] PluginPtr Pointer to the Plugin to cast.
+\param[in] PluginName String containing the name of the desired NetModuleStats.
+\return Returns pointer to the NetModuleStats. Returns NULL if the PluginPtr does not
+implement the NetModuleStats interface or the \a PluginName is not empty
+and not equal to the Plugin's name.
+
+\fn void dmz::NetModuleStats::add_object_stat (
+const NetStatsDirectionEnum Direction,
+const ObjectType &Type,
+const Int32 Size)
+\brief Adds an encoded or decoded object to the statistics.
+\param[in] Direction Specifies if the object was read or written.
+\param[in] Type ObjectType of the object.
+\param[in] Size Number of bytes used by the object in the packet.
+
+\fn void dmz::NetModuleStats::add_adapter_stat (
+const NetStatsDirectionEnum Direction,
+const Handle AdapterHandle,
+const Int32 Size)
+\brief Adds an encoded or decoded attribute to the statistics.
+\param[in] Direction Specifies if the attribute was read or written.
+\param[in] AdapterHandle Named handle of the attribute adapter.
+\param[in] Size Number of bytes used by the attribute in the packet.
+
+\fn dmz::Boolean dmz::NetModuleStats::get_packet_stats (
+const NetStatsDirectionEnum Direction,
+NetStats &stats)
+\brief Gets the packet statistics.
+\param[in] Direction Specifies the direction.
+\param[out] stats NetStats containing the packet counts.
+\return Returns dmz::True if \a stats was set.
+
+\fn dmz::Boolean dmz::NetModuleStats::get_object_stats (
+const NetStatsDirectionEnum Direction,
+const ObjectType &Type,
+NetStats &stats)
+\brief Gets the statistics of an object type.
+\param[in] Direction Specifies the direction.
+\param[in] Type ObjectType to look up. Derived types are not included.
+\param[out] stats NetStats containing the object counts.
+\return Returns dmz::True if objects of \a Type have been seen.
+
+\fn dmz::Boolean dmz::NetModuleStats::get_adapter_stats (
+const NetStatsDirectionEnum Direction,
+const Handle AdapterHandle,
+NetStats &stats)
+\brief Gets the statistics of an attribute adapter.
+\param[in] Direction Specifies the direction.
+\param[in] AdapterHandle Named handle of the attribute adapter.
+\param[out] stats NetStats containing the attribute counts.
+\return Returns dmz::True if the adapter has been seen.
+
+\fn dmz::Boolean dmz::NetModuleStats::get_histogram (
+const NetStatsDirectionEnum Direction,
+const NetStatsHistogramEnum Histogram,
+UInt64 counts[NetStatsHistogramBins])
+\brief Gets a histogram.
+\param[in] Direction Specifies the direction.
+\param[in] Histogram Specifies the histogram.
+\param[out] counts Array that receives the count of each bin.
+\return Returns dmz::True if \a counts was set.
+
+\fn void dmz::NetModuleStats::dump_stats ()
+\brief Writes the current statistics to the log.
+
+*/
@@ -0,0 +1,129 @@
+#ifndef DMZ_NET_MODULE_STATS_DOT_H
+#define DMZ_NET_MODULE_STATS_DOT_H
+
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeRTTI.h>
+#include <dmzTypesBase.h>
+
+namespace dmz {
+
+   class ObjectType;
+
+   //! \cond
+   const char NetModuleStatsInterfaceName[] = "NetModuleStatsInterface";
+   //! \endcond
+
+   //! \addtogroup Net
+   //! @{
+
+   //! Network statistics direction. Defined in dmzNetModuleStats.h.
+   enum NetStatsDirectionEnum {
+      NetStatsRead,  //!< Packets received.
+      NetStatsWrite, //!< Packets sent.
+   };
+
+   //! Network statistics histogram. Defined in dmzNetModuleStats.h.
+   enum NetStatsHistogramEnum {
+      NetStatsPacketSize,   //!< Packet size in bytes.
+      NetStatsInterArrival, //!< Seconds between packets.
+   };
+
+   //! Number of bins in a network statistics histogram. Defined in dmzNetModuleStats.h.
+   const Int32 NetStatsHistogramBins = 12;
+
+   //! Network statistics counts. Defined in dmzNetModuleStats.h.
+   struct NetStats {
+
+      UInt64 packets; //!< Total number of packets.
+      UInt64 bytes; //!< Total number of bytes.
+      Float64 packetsPerSecond; //!< Packets in the last second.
+      Float64 bytesPerSecond; //!< Bytes in the last second.
+
+      //! Constructor.
+      NetStats () :
+            packets (0),
+            bytes (0),
+            packetsPerSecond (0.0),
+            bytesPerSecond (0.0) {;}
+   };
+
+   //! @}
+
+   class NetModuleStats {
+
+      public:
+         static NetModuleStats *cast (
+            const Plugin *PluginPtr,
+            const String &PluginName = "");
+
+         // NetModuleStats Interface
+         virtual void add_object_stat (
+            const NetStatsDirectionEnum Direction,
+            const ObjectType &Type,
+            const Int32 Size) = 0;
+
+         virtual void add_adapter_stat (
+            const NetStatsDirectionEnum Direction,
+            const Handle AdapterHandle,
+            const Int32 Size) = 0;
+
+         virtual Boolean get_packet_stats (
+            const NetStatsDirectionEnum Direction,
+            NetStats &stats) = 0;
+
+         virtual Boolean get_object_stats (
+            const NetStatsDirectionEnum Direction,
+            const ObjectType &Type,
+            NetStats &stats) = 0;
+
+         virtual Boolean get_adapter_stats (
+            const NetStatsDirectionEnum Direction,
+            const Handle AdapterHandle,
+            NetStats &stats) = 0;
+
+         virtual Boolean get_histogram (
+            const NetStatsDirectionEnum Direction,
+            const NetStatsHistogramEnum Histogram,
+            UInt64 counts[NetStatsHistogramBins]) = 0;
+
+         virtual void dump_stats () = 0;
+
+      protected:
+         NetModuleStats (const PluginInfo &Info);
+         ~NetModuleStats ();
+
+      private:
+         NetModuleStats ();
+         NetModuleStats (const NetModuleStats &);
+         NetModuleStats &operator= (const NetModuleStats &);
+
+         const PluginInfo &__Info;
+   };
+};
+
+
+inline dmz::NetModuleStats *
+dmz::NetModuleStats::cast (const Plugin *PluginPtr, const String &PluginName) {
+
+   return (NetModuleStats *)lookup_rtti_interface (
+      NetModuleStatsInterfaceName,
+      PluginName,
+      PluginPtr);
+}
+
+
+inline
+dmz::NetModuleStats::NetModuleStats (const PluginInfo &Info) :
+      __Info (Info) {
+
+   store_rtti_interface (NetModuleStatsInterfaceName, __Info, (void *)this);
+}
+
+
+inline
+dmz::NetModuleStats::~NetModuleStats () {
+
+   remove_rtti_interface (NetModuleStatsInterfaceName, __Info);
+}
+
+#endif // DMZ_NET_MODULE_STATS_DOT_H
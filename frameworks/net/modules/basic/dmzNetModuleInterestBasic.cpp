@@ -0,0 +1,286 @@
+#include "dmzNetModuleInterestBasic.h"
+#include <dmzObjectAttributeMasks.h>
+#include <dmzObjectConsts.h>
+#include <dmzObjectModule.h>
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+
+#include <math.h>
+
+/*!
+
+\class dmz::NetModuleInterestBasic
+\ingroup Net
+\brief Basic area of interest network module.
+\details The ground plane is divided into square cells and each cell is mapped to a
+network channel. Packets for a local object are tagged with the channel of the cell the
+object is in. The host subscribes to every cell within the interest radius of its local
+objects. If types are specified, only local objects of those types define the area of
+interest. A host without any positioned objects of interest is subscribed to every
+channel. A channel holds the X and Z cell coordinates in 15 bits each so cell
+coordinates are clamped to the range [-16384, 16383]. Objects beyond that range share
+the channels of the outermost cells.
+\code
+<local-scope>
+   <cell size="1000.0"/>
+   <interest radius="2000.0"/>
+   <object-type name="Object Type Name"/>
+   ...
+</local-scope>
+\endcode
+
+*/
+
+//! \cond
+static const dmz::UInt32 LocalChannelFlag (0x80000000);
+static const dmz::Int32 LocalCoordBits (15);
+static const dmz::UInt32 LocalCoordMask ((1 << LocalCoordBits) - 1);
+static const dmz::Float64 LocalCoordMin (-dmz::Float64 (1 << (LocalCoordBits - 1)));
+static const dmz::Float64 LocalCoordMax (dmz::Float64 ((1 << (LocalCoordBits - 1)) - 1));
+
+
+dmz::NetModuleInterestBasic::NetModuleInterestBasic (
+      const PluginInfo &Info,
+      Config &local) :
+      Plugin (Info),
+      TimeSlice (Info),
+      NetModuleInterest (Info),
+      ObjectObserverUtil (Info, local),
+      _log (Info),
+      _defaultHandle (0),
+      _cellSize (1000.0),
+      _radius (2000.0),
+      _dirty (False) {
+
+   _init (local);
+}
+
+
+dmz::NetModuleInterestBasic::~NetModuleInterestBasic () {
+
+   _interestTable.empty ();
+}
+
+
+// TimeSlice Interface
+void
+dmz::NetModuleInterestBasic::update_time_slice (const Float64 TimeDelta) {
+
+   if (_dirty) { _update_channels (); }
+}
+
+
+// NetModuleInterest Interface
+dmz::UInt32
+dmz::NetModuleInterestBasic::lookup_object_channel (const Handle ObjectHandle) {
+
+   UInt32 result (0);
+
+   ObjectModule *objMod (get_object_module ());
+   Vector pos;
+
+   if (objMod && objMod->lookup_position (ObjectHandle, _defaultHandle, pos)) {
+
+      result = _map_channel (_map_coord (pos.get_x ()), _map_coord (pos.get_z ()));
+   }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::NetModuleInterestBasic::is_channel_subscribed (const UInt32 Channel) {
+
+   if (_dirty) { _update_channels (); }
+
+   // Objects without a position do not add any channels so an empty channel list means
+   // there is nothing to filter on.
+   return !Channel || !_channels.get_count () || _channels.contains (Channel);
+}
+
+
+// Object Observer Interface
+void
+dmz::NetModuleInterestBasic::create_object (
+      const UUID &Identity,
+      const Handle ObjectHandle,
+      const ObjectType &Type,
+      const ObjectLocalityEnum Locality) {
+
+   if (Locality == ObjectLocal) { _add_interest (ObjectHandle, Type); }
+}
+
+
+void
+dmz::NetModuleInterestBasic::destroy_object (
+      const UUID &Identity,
+      const Handle ObjectHandle) {
+
+   InterestStruct *is (_interestTable.remove (ObjectHandle));
+
+   if (is) { delete is; is = 0; _dirty = True; }
+}
+
+
+void
+dmz::NetModuleInterestBasic::update_object_locality (
+      const UUID &Identity,
+      const Handle ObjectHandle,
+      const ObjectLocalityEnum Locality,
+      const ObjectLocalityEnum PrevLocality) {
+
+   ObjectModule *objMod (get_object_module ());
+
+   if ((Locality == ObjectLocal) && objMod) {
+
+      _add_interest (ObjectHandle, objMod->lookup_object_type (ObjectHandle));
+   }
+   else { destroy_object (Identity, ObjectHandle); }
+}
+
+
+void
+dmz::NetModuleInterestBasic::update_object_position (
+      const UUID &Identity,
+      const Handle ObjectHandle,
+      const Handle AttributeHandle,
+      const Vector &Value,
+      const Vector *PreviousValue) {
+
+   InterestStruct *is (_interestTable.lookup (ObjectHandle));
+
+   if (is) { _update_interest (*is, Value); }
+}
+
+
+dmz::Int32
+dmz::NetModuleInterestBasic::_map_coord (const Float64 Value) const {
+
+   Float64 cell (floor (Value / _cellSize));
+
+   // Clamps before the conversion so that the coordinate does not overflow the channel
+   // bits or the Int32. NaN is mapped to the lowest cell.
+   if (!(cell >= LocalCoordMin)) { cell = LocalCoordMin; }
+   else if (cell > LocalCoordMax) { cell = LocalCoordMax; }
+
+   return Int32 (cell);
+}
+
+
+dmz::UInt32
+dmz::NetModuleInterestBasic::_map_channel (const Int32 X, const Int32 Z) const {
+
+   return LocalChannelFlag |
+      ((UInt32 (X) & LocalCoordMask) << LocalCoordBits) | (UInt32 (Z) & LocalCoordMask);
+}
+
+
+void
+dmz::NetModuleInterestBasic::_add_interest (
+      const Handle ObjectHandle,
+      const ObjectType &Type) {
+
+   if (!_typeSet.get_count () || _typeSet.contains_type (Type)) {
+
+      if (!_interestTable.lookup (ObjectHandle)) {
+
+         InterestStruct *is (new InterestStruct);
+
+         if (!_interestTable.store (ObjectHandle, is)) { delete is; is = 0; }
+         else {
+
+            ObjectModule *objMod (get_object_module ());
+            Vector pos;
+
+            if (objMod && objMod->lookup_position (ObjectHandle, _defaultHandle, pos)) {
+
+               _update_interest (*is, pos);
+            }
+         }
+      }
+   }
+}
+
+
+// Only flags the channels for rebuilding when the cells covered by the object change.
+void
+dmz::NetModuleInterestBasic::_update_interest (
+      InterestStruct &is,
+      const Vector &Position) {
+
+   const Int32 MinX (_map_coord (Position.get_x () - _radius));
+   const Int32 MinZ (_map_coord (Position.get_z () - _radius));
+   const Int32 MaxX (_map_coord (Position.get_x () + _radius));
+   const Int32 MaxZ (_map_coord (Position.get_z () + _radius));
+
+   if ((MinX != is.minX) || (MinZ != is.minZ) || (MaxX != is.maxX) || (MaxZ != is.maxZ)) {
+
+      is.minX = MinX;
+      is.minZ = MinZ;
+      is.maxX = MaxX;
+      is.maxZ = MaxZ;
+      _dirty = True;
+   }
+}
+
+
+void
+dmz::NetModuleInterestBasic::_update_channels () {
+
+   _channels.clear ();
+
+   HashTableHandleIterator it;
+   InterestStruct *is (0);
+
+   while (_interestTable.get_next (it, is)) {
+
+      for (Int32 ix = is->minX; ix <= is->maxX; ix++) {
+
+         for (Int32 jz = is->minZ; jz <= is->maxZ; jz++) {
+
+            _channels.add (_map_channel (ix, jz));
+         }
+      }
+   }
+
+   _dirty = False;
+}
+
+
+void
+dmz::NetModuleInterestBasic::_init (Config &local) {
+
+   RuntimeContext *context (get_plugin_runtime_context ());
+
+   _defaultHandle = activate_default_object_attribute (
+      ObjectCreateMask | ObjectDestroyMask | ObjectLocalityMask | ObjectPositionMask);
+
+   _cellSize = config_to_float64 ("cell.size", local, _cellSize);
+   _radius = config_to_float64 ("interest.radius", local, _radius);
+   _typeSet = config_to_object_type_set (local, context);
+
+   if (_cellSize <= 0.0) {
+
+      _log.error << "Invalid cell size: " << _cellSize << " using 1000.0" << endl;
+      _cellSize = 1000.0;
+   }
+
+   _log.info << "Cell size: " << _cellSize << " Interest radius: " << _radius << endl;
+}
+//! \endcond
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetModuleInterestBasic (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetModuleInterestBasic (Info, local);
+}
+
+};
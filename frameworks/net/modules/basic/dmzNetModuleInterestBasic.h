@@ -0,0 +1,102 @@
+#ifndef DMZ_NET_MODULE_INTEREST_BASIC_DOT_H
+#define DMZ_NET_MODULE_INTEREST_BASIC_DOT_H
+
+#include <dmzNetModuleInterest.h>
+#include <dmzObjectObserverUtil.h>
+#include <dmzRuntimeLog.h>
+#include <dmzRuntimeObjectType.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzTypesHandleContainer.h>
+#include <dmzTypesHashTableHandleTemplate.h>
+#include <dmzTypesVector.h>
+
+namespace dmz {
+
+   class NetModuleInterestBasic :
+         public Plugin,
+         public TimeSlice,
+         public NetModuleInterest,
+         public ObjectObserverUtil {
+
+      public:
+         //! \cond
+         NetModuleInterestBasic (const PluginInfo &Info, Config &local);
+         ~NetModuleInterestBasic ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level) {;}
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr) {;}
+
+         // TimeSlice Interface
+         virtual void update_time_slice (const Float64 TimeDelta);
+
+         // NetModuleInterest Interface
+         virtual UInt32 lookup_object_channel (const Handle ObjectHandle);
+         virtual Boolean is_channel_subscribed (const UInt32 Channel);
+
+         // Object Observer Interface
+         virtual void create_object (
+            const UUID &Identity,
+            const Handle ObjectHandle,
+            const ObjectType &Type,
+            const ObjectLocalityEnum Locality);
+
+         virtual void destroy_object (const UUID &Identity, const Handle ObjectHandle);
+
+         virtual void update_object_locality (
+            const UUID &Identity,
+            const Handle ObjectHandle,
+            const ObjectLocalityEnum Locality,
+            const ObjectLocalityEnum PrevLocality);
+
+         virtual void update_object_position (
+            const UUID &Identity,
+            const Handle ObjectHandle,
+            const Handle AttributeHandle,
+            const Vector &Value,
+            const Vector *PreviousValue);
+
+      protected:
+         struct InterestStruct {
+
+            Int32 minX;
+            Int32 minZ;
+            Int32 maxX;
+            Int32 maxZ;
+
+            InterestStruct () : minX (0), minZ (0), maxX (-1), maxZ (-1) {;}
+         };
+
+         Int32 _map_coord (const Float64 Value) const;
+         UInt32 _map_channel (const Int32 X, const Int32 Z) const;
+         void _add_interest (const Handle ObjectHandle, const ObjectType &Type);
+         void _update_interest (InterestStruct &is, const Vector &Position);
+         void _update_channels ();
+         void _init (Config &local);
+
+         Log _log;
+
+         Handle _defaultHandle;
+         Float64 _cellSize;
+         Float64 _radius;
+         ObjectTypeSet _typeSet;
+         Boolean _dirty;
+
+         HandleContainer _channels;
+         HashTableHandleTemplate<InterestStruct> _interestTable;
+         //! \endcond
+
+      private:
+         NetModuleInterestBasic ();
+         NetModuleInterestBasic (const NetModuleInterestBasic &);
+         NetModuleInterestBasic &operator= (const NetModuleInterestBasic &);
+   };
+};
+
+#endif // DMZ_NET_MODULE_INTEREST_BASIC_DOT_H
@@ -1,13 +1,18 @@
 #include "dmzNetModuleLocalDRBasic.h"
+#include <dmzNetDeadReckon.h>
+#include <dmzObjectAttributeMasks.h>
 #include <dmzObjectConsts.h>
 #include <dmzObjectModule.h>
+#include <dmzObjectModuleGrid.h>
 #include <dmzRuntimeConfig.h>
 #include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeData.h>
 #include <dmzRuntimeDefinitions.h>
 #include <dmzRuntimeObjectType.h>
 #include <dmzRuntimePluginFactoryLinkSymbol.h>
 #include <dmzRuntimePluginInfo.h>
 #include <dmzRuntimeTime.h>
+#include <dmzSystem.h>
 #include <dmzTypesMask.h>
 #include <dmzTypesMatrix.h>
 #include <dmzTypesVector.h>
@@ -53,6 +58,79 @@ counter = N/A \n
 state = Empty Mask \n
 heartbeat = 5.0sec \n
 rate-limit = 1/15 of a second \n
+skew = 0.25m \n
+orientation-skew = 0.25 radians \n
+
+\n
+The skew and orientation-skew rules compare the current value with the last network
+value dead reckoned to the current frame time. The dead reckoning model is read from
+the \a net.dead-reckon config of the object type, the same config
+dmz::NetPluginRemoteDR uses on the remote side (see dmzNetDeadReckon.h). The model
+defaults to velocity. The orientation-skew rule only extrapolates the orientation for
+the rotation models. It reads the last network value of the angular velocity
+attribute named by the \a angular-velocity attribute which defaults to
+"Object_Angular_Velocity".
+\code
+<net>
+   <dead-reckon model="rotation-acceleration"/>
+   <rule type="skew" value="0.5"/>
+   <rule type="orientation-skew" value="0.05"/>
+</net>
+\endcode
+
+\n
+When a bandwidth budget is configured, updates are no longer sent the moment a rule
+fires. Once per frame every local object is tested, the objects that need an update are
+ranked and only as many as the budget allows are sent. The rest are deferred to a
+later frame. The rank of an object is:\n
+type priority * rule priority * observer factor * (1 + position error) * (1 + age)\n
+where the position error is the distance between the current position and the last
+network value dead reckoned with the model of the object type, and the age is the number
+of seconds since the last update was sent. The rule priority is set with the \a priority
+attribute of the rule that fired. State, counter and zero-velocity rules default to 4.0,
+all other rules to 1.0. The type priority defaults to 1.0 and is inherited from parent
+types. The observer factor is range / (range + distance) for the nearest remote observer
+object, or 1.0 when no observer types are configured. Observers further away than ten
+times the range are treated as if they were at ten times the range. The nearest observer
+is found with the ObjectModuleGrid when one is loaded. The budget is refilled from the
+real time that has passed so updates are still sent while the frame time is paused.
+Objects seen for the first time are sent right away if the budget allows, otherwise they
+compete with the other candidates in the next frame.
+Heartbeat rules accept a \a spread attribute that moves the first heartbeat of each
+object forward by a fixed fraction of the heartbeat interval so that objects created
+together do not send their heartbeats in the same frame. Later heartbeats keep the
+full interval.
+\code
+<dmz>
+<runtime>
+   <object-type name="Type Name">
+      <net>
+         <priority value="1.0"/>
+         <rule type="state" priority="4.0"/>
+         <rule type="heartbeat" value="5.0" spread="0.5"/>
+         ...
+      </net>
+   </object-type>
+</runtime>
+<dmzNetModuleLocalDRBasic>
+   <budget
+      bytes-per-second="Budget, zero disables scheduling"
+      packet-size="Estimated bytes per update, defaults to 200"
+      burst="Seconds of unused budget that may be saved, defaults to 0.25"
+      heartbeat-spread="Default heartbeat spread, defaults to 0.5 when budgeted"
+   />
+   <observer range="1000.0">
+      <object-type name="Observer Type Name"/>
+      ...
+   </observer>
+   <update-stats message="Message Name"/>
+</dmzNetModuleLocalDRBasic>
+</dmz>
+\endcode
+The optional update-stats message is sent once per frame with the number of
+candidates, sent and deferred updates, the sum of the deferred position error and
+the remaining budget stored under the named handles "candidates", "sent", "deferred",
+"deferred-error" and "credit".
 
 */
 
@@ -61,6 +139,15 @@ namespace {
 
    enum TestTypeEnum { TestPosition, TestVelocity, TestAcceleration, TestVector };
 
+   static const dmz::Float64 DiscreteWeight (4.0);
+
+   // Observers are searched for within this many observer ranges.
+   static const dmz::Float64 ObserverSearchScale (10.0);
+
+   // Local objects of an observer type are returned by the grid too so a few extra
+   // objects are asked for.
+   static const dmz::Int32 ObserverSearchCount (4);
+
    class debugWrapperTest : public dmz::NetModuleLocalDRBasic::ObjectUpdate {
 
       public:
@@ -76,6 +163,8 @@ namespace {
             dmz::ObjectModule &module,
             dmz::Boolean &limitRate);
 
+         virtual void remove_object (const dmz::Handle ObjectHandle);
+
       protected:
          const dmz::String _Name;
          dmz::NetModuleLocalDRBasic::ObjectUpdate &_test;
@@ -140,6 +229,20 @@ namespace {
          const dmz::Mask _StateMask;
    };
 
+   // Caches the dead reckoning model of each object type.
+   class modelTable {
+
+      public:
+         ~modelTable () { _table.empty (); }
+
+         dmz::NetDeadReckonModelEnum lookup (
+            const dmz::Handle ObjectHandle,
+            dmz::ObjectModule &module);
+
+      protected:
+         dmz::HashTableHandleTemplate<dmz::NetDeadReckonModelEnum> _table;
+   };
+
    class posSkewTest : public valueTest {
 
       public:
@@ -156,6 +259,28 @@ namespace {
 
       protected:
          const dmz::Time &_Time;
+         modelTable _models;
+   };
+
+   class oriSkewTest : public valueTest {
+
+      public:
+         oriSkewTest (
+            const dmz::Handle AttributeHandle,
+            const dmz::Handle LNVHandle,
+            const dmz::Handle AngularLNVHandle,
+            const dmz::Time &TheTime,
+            const dmz::Float64 Diff);
+
+         dmz::Boolean update_object (
+            const dmz::Handle ObjectHandle,
+            dmz::ObjectModule &module,
+            dmz::Boolean &limitRate);
+
+      protected:
+         const dmz::Handle _AngularLNVHandle;
+         const dmz::Time &_Time;
+         modelTable _models;
    };
 
    class vectorTest : public valueTest {
@@ -225,12 +350,19 @@ namespace {
          heartbeatTest (
             const dmz::Handle LNVHandle,
             const dmz::Time &TheTime,
-            const dmz::Float64 Diff);
+            const dmz::Float64 Diff,
+            const dmz::Float64 Spread);
 
          dmz::Boolean update_object (
             const dmz::Handle ObjectHandle,
             dmz::ObjectModule &module,
             dmz::Boolean &limitRate);
+
+         void remove_object (const dmz::Handle ObjectHandle);
+
+      protected:
+         const dmz::Float64 _Spread;
+         dmz::HandleContainer _started;
    };
 
    class limitRateTest : public timeTest {
@@ -255,7 +387,7 @@ debugWrapperTest::debugWrapperTest (
       dmz::Stream &stream) :
       _Name (Name),
       _test (test),
-      _stream (stream) {;}
+      _stream (stream) { weight = test.weight; }
 
 
 debugWrapperTest::~debugWrapperTest () { delete &_test; }
@@ -276,6 +408,13 @@ debugWrapperTest::update_object (
 }
 
 
+void
+debugWrapperTest::remove_object (const dmz::Handle ObjectHandle) {
+
+   _test.remove_object (ObjectHandle);
+}
+
+
 valueTest::valueTest (
       const dmz::Handle AttributeHandle,
       const dmz::Handle LNVHandle,
@@ -289,7 +428,7 @@ valueTest::valueTest (
 zeroVelocityTest::zeroVelocityTest (
       const dmz::Handle AttributeHandle,
       const dmz::Handle LNVHandle) :
-      valueTest (AttributeHandle, LNVHandle, 0.0) {;}
+      valueTest (AttributeHandle, LNVHandle, 0.0) { weight = DiscreteWeight; }
 
 
 dmz::Boolean
@@ -325,7 +464,7 @@ zeroVelocityTest::update_object (
 counterTest::counterTest (
       const dmz::Handle AttributeHandle,
       const dmz::Handle LNVHandle) :
-      valueTest (AttributeHandle, LNVHandle, 0.0) {;}
+      valueTest (AttributeHandle, LNVHandle, 0.0) { weight = DiscreteWeight; }
 
 
 dmz::Boolean
@@ -352,7 +491,8 @@ stateTest::stateTest (
       const dmz::Handle AttributeHandle,
       const dmz::Handle LNVHandle,
       const dmz::Mask &TheState) :
-      valueTest (AttributeHandle, LNVHandle, 0.0), _StateMask (TheState) {;}
+      valueTest (AttributeHandle, LNVHandle, 0.0),
+      _StateMask (TheState) { weight = DiscreteWeight; }
 
 
 dmz::Boolean
@@ -381,12 +521,35 @@ stateTest::update_object (
 }
 
 
+dmz::NetDeadReckonModelEnum
+modelTable::lookup (const dmz::Handle ObjectHandle, dmz::ObjectModule &module) {
+
+   dmz::NetDeadReckonModelEnum result (dmz::NetDeadReckonVelocity);
+
+   const dmz::ObjectType Type (module.lookup_object_type (ObjectHandle));
+
+   dmz::NetDeadReckonModelEnum *model (_table.lookup (Type.get_handle ()));
+
+   if (model) { result = *model; }
+   else {
+
+      result = dmz::lookup_net_dead_reckon_model (Type);
+
+      model = new dmz::NetDeadReckonModelEnum (result);
+      if (!_table.store (Type.get_handle (), model)) { delete model; model = 0; }
+   }
+
+   return result;
+}
+
+
 posSkewTest::posSkewTest (
       const dmz::Handle AttributeHandle,
       const dmz::Handle LNVHandle,
       const dmz::Time &TheTime,
       const dmz::Float64 Diff) :
-      valueTest (AttributeHandle, LNVHandle, Diff), _Time (TheTime) {;}
+      valueTest (AttributeHandle, LNVHandle, Diff),
+      _Time (TheTime) {;}
 
 
 dmz::Boolean
@@ -397,7 +560,7 @@ posSkewTest::update_object (
 
    dmz::Boolean result (dmz::False);
 
-   dmz::Vector pos, lnvPos, lnvVel;
+   dmz::Vector pos, lnvPos, lnvVel, lnvAccel;
    dmz::Float64 lnvStamp (0.0);
 
    if (module.lookup_position (ObjectHandle, _AttributeHandle, pos) &&
@@ -405,9 +568,21 @@ posSkewTest::update_object (
          module.lookup_velocity (ObjectHandle, _LNVHandle, lnvVel) &&
          module.lookup_time_stamp (ObjectHandle, _LNVHandle, lnvStamp)) {
 
+      const dmz::NetDeadReckonModelEnum Model (_models.lookup (ObjectHandle, module));
+
+      if (dmz::net_dead_reckon_uses_acceleration (Model)) {
+
+         module.lookup_acceleration (ObjectHandle, _LNVHandle, lnvAccel);
+      }
+
       const dmz::Float64 FrameTime (_Time.get_frame_time ());
 
-      lnvPos += lnvVel * (FrameTime - lnvStamp);
+      lnvPos = dmz::net_dead_reckon_position (
+         Model,
+         lnvPos,
+         lnvVel,
+         lnvAccel,
+         FrameTime - lnvStamp);
 
       const dmz::Float64 CalcDiff ((pos - lnvPos).magnitude ());
 
@@ -419,6 +594,64 @@ posSkewTest::update_object (
 }
 
 
+oriSkewTest::oriSkewTest (
+      const dmz::Handle AttributeHandle,
+      const dmz::Handle LNVHandle,
+      const dmz::Handle AngularLNVHandle,
+      const dmz::Time &TheTime,
+      const dmz::Float64 Diff) :
+      valueTest (AttributeHandle, LNVHandle, Diff),
+      _AngularLNVHandle (AngularLNVHandle),
+      _Time (TheTime) {;}
+
+
+dmz::Boolean
+oriSkewTest::update_object (
+      const dmz::Handle ObjectHandle,
+      dmz::ObjectModule &module,
+      dmz::Boolean &limitRate) {
+
+   dmz::Boolean result (dmz::False);
+
+   dmz::Matrix ori, lnvOri;
+   dmz::Vector lnvAngular;
+   dmz::Float64 lnvStamp (0.0);
+
+   if (module.lookup_orientation (ObjectHandle, _AttributeHandle, ori) &&
+         module.lookup_orientation (ObjectHandle, _LNVHandle, lnvOri) &&
+         module.lookup_time_stamp (ObjectHandle, _LNVHandle, lnvStamp)) {
+
+      module.lookup_vector (ObjectHandle, _AngularLNVHandle, lnvAngular);
+
+      lnvOri = dmz::net_dead_reckon_orientation (
+         _models.lookup (ObjectHandle, module),
+         lnvOri,
+         lnvAngular,
+         _Time.get_frame_time () - lnvStamp);
+
+      dmz::Vector vec1 (0.0, 0.0, -1.0);
+      dmz::Vector vec2 (0.0, 0.0, -1.0);
+
+      ori.transform_vector (vec1);
+      lnvOri.transform_vector (vec2);
+
+      if (vec1.get_angle (vec2) > _Diff) { result = dmz::True; }
+      else {
+
+         dmz::Vector vec3 (0.0, 1.0, 0.0);
+         dmz::Vector vec4 (0.0, 1.0, 0.0);
+
+         ori.transform_vector (vec3);
+         lnvOri.transform_vector (vec4);
+
+         if (vec3.get_angle (vec4) > _Diff) { result = dmz::True; }
+      }
+   }
+
+   return result;
+}
+
+
 vectorTest::vectorTest (
       const TestTypeEnum Type,
       const dmz::Handle AttributeHandle,
@@ -559,7 +792,10 @@ timeTest::timeTest (
 heartbeatTest::heartbeatTest (
       const dmz::Handle LNVHandle,
       const dmz::Time &TheTime,
-      const dmz::Float64 Diff) : timeTest (LNVHandle, TheTime, Diff) {;}
+      const dmz::Float64 Diff,
+      const dmz::Float64 Spread) :
+      timeTest (LNVHandle, TheTime, Diff),
+      _Spread (Diff * Spread) {;}
 
 
 dmz::Boolean
@@ -570,17 +806,38 @@ heartbeatTest::update_object (
 
    dmz::Boolean result (dmz::False);
 
-      dmz::Float64 lnvStamp (0.0);
+   dmz::Float64 lnvStamp (0.0);
+
+   if (module.lookup_time_stamp (ObjectHandle, _LNVHandle, lnvStamp)) {
+
+      // Only the first heartbeat is moved forward. Each object gets a fixed phase in
+      // [0, 1) so the spread is stable over time.
+      const dmz::Boolean First ((_Spread > 0.0) && !_started.contains (ObjectHandle));
 
-      if (module.lookup_time_stamp (ObjectHandle, _LNVHandle, lnvStamp)) {
+      const dmz::Float64 Offset (
+         First ?
+            _Spread * dmz::Float64 ((dmz::UInt32 (ObjectHandle) * 2654435761u) >> 16) /
+               65536.0 :
+            0.0);
 
-         if (_Time.get_frame_time () >= (lnvStamp + _Diff)) { result = dmz::True; }
+      if (_Time.get_frame_time () >= (lnvStamp + _Diff - Offset)) {
+
+         result = dmz::True;
+         if (First) { _started.add (ObjectHandle); }
       }
+   }
 
    return result;
 }
 
 
+void
+heartbeatTest::remove_object (const dmz::Handle ObjectHandle) {
+
+   _started.remove (ObjectHandle);
+}
+
+
 limitRateTest::limitRateTest (
       const dmz::Handle LNVHandle,
       const dmz::Time &TheTime,
@@ -609,11 +866,35 @@ dmz::NetModuleLocalDRBasic::NetModuleLocalDRBasic (
       Config &local) :
       Plugin (Info),
       NetModuleLocalDR (Info),
+      ObjectObserverUtil (Info, local),
       _log (Info),
       _time (Info),
+      _defaultTest (0),
       _objMod (0),
+      _gridMod (0),
       _debug (False),
-      _defaultHandle (0) {
+      _defaultHandle (0),
+      _lnvHandle (0),
+      _bytesPerSecond (0.0),
+      _packetSize (200.0),
+      _burst (0.25),
+      _heartbeatSpread (0.0),
+      _observerRange (1000.0),
+      _credit (0.0),
+      _frameTime (0.0),
+      _realTime (0.0),
+      _round (0),
+      _candidates (0),
+      _candidateSize (0),
+      _candidateCount (0),
+      _sentCount (0),
+      _deferredCount (0),
+      _deferredError (0.0),
+      _candidatesHandle (0),
+      _sentHandle (0),
+      _deferredHandle (0),
+      _errorHandle (0),
+      _creditHandle (0) {
 
    _init (local);
 }
@@ -625,6 +906,11 @@ dmz::NetModuleLocalDRBasic::~NetModuleLocalDRBasic () {
 
    _baseTable.empty ();
    _typeTable.clear ();
+   _scheduleTable.empty ();
+   _observerTable.empty ();
+   _scoreTable.empty ();
+
+   if (_candidates) { delete []_candidates; _candidates = 0; }
 }
 
 
@@ -637,10 +923,12 @@ dmz::NetModuleLocalDRBasic::discover_plugin (
    if (Mode == PluginDiscoverAdd) {
 
       if (!_objMod) { _objMod = ObjectModule::cast (PluginPtr); }
+      if (!_gridMod) { _gridMod = ObjectModuleGrid::cast (PluginPtr); }
    }
    else if (Mode == PluginDiscoverRemove) {
 
       if (_objMod && (_objMod == ObjectModule::cast (PluginPtr))) { _objMod = 0; }
+      if (_gridMod && (_gridMod == ObjectModuleGrid::cast (PluginPtr))) { _gridMod = 0; }
    }
 }
 
@@ -648,6 +936,70 @@ dmz::NetModuleLocalDRBasic::discover_plugin (
 dmz::Boolean
 dmz::NetModuleLocalDRBasic::update_object (const Handle ObjectHandle) {
 
+   return _bytesPerSecond > 0.0 ?
+      _schedule_object (ObjectHandle) :
+      _test_object (ObjectHandle, 0);
+}
+
+
+// Object Observer Interface
+void
+dmz::NetModuleLocalDRBasic::create_object (
+      const UUID &Identity,
+      const Handle ObjectHandle,
+      const ObjectType &Type,
+      const ObjectLocalityEnum Locality) {
+
+   if ((Locality == ObjectRemote) && _observerTypes.contains_type (Type)) {
+
+      ObserverStruct *os (new ObserverStruct);
+
+      if (_observerTable.store (ObjectHandle, os)) {
+
+         ObjectModule *objMod (get_object_module ());
+         if (objMod) { objMod->lookup_position (ObjectHandle, _defaultHandle, os->pos); }
+      }
+      else { delete os; os = 0; }
+   }
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::destroy_object (
+      const UUID &Identity,
+      const Handle ObjectHandle) {
+
+   ObserverStruct *os (_observerTable.remove (ObjectHandle));
+
+   if (os) { delete os; os = 0; }
+
+   ScheduleStruct *ss (_scheduleTable.remove (ObjectHandle));
+
+   if (ss) { delete ss; ss = 0; }
+
+   _remove_object_from_tests (ObjectHandle);
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::update_object_position (
+      const UUID &Identity,
+      const Handle ObjectHandle,
+      const Handle AttributeHandle,
+      const Vector &Value,
+      const Vector *PreviousValue) {
+
+   ObserverStruct *os (_observerTable.lookup (ObjectHandle));
+
+   if (os) { os->pos = Value; }
+}
+
+
+dmz::Boolean
+dmz::NetModuleLocalDRBasic::_test_object (
+      const Handle ObjectHandle,
+      ObjectUpdate **fired) {
+
    Boolean result (False);
 
    if (_objMod) {
@@ -665,6 +1017,7 @@ dmz::NetModuleLocalDRBasic::update_object (const Handle ObjectHandle) {
          while (test && !result && !limitRate) {
 
             result = test->update_object (ObjectHandle, *_objMod, limitRate);
+            if (result && fired) { *fired = test; }
             test = test->next;
          }
       }
@@ -674,6 +1027,452 @@ dmz::NetModuleLocalDRBasic::update_object (const Handle ObjectHandle) {
 }
 
 
+// Every local object is asked about once per frame. A new round of scheduling starts
+// when the frame time changes or when an object is asked about a second time, so
+// updates are still scheduled while the frame time is paused. Objects seen for the
+// first time are tested immediately and sent if the budget allows. Otherwise they are
+// ranked with the other candidates in the next round.
+dmz::Boolean
+dmz::NetModuleLocalDRBasic::_schedule_object (const Handle ObjectHandle) {
+
+   Boolean result (False);
+
+   const Float64 FrameTime (_time.get_frame_time ());
+
+   ScheduleStruct *ss (_scheduleTable.lookup (ObjectHandle));
+
+   if ((FrameTime != _frameTime) || !_round || (ss && (ss->round == _round))) {
+
+      _schedule_frame (FrameTime);
+   }
+
+   if (ss) {
+
+      result = ss->send;
+      ss->send = False;
+      ss->round = _round;
+   }
+   else {
+
+      ss = new ScheduleStruct (ObjectHandle);
+
+      if (_scheduleTable.store (ObjectHandle, ss)) { ss->round = _round; }
+      else { delete ss; ss = 0; }
+
+      if (_test_object (ObjectHandle, 0)) {
+
+         if (_credit >= _packetSize) {
+
+            result = True;
+            _credit -= _packetSize;
+            _sentCount++;
+         }
+         else { _deferredCount++; }
+      }
+   }
+
+   return result;
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::_schedule_frame (const Float64 FrameTime) {
+
+   const Float64 RealTime (_get_real_time ());
+   const Float64 MaxCredit (_bytesPerSecond * _burst);
+
+   if (_round) {
+
+      _send_stats ();
+
+      const Float64 Delta (RealTime - _realTime);
+
+      if (Delta > 0.0) { _credit += _bytesPerSecond * Delta; }
+   }
+   else { _credit = MaxCredit; }
+
+   if (_credit > MaxCredit) { _credit = MaxCredit; }
+
+   const UInt32 LastRound (_round);
+   _frameTime = FrameTime;
+   _realTime = RealTime;
+   _round++;
+
+   _candidateCount = 0;
+   _sentCount = 0;
+   _deferredCount = 0;
+   _deferredError = 0.0;
+
+   HandleContainer stale;
+   HashTableHandleIterator it;
+   ScheduleStruct *ss (0);
+
+   while (_scheduleTable.get_next (it, ss)) {
+
+      ss->send = False;
+
+      // Objects not asked about during the last round are no longer local.
+      if (ss->round != LastRound) { stale.add (ss->Object); }
+      else {
+
+         ObjectUpdate *fired (0);
+
+         if (_test_object (ss->Object, &fired) && fired) {
+
+            _score_object (*ss, *fired);
+
+            if (_candidateCount >= _candidateSize) { _grow_candidates (); }
+            _candidates[_candidateCount] = ss;
+            _candidateCount++;
+         }
+      }
+   }
+
+   HandleContainerIterator staleIt;
+   Handle object (0);
+
+   while (stale.get_next (staleIt, object)) {
+
+      ss = _scheduleTable.remove (object);
+      if (ss) { delete ss; ss = 0; }
+   }
+
+   _sort_candidates ();
+
+   for (Int32 ix = 0; ix < _candidateCount; ix++) {
+
+      ss = _candidates[ix];
+
+      if (_credit >= _packetSize) {
+
+         ss->send = True;
+         _credit -= _packetSize;
+         _sentCount++;
+      }
+      else {
+
+         _deferredCount++;
+         _deferredError += ss->error;
+      }
+   }
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::_score_object (
+      ScheduleStruct &ss,
+      const ObjectUpdate &Fired) {
+
+   Float64 priority (Fired.weight);
+   Float64 age (0.0);
+   NetDeadReckonModelEnum model (NetDeadReckonVelocity);
+
+   ss.error = 0.0;
+
+   const ObjectType Type (_objMod->lookup_object_type (ss.Object));
+
+   ScoreStruct *score (Type ? _lookup_score (Type) : 0);
+
+   if (score) { priority *= score->Priority; model = score->Model; }
+
+   Vector pos;
+
+   if (_objMod->lookup_position (ss.Object, _defaultHandle, pos)) {
+
+      Vector lnvPos, lnvVel, lnvAccel;
+      Float64 lnvStamp (0.0);
+
+      if (_objMod->lookup_time_stamp (ss.Object, _lnvHandle, lnvStamp)) {
+
+         age = _frameTime - lnvStamp;
+         if (age < 0.0) { age = 0.0; }
+      }
+
+      if (_objMod->lookup_position (ss.Object, _lnvHandle, lnvPos)) {
+
+         // Same extrapolation the remote side and the skew rules use.
+         _objMod->lookup_velocity (ss.Object, _lnvHandle, lnvVel);
+
+         if (net_dead_reckon_uses_acceleration (model)) {
+
+            _objMod->lookup_acceleration (ss.Object, _lnvHandle, lnvAccel);
+         }
+
+         lnvPos = net_dead_reckon_position (model, lnvPos, lnvVel, lnvAccel, age);
+
+         ss.error = (pos - lnvPos).magnitude ();
+      }
+
+      priority *= _observer_factor (pos);
+   }
+
+   ss.score = priority * (1.0 + ss.error) * (1.0 + age);
+}
+
+
+dmz::Float64
+dmz::NetModuleLocalDRBasic::_observer_factor (const Vector &Position) {
+
+   Float64 result (1.0);
+
+   if (_observerTable.get_count ()) {
+
+      const Float64 Radius (_observerRange * ObserverSearchScale);
+      Float64 distance (Radius);
+
+      if (_gridMod) {
+
+         // Local objects of the observer types are returned by the grid too, so the
+         // search is widened until a remote observer is found or the radius is used up.
+         Int32 count (ObserverSearchCount);
+         Boolean done (False);
+
+         while (!done) {
+
+            _nearest.clear ();
+
+            _gridMod->find_nearest_objects (
+               Position,
+               count,
+               Radius,
+               _nearest,
+               &_observerTypes);
+
+            HandleContainerIterator it;
+            Handle object (0);
+
+            while (_nearest.get_next (it, object)) {
+
+               ObserverStruct *os (_observerTable.lookup (object));
+
+               if (os) {
+
+                  const Float64 Distance ((os->pos - Position).magnitude ());
+                  if (Distance < distance) { distance = Distance; done = True; }
+               }
+            }
+
+            if (_nearest.get_count () < count) { done = True; }
+            else { count *= 2; }
+         }
+      }
+      else {
+
+         HashTableHandleIterator it;
+         ObserverStruct *os (0);
+         Float64 nearest (Radius * Radius);
+
+         while (_observerTable.get_next (it, os)) {
+
+            const Float64 Distance ((os->pos - Position).magnitude_squared ());
+            if (Distance < nearest) { nearest = Distance; }
+         }
+
+         distance = sqrt (nearest);
+      }
+
+      result = _observerRange / (_observerRange + distance);
+   }
+
+   return result;
+}
+
+
+// The budget is a network rate so it is refilled from the frame clock when one is set
+// and from the system time otherwise, not from the frame time.
+dmz::Float64
+dmz::NetModuleLocalDRBasic::_get_real_time () const {
+
+   FrameClock *clock (_time.get_frame_clock ());
+
+   return clock ? clock->get_frame_clock_time () : get_time ();
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::_remove_object_from_tests (const Handle ObjectHandle) {
+
+   HashTableUInt32Iterator it;
+   ObjectUpdate *test (0);
+
+   while (_baseTable.get_next (it, test)) {
+
+      while (test) { test->remove_object (ObjectHandle); test = test->next; }
+   }
+
+   test = _defaultTest;
+
+   while (test) { test->remove_object (ObjectHandle); test = test->next; }
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::_grow_candidates () {
+
+   const Int32 Size (_candidateSize < 64 ? 64 : _candidateSize * 2);
+   ScheduleStruct **list = new ScheduleStruct *[Size];
+
+   for (Int32 ix = 0; ix < _candidateCount; ix++) { list[ix] = _candidates[ix]; }
+
+   if (_candidates) { delete []_candidates; }
+   _candidates = list;
+   _candidateSize = Size;
+}
+
+
+// Min heap sort so the candidate with the highest score is first.
+void
+dmz::NetModuleLocalDRBasic::_sort_candidates () {
+
+   for (Int32 ix = (_candidateCount / 2) - 1; ix >= 0; ix--) {
+
+      _sift_candidates (ix, _candidateCount);
+   }
+
+   for (Int32 ix = _candidateCount - 1; ix > 0; ix--) {
+
+      ScheduleStruct *tmp (_candidates[0]);
+      _candidates[0] = _candidates[ix];
+      _candidates[ix] = tmp;
+      _sift_candidates (0, ix);
+   }
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::_sift_candidates (const Int32 Start, const Int32 Count) {
+
+   Int32 parent (Start);
+   Boolean done (False);
+
+   while (!done) {
+
+      Int32 smallest (parent);
+      const Int32 Left ((parent * 2) + 1);
+      const Int32 Right (Left + 1);
+
+      if ((Left < Count) && (_candidates[Left]->score < _candidates[smallest]->score)) {
+
+         smallest = Left;
+      }
+
+      if ((Right < Count) &&
+            (_candidates[Right]->score < _candidates[smallest]->score)) {
+
+         smallest = Right;
+      }
+
+      if (smallest != parent) {
+
+         ScheduleStruct *tmp (_candidates[parent]);
+         _candidates[parent] = _candidates[smallest];
+         _candidates[smallest] = tmp;
+         parent = smallest;
+      }
+      else { done = True; }
+   }
+}
+
+
+dmz::NetModuleLocalDRBasic::ScoreStruct *
+dmz::NetModuleLocalDRBasic::_lookup_score (const ObjectType &Type) {
+
+   ScoreStruct *ss (_scoreTable.lookup (Type.get_handle ()));
+
+   if (!ss) {
+
+      Float64 value (1.0);
+      ObjectType current (Type);
+      Boolean found (False);
+
+      while (current && !found) {
+
+         Config priority;
+
+         if (current.get_config ().lookup_config ("net.priority", priority)) {
+
+            value = config_to_float64 ("value", priority, value);
+            found = True;
+         }
+         else { current.become_parent (); }
+      }
+
+      ss = new ScoreStruct (value, lookup_net_dead_reckon_model (Type));
+
+      if (!_scoreTable.store (Type.get_handle (), ss)) { delete ss; ss = 0; }
+   }
+
+   return ss;
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::_send_stats () {
+
+   if (_statsMsg) {
+
+      Data data;
+      data.store_int32 (_candidatesHandle, 0, _candidateCount);
+      data.store_int32 (_sentHandle, 0, _sentCount);
+      data.store_int32 (_deferredHandle, 0, _deferredCount);
+      data.store_float64 (_errorHandle, 0, _deferredError);
+      data.store_float64 (_creditHandle, 0, _credit);
+
+      _statsMsg.send (&data);
+   }
+}
+
+
+void
+dmz::NetModuleLocalDRBasic::_init_budget (Config &local) {
+
+   _bytesPerSecond = config_to_float64 ("budget.bytes-per-second", local, 0.0);
+
+   if (_bytesPerSecond > 0.0) {
+
+      RuntimeContext *context (get_plugin_runtime_context ());
+      Definitions defs (context, &_log);
+
+      _packetSize = config_to_float64 ("budget.packet-size", local, _packetSize);
+      _burst = config_to_float64 ("budget.burst", local, _burst);
+      _heartbeatSpread = config_to_float64 ("budget.heartbeat-spread", local, 0.5);
+      _observerRange = config_to_float64 ("observer.range", local, _observerRange);
+      _observerTypes = config_to_object_type_set ("observer", local, context);
+
+      if (_packetSize <= 0.0) {
+
+         _log.error << "Invalid packet size: " << _packetSize << " using 200" << endl;
+         _packetSize = 200.0;
+      }
+
+      if (_burst < 0.0) { _burst = 0.0; }
+      if (_observerRange <= 0.0) { _observerRange = 1000.0; }
+
+      _lnvHandle = defs.create_named_handle (ObjectAttributeLastNetworkValueName);
+
+      if (_observerTypes.get_count ()) {
+
+         activate_default_object_attribute (
+            ObjectCreateMask | ObjectDestroyMask | ObjectPositionMask);
+      }
+
+      const String StatsMessageName (config_to_string ("update-stats.message", local));
+
+      if (StatsMessageName) {
+
+         defs.create_message (StatsMessageName, _statsMsg);
+         _candidatesHandle = defs.create_named_handle ("candidates");
+         _sentHandle = defs.create_named_handle ("sent");
+         _deferredHandle = defs.create_named_handle ("deferred");
+         _errorHandle = defs.create_named_handle ("deferred-error");
+         _creditHandle = defs.create_named_handle ("credit");
+      }
+
+      _log.info << "Update budget: " << _bytesPerSecond << " bytes per second" << endl;
+   }
+}
+
+
 void
 dmz::NetModuleLocalDRBasic::_init (Config &local) {
 
@@ -683,6 +1482,11 @@ dmz::NetModuleLocalDRBasic::_init (Config &local) {
 
    _defaultHandle = defs.create_named_handle (ObjectAttributeDefaultName);
 
+   // Rules may keep per object state that is released when the object is destroyed.
+   activate_default_object_attribute (ObjectDestroyMask);
+
+   _init_budget (local);
+
    Config defaultList;
 
    _log.info << "Creating default network transmission rules." << endl;
@@ -704,7 +1508,8 @@ dmz::NetModuleLocalDRBasic::_init (Config &local) {
       ObjectUpdate *current = _defaultTest = new heartbeatTest (
          LNVHandle,
          _time,
-         5.0);
+         5.0,
+         _heartbeatSpread);
 
       if (current) {
 
@@ -848,12 +1653,27 @@ dmz::NetModuleLocalDRBasic::_create_update_list (Config &listData) {
             _time,
             config_to_float64 ("value", cd, 0.25));
       }
+      else if (Type == "orientation-skew") {
+
+         const String AngularName (config_to_string (
+            "angular-velocity",
+            cd,
+            NetAttributeAngularVelocityName));
+
+         next = new oriSkewTest (
+            AttributeHandle,
+            LNVHandle,
+            defs.create_named_handle (create_last_network_value_name (AngularName)),
+            _time,
+            config_to_float64 ("value", cd, 0.25));
+      }
       else if (Type == "heartbeat") {
 
          next = new heartbeatTest (
             LNVHandle,
             _time,
-            config_to_float64 ("value", cd, 5.0));
+            config_to_float64 ("value", cd, 5.0),
+            config_to_float64 ("spread", cd, _heartbeatSpread));
       }
       else if (Type == "rate-limit") {
 
@@ -866,6 +1686,8 @@ dmz::NetModuleLocalDRBasic::_create_update_list (Config &listData) {
 
       if (next) {
 
+         next->weight = config_to_float64 ("priority", cd, next->weight);
+
          if (_debug) { next = new debugWrapperTest (Type, *next, _log.error); }
 
          _log.info << "Adding rule: " << Type << endl;
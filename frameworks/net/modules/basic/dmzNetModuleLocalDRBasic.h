@@ -1,21 +1,29 @@
 #ifndef DMZ_NET_MODULE_LOCAL_DR_BASIC_DOT_H
 #define DMZ_NET_MODULE_LOCAL_DR_BASIC_DOT_H
 
+#include <dmzNetDeadReckon.h>
 #include <dmzNetModuleLocalDR.h>
+#include <dmzObjectObserverUtil.h>
 #include <dmzRuntimeLog.h>
+#include <dmzRuntimeMessaging.h>
+#include <dmzRuntimeObjectType.h>
 #include <dmzRuntimePlugin.h>
 #include <dmzRuntimeTime.h>
+#include <dmzTypesHandleContainer.h>
+#include <dmzTypesHashTableHandleTemplate.h>
 #include <dmzTypesHashTableUInt32Template.h>
 #include <dmzTypesDeleteListTemplate.h>
+#include <dmzTypesVector.h>
 
 namespace dmz {
 
    class ObjectModule;
-   class ObjectType;
+   class ObjectModuleGrid;
 
    class NetModuleLocalDRBasic :
          public Plugin,
-         public NetModuleLocalDR {
+         public NetModuleLocalDR,
+         public ObjectObserverUtil {
 
       public:
          //! \cond
@@ -23,6 +31,7 @@ namespace dmz {
 
             public:
                ObjectUpdate *next;
+               Float64 weight;
 
                virtual ~ObjectUpdate () { delete_list (next); }
 
@@ -31,8 +40,10 @@ namespace dmz {
                   ObjectModule &module,
                   Boolean &limitRate) = 0;
 
+               virtual void remove_object (const Handle ObjectHandle) {;}
+
             protected:
-               ObjectUpdate () : next (0) {;}
+               ObjectUpdate () : next (0), weight (1.0) {;}
 
             private:
                ObjectUpdate (const ObjectUpdate &);
@@ -54,7 +65,66 @@ namespace dmz {
          // NetModuleLocalDR Interface
          virtual Boolean update_object (const Handle ObjectHandle);
 
+         // Object Observer Interface
+         virtual void create_object (
+            const UUID &Identity,
+            const Handle ObjectHandle,
+            const ObjectType &Type,
+            const ObjectLocalityEnum Locality);
+
+         virtual void destroy_object (const UUID &Identity, const Handle ObjectHandle);
+
+         virtual void update_object_position (
+            const UUID &Identity,
+            const Handle ObjectHandle,
+            const Handle AttributeHandle,
+            const Vector &Value,
+            const Vector *PreviousValue);
+
       protected:
+         struct ScheduleStruct {
+
+            const Handle Object;
+            UInt32 round;
+            Float64 score;
+            Float64 error;
+            Boolean send;
+
+            ScheduleStruct (const Handle TheObject) :
+                  Object (TheObject),
+                  round (0),
+                  score (0.0),
+                  error (0.0),
+                  send (False) {;}
+         };
+
+         struct ScoreStruct {
+
+            const Float64 Priority;
+            const NetDeadReckonModelEnum Model;
+
+            ScoreStruct (
+                  const Float64 ThePriority,
+                  const NetDeadReckonModelEnum TheModel) :
+                  Priority (ThePriority),
+                  Model (TheModel) {;}
+         };
+
+         struct ObserverStruct { Vector pos; };
+
+         Boolean _test_object (const Handle ObjectHandle, ObjectUpdate **fired);
+         Boolean _schedule_object (const Handle ObjectHandle);
+         void _schedule_frame (const Float64 FrameTime);
+         void _score_object (ScheduleStruct &ss, const ObjectUpdate &Fired);
+         Float64 _observer_factor (const Vector &Position);
+         Float64 _get_real_time () const;
+         void _remove_object_from_tests (const Handle ObjectHandle);
+         void _grow_candidates ();
+         void _sift_candidates (const Int32 Start, const Int32 Count);
+         void _sort_candidates ();
+         ScoreStruct *_lookup_score (const ObjectType &Type);
+         void _send_stats ();
+         void _init_budget (Config &local);
          void _init (Config &local);
          ObjectUpdate *_create_update_list (Config &listData);
          ObjectUpdate *_create_test_from_type (const ObjectType &Type);
@@ -68,9 +138,41 @@ namespace dmz {
          HashTableUInt32Template<ObjectUpdate> _typeTable;
 
          ObjectModule *_objMod;
+         ObjectModuleGrid *_gridMod;
 
          Boolean _debug;
          UInt32 _defaultHandle;
+         Handle _lnvHandle;
+
+         Float64 _bytesPerSecond;
+         Float64 _packetSize;
+         Float64 _burst;
+         Float64 _heartbeatSpread;
+         Float64 _observerRange;
+         ObjectTypeSet _observerTypes;
+
+         Float64 _credit;
+         Float64 _frameTime;
+         Float64 _realTime;
+         UInt32 _round;
+         ScheduleStruct **_candidates;
+         Int32 _candidateSize;
+         Int32 _candidateCount;
+         Int32 _sentCount;
+         Int32 _deferredCount;
+         Float64 _deferredError;
+
+         HashTableHandleTemplate<ScheduleStruct> _scheduleTable;
+         HashTableHandleTemplate<ObserverStruct> _observerTable;
+         HashTableUInt32Template<ScoreStruct> _scoreTable;
+         HandleContainer _nearest;
+
+         Message _statsMsg;
+         Handle _candidatesHandle;
+         Handle _sentHandle;
+         Handle _deferredHandle;
+         Handle _errorHandle;
+         Handle _creditHandle;
          //! \endcond
 
       private:
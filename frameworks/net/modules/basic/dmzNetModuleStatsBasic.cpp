@@ -0,0 +1,431 @@
+#include "dmzNetModuleStatsBasic.h"
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimeObjectType.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzSystem.h>
+
+/*!
+
+\class dmz::NetModuleStatsBasic
+\ingroup Net
+\brief Basic implementation of the network statistics module.
+\details Packet counts and histograms are gathered from dmz::NetPluginPacket through the
+dmz::NetPacketStatsObserver interface. Object type and attribute adapter counts are
+reported by the object packet codecs. Attribute adapters are named by their type and
+attribute, for example "position:Object_Default_Attribute". The rates are updated once
+a second. The histograms cover the last \b window seconds. \n \n
+The statistics are written to the log when the dump message is received. The
+dmz::PluginConsole may be used to send the message from a key press:
+\code
+<dmzPluginConsole>
+   <message key="n" name="NetStatsDumpMessage"/>
+</dmzPluginConsole>
+\endcode
+\code
+<local-scope>
+   <histogram window="Seconds of history kept in the histograms. Defaults to 10"/>
+   <dump message="Message Name. Defaults to NetStatsDumpMessage"/>
+</local-scope>
+\endcode
+
+*/
+
+//! \cond
+static const dmz::Float64 LocalSizeBase (32.0);
+static const dmz::Float64 LocalTimeBase (0.0001);
+
+
+static dmz::Int32
+local_bin (const dmz::Float64 Value, const dmz::Float64 Base) {
+
+   dmz::Int32 result (0);
+   dmz::Float64 limit (Base);
+
+   while ((Value >= limit) && (result < (dmz::NetStatsHistogramBins - 1))) {
+
+      limit *= 2.0;
+      result++;
+   }
+
+   return result;
+}
+
+
+dmz::NetModuleStatsBasic::NetModuleStatsBasic (
+      const PluginInfo &Info,
+      Config &local) :
+      Plugin (Info),
+      TimeSlice (Info, TimeSliceTypeSystemTime, TimeSliceModeRepeating, 1.0),
+      NetModuleStats (Info),
+      NetPacketStatsObserver (Info),
+      MessageObserver (Info),
+      _log (Info),
+      _window (10),
+      _slot (0),
+      _read ("Read"),
+      _write ("Write") {
+
+   _init (local);
+}
+
+
+dmz::NetModuleStatsBasic::~NetModuleStatsBasic () {;}
+
+
+// TimeSlice Interface
+void
+dmz::NetModuleStatsBasic::update_time_slice (const Float64 TimeDelta) {
+
+   if (TimeDelta > 0.0) {
+
+      const Float64 Scale (1.0 / TimeDelta);
+
+      _slot = (_slot + 1) % _window;
+
+      _roll (_read, Scale);
+      _roll (_write, Scale);
+   }
+}
+
+
+// NetModuleStats Interface
+void
+dmz::NetModuleStatsBasic::add_object_stat (
+      const NetStatsDirectionEnum Direction,
+      const ObjectType &Type,
+      const Int32 Size) {
+
+   const Handle TypeHandle (Type.get_handle ());
+
+   if (TypeHandle) {
+
+      DirectionStruct &dir (_get_direction (Direction));
+
+      CountStruct *count (dir.typeTable.lookup (TypeHandle));
+
+      if (!count) {
+
+         count = new CountStruct;
+         if (!dir.typeTable.store (TypeHandle, count)) { delete count; count = 0; }
+      }
+
+      if (count) { count->add (Size); }
+   }
+}
+
+
+void
+dmz::NetModuleStatsBasic::add_adapter_stat (
+      const NetStatsDirectionEnum Direction,
+      const Handle AdapterHandle,
+      const Int32 Size) {
+
+   if (AdapterHandle) {
+
+      DirectionStruct &dir (_get_direction (Direction));
+
+      CountStruct *count (dir.adapterTable.lookup (AdapterHandle));
+
+      if (!count) {
+
+         count = new CountStruct;
+         if (!dir.adapterTable.store (AdapterHandle, count)) { delete count; count = 0; }
+      }
+
+      if (count) { count->add (Size); }
+   }
+}
+
+
+dmz::Boolean
+dmz::NetModuleStatsBasic::get_packet_stats (
+      const NetStatsDirectionEnum Direction,
+      NetStats &stats) {
+
+   _get_direction (Direction).packets.get_stats (stats);
+
+   return True;
+}
+
+
+dmz::Boolean
+dmz::NetModuleStatsBasic::get_object_stats (
+      const NetStatsDirectionEnum Direction,
+      const ObjectType &Type,
+      NetStats &stats) {
+
+   Boolean result (False);
+
+   CountStruct *count (_get_direction (Direction).typeTable.lookup (Type.get_handle ()));
+
+   if (count) { count->get_stats (stats); result = True; }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::NetModuleStatsBasic::get_adapter_stats (
+      const NetStatsDirectionEnum Direction,
+      const Handle AdapterHandle,
+      NetStats &stats) {
+
+   Boolean result (False);
+
+   CountStruct *count (_get_direction (Direction).adapterTable.lookup (AdapterHandle));
+
+   if (count) { count->get_stats (stats); result = True; }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::NetModuleStatsBasic::get_histogram (
+      const NetStatsDirectionEnum Direction,
+      const NetStatsHistogramEnum Histogram,
+      UInt64 counts[NetStatsHistogramBins]) {
+
+   Boolean result (False);
+
+   if (counts) {
+
+      DirectionStruct &dir (_get_direction (Direction));
+
+      _sum_histogram (
+         Histogram == NetStatsPacketSize ? dir.sizeHistogram : dir.timeHistogram,
+         counts);
+
+      result = True;
+   }
+
+   return result;
+}
+
+
+void
+dmz::NetModuleStatsBasic::dump_stats () {
+
+   _dump_direction (_read);
+   _dump_direction (_write);
+}
+
+
+// NetPacketStatsObserver Interface
+void
+dmz::NetModuleStatsBasic::add_write_packet_stat (
+      const Handle SourceHandle,
+      const Handle TargetHandle,
+      const Int32 PacketSize,
+      const char *Buffer) {
+
+   _add_packet (_write, PacketSize);
+}
+
+
+void
+dmz::NetModuleStatsBasic::add_read_packet_stat (
+      const Handle SourceHandle,
+      const Int32 PacketSize,
+      const char *Buffer) {
+
+   _add_packet (_read, PacketSize);
+}
+
+
+// MessageObserver Interface
+void
+dmz::NetModuleStatsBasic::receive_message (
+      const Message &Type,
+      const UInt32 MessageSendHandle,
+      const Handle TargetObserverHandle,
+      const Data *InData,
+      Data *outData) {
+
+   if (Type == _dumpMsg) { dump_stats (); }
+}
+
+
+dmz::NetModuleStatsBasic::DirectionStruct &
+dmz::NetModuleStatsBasic::_get_direction (const NetStatsDirectionEnum Direction) {
+
+   return Direction == NetStatsWrite ? _write : _read;
+}
+
+
+void
+dmz::NetModuleStatsBasic::_add_packet (DirectionStruct &dir, const Int32 Size) {
+
+   const Float64 Now (get_time ());
+   const Int32 Offset (_slot * NetStatsHistogramBins);
+
+   dir.packets.add (Size);
+
+   dir.sizeHistogram[Offset + local_bin (Float64 (Size), LocalSizeBase)]++;
+
+   if (dir.lastTime >= 0.0) {
+
+      dir.timeHistogram[Offset + local_bin (Now - dir.lastTime, LocalTimeBase)]++;
+   }
+
+   dir.lastTime = Now;
+}
+
+
+void
+dmz::NetModuleStatsBasic::_roll (DirectionStruct &dir, const Float64 Scale) {
+
+   dir.packets.roll (Scale);
+
+   HashTableHandleIterator it;
+   CountStruct *count (0);
+
+   while (dir.typeTable.get_next (it, count)) { count->roll (Scale); }
+
+   it.reset ();
+
+   while (dir.adapterTable.get_next (it, count)) { count->roll (Scale); }
+
+   const Int32 Offset (_slot * NetStatsHistogramBins);
+
+   for (Int32 ix = 0; ix < NetStatsHistogramBins; ix++) {
+
+      dir.sizeHistogram[Offset + ix] = 0;
+      dir.timeHistogram[Offset + ix] = 0;
+   }
+}
+
+
+void
+dmz::NetModuleStatsBasic::_sum_histogram (const UInt64 *Histogram, UInt64 *counts) {
+
+   for (Int32 ix = 0; ix < NetStatsHistogramBins; ix++) { counts[ix] = 0; }
+
+   for (Int32 slot = 0; slot < _window; slot++) {
+
+      const UInt64 *Current (Histogram + (slot * NetStatsHistogramBins));
+
+      for (Int32 ix = 0; ix < NetStatsHistogramBins; ix++) { counts[ix] += Current[ix]; }
+   }
+}
+
+
+void
+dmz::NetModuleStatsBasic::_dump_direction (DirectionStruct &dir) {
+
+   Definitions defs (get_plugin_runtime_context ());
+
+   NetStats stats;
+   dir.packets.get_stats (stats);
+
+   _log.out << dir.Name << " packets: " << stats.packets << " bytes: " << stats.bytes
+      << " (" << stats.packetsPerSecond << " packets/sec " << stats.bytesPerSecond
+      << " bytes/sec)" << endl;
+
+   HashTableHandleIterator it;
+   CountStruct *count (0);
+
+   while (dir.typeTable.get_next (it, count)) {
+
+      ObjectType type;
+      defs.lookup_object_type (it.get_hash_key (), type);
+      count->get_stats (stats);
+
+      _log.out << "   Type: " << type.get_name () << " objects: " << stats.packets
+         << " bytes: " << stats.bytes << " (" << stats.bytesPerSecond << " bytes/sec)"
+         << endl;
+   }
+
+   it.reset ();
+
+   while (dir.adapterTable.get_next (it, count)) {
+
+      count->get_stats (stats);
+
+      _log.out << "   Adapter: " << defs.lookup_named_handle_name (it.get_hash_key ())
+         << " values: " << stats.packets << " bytes: " << stats.bytes << " ("
+         << stats.bytesPerSecond << " bytes/sec)" << endl;
+   }
+
+   _dump_histogram ("Packet size bytes", dir.sizeHistogram, LocalSizeBase);
+   _dump_histogram ("Inter-arrival seconds", dir.timeHistogram, LocalTimeBase);
+}
+
+
+void
+dmz::NetModuleStatsBasic::_dump_histogram (
+      const String &Name,
+      const UInt64 *Histogram,
+      const Float64 Base) {
+
+   UInt64 counts[NetStatsHistogramBins];
+
+   _sum_histogram (Histogram, counts);
+
+   _log.out << "   " << Name << ":";
+
+   Float64 limit (Base);
+
+   for (Int32 ix = 0; ix < NetStatsHistogramBins; ix++) {
+
+      const Float64 Value (ix < (NetStatsHistogramBins - 1) ? limit : limit * 0.5);
+
+      _log.out << (ix < (NetStatsHistogramBins - 1) ? " <" : " >=");
+
+      if (Base < 1.0) { _log.out << Value; }
+      else { _log.out << UInt64 (Value); }
+
+      _log.out << ":" << counts[ix];
+      limit *= 2.0;
+   }
+
+   _log.out << endl;
+}
+
+
+void
+dmz::NetModuleStatsBasic::_init (Config &local) {
+
+   _window = config_to_int32 ("histogram.window", local, _window);
+
+   if (_window < 1) { _window = 1; }
+
+   const Int32 Size (_window * NetStatsHistogramBins);
+
+   _read.sizeHistogram = new UInt64[Size];
+   _read.timeHistogram = new UInt64[Size];
+   _write.sizeHistogram = new UInt64[Size];
+   _write.timeHistogram = new UInt64[Size];
+
+   for (Int32 ix = 0; ix < Size; ix++) {
+
+      _read.sizeHistogram[ix] = _read.timeHistogram[ix] = 0;
+      _write.sizeHistogram[ix] = _write.timeHistogram[ix] = 0;
+   }
+
+   _dumpMsg = config_create_message (
+      "dump.message",
+      local,
+      "NetStatsDumpMessage",
+      get_plugin_runtime_context (),
+      &_log);
+
+   subscribe_to_message (_dumpMsg);
+}
+//! \endcond
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetModuleStatsBasic (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetModuleStatsBasic (Info, local);
+}
+
+};
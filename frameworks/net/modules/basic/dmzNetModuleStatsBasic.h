@@ -0,0 +1,186 @@
+#ifndef DMZ_NET_MODULE_STATS_BASIC_DOT_H
+#define DMZ_NET_MODULE_STATS_BASIC_DOT_H
+
+#include <dmzNetModuleStats.h>
+#include <dmzNetPacketStatsObserver.h>
+#include <dmzRuntimeLog.h>
+#include <dmzRuntimeMessaging.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzTypesHashTableHandleTemplate.h>
+
+namespace dmz {
+
+   class NetModuleStatsBasic :
+         public Plugin,
+         public TimeSlice,
+         public NetModuleStats,
+         public NetPacketStatsObserver,
+         public MessageObserver {
+
+      public:
+         //! \cond
+         NetModuleStatsBasic (const PluginInfo &Info, Config &local);
+         ~NetModuleStatsBasic ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level) {;}
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr) {;}
+
+         // TimeSlice Interface
+         virtual void update_time_slice (const Float64 TimeDelta);
+
+         // NetModuleStats Interface
+         virtual void add_object_stat (
+            const NetStatsDirectionEnum Direction,
+            const ObjectType &Type,
+            const Int32 Size);
+
+         virtual void add_adapter_stat (
+            const NetStatsDirectionEnum Direction,
+            const Handle AdapterHandle,
+            const Int32 Size);
+
+         virtual Boolean get_packet_stats (
+            const NetStatsDirectionEnum Direction,
+            NetStats &stats);
+
+         virtual Boolean get_object_stats (
+            const NetStatsDirectionEnum Direction,
+            const ObjectType &Type,
+            NetStats &stats);
+
+         virtual Boolean get_adapter_stats (
+            const NetStatsDirectionEnum Direction,
+            const Handle AdapterHandle,
+            NetStats &stats);
+
+         virtual Boolean get_histogram (
+            const NetStatsDirectionEnum Direction,
+            const NetStatsHistogramEnum Histogram,
+            UInt64 counts[NetStatsHistogramBins]);
+
+         virtual void dump_stats ();
+
+         // NetPacketStatsObserver Interface
+         virtual void add_write_packet_stat (
+            const Handle SourceHandle,
+            const Handle TargetHandle,
+            const Int32 PacketSize,
+            const char *Buffer);
+
+         virtual void add_read_packet_stat (
+            const Handle SourceHandle,
+            const Int32 PacketSize,
+            const char *Buffer);
+
+         // MessageObserver Interface
+         virtual void receive_message (
+            const Message &Type,
+            const UInt32 MessageSendHandle,
+            const Handle TargetObserverHandle,
+            const Data *InData,
+            Data *outData);
+
+      protected:
+         struct CountStruct {
+
+            UInt64 packets;
+            UInt64 bytes;
+            UInt64 currentPackets;
+            UInt64 currentBytes;
+            Float64 packetRate;
+            Float64 byteRate;
+
+            CountStruct () :
+                  packets (0),
+                  bytes (0),
+                  currentPackets (0),
+                  currentBytes (0),
+                  packetRate (0.0),
+                  byteRate (0.0) {;}
+
+            void add (const Int32 Size) {
+
+               packets++;
+               bytes += UInt64 (Size);
+               currentPackets++;
+               currentBytes += UInt64 (Size);
+            }
+
+            void roll (const Float64 Scale) {
+
+               packetRate = Float64 (currentPackets) * Scale;
+               byteRate = Float64 (currentBytes) * Scale;
+               currentPackets = currentBytes = 0;
+            }
+
+            void get_stats (NetStats &stats) const {
+
+               stats.packets = packets;
+               stats.bytes = bytes;
+               stats.packetsPerSecond = packetRate;
+               stats.bytesPerSecond = byteRate;
+            }
+         };
+
+         struct DirectionStruct {
+
+            const String Name;
+            CountStruct packets;
+            HashTableHandleTemplate<CountStruct> typeTable;
+            HashTableHandleTemplate<CountStruct> adapterTable;
+            Float64 lastTime;
+            UInt64 *sizeHistogram;
+            UInt64 *timeHistogram;
+
+            DirectionStruct (const String &TheName) :
+                  Name (TheName),
+                  lastTime (-1.0),
+                  sizeHistogram (0),
+                  timeHistogram (0) {;}
+
+            ~DirectionStruct () {
+
+               typeTable.empty ();
+               adapterTable.empty ();
+               if (sizeHistogram) { delete []sizeHistogram; sizeHistogram = 0; }
+               if (timeHistogram) { delete []timeHistogram; timeHistogram = 0; }
+            }
+         };
+
+         DirectionStruct &_get_direction (const NetStatsDirectionEnum Direction);
+         void _add_packet (DirectionStruct &dir, const Int32 Size);
+         void _roll (DirectionStruct &dir, const Float64 Scale);
+         void _sum_histogram (const UInt64 *Histogram, UInt64 *counts);
+         void _dump_direction (DirectionStruct &dir);
+
+         void _dump_histogram (
+            const String &Name,
+            const UInt64 *Histogram,
+            const Float64 Base);
+
+         void _init (Config &local);
+
+         Log _log;
+         Int32 _window;
+         Int32 _slot;
+         DirectionStruct _read;
+         DirectionStruct _write;
+         Message _dumpMsg;
+         //! \endcond
+
+      private:
+         NetModuleStatsBasic ();
+         NetModuleStatsBasic (const NetModuleStatsBasic &);
+         NetModuleStatsBasic &operator= (const NetModuleStatsBasic &);
+
+   };
+};
+
+#endif // DMZ_NET_MODULE_STATS_BASIC_DOT_H
@@ -0,0 +1,310 @@
+#include "dmzNetModulePacketIOReplay.h"
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeExit.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzSystem.h>
+#include <dmzSystemFile.h>
+
+#if !defined (_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*!
+
+\class dmz::NetModulePacketIOReplay
+\ingroup Net
+\brief Network Packet I/O Module that plays back a capture file.
+\details Plays back a file recorded by dmz::NetPluginPacketCapture. The packets are
+passed to the registered observers from the time slice using the times stored in the
+file. The speed scales the playback rate: 1.0 is real time, 2.0 is twice real time and
+0.0 plays the packets back as fast as possible. Packets are read directly from the
+memory mapped file so no copies are made. Delivery stops for the frame once the frame
+budget in seconds has been used so the application keeps running frames during a fast
+replay. Written packets are counted and discarded.
+When the end of the file is reached, playback restarts if loop is true. Otherwise the
+replay rate is logged and an application exit is requested if exit is true.
+\code
+<local-scope>
+   <file name="Capture File Name"/>
+   <replay
+      speed="Playback speed. Defaults to 1.0"
+      budget="Seconds spent delivering packets per frame. Zero is unlimited. Default 0.01"
+      loop="Boolean. Defaults to false"
+      exit="Boolean. Defaults to false"
+   />
+</local-scope>
+\endcode
+
+*/
+
+//! \cond
+static const dmz::UInt32 LocalCaptureMagic (0x50435A44);
+static const dmz::UInt32 LocalCaptureVersion (1);
+static const dmz::UInt64 LocalFileHeaderSize (8);
+static const dmz::UInt64 LocalRecordHeaderSize (12);
+static const dmz::Int32 LocalBudgetCheck (0x0F);
+
+
+dmz::NetModulePacketIOReplay::NetModulePacketIOReplay (
+      const PluginInfo &Info,
+      Config &local) :
+      Plugin (Info),
+      TimeSlice (Info),
+      NetModulePacketIO (Info),
+      _log (Info),
+      _speed (1.0),
+      _budget (0.01),
+      _loop (False),
+      _exit (False),
+      _data (0),
+      _length (0),
+      _offset (0),
+      _record (ByteOrderLittleEndian),
+      _done (False),
+      _replayStart (-1.0),
+      _firstStart (-1.0),
+      _count (0),
+      _written (0) {
+
+   _init (local);
+}
+
+
+dmz::NetModulePacketIOReplay::~NetModulePacketIOReplay () {
+
+   _obsTable.clear ();
+   _unmap_file ();
+}
+
+
+// TimeSlice Interface
+void
+dmz::NetModulePacketIOReplay::update_time_slice (const Float64 TimeDelta) {
+
+   if (_data && !_done) {
+
+      const Float64 Now (get_time ());
+
+      if (_replayStart < 0.0) { _replayStart = Now; }
+      if (_firstStart < 0.0) { _firstStart = Now; }
+
+      const Float64 Elapsed ((Now - _replayStart) * _speed);
+
+      Boolean more (True);
+      Int32 delivered (0);
+
+      while (more) {
+
+         if ((_offset + LocalRecordHeaderSize) > _length) {
+
+            if (_loop && (_length > LocalFileHeaderSize)) {
+
+               _offset = LocalFileHeaderSize;
+               _replayStart = Now;
+            }
+            else { _finish (Now); }
+
+            more = False;
+         }
+         else {
+
+            _record.set_buffer (Int32 (LocalRecordHeaderSize), _data + _offset);
+
+            const Float64 Stamp (_record.get_next_float64 ());
+            const Int32 Size (Int32 (_record.get_next_uint32 ()));
+            const UInt64 Next (_offset + LocalRecordHeaderSize + UInt64 (Size));
+
+            if ((Size < 0) || (Next > _length)) {
+
+               _log.error << "Truncated packet in capture file: " << _fileName << endl;
+               _finish (Now);
+               more = False;
+            }
+            else if ((_speed > 0.0) && (Stamp > Elapsed)) { more = False; }
+            else {
+
+               char *buffer (_data + _offset + LocalRecordHeaderSize);
+
+               HashTableUInt32Iterator it;
+               NetPacketObserver *obs (0);
+
+               while (_obsTable.get_next (it, obs)) { obs->read_packet (Size, buffer); }
+
+               _offset = Next;
+               _count++;
+               delivered++;
+
+               if ((_budget > 0.0) && !(delivered & LocalBudgetCheck) &&
+                     ((get_time () - Now) > _budget)) {
+
+                  more = False;
+               }
+            }
+         }
+      }
+   }
+}
+
+
+// Net Module Packet IO Interface
+dmz::Boolean
+dmz::NetModulePacketIOReplay::register_packet_observer (NetPacketObserver &obs) {
+
+   return _obsTable.store (obs.get_net_packet_observer_handle (), &obs);
+}
+
+
+dmz::Boolean
+dmz::NetModulePacketIOReplay::release_packet_observer (NetPacketObserver &obs) {
+
+   return _obsTable.remove (obs.get_net_packet_observer_handle ()) == &obs;
+}
+
+
+dmz::Boolean
+dmz::NetModulePacketIOReplay::write_packet (const Int32 Size, char *buffer) {
+
+   _written++;
+
+   return True;
+}
+
+
+// The file is mapped copy on write so observers may modify the packet buffers.
+dmz::Boolean
+dmz::NetModulePacketIOReplay::_map_file () {
+
+   _unmap_file ();
+
+   const UInt64 Length (get_file_size (_fileName));
+
+   if (Length >= LocalFileHeaderSize) {
+
+#if defined (_WIN32)
+      FILE *file = open_file (_fileName, "rb");
+
+      if (file) {
+
+         _data = new char[Length];
+
+         if (read_file (file, Int32 (Length), _data) != Int32 (Length)) {
+
+            delete []_data; _data = 0;
+         }
+
+         close_file (file);
+      }
+#else
+      const int File (open (_fileName.get_buffer (), O_RDONLY));
+
+      if (File >= 0) {
+
+         void *map (
+            mmap (0, size_t (Length), PROT_READ | PROT_WRITE, MAP_PRIVATE, File, 0));
+
+         if (map != MAP_FAILED) {
+
+            _data = (char *)map;
+            madvise (map, size_t (Length), MADV_SEQUENTIAL);
+         }
+
+         close (File);
+      }
+#endif
+   }
+
+   if (_data) {
+
+      _length = Length;
+
+      _record.set_buffer (Int32 (LocalFileHeaderSize), _data);
+
+      const UInt32 Magic (_record.get_next_uint32 ());
+      const UInt32 Version (_record.get_next_uint32 ());
+
+      if ((Magic != LocalCaptureMagic) || (Version != LocalCaptureVersion)) {
+
+         _log.error << "Unsupported capture file: " << _fileName << endl;
+         _unmap_file ();
+      }
+      else { _offset = LocalFileHeaderSize; }
+   }
+   else { _log.error << "Unable to open capture file: " << _fileName << endl; }
+
+   return _data != 0;
+}
+
+
+void
+dmz::NetModulePacketIOReplay::_unmap_file () {
+
+   if (_data) {
+
+#if defined (_WIN32)
+      delete []_data;
+#else
+      munmap (_data, size_t (_length));
+#endif
+      _data = 0;
+   }
+
+   _length = _offset = 0;
+}
+
+
+void
+dmz::NetModulePacketIOReplay::_finish (const Float64 Now) {
+
+   _done = True;
+
+   const Float64 Duration (Now - _firstStart);
+
+   _log.info << "Replayed " << _count << " packets in " << Duration << " seconds";
+   if (Duration > 0.0) { _log.info << " (" << Float64 (_count) / Duration << "/sec)"; }
+   _log.info << endl;
+
+   if (_exit) {
+
+      Exit (get_plugin_runtime_context ()).request_exit (
+         ExitStatusNormal,
+         "Capture file replay complete");
+   }
+}
+
+
+void
+dmz::NetModulePacketIOReplay::_init (Config &local) {
+
+   _fileName = config_to_string ("file.name", local);
+   _speed = config_to_float64 ("replay.speed", local, _speed);
+   _budget = config_to_float64 ("replay.budget", local, _budget);
+   _loop = config_to_boolean ("replay.loop", local, _loop);
+   _exit = config_to_boolean ("replay.exit", local, _exit);
+
+   if (_speed < 0.0) { _speed = 0.0; }
+
+   if (_fileName && _map_file ()) {
+
+      _log.info << "Replaying: " << _fileName << " (" << _length << " bytes) at speed: "
+         << _speed << endl;
+   }
+}
+//! \endcond
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetModulePacketIOReplay (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetModulePacketIOReplay (Info, local);
+}
+
+};
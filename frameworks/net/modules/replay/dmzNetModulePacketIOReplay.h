@@ -0,0 +1,76 @@
+#ifndef DMZ_NET_MODULE_PACKET_IO_REPLAY_DOT_H
+#define DMZ_NET_MODULE_PACKET_IO_REPLAY_DOT_H
+
+#include <dmzNetModulePacketIO.h>
+#include <dmzRuntimeLog.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzSystemUnmarshal.h>
+#include <dmzTypesHashTableUInt32Template.h>
+#include <dmzTypesString.h>
+
+namespace dmz {
+
+   class NetModulePacketIOReplay :
+         public Plugin,
+         public TimeSlice,
+         public NetModulePacketIO {
+
+      public:
+         //! \cond
+         NetModulePacketIOReplay (const PluginInfo &Info, Config &local);
+         ~NetModulePacketIOReplay ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level) {;}
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr) {;}
+
+         // TimeSlice Interface
+         virtual void update_time_slice (const Float64 TimeDelta);
+
+         // Net Module Packet IO Interface
+         virtual Boolean register_packet_observer (NetPacketObserver &obs);
+         virtual Boolean release_packet_observer (NetPacketObserver &obs);
+
+         virtual Boolean write_packet (const Int32 Size, char *buffer);
+
+      protected:
+         Boolean _map_file ();
+         void _unmap_file ();
+         void _finish (const Float64 Now);
+         void _init (Config &local);
+
+         Log _log;
+         HashTableUInt32Template<NetPacketObserver> _obsTable;
+
+         String _fileName;
+         Float64 _speed;
+         Float64 _budget;
+         Boolean _loop;
+         Boolean _exit;
+
+         char *_data;
+         UInt64 _length;
+         UInt64 _offset;
+         Unmarshal _record;
+
+         Boolean _done;
+         Float64 _replayStart;
+         Float64 _firstStart;
+         UInt64 _count;
+         UInt64 _written;
+         //! \endcond
+
+      private:
+         NetModulePacketIOReplay ();
+         NetModulePacketIOReplay (const NetModulePacketIOReplay &);
+         NetModulePacketIOReplay &operator= (const NetModulePacketIOReplay &);
+   };
+};
+
+#endif // DMZ_NET_MODULE_PACKET_IO_REPLAY_DOT_H
@@ -0,0 +1,653 @@
+#include "dmzNetModulePacketIOBatchUDP.h"
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeData.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzSystem.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/*!
+
+\class dmz::NetModulePacketIOBatchUDP
+\ingroup Net
+\brief Batched and threaded UDP implementation of the Network Packet I/O Module.
+\details Creates a broadcast socket for reading and writing. Defaults to port 3001 and
+a max packet size of 1500 bytes.
+
+A receive thread reads datagrams from the socket in batches and places them in a ring
+of pre-allocated buffers. On Linux each batch is read with a single recvmmsg call.
+The ring is drained in the time slice and each packet is passed to the registered
+observers. Draining stops when the ring is empty or when the drain budget for the
+frame has been used. Packets left in the ring are drained in the next frame. When the
+ring is full, received packets are dropped and counted. Datagrams larger than the
+buffer size are truncated by the socket. They are dropped and counted separately.
+
+Written packets are copied into a send ring and written by a send thread. On Linux
+each batch is written with a single sendmmsg call.
+
+If an update stats message is specified, it is sent every frame with the following
+named handles: \b received, \b dropped, \b truncated, \b sent and \b failed contain
+running totals as 64 bit unsigned integers. \b count contains the number of packets left in the
+receive ring and \b peak contains the highest number of packets seen in the receive
+ring, both as 32 bit unsigned integers. \b drain contains the time in seconds spent
+draining the ring in the frame as a 64 bit float.
+\code
+<local-scope>
+   <socket
+      port="Port Number"
+      address="Destination address. Defaults to 255.255.255.255"
+      receive-buffer="Socket receive buffer size in bytes. Optional"/>
+   <buffer size="Buffer Size" count="Number of buffers in each ring. Defaults to 4096"/>
+   <batch size="Packets read or written in one system call. Defaults to 32"/>
+   <drain budget="Seconds spent draining per frame. Zero is unlimited. Default 0.002"/>
+   <update-stats message="Message Name"/>
+</local-scope>
+\endcode
+
+*/
+
+//! \cond
+static const dmz::Float64 LocalReceiveTimeout (0.1);
+static const dmz::Int32 LocalBudgetCheck (0x0F);
+
+struct dmz::NetModulePacketIOBatchUDP::SocketStruct {
+
+   int sock;
+   struct sockaddr_in address;
+
+   SocketStruct () : sock (-1) { memset (&address, 0, sizeof (address)); }
+
+   ~SocketStruct () { if (sock >= 0) { close (sock); sock = -1; } }
+};
+
+
+struct dmz::NetModulePacketIOBatchUDP::BatchStruct {
+
+   const Int32 Count;
+   const Int32 BufferSize;
+   char *data;
+   Int32 *sizes;
+#if defined (__linux__)
+   struct mmsghdr *msgs;
+   struct iovec *iov;
+#endif
+
+   BatchStruct (
+         const Int32 TheCount,
+         const Int32 TheBufferSize,
+         struct sockaddr_in *address) :
+         Count (TheCount),
+         BufferSize (TheBufferSize),
+         data (new char[TheCount * TheBufferSize]),
+         sizes (new Int32[TheCount]) {
+#if defined (__linux__)
+      msgs = new struct mmsghdr[Count];
+      iov = new struct iovec[Count];
+      memset (msgs, 0, sizeof (struct mmsghdr) * Count);
+
+      for (Int32 ix = 0; ix < Count; ix++) {
+
+         iov[ix].iov_base = get_buffer (ix);
+         iov[ix].iov_len = BufferSize;
+         msgs[ix].msg_hdr.msg_iov = &(iov[ix]);
+         msgs[ix].msg_hdr.msg_iovlen = 1;
+         msgs[ix].msg_hdr.msg_name = address;
+         msgs[ix].msg_hdr.msg_namelen = address ? sizeof (struct sockaddr_in) : 0;
+      }
+#endif
+   }
+
+   ~BatchStruct () {
+
+      delete []data; data = 0;
+      delete []sizes; sizes = 0;
+#if defined (__linux__)
+      delete []msgs; msgs = 0;
+      delete []iov; iov = 0;
+#endif
+   }
+
+   char *get_buffer (const Int32 Index) { return data + (Index * BufferSize); }
+};
+
+
+dmz::NetModulePacketIOBatchUDP::NetModulePacketIOBatchUDP (
+      const PluginInfo &Info,
+      Config &local) :
+      Plugin (Info),
+      TimeSlice (Info),
+      NetModulePacketIO (Info),
+      _log (Info),
+      _socket (*(new SocketStruct)),
+      _bufferSize (1500),
+      _batchSize (32),
+      _drainBudget (0.002),
+      _recvRing (0),
+      _sendRing (0),
+      _recvBatch (0),
+      _sendBatch (0),
+      _recvThread (0),
+      _sendThread (0),
+      _threadCount (0),
+      _quit (False),
+      _received (0),
+      _dropped (0),
+      _truncated (0),
+      _sent (0),
+      _sendFailed (0),
+      _ringPeak (0),
+      _drainTime (0.0),
+      _drainPeak (0.0),
+      _receivedHandle (0),
+      _droppedHandle (0),
+      _truncatedHandle (0),
+      _sentHandle (0),
+      _failedHandle (0),
+      _countHandle (0),
+      _peakHandle (0),
+      _drainHandle (0) {
+
+   _init (local);
+}
+
+
+dmz::NetModulePacketIOBatchUDP::~NetModulePacketIOBatchUDP () {
+
+   _stop_threads ();
+   _obsTable.clear ();
+
+   delete &_socket;
+
+   if (_recvRing) { delete _recvRing; _recvRing = 0; }
+   if (_sendRing) { delete _sendRing; _sendRing = 0; }
+   if (_recvBatch) { delete _recvBatch; _recvBatch = 0; }
+   if (_sendBatch) { delete _sendBatch; _sendBatch = 0; }
+}
+
+
+// Plugin Interface
+void
+dmz::NetModulePacketIOBatchUDP::update_plugin_state (
+      const PluginStateEnum State,
+      const UInt32 Level) {
+
+   if (State == PluginStateStart) { _start_threads (); }
+   else if (State == PluginStateStop) {
+
+      _stop_threads ();
+
+      _log.info << "Received: " << _received << " Dropped: " << _dropped
+         << " Truncated: " << _truncated << " Ring peak: " << _ringPeak << endl;
+      _log.info << "Sent: " << _sent << " Failed: " << _sendFailed
+         << " Drain peak: " << _drainPeak << endl;
+   }
+}
+
+
+// TimeSlice Interface
+void
+dmz::NetModulePacketIOBatchUDP::update_time_slice (const Float64 TimeDelta) {
+
+   if (_recvRing) {
+
+      const Float64 StartTime (get_time ());
+      const UInt32 Pending (_recvRing->queue.get_count ());
+
+      if (Pending > _ringPeak) { _ringPeak = Pending; }
+
+      Int32 count (0);
+      UInt32 index (0);
+      Boolean done (False);
+
+      while (!done && _recvRing->queue.peek (index)) {
+
+         const Int32 Size (_recvRing->sizes[index]);
+         char *buffer (_recvRing->get_buffer (index));
+
+         HashTableUInt32Iterator it;
+         NetPacketObserver *obs (0);
+
+         while (_obsTable.get_next (it, obs)) { obs->read_packet (Size, buffer); }
+
+         _recvRing->queue.release (index);
+         count++;
+
+         if ((_drainBudget > 0.0) && !(count & LocalBudgetCheck) &&
+               ((get_time () - StartTime) >= _drainBudget)) { done = True; }
+      }
+
+      _drainTime = get_time () - StartTime;
+      if (_drainTime > _drainPeak) { _drainPeak = _drainTime; }
+   }
+
+   if (_statsMsg) { _send_stats (); }
+}
+
+
+// Net Module Packet IO Interface
+dmz::Boolean
+dmz::NetModulePacketIOBatchUDP::register_packet_observer (NetPacketObserver &obs) {
+
+   return _obsTable.store (obs.get_net_packet_observer_handle (), &obs);
+}
+
+
+dmz::Boolean
+dmz::NetModulePacketIOBatchUDP::release_packet_observer (NetPacketObserver &obs) {
+
+   return _obsTable.remove (obs.get_net_packet_observer_handle ()) ==  &obs;
+}
+
+
+dmz::Boolean
+dmz::NetModulePacketIOBatchUDP::write_packet (const Int32 Size, char *buffer) {
+
+   Boolean result (False);
+
+   if (buffer && (Size > 0) && (Size <= _bufferSize) && (_socket.sock >= 0)) {
+
+      if (_sendThread) {
+
+         UInt32 index (0);
+
+         if (_sendRing->queue.reserve (index)) {
+
+            memcpy (_sendRing->get_buffer (index), buffer, Size);
+            _sendRing->sizes[index] = Size;
+            _sendRing->queue.commit (index);
+            _sendSignal.post ();
+            result = True;
+         }
+      }
+      else {
+
+         result = (sendto (
+            _socket.sock,
+            buffer,
+            Size,
+            0,
+            (struct sockaddr *)&(_socket.address),
+            sizeof (_socket.address)) == Size);
+      }
+
+      if (!result) {
+
+         _statsLock.lock (); _sendFailed++; _statsLock.unlock ();
+      }
+   }
+
+   return result;
+}
+
+
+void
+dmz::NetModulePacketIOBatchUDP::run_receive () {
+
+   while (!_is_quitting ()) {
+
+      const Int32 Count (_receive_batch (*_recvBatch));
+
+      if (Count > 0) {
+
+         UInt64 received (0), dropped (0), truncated (0);
+
+         for (Int32 ix = 0; ix < Count; ix++) {
+
+            UInt32 index (0);
+
+            if (_recvBatch->sizes[ix] < 0) { truncated++; }
+            else if (_recvRing->queue.reserve (index)) {
+
+               memcpy (
+                  _recvRing->get_buffer (index),
+                  _recvBatch->get_buffer (ix),
+                  _recvBatch->sizes[ix]);
+
+               _recvRing->sizes[index] = _recvBatch->sizes[ix];
+               _recvRing->queue.commit (index);
+               received++;
+            }
+            else { dropped++; }
+         }
+
+         _statsLock.lock ();
+         _received += received;
+         _dropped += dropped;
+         _truncated += truncated;
+         _statsLock.unlock ();
+      }
+      else if ((Count < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) &&
+            (errno != EINTR)) {
+
+         // Avoid spinning on a socket that is in an error state.
+         sleep (LocalReceiveTimeout);
+      }
+   }
+
+   _threadDone.post ();
+}
+
+
+void
+dmz::NetModulePacketIOBatchUDP::run_send () {
+
+   Boolean done (False);
+
+   while (!done) {
+
+      _sendSignal.wait ();
+      while (_sendSignal.try_wait ()) {;}
+
+      if (_is_quitting ()) { done = True; }
+
+      Int32 count (1);
+
+      while (count > 0) {
+
+         UInt32 index (0);
+         count = 0;
+
+         while ((count < _sendBatch->Count) && _sendRing->queue.peek (index)) {
+
+            memcpy (
+               _sendBatch->get_buffer (count),
+               _sendRing->get_buffer (index),
+               _sendRing->sizes[index]);
+
+            _sendBatch->sizes[count] = _sendRing->sizes[index];
+            _sendRing->queue.release (index);
+            count++;
+         }
+
+         if (count > 0) {
+
+            const Int32 Sent (_send_batch (*_sendBatch, count));
+
+            _statsLock.lock ();
+            _sent += UInt64 (Sent);
+            _sendFailed += UInt64 (count - Sent);
+            _statsLock.unlock ();
+         }
+      }
+   }
+
+   _threadDone.post ();
+}
+
+
+dmz::Int32
+dmz::NetModulePacketIOBatchUDP::_receive_batch (BatchStruct &batch) {
+
+   Int32 result (0);
+
+#if defined (__linux__)
+   for (Int32 ix = 0; ix < batch.Count; ix++) {
+
+      batch.msgs[ix].msg_len = 0;
+      batch.msgs[ix].msg_hdr.msg_flags = 0;
+   }
+
+   // Blocks until at least one packet is read or the receive timeout expires.
+   result = recvmmsg (_socket.sock, batch.msgs, batch.Count, MSG_WAITFORONE, 0);
+
+   // A size of -1 marks a datagram that did not fit in the buffer.
+   for (Int32 ix = 0; ix < result; ix++) {
+
+      batch.sizes[ix] = (batch.msgs[ix].msg_hdr.msg_flags & MSG_TRUNC) ?
+         -1 : Int32 (batch.msgs[ix].msg_len);
+   }
+#else
+   Boolean done (False);
+
+   while (!done && (result < batch.Count)) {
+
+      struct iovec iov;
+      iov.iov_base = batch.get_buffer (result);
+      iov.iov_len = batch.BufferSize;
+
+      struct msghdr msg;
+      memset (&msg, 0, sizeof (msg));
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+
+      const ssize_t Size (recvmsg (_socket.sock, &msg, result ? MSG_DONTWAIT : 0));
+
+      if (Size >= 0) {
+
+         batch.sizes[result] = (msg.msg_flags & MSG_TRUNC) ? -1 : Int32 (Size);
+         result++;
+      }
+      else {
+
+         if (!result) { result = -1; }
+         done = True;
+      }
+   }
+#endif
+
+   return result;
+}
+
+
+dmz::Int32
+dmz::NetModulePacketIOBatchUDP::_send_batch (BatchStruct &batch, const Int32 Count) {
+
+   Int32 result (0);
+   Boolean done (False);
+
+   while (!done && (result < Count)) {
+
+#if defined (__linux__)
+      for (Int32 ix = result; ix < Count; ix++) {
+
+         batch.iov[ix].iov_len = batch.sizes[ix];
+      }
+
+      const int Sent (sendmmsg (_socket.sock, batch.msgs + result, Count - result, 0));
+
+      if (Sent > 0) { result += Sent; }
+      else if (errno != EINTR) { done = True; }
+#else
+      const ssize_t Sent (sendto (
+         _socket.sock,
+         batch.get_buffer (result),
+         batch.sizes[result],
+         0,
+         (struct sockaddr *)&(_socket.address),
+         sizeof (_socket.address)));
+
+      if (Sent == batch.sizes[result]) { result++; }
+      else if ((Sent >= 0) || (errno != EINTR)) { done = True; }
+#endif
+   }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::NetModulePacketIOBatchUDP::_is_quitting () {
+
+   _statsLock.lock (); const Boolean Result (_quit); _statsLock.unlock ();
+   return Result;
+}
+
+
+void
+dmz::NetModulePacketIOBatchUDP::_start_threads () {
+
+   if (!_threadCount && (_socket.sock >= 0) && _recvRing && _sendRing) {
+
+      _statsLock.lock (); _quit = False; _statsLock.unlock ();
+
+      _recvThread = new IOThread (*this, True);
+
+      if (create_thread (*_recvThread)) { _threadCount++; }
+      else {
+
+         _log.error << "Failed to create receive thread" << endl;
+         delete _recvThread; _recvThread = 0;
+      }
+
+      _sendThread = new IOThread (*this, False);
+
+      if (create_thread (*_sendThread)) { _threadCount++; }
+      else {
+
+         _log.warn << "Failed to create send thread. Packets will be sent directly"
+            << endl;
+         delete _sendThread; _sendThread = 0;
+      }
+   }
+}
+
+
+void
+dmz::NetModulePacketIOBatchUDP::_stop_threads () {
+
+   if (_threadCount) {
+
+      _statsLock.lock (); _quit = True; _statsLock.unlock ();
+
+      // The receive thread wakes up when its receive timeout expires.
+      _sendSignal.post ();
+
+      for (Int32 ix = 0; ix < _threadCount; ix++) { _threadDone.wait (); }
+
+      _threadCount = 0;
+   }
+
+   if (_recvThread) { delete _recvThread; _recvThread = 0; }
+   if (_sendThread) { delete _sendThread; _sendThread = 0; }
+}
+
+
+void
+dmz::NetModulePacketIOBatchUDP::_send_stats () {
+
+   Data out;
+
+   _statsLock.lock ();
+   out.store_uint64 (_receivedHandle, 0, _received);
+   out.store_uint64 (_droppedHandle, 0, _dropped);
+   out.store_uint64 (_truncatedHandle, 0, _truncated);
+   out.store_uint64 (_sentHandle, 0, _sent);
+   out.store_uint64 (_failedHandle, 0, _sendFailed);
+   _statsLock.unlock ();
+
+   out.store_uint32 (_countHandle, 0, _recvRing ? _recvRing->queue.get_count () : 0);
+   out.store_uint32 (_peakHandle, 0, _ringPeak);
+   out.store_float64 (_drainHandle, 0, _drainTime);
+
+   _statsMsg.send (&out);
+}
+
+
+void
+dmz::NetModulePacketIOBatchUDP::_init (Config &local) {
+
+   const UInt32 Port (config_to_uint32 ("socket.port", local, 3001));
+   const String Address (config_to_string ("socket.address", local, "255.255.255.255"));
+   const Int32 ReceiveBuffer (config_to_int32 ("socket.receive-buffer", local, 0));
+
+   _bufferSize = config_to_int32 ("buffer.size", local, _bufferSize);
+   const UInt32 Count (config_to_uint32 ("buffer.count", local, 4096));
+   _batchSize = config_to_int32 ("batch.size", local, _batchSize);
+   _drainBudget = config_to_float64 ("drain.budget", local, _drainBudget);
+
+   if (_batchSize < 1) { _batchSize = 1; }
+
+   _log.info << "Using port: " << Port << endl;
+
+   _socket.sock = socket (AF_INET, SOCK_DGRAM, 0);
+
+   if (_socket.sock >= 0) {
+
+      int on (1);
+      setsockopt (_socket.sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof (on));
+#if defined (SO_REUSEPORT)
+      setsockopt (_socket.sock, SOL_SOCKET, SO_REUSEPORT, &on, sizeof (on));
+#endif
+      setsockopt (_socket.sock, SOL_SOCKET, SO_BROADCAST, &on, sizeof (on));
+
+      if (ReceiveBuffer > 0) {
+
+         int size (ReceiveBuffer);
+         setsockopt (_socket.sock, SOL_SOCKET, SO_RCVBUF, &size, sizeof (size));
+      }
+
+      struct timeval timeout;
+      timeout.tv_sec = 0;
+      timeout.tv_usec = suseconds_t (LocalReceiveTimeout * 1000000.0);
+      setsockopt (_socket.sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof (timeout));
+
+      struct sockaddr_in bindAddress;
+      memset (&bindAddress, 0, sizeof (bindAddress));
+      bindAddress.sin_family = AF_INET;
+      bindAddress.sin_addr.s_addr = htonl (INADDR_ANY);
+      bindAddress.sin_port = htons ((unsigned short)Port);
+
+      _socket.address.sin_family = AF_INET;
+      _socket.address.sin_addr.s_addr = inet_addr (Address.get_buffer ());
+      _socket.address.sin_port = htons ((unsigned short)Port);
+
+      if (bind (_socket.sock, (struct sockaddr *)&bindAddress, sizeof (bindAddress))) {
+
+         _log.error << "Failed binding socket: " << strerror (errno) << endl;
+         close (_socket.sock); _socket.sock = -1;
+      }
+   }
+   else { _log.error << "Failed creating socket: " << strerror (errno) << endl; }
+
+   if (_bufferSize > 0) {
+
+      _recvRing = new RingStruct (Count, _bufferSize);
+      _sendRing = new RingStruct (Count, _bufferSize);
+      _recvBatch = new BatchStruct (_batchSize, _bufferSize, 0);
+      _sendBatch = new BatchStruct (_batchSize, _bufferSize, &(_socket.address));
+
+      _log.info << "Buffer size: " << _bufferSize << " Ring size: "
+         << _recvRing->queue.get_size () << " Batch size: " << _batchSize << endl;
+   }
+
+   const String StatsMessageName (config_to_string ("update-stats.message", local));
+
+   if (StatsMessageName) {
+
+      Definitions defs (get_plugin_runtime_context (), &_log);
+
+      defs.create_message (StatsMessageName, _statsMsg);
+      _receivedHandle = defs.create_named_handle ("received");
+      _droppedHandle = defs.create_named_handle ("dropped");
+      _truncatedHandle = defs.create_named_handle ("truncated");
+      _sentHandle = defs.create_named_handle ("sent");
+      _failedHandle = defs.create_named_handle ("failed");
+      _countHandle = defs.create_named_handle ("count");
+      _peakHandle = defs.create_named_handle ("peak");
+      _drainHandle = defs.create_named_handle ("drain");
+   }
+}
+//! \endcond
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetModulePacketIOBatchUDP (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetModulePacketIOBatchUDP (Info, local);
+}
+
+};
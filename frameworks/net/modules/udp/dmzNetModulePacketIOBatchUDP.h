@@ -0,0 +1,148 @@
+#ifndef DMZ_NET_MODULE_PACKET_IO_BATCH_UDP_DOT_H
+#define DMZ_NET_MODULE_PACKET_IO_BATCH_UDP_DOT_H
+
+#include <dmzNetModulePacketIO.h>
+#include <dmzRuntimeLog.h>
+#include <dmzRuntimeMessaging.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzSystemSemaphore.h>
+#include <dmzSystemSlotQueue.h>
+#include <dmzSystemSpinLock.h>
+#include <dmzSystemThread.h>
+#include <dmzTypesHashTableUInt32Template.h>
+
+namespace dmz {
+
+   class NetModulePacketIOBatchUDP :
+         public Plugin,
+         public TimeSlice,
+         public NetModulePacketIO {
+
+      public:
+         //! \cond
+         NetModulePacketIOBatchUDP (const PluginInfo &Info, Config &local);
+         ~NetModulePacketIOBatchUDP ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level);
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr) {;}
+
+         // TimeSlice Interface
+         virtual void update_time_slice (const Float64 TimeDelta);
+
+         // Net Module Packet IO Interface
+         virtual Boolean register_packet_observer (NetPacketObserver &obs);
+         virtual Boolean release_packet_observer (NetPacketObserver &obs);
+
+         virtual Boolean write_packet (const Int32 Size, char *buffer);
+
+         void run_receive ();
+         void run_send ();
+
+      protected:
+         struct BatchStruct;
+         struct SocketStruct;
+
+         struct RingStruct {
+
+            SlotQueue queue;
+            const Int32 BufferSize;
+            char *data;
+            Int32 *sizes;
+
+            RingStruct (const UInt32 Count, const Int32 TheBufferSize) :
+                  queue (Count),
+                  BufferSize (TheBufferSize),
+                  data (new char[queue.get_size () * TheBufferSize]),
+                  sizes (new Int32[queue.get_size ()]) {;}
+
+            ~RingStruct () {
+
+               delete []data; data = 0;
+               delete []sizes; sizes = 0;
+            }
+
+            char *get_buffer (const UInt32 Index) { return data + (Index * BufferSize); }
+         };
+
+         class IOThread : public ThreadFunction {
+
+            public:
+               IOThread (NetModulePacketIOBatchUDP &module, const Boolean Receive) :
+                     _module (module),
+                     _Receive (Receive) {;}
+
+               virtual void run_thread_function () {
+
+                  if (_Receive) { _module.run_receive (); }
+                  else { _module.run_send (); }
+               }
+
+            protected:
+               NetModulePacketIOBatchUDP &_module;
+               const Boolean _Receive;
+         };
+
+         Int32 _receive_batch (BatchStruct &batch);
+         Int32 _send_batch (BatchStruct &batch, const Int32 Count);
+         Boolean _is_quitting ();
+         void _start_threads ();
+         void _stop_threads ();
+         void _send_stats ();
+         void _init (Config &local);
+
+         Log _log;
+         SocketStruct &_socket;
+         HashTableUInt32Template<NetPacketObserver> _obsTable;
+
+         Int32 _bufferSize;
+         Int32 _batchSize;
+         Float64 _drainBudget;
+
+         RingStruct *_recvRing;
+         RingStruct *_sendRing;
+         BatchStruct *_recvBatch;
+         BatchStruct *_sendBatch;
+
+         IOThread *_recvThread;
+         IOThread *_sendThread;
+         Semaphore _sendSignal;
+         Semaphore _threadDone;
+         Int32 _threadCount;
+
+         SpinLock _statsLock;
+         Boolean _quit;
+         UInt64 _received;
+         UInt64 _dropped;
+         UInt64 _truncated;
+         UInt64 _sent;
+         UInt64 _sendFailed;
+         UInt32 _ringPeak;
+         Float64 _drainTime;
+         Float64 _drainPeak;
+
+         Message _statsMsg;
+         Handle _receivedHandle;
+         Handle _droppedHandle;
+         Handle _truncatedHandle;
+         Handle _sentHandle;
+         Handle _failedHandle;
+         Handle _countHandle;
+         Handle _peakHandle;
+         Handle _drainHandle;
+         //! \endcond
+
+      private:
+         NetModulePacketIOBatchUDP ();
+         NetModulePacketIOBatchUDP (const NetModulePacketIOBatchUDP &);
+         NetModulePacketIOBatchUDP &operator= (const NetModulePacketIOBatchUDP &);
+   };
+};
+
+#endif // DMZ_NET_MODULE_PACKET_IO_BATCH_UDP_DOT_H
@@ -0,0 +1,180 @@
+#include "dmzNetPluginPacketCapture.h"
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzSystem.h>
+#include <dmzSystemFile.h>
+
+/*!
+
+\class dmz::NetPluginPacketCapture
+\ingroup Net
+\brief Records every packet received by a Network Packet I/O Module to a capture file.
+\details The capture file may be played back with dmz::NetModulePacketIOReplay.
+All values in the file are little endian. The file starts with an eight byte header
+made up of the 32 bit magic number 0x50435A44 and the 32 bit format version. Each
+packet is stored as a 64 bit float containing the number of seconds since the capture
+started, a 32 bit packet size, and the packet bytes.
+If no module name is given, the first Network Packet I/O Module discovered is used.
+\code
+<local-scope>
+   <file name="Capture File Name"/>
+   <module name="Network Packet I/O Module Name. Optional"/>
+</local-scope>
+\endcode
+
+*/
+
+//! \cond
+static const dmz::UInt32 LocalCaptureMagic (0x50435A44);
+static const dmz::UInt32 LocalCaptureVersion (1);
+static const dmz::Int32 LocalRecordHeaderSize (12);
+
+
+dmz::NetPluginPacketCapture::NetPluginPacketCapture (
+      const PluginInfo &Info,
+      Config &local) :
+      Plugin (Info),
+      NetPacketObserver (Info),
+      _log (Info),
+      _ioMod (0),
+      _file (0),
+      _header (ByteOrderLittleEndian),
+      _startTime (0.0),
+      _count (0),
+      _bytes (0) {
+
+   _init (local);
+}
+
+
+dmz::NetPluginPacketCapture::~NetPluginPacketCapture () { _close_file (); }
+
+
+// Plugin Interface
+void
+dmz::NetPluginPacketCapture::update_plugin_state (
+      const PluginStateEnum State,
+      const UInt32 Level) {
+
+   if (State == PluginStateStart) { _open_file (); }
+   else if (State == PluginStateStop) { _close_file (); }
+}
+
+
+void
+dmz::NetPluginPacketCapture::discover_plugin (
+      const PluginDiscoverEnum Mode,
+      const Plugin *PluginPtr) {
+
+   if (Mode == PluginDiscoverAdd) {
+
+      if (!_ioMod) {
+
+         _ioMod = NetModulePacketIO::cast (PluginPtr, _ioModName);
+
+         if (_ioMod) { _ioMod->register_packet_observer (*this); }
+      }
+   }
+   else if (Mode == PluginDiscoverRemove) {
+
+      if (_ioMod && (_ioMod == NetModulePacketIO::cast (PluginPtr, _ioModName))) {
+
+         _ioMod->release_packet_observer (*this);
+         _ioMod = 0;
+      }
+   }
+}
+
+
+// NetPacketObserver Interface
+void
+dmz::NetPluginPacketCapture::read_packet (const Int32 Size, char *buffer) {
+
+   if (_file && buffer && (Size > 0)) {
+
+      _header.reset ();
+      _header.set_next_float64 (get_time () - _startTime);
+      _header.set_next_uint32 (UInt32 (Size));
+
+      if ((fwrite (_header.get_buffer (), LocalRecordHeaderSize, 1, _file) == 1) &&
+            (fwrite (buffer, Size, 1, _file) == 1)) {
+
+         _count++;
+         _bytes += UInt64 (Size);
+      }
+      else {
+
+         _log.error << "Failed writing to capture file: " << _fileName << endl;
+         _close_file ();
+      }
+   }
+}
+
+
+dmz::Boolean
+dmz::NetPluginPacketCapture::_open_file () {
+
+   if (!_file && _fileName) {
+
+      _file = open_file (_fileName, "wb");
+
+      if (_file) {
+
+         _header.reset ();
+         _header.set_next_uint32 (LocalCaptureMagic);
+         _header.set_next_uint32 (LocalCaptureVersion);
+
+         if (fwrite (_header.get_buffer (), _header.get_length (), 1, _file) == 1) {
+
+            _startTime = get_time ();
+            _count = _bytes = 0;
+            _log.info << "Capturing packets to: " << _fileName << endl;
+         }
+         else { close_file (_file); _file = 0; }
+      }
+
+      if (!_file) { _log.error << "Unable to open capture file: " << _fileName << endl; }
+   }
+
+   return _file != 0;
+}
+
+
+void
+dmz::NetPluginPacketCapture::_close_file () {
+
+   if (_file) {
+
+      close_file (_file);
+      _file = 0;
+
+      _log.info << "Captured " << _count << " packets (" << _bytes << " bytes) to: "
+         << _fileName << endl;
+   }
+}
+
+
+void
+dmz::NetPluginPacketCapture::_init (Config &local) {
+
+   _fileName = config_to_string ("file.name", local);
+   _ioModName = config_to_string ("module.name", local);
+
+   if (!_fileName) { _log.error << "No capture file name specified." << endl; }
+}
+//! \endcond
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetPluginPacketCapture (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetPluginPacketCapture (Info, local);
+}
+
+};
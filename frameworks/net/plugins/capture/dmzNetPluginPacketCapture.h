@@ -0,0 +1,60 @@
+#ifndef DMZ_NET_PLUGIN_PACKET_CAPTURE_DOT_H
+#define DMZ_NET_PLUGIN_PACKET_CAPTURE_DOT_H
+
+#include <dmzNetModulePacketIO.h>
+#include <dmzRuntimeLog.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzSystemMarshal.h>
+#include <dmzTypesString.h>
+
+#include <stdio.h>
+
+namespace dmz {
+
+   class NetPluginPacketCapture :
+         public Plugin,
+         public NetPacketObserver {
+
+      public:
+         //! \cond
+         NetPluginPacketCapture (const PluginInfo &Info, Config &local);
+         ~NetPluginPacketCapture ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level);
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr);
+
+         // NetPacketObserver Interface
+         virtual void read_packet (const Int32 Size, char *buffer);
+
+      protected:
+         Boolean _open_file ();
+         void _close_file ();
+         void _init (Config &local);
+
+         Log _log;
+
+         String _fileName;
+         String _ioModName;
+         NetModulePacketIO *_ioMod;
+
+         FILE *_file;
+         Marshal _header;
+         Float64 _startTime;
+         UInt64 _count;
+         UInt64 _bytes;
+         //! \endcond
+
+      private:
+         NetPluginPacketCapture ();
+         NetPluginPacketCapture (const NetPluginPacketCapture &);
+         NetPluginPacketCapture &operator= (const NetPluginPacketCapture &);
+   };
+};
+
+#endif // DMZ_NET_PLUGIN_PACKET_CAPTURE_DOT_H
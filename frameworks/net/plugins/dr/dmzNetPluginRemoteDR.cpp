@@ -1,19 +1,49 @@
 #include "dmzNetPluginRemoteDR.h"
 #include <dmzObjectConsts.h>
 #include <dmzObjectAttributeMasks.h>
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimeObjectType.h>
 #include <dmzRuntimePluginFactoryLinkSymbol.h>
 #include <dmzRuntimePluginInfo.h>
-#include <dmzTypesVector.h>
 
 /*!
 
 \class dmz::NetPluginRemoteDR
 \ingroup Net
-\brief Performs basic linear dead-reckoning of remote objects using the last network value
-times stamp, velocity, and position.
+\brief Performs dead-reckoning of remote objects using the last network value
+times stamp, position, and orientation.
+\details By default, objects are linearly dead reckoned:
 \code
 CurrentPosition = LastNetworkValuePosition + (LastNetworkValueVelocity * (CurrentTime - LastNetworkValueTimeStamp))
 \endcode
+The dead reckoning model may be changed for each object type. The acceleration models
+add the last network value of the acceleration of the object. The rotation models also
+extrapolate the orientation of the object using the last network value of its angular
+velocity. The models are defined in dmzNetDeadReckon.h. The model is read from the
+same object type config as the skew and orientation-skew rules of
+dmz::NetModuleLocalDRBasic so both sides always use the same model.\n
+When a convergence time is set, a new network value does not snap the object to the
+new dead reckoned track. The difference between the displayed value and the new track
+is instead blended out over the convergence time.
+\code
+<dmz>
+<runtime>
+   <object-type name="Type Name">
+      <net>
+         <dead-reckon model="rotation-acceleration"/>
+      </net>
+   </object-type>
+</runtime>
+<dmzNetPluginRemoteDR>
+   <convergence time="0.0"/>
+   <angular-velocity name="Object_Angular_Velocity"/>
+</dmzNetPluginRemoteDR>
+</dmz>
+\endcode
+Possible models are static, velocity, acceleration, rotation, and
+rotation-acceleration. The DIS names fpw, fvw, rpw, and rvw may also be used.
 
 */
 
@@ -26,7 +56,20 @@ dmz::NetPluginRemoteDR::NetPluginRemoteDR (const PluginInfo &Info, Config &local
       _time (Info.get_context ()),
       _objMod (0),
       _defaultHandle (0),
-      _lnvHandle (0) {
+      _lnvHandle (0),
+      _angularHandle (0),
+      _convergence (0.0),
+      _rotationCount (0),
+      _bufferSize (0),
+      _lnvPosBuffer (0),
+      _velBuffer (0),
+      _posBuffer (0),
+      _lnvOriBuffer (0),
+      _oriBuffer (0),
+      _timeStampBuffer (0),
+      _validBuffer (0),
+      _foundBuffer (0),
+      _oriValidBuffer (0) {
 
    _init (local);
 
@@ -42,7 +85,9 @@ dmz::NetPluginRemoteDR::NetPluginRemoteDR (const PluginInfo &Info, Config &local
 
 dmz::NetPluginRemoteDR::~NetPluginRemoteDR () {
 
-   _objTable.clear ();
+   _objects.clear ();
+   _objTable.empty ();
+   _grow_buffers (0);
 }
 
 
@@ -69,27 +114,66 @@ dmz::NetPluginRemoteDR::update_time_slice (const Float64 TimeDelta) {
 
    if (_objMod && _lnvHandle && _defaultHandle) {
 
-      const Float64 CurrentTime (_time.get_frame_time ());
+      const Int32 Count (_objects.get_count ());
+
+      if (Count > 0) {
+
+         if (Count > _bufferSize) { _grow_buffers (Count); }
+
+         const Float64 CurrentTime (_time.get_frame_time ());
 
-      HashTableHandleIterator it;
+         _objMod->lookup_positions (_objects, _lnvHandle, _lnvPosBuffer, _validBuffer);
+         _objMod->lookup_velocities (_objects, _defaultHandle, _velBuffer, _foundBuffer);
 
-      for (
-            NetPluginRemoteDR *current = _objTable.get_first (it);
-            current;
-            current = _objTable.get_next (it)) {
+         for (Int32 ix = 0; ix < Count; ix++) {
 
-         const Handle ObjectHandle (it.get_hash_key ());
+            _validBuffer[ix] = _validBuffer[ix] && _foundBuffer[ix];
+         }
+
+         _objMod->lookup_time_stamps (
+            _objects,
+            _lnvHandle,
+            _timeStampBuffer,
+            _foundBuffer);
+
+         if (_rotationCount > 0) {
+
+            _objMod->lookup_orientations (
+               _objects,
+               _lnvHandle,
+               _lnvOriBuffer,
+               _oriValidBuffer);
+         }
+         else {
+
+            for (Int32 ix = 0; ix < Count; ix++) { _oriValidBuffer[ix] = False; }
+         }
+
+         HandleContainerIterator it;
+         Handle object (0);
+         Int32 index (0);
+
+         while (_objects.get_next (it, object) && (index < Count)) {
+
+            _validBuffer[index] = _validBuffer[index] && _foundBuffer[index];
+
+            ObjectStruct *os (_validBuffer[index] ? _objTable.lookup (object) : 0);
+
+            if (os) { _update_object (object, *os, CurrentTime, index); }
+            else { _validBuffer[index] = _oriValidBuffer[index] = False; }
+
+            index++;
+         }
 
-         Vector lnvPos;
-         Vector vel;
-         Float64 timestamp (0.0);
+         _objMod->store_positions (_objects, _defaultHandle, _posBuffer, _validBuffer);
 
-         if (_objMod->lookup_position (ObjectHandle, _lnvHandle, lnvPos) &&
-               _objMod->lookup_velocity (ObjectHandle, _defaultHandle, vel) &&
-               _objMod->lookup_time_stamp (ObjectHandle, _lnvHandle, timestamp)) {
+         if (_rotationCount > 0) {
 
-            const Vector Pos (lnvPos + (vel * (CurrentTime - timestamp)));
-            _objMod->store_position (ObjectHandle, _defaultHandle, Pos);
+            _objMod->store_orientations (
+               _objects,
+               _defaultHandle,
+               _oriBuffer,
+               _oriValidBuffer);
          }
       }
    }
@@ -104,7 +188,17 @@ dmz::NetPluginRemoteDR::create_object (
       const ObjectType &Type,
       const ObjectLocalityEnum Locality) {
 
-   if (Locality == ObjectRemote) { _objTable.store (ObjectHandle, this); }
+   if ((Locality == ObjectRemote) && !_objTable.lookup (ObjectHandle)) {
+
+      ObjectStruct *os (new ObjectStruct (lookup_net_dead_reckon_model (Type)));
+
+      if (_objTable.store (ObjectHandle, os)) {
+
+         _objects.add (ObjectHandle);
+         if (net_dead_reckon_uses_rotation (os->Model)) { _rotationCount++; }
+      }
+      else { delete os; os = 0; }
+   }
 }
 
 
@@ -113,7 +207,15 @@ dmz::NetPluginRemoteDR::destroy_object (
       const UUID &Identity,
       const Handle ObjectHandle) {
 
-   _objTable.remove (ObjectHandle);
+   ObjectStruct *os (_objTable.remove (ObjectHandle));
+
+   if (os) {
+
+      if (net_dead_reckon_uses_rotation (os->Model)) { _rotationCount--; }
+      delete os; os = 0;
+   }
+
+   _objects.remove (ObjectHandle);
 }
 
 
@@ -124,13 +226,143 @@ dmz::NetPluginRemoteDR::update_object_locality (
       const ObjectLocalityEnum Locality,
       const ObjectLocalityEnum PrevLocality) {
 
-   if (Locality == ObjectLocal) { _objTable.remove (ObjectHandle); }
+   if (Locality == ObjectLocal) { destroy_object (Identity, ObjectHandle); }
+}
+
+
+// A new network value starts a convergence from the last displayed value to the new
+// dead reckoned track instead of snapping the object to it.
+void
+dmz::NetPluginRemoteDR::_update_object (
+      const Handle ObjectHandle,
+      ObjectStruct &os,
+      const Float64 CurrentTime,
+      const Int32 Index) {
+
+   const Float64 TimeStamp (_timeStampBuffer[Index]);
+   const Float64 Delta (CurrentTime - TimeStamp);
+   const Boolean Rotate (
+      net_dead_reckon_uses_rotation (os.Model) && _oriValidBuffer[Index]);
+
+   Vector accel;
+
+   if (net_dead_reckon_uses_acceleration (os.Model)) {
+
+      _objMod->lookup_acceleration (ObjectHandle, _lnvHandle, accel);
+   }
+
+   Vector pos (net_dead_reckon_position (
+      os.Model,
+      _lnvPosBuffer[Index],
+      _velBuffer[Index],
+      accel,
+      Delta));
+
+   Matrix ori;
+
+   if (Rotate) {
+
+      Vector angular;
+      _objMod->lookup_vector (ObjectHandle, _angularHandle, angular);
+
+      ori = net_dead_reckon_orientation (os.Model, _lnvOriBuffer[Index], angular, Delta);
+   }
+
+   if (TimeStamp != os.lnvStamp) {
+
+      if (os.init && (_convergence > 0.0)) {
+
+         os.posOffset = os.pos - pos;
+         os.oriAngle = 0.0;
+
+         if (Rotate) {
+
+            const Matrix Offset (os.ori * ori.transpose ());
+            Offset.to_axis_and_angle (os.oriAxis, os.oriAngle);
+         }
+
+         os.blendStart = CurrentTime;
+      }
+
+      os.lnvStamp = TimeStamp;
+   }
+
+   if (os.blendStart >= 0.0) {
+
+      const Float64 Blend ((CurrentTime - os.blendStart) / _convergence);
+
+      if (Blend >= 1.0) { os.blendStart = -1.0; }
+      else {
+
+         // Smooth step so the offset fades out without a jump in velocity.
+         const Float64 Weight (1.0 - (Blend * Blend * (3.0 - (2.0 * Blend))));
+
+         pos += os.posOffset * Weight;
+
+         if (Rotate && !is_zero64 (os.oriAngle)) {
+
+            ori = Matrix (os.oriAxis, os.oriAngle * Weight) * ori;
+         }
+      }
+   }
+
+   _posBuffer[Index] = pos;
+   os.pos = pos;
+
+   if (Rotate) { _oriBuffer[Index] = ori; os.ori = ori; }
+
+   _oriValidBuffer[Index] = Rotate;
+   os.init = True;
+}
+
+
+void
+dmz::NetPluginRemoteDR::_grow_buffers (const Int32 Size) {
+
+   if (_lnvPosBuffer) { delete []_lnvPosBuffer; _lnvPosBuffer = 0; }
+   if (_velBuffer) { delete []_velBuffer; _velBuffer = 0; }
+   if (_posBuffer) { delete []_posBuffer; _posBuffer = 0; }
+   if (_lnvOriBuffer) { delete []_lnvOriBuffer; _lnvOriBuffer = 0; }
+   if (_oriBuffer) { delete []_oriBuffer; _oriBuffer = 0; }
+   if (_timeStampBuffer) { delete []_timeStampBuffer; _timeStampBuffer = 0; }
+   if (_validBuffer) { delete []_validBuffer; _validBuffer = 0; }
+   if (_foundBuffer) { delete []_foundBuffer; _foundBuffer = 0; }
+   if (_oriValidBuffer) { delete []_oriValidBuffer; _oriValidBuffer = 0; }
+
+   _bufferSize = 0;
+
+   if (Size > 0) {
+
+      _bufferSize = Size * 2;
+
+      _lnvPosBuffer = new Vector[_bufferSize];
+      _velBuffer = new Vector[_bufferSize];
+      _posBuffer = new Vector[_bufferSize];
+      _lnvOriBuffer = new Matrix[_bufferSize];
+      _oriBuffer = new Matrix[_bufferSize];
+      _timeStampBuffer = new Float64[_bufferSize];
+      _validBuffer = new Boolean[_bufferSize];
+      _foundBuffer = new Boolean[_bufferSize];
+      _oriValidBuffer = new Boolean[_bufferSize];
+   }
 }
 
 
 void
 dmz::NetPluginRemoteDR::_init (Config &local) {
 
+   Definitions defs (get_plugin_runtime_context (), &_log);
+
+   _convergence = config_to_float64 ("convergence.time", local, _convergence);
+
+   const String AngularName (config_to_string (
+      "angular-velocity.name",
+      local,
+      NetAttributeAngularVelocityName));
+
+   // Uses the same last network value as the orientation-skew rule.
+   _angularHandle = defs.create_named_handle (
+      create_last_network_value_name (AngularName));
 }
 //! \endcond
 
@@ -1,13 +1,17 @@
 #ifndef DMZ_NET_PLUGIN_REMOTE_DR_DOT_H
 #define DMZ_NET_PLUGIN_REMOTE_DR_DOT_H
 
+#include <dmzNetDeadReckon.h>
 #include <dmzObjectModule.h>
 #include <dmzObjectObserverUtil.h>
 #include <dmzRuntimeLog.h>
 #include <dmzRuntimePlugin.h>
 #include <dmzRuntimeTimeSlice.h>
 #include <dmzRuntimeTime.h>
+#include <dmzTypesHandleContainer.h>
 #include <dmzTypesHashTableHandleTemplate.h>
+#include <dmzTypesMatrix.h>
+#include <dmzTypesVector.h>
 
 namespace dmz {
 
@@ -49,6 +53,33 @@ namespace dmz {
             const ObjectLocalityEnum PrevLocality);
 
       protected:
+         struct ObjectStruct {
+
+            const NetDeadReckonModelEnum Model;
+            Boolean init;
+            Float64 lnvStamp;
+            Vector pos;
+            Matrix ori;
+            Float64 blendStart;
+            Vector posOffset;
+            Vector oriAxis;
+            Float64 oriAngle;
+
+            ObjectStruct (const NetDeadReckonModelEnum TheModel) :
+                  Model (TheModel),
+                  init (False),
+                  lnvStamp (0.0),
+                  blendStart (-1.0),
+                  oriAngle (0.0) {;}
+         };
+
+         void _update_object (
+            const Handle ObjectHandle,
+            ObjectStruct &os,
+            const Float64 CurrentTime,
+            const Int32 Index);
+
+         void _grow_buffers (const Int32 Size);
          void _init (Config &local);
 
          Log _log;
@@ -58,8 +89,24 @@ namespace dmz {
 
          Handle _defaultHandle;
          Handle _lnvHandle;
-
-         HashTableHandleTemplate<NetPluginRemoteDR> _objTable;
+         Handle _angularHandle;
+
+         Float64 _convergence;
+         Int32 _rotationCount;
+
+         HandleContainer _objects;
+         HashTableHandleTemplate<ObjectStruct> _objTable;
+
+         Int32 _bufferSize;
+         Vector *_lnvPosBuffer;
+         Vector *_velBuffer;
+         Vector *_posBuffer;
+         Matrix *_lnvOriBuffer;
+         Matrix *_oriBuffer;
+         Float64 *_timeStampBuffer;
+         Boolean *_validBuffer;
+         Boolean *_foundBuffer;
+         Boolean *_oriValidBuffer;
          //! \endcond
 
       private:
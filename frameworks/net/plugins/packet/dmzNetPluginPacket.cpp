@@ -8,21 +8,49 @@
 #include <dmzRuntimePluginInfo.h>
 #include <dmzTypesUUID.h>
 
+#include <string.h>
+
 /*!
 
 \class dmz::NetPluginPacket
 \ingroup Net
 \brief Automatically encodes and decodes local objects and events.
-\details
+\details Packets may be framed so that bundles and channel tags can be told apart from
+plain encoded packets. Framing is negotiated through the \b version attribute which must
+be the same on every host. Version 0, the default, writes and reads plain encoded
+packets. With version 1 every packet starts with the 32 bit frame magic number
+0x444D5A46, the 8 bit version and an 8 bit flags field. Received packets without the
+magic number, with a different version or with unknown flags are rejected. \n \n
+When bundling is enabled, encoded objects and events are packed into bundles of at most
+\b size bytes instead of being written as individual packets. A bundle is written when
+it is full and at the end of each frame. A bundle is a frame with the bundle flag set
+followed by one entry per packet. Each entry is the 16 bit length of the rest of the
+entry, the 8 bit flags of the packet and the packet. A bundle is rejected as a whole
+when an entry length is zero or runs past the end of the bundle. A bundle that contains
+a single packet is written as a normal packet. Bundling requires framing. \n \n
+If a dmz::NetModuleInterest is discovered and framing is enabled, object activation and
+update packets have the channel flag set and the 32 bit channel of the object follows
+the flags. Received packets with a channel the host is not subscribed to are dropped
+before they are decoded. Deactivation and event packets are always sent to all hosts.
 \code
 <local-scope>
    <endian value="big/little"/>
+   <framing version="0/1"/>
+   <bundle enabled="true/false" size="1400"/>
 </local-scope>
 \endcode
 
 */
 
 //! \cond
+static const dmz::UInt32 LocalFrameMagic (0x444D5A46);
+static const dmz::UInt32 LocalFrameVersion (1);
+static const dmz::Int32 LocalFrameVersionSize (5); // Magic number and version.
+static const dmz::Int32 LocalFrameHeaderSize (6); // Magic number, version and flags.
+static const dmz::UInt8 LocalFrameBundle (0x01);
+static const dmz::UInt8 LocalFrameChannel (0x02);
+
+
 dmz::NetPluginPacket::NetPluginPacket (
       const PluginInfo &Info,
       const ByteOrderEnum Endian,
@@ -36,10 +64,18 @@ dmz::NetPluginPacket::NetPluginPacket (
       _drMod (0),
       _codecMod (0),
       _ioMod (0),
+      _interestMod (0),
       _ioModHandle (0),
       _statsList (0),
       _outData (Endian),
-      _inData (Endian) {
+      _inData (Endian),
+      _framingVersion (0),
+      _rejectCount (0),
+      _bundling (False),
+      _bundleSize (1400),
+      _bundleCount (0),
+      _bundleData (Endian),
+      _inBundleData (Endian) {
 
    _init (local);
 
@@ -69,13 +105,13 @@ dmz::NetPluginPacket::update_plugin_state (
 
       while (_preRegObjTable.get_next (it, ptr)) {
 
-         _outData.reset ();
+         _start_packet (ptr->ObjectHandle);
 
          if (_codecMod->register_object (ptr->ObjectHandle, ptr->type, _outData)) {
 
             if (_objTable.store (ptr->ObjectHandle, ptr)) {
 
-               _ioMod->write_packet (_outData.get_length (), _outData.get_buffer ());
+               _write_packet ();
                if (_statsList) { _add_write_stat (ptr->ObjectHandle); }
             }
             else {
@@ -88,6 +124,7 @@ dmz::NetPluginPacket::update_plugin_state (
       }
 
       _preRegObjTable.clear ();
+      _flush_bundle ();
    }
    else if (State == PluginStateShutdown) {
 
@@ -97,6 +134,10 @@ dmz::NetPluginPacket::update_plugin_state (
       ObjStruct *ptr (0);
 
       while (_objTable.get_next (it, ptr)) { destroy_object (empty, ptr->ObjectHandle); }
+
+      _flush_bundle ();
+
+      if (_rejectCount) { _log.info << "Rejected packets: " << _rejectCount << endl; }
    }
 }
 
@@ -109,6 +150,16 @@ dmz::NetPluginPacket::discover_plugin (
    if (Mode == PluginDiscoverAdd) {
 
       if (!_drMod) { _drMod = NetModuleLocalDR::cast (PluginPtr); }
+      if (!_interestMod) {
+
+         _interestMod = NetModuleInterest::cast (PluginPtr);
+
+         if (_interestMod && !_framingVersion) {
+
+            _log.warn << "Channel tags require framing. Interest management disabled"
+               << endl;
+         }
+      }
 
       if (!_codecMod) {
 
@@ -153,6 +204,11 @@ dmz::NetPluginPacket::discover_plugin (
 
       if (_drMod && (_drMod = NetModuleLocalDR::cast (PluginPtr))) { _drMod = 0; }
 
+      if (_interestMod && (_interestMod == NetModuleInterest::cast (PluginPtr))) {
+
+         _interestMod = 0;
+      }
+
       if (_codecMod && (_codecMod == NetModulePacketCodec::cast (PluginPtr))) {
 
          HashTableHandleIterator it;
@@ -181,6 +237,7 @@ dmz::NetPluginPacket::discover_plugin (
 
       if (_ioMod && (_ioMod == NetModulePacketIO::cast (PluginPtr))) {
 
+         _flush_bundle ();
          _ioMod->release_packet_observer (*this);
          _ioMod = 0;
          _ioModHandle = 0;
@@ -220,16 +277,18 @@ dmz::NetPluginPacket::update_time_slice (const Float64 TimeDelta) {
 
       while (_objTable.get_next (it, os)) {
 
-         _outData.reset ();
+         _start_packet (os->ObjectHandle);
 
          Boolean update (_drMod ? _drMod->update_object (os->ObjectHandle) : True);
 
          if (update && _codecMod->encode_object (os->ObjectHandle, _outData)) {
 
-            _ioMod->write_packet (_outData.get_length (), _outData.get_buffer ());
+            _write_packet ();
             if (_statsList) { _add_write_stat (os->ObjectHandle); }
          }
       }
+
+      _flush_bundle ();
    }
 }
 
@@ -241,9 +300,9 @@ dmz::NetPluginPacket::read_packet (const Int32 Size, char *buffer) {
    if (buffer && Size && _codecMod) {
 
       _inData.set_buffer (Size, buffer);
-      Boolean isLoopback (False);
-      _codecMod->decode (_inData, isLoopback);
-      if (_statsList && !isLoopback) { _add_read_stat (); }
+
+      if (!_framingVersion) { _decode_packet (_inData); }
+      else if (!_read_frame (Size, buffer)) { _reject_packet (); }
    }
 }
 
@@ -259,11 +318,11 @@ dmz::NetPluginPacket::close_event (
 
       if (_codecMod && _ioMod) {
 
-         _outData.reset ();
+         _start_packet (0);
 
          if (_codecMod->encode_event (Type, EventHandle, _outData)) {
 
-            _ioMod->write_packet (_outData.get_length (), _outData.get_buffer ());
+            _write_packet ();
             if (_statsList) { _add_write_stat (EventHandle); }
          }
       }
@@ -283,7 +342,7 @@ dmz::NetPluginPacket::create_object (
 
       if (_codecMod && _ioMod) {
 
-         _outData.reset ();
+         _start_packet (ObjectHandle);
 
          if (_codecMod->register_object (ObjectHandle, Type, _outData)) {
 
@@ -292,7 +351,7 @@ dmz::NetPluginPacket::create_object (
             if (ptr && !_objTable.store (ObjectHandle, ptr)) { delete ptr; ptr = 0; }
             else if (ptr) {
 
-               _ioMod->write_packet (_outData.get_length (), _outData.get_buffer ());
+               _write_packet ();
                if (_statsList) { _add_write_stat (ObjectHandle); }
             }
          }
@@ -316,11 +375,11 @@ dmz::NetPluginPacket::destroy_object (
 
    if (ptr) {
 
-      _outData.reset ();
+      _start_packet (0);
 
       if (_codecMod && _ioMod && _codecMod->release_object (ObjectHandle, _outData)) {
 
-         _ioMod->write_packet (_outData.get_length (), _outData.get_buffer ());
+         _write_packet ();
          if (_statsList) { _add_write_stat (ObjectHandle); }
       }
 
@@ -346,6 +405,216 @@ dmz::NetPluginPacket::update_object_locality (
 
 
 // Internal Interface
+// Starts a packet with the frame header. The object channel is only added for a non
+// zero ObjectHandle.
+void
+dmz::NetPluginPacket::_start_packet (const Handle ObjectHandle) {
+
+   _outData.reset ();
+
+   if (_framingVersion) {
+
+      const UInt32 Channel (
+         (ObjectHandle && _interestMod) ?
+            _interestMod->lookup_object_channel (ObjectHandle) : 0);
+
+      _outData.set_next_uint32 (LocalFrameMagic);
+      _outData.set_next_uint8 (UInt8 (_framingVersion));
+      _outData.set_next_uint8 (Channel ? LocalFrameChannel : 0);
+
+      if (Channel) { _outData.set_next_uint32 (Channel); }
+   }
+}
+
+
+void
+dmz::NetPluginPacket::_write_packet () {
+
+   const Int32 Size (_outData.get_length ());
+
+   // A bundle entry is the packet without the frame magic number and version.
+   const Int32 EntrySize (Size - LocalFrameVersionSize);
+
+   if (!_bundling || ((LocalFrameHeaderSize + 2 + EntrySize) > _bundleSize)) {
+
+      // Keep packets in order when a packet is too large to bundle.
+      _flush_bundle ();
+      _ioMod->write_packet (Size, _outData.get_buffer ());
+   }
+   else {
+
+      if ((_bundleData.get_length () + 2 + EntrySize) > _bundleSize) { _flush_bundle (); }
+
+      if (!_bundleCount) {
+
+         _bundleData.reset ();
+         _bundleData.set_next_uint32 (LocalFrameMagic);
+         _bundleData.set_next_uint8 (UInt8 (_framingVersion));
+         _bundleData.set_next_uint8 (LocalFrameBundle);
+      }
+
+      _bundleData.set_next_uint16 (UInt16 (EntrySize));
+
+      const Int32 Place (_bundleData.get_place ());
+
+      if (_bundleData.set_length (Place + EntrySize)) {
+
+         memcpy (
+            _bundleData.get_buffer () + Place,
+            _outData.get_buffer () + LocalFrameVersionSize,
+            EntrySize);
+
+         _bundleData.set_place (Place + EntrySize);
+         _bundleCount++;
+      }
+   }
+}
+
+
+void
+dmz::NetPluginPacket::_flush_bundle () {
+
+   if (_bundleCount && _ioMod) {
+
+      char *buffer (_bundleData.get_buffer ());
+
+      if (_bundleCount == 1) {
+
+         // Move the magic number and version up against the entry so that it is
+         // written as a normal packet without the bundle flags and entry length.
+         const Int32 Skip (LocalFrameHeaderSize + 2 - LocalFrameVersionSize);
+
+         memmove (buffer + Skip, buffer, LocalFrameVersionSize);
+         _ioMod->write_packet (_bundleData.get_length () - Skip, buffer + Skip);
+      }
+      else { _ioMod->write_packet (_bundleData.get_length (), buffer); }
+   }
+
+   _bundleCount = 0;
+   _bundleData.reset ();
+}
+
+
+dmz::Boolean
+dmz::NetPluginPacket::_read_frame (const Int32 Size, char *buffer) {
+
+   Boolean result (False);
+
+   const UInt32 Magic (Size >= LocalFrameHeaderSize ? _inData.get_next_uint32 () : 0);
+
+   if (Magic == LocalFrameMagic) {
+
+      const UInt32 Version (_inData.get_next_uint8 ());
+      const UInt8 Flags (_inData.get_next_uint8 ());
+
+      if (Version == _framingVersion) {
+
+         if (Flags == LocalFrameBundle) { result = _read_bundle (Size, buffer); }
+         else { result = _read_entry (Flags, _inData); }
+      }
+   }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::NetPluginPacket::_read_bundle (const Int32 Size, char *buffer) {
+
+   Boolean result (Size > LocalFrameHeaderSize);
+
+   // Every entry length is checked before any entry is decoded so that a malformed
+   // bundle is rejected as a whole.
+   Int32 place (LocalFrameHeaderSize);
+
+   while (result && (place < Size)) {
+
+      _inData.set_place (place);
+
+      const Int32 Length ((place + 2) <= Size ? Int32 (_inData.get_next_uint16 ()) : 0);
+
+      if ((Length > 0) && ((place + 2 + Length) <= Size)) { place += 2 + Length; }
+      else { result = False; }
+   }
+
+   place = LocalFrameHeaderSize;
+
+   while (result && (place < Size)) {
+
+      _inData.set_place (place);
+
+      const Int32 Length (_inData.get_next_uint16 ());
+
+      _inBundleData.set_buffer (Length, buffer + place + 2);
+
+      const UInt8 Flags (_inBundleData.get_next_uint8 ());
+
+      if (!_read_entry (Flags, _inBundleData)) { _reject_packet (); }
+
+      place += 2 + Length;
+   }
+
+   return result;
+}
+
+
+// Reads the part of a frame that follows the flags. Nested bundles and unknown flags
+// are rejected.
+dmz::Boolean
+dmz::NetPluginPacket::_read_entry (const UInt8 Flags, Unmarshal &data) {
+
+   Boolean result (False);
+
+   if (!(Flags & ~LocalFrameChannel)) {
+
+      Boolean decode (True);
+
+      if (Flags & LocalFrameChannel) {
+
+         if ((data.get_length () - data.get_place ()) >= 4) {
+
+            const UInt32 Channel (data.get_next_uint32 ());
+
+            if (_interestMod && !_interestMod->is_channel_subscribed (Channel)) {
+
+               decode = False;
+            }
+
+            result = True;
+         }
+      }
+      else { result = True; }
+
+      if (result && decode) { _decode_packet (data); }
+   }
+
+   return result;
+}
+
+
+void
+dmz::NetPluginPacket::_decode_packet (Unmarshal &data) {
+
+   Boolean isLoopback (False);
+   _codecMod->decode (data, isLoopback);
+   if (_statsList && !isLoopback) { _add_read_stat (data); }
+}
+
+
+void
+dmz::NetPluginPacket::_reject_packet () {
+
+   if (!_rejectCount) {
+
+      _log.warn << "Rejected a packet that is not framed as version " << _framingVersion
+         << " or is malformed. Check that all hosts use the same framing version."
+         << " Further rejections are only counted." << endl;
+   }
+
+   _rejectCount++;
+}
+
+
 void
 dmz::NetPluginPacket::_add_write_stat (const Handle Source) {
 
@@ -362,11 +631,11 @@ dmz::NetPluginPacket::_add_write_stat (const Handle Source) {
 
 
 void
-dmz::NetPluginPacket::_add_read_stat () {
+dmz::NetPluginPacket::_add_read_stat (const Unmarshal &Data) {
 
    StatsStruct *current (_statsList);
-   const Int32 Size = _inData.get_length ();
-   const char *Buffer = _inData.get_buffer ();
+   const Int32 Size = Data.get_length ();
+   const char *Buffer = Data.get_buffer ();
 
    while (current) {
 
@@ -379,6 +648,31 @@ dmz::NetPluginPacket::_add_read_stat () {
 void
 dmz::NetPluginPacket::_init (Config &local) {
 
+   _framingVersion = config_to_uint32 ("framing.version", local, _framingVersion);
+   _bundling = config_to_boolean ("bundle.enabled", local, _bundling);
+   _bundleSize = config_to_int32 ("bundle.size", local, _bundleSize);
+
+   if (_framingVersion > LocalFrameVersion) {
+
+      _log.error << "Unsupported framing version: " << _framingVersion
+         << " using version " << LocalFrameVersion << endl;
+
+      _framingVersion = LocalFrameVersion;
+   }
+
+   if (_bundling && !_framingVersion) {
+
+      _log.warn << "Bundling requires framing. Bundling disabled" << endl;
+      _bundling = False;
+   }
+
+   if (_bundleSize > 0xFFFF) { _bundleSize = 0xFFFF; }
+
+   if (_bundling) {
+
+      _bundleData.grow (_bundleSize);
+      _log.info << "Bundling packets up to " << _bundleSize << " bytes" << endl;
+   }
 }
 //! \endcond
 
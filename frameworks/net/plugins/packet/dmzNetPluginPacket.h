@@ -2,6 +2,7 @@
 #define DMZ_NET_PLUGIN_PACKET_DOT_H
 
 #include <dmzEventObserverUtil.h>
+#include <dmzNetModuleInterest.h>
 #include <dmzNetModuleLocalDR.h>
 #include <dmzNetModulePacketCodec.h>
 #include <dmzNetModulePacketIO.h>
@@ -93,8 +94,16 @@ namespace dmz {
                type (TheType) {;}
          };
 
+         void _start_packet (const Handle ObjectHandle);
+         void _write_packet ();
+         void _flush_bundle ();
+         Boolean _read_frame (const Int32 Size, char *buffer);
+         Boolean _read_bundle (const Int32 Size, char *buffer);
+         Boolean _read_entry (const UInt8 Flags, Unmarshal &data);
+         void _decode_packet (Unmarshal &data);
+         void _reject_packet ();
          void _add_write_stat (const Handle Source);
-         void _add_read_stat ();
+         void _add_read_stat (const Unmarshal &Data);
          void _init (Config &local);
 
          Log _log;
@@ -102,12 +111,22 @@ namespace dmz {
         NetModuleLocalDR *_drMod;
         NetModulePacketCodec *_codecMod;
         NetModulePacketIO *_ioMod;
+        NetModuleInterest *_interestMod;
         Handle _ioModHandle;
         StatsStruct *_statsList;
 
         Marshal _outData;
         Unmarshal _inData;
 
+        UInt32 _framingVersion;
+        UInt64 _rejectCount;
+
+        Boolean _bundling;
+        Int32 _bundleSize;
+        Int32 _bundleCount;
+        Marshal _bundleData;
+        Unmarshal _inBundleData;
+
         HashTableHandleTemplate<ObjStruct> _objTable;
         HashTableHandleTemplate<ObjStruct> _preRegObjTable;
         //! \endcond
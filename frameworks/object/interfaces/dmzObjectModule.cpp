@@ -174,6 +174,22 @@ remotely.
 \return Returns the object handle of the newly created object. Will return zero if
 the creation fails.
 
+\fn dmz::Int32 dmz::ObjectModule::create_objects (
+const dmz::ObjectType &Type,
+const dmz::ObjectLocalityEnum Locality,
+const dmz::Int32 Count,
+dmz::HandleContainer &objects)
+\brief Creates a set of objects of the same type in a single call.
+\details Each object is created as if by dmz::ObjectModule::create_object() and must
+be activated with dmz::ObjectModule::activate_object(). Use this function when a
+large number of objects are created at once such as when a scenario is loaded.
+\param[in] Type ObjectType of the objects being created.
+\param[in] Locality dmz::ObjectLocalityEnum specifying if the objects are owned locally
+or remotely.
+\param[in] Count Number of objects to create.
+\param[out] objects dmz::HandleContainer the handles of the created objects are added to.
+\return Returns the number of objects created.
+
 \fn dmz::Boolean dmz::ObjectModule::activate_object (const dmz::Handle ObjectHandle)
 \brief Activates a created object.
 \details Any attribute values that have been set since the object was created will
@@ -747,6 +763,118 @@ dmz::Data &value)
 \param[out] value Object Data object value.
 \return Returns dmz::True if the attribute was found.
 
+\fn dmz::Int32 dmz::ObjectModule::lookup_time_stamps (
+const dmz::HandleContainer &Objects,
+const dmz::Handle AttributeHandle,
+dmz::Float64 *values,
+dmz::Boolean *found)
+\brief Looks up the time stamps of a set of objects in a single call.
+\details The \a values and \a found arrays are indexed in the iteration order of
+\a Objects and must each hold at least Objects.get_count () elements. Elements of
+\a values for objects that do not have the attribute are left unchanged.
+\param[in] Objects dmz::HandleContainer of object handles.
+\param[in] AttributeHandle Attribute handle.
+\param[out] values Array of object time stamps values.
+\param[out] found Optional array set to dmz::True for each object that has the attribute.
+May be NULL.
+\return Returns the number of objects that had the attribute.
+
+\fn dmz::Int32 dmz::ObjectModule::lookup_positions (
+const dmz::HandleContainer &Objects,
+const dmz::Handle AttributeHandle,
+dmz::Vector *values,
+dmz::Boolean *found)
+\brief Looks up the positions of a set of objects in a single call.
+\details The \a values and \a found arrays are indexed in the iteration order of
+\a Objects and must each hold at least Objects.get_count () elements. Elements of
+\a values for objects that do not have the attribute are left unchanged.
+\param[in] Objects dmz::HandleContainer of object handles.
+\param[in] AttributeHandle Attribute handle.
+\param[out] values Array of object positions values.
+\param[out] found Optional array set to dmz::True for each object that has the attribute.
+May be NULL.
+\return Returns the number of objects that had the attribute.
+
+\fn dmz::Int32 dmz::ObjectModule::lookup_orientations (
+const dmz::HandleContainer &Objects,
+const dmz::Handle AttributeHandle,
+dmz::Matrix *values,
+dmz::Boolean *found)
+\brief Looks up the orientations of a set of objects in a single call.
+\details The \a values and \a found arrays are indexed in the iteration order of
+\a Objects and must each hold at least Objects.get_count () elements. Elements of
+\a values for objects that do not have the attribute are left unchanged.
+\param[in] Objects dmz::HandleContainer of object handles.
+\param[in] AttributeHandle Attribute handle.
+\param[out] values Array of object orientations values.
+\param[out] found Optional array set to dmz::True for each object that has the attribute.
+May be NULL.
+\return Returns the number of objects that had the attribute.
+
+\fn dmz::Int32 dmz::ObjectModule::lookup_velocities (
+const dmz::HandleContainer &Objects,
+const dmz::Handle AttributeHandle,
+dmz::Vector *values,
+dmz::Boolean *found)
+\brief Looks up the velocities of a set of objects in a single call.
+\details The \a values and \a found arrays are indexed in the iteration order of
+\a Objects and must each hold at least Objects.get_count () elements. Elements of
+\a values for objects that do not have the attribute are left unchanged.
+\param[in] Objects dmz::HandleContainer of object handles.
+\param[in] AttributeHandle Attribute handle.
+\param[out] values Array of object velocities values.
+\param[out] found Optional array set to dmz::True for each object that has the attribute.
+May be NULL.
+\return Returns the number of objects that had the attribute.
+
+\fn dmz::Int32 dmz::ObjectModule::store_positions (
+const dmz::HandleContainer &Objects,
+const dmz::Handle AttributeHandle,
+const dmz::Vector *Values,
+const dmz::Boolean *Valid)
+\brief Stores the positions of a set of objects in a single call.
+\details The \a Values and \a Valid arrays are indexed in the iteration order of
+\a Objects. Observers are notified of each change as if the values had been stored
+individually.
+\param[in] Objects dmz::HandleContainer of object handles.
+\param[in] AttributeHandle Attribute handle.
+\param[in] Values Array of object positions values.
+\param[in] Valid Optional array specifying which elements of \a Values should be
+stored. May be NULL in which case all elements are stored.
+\return Returns the number of object attributes that were stored.
+
+\fn dmz::Int32 dmz::ObjectModule::store_orientations (
+const dmz::HandleContainer &Objects,
+const dmz::Handle AttributeHandle,
+const dmz::Matrix *Values,
+const dmz::Boolean *Valid)
+\brief Stores the orientations of a set of objects in a single call.
+\details The \a Values and \a Valid arrays are indexed in the iteration order of
+\a Objects. Observers are notified of each change as if the values had been stored
+individually.
+\param[in] Objects dmz::HandleContainer of object handles.
+\param[in] AttributeHandle Attribute handle.
+\param[in] Values Array of object orientations values.
+\param[in] Valid Optional array specifying which elements of \a Values should be
+stored. May be NULL in which case all elements are stored.
+\return Returns the number of object attributes that were stored.
+
+\fn dmz::Int32 dmz::ObjectModule::store_velocities (
+const dmz::HandleContainer &Objects,
+const dmz::Handle AttributeHandle,
+const dmz::Vector *Values,
+const dmz::Boolean *Valid)
+\brief Stores the velocities of a set of objects in a single call.
+\details The \a Values and \a Valid arrays are indexed in the iteration order of
+\a Objects. Observers are notified of each change as if the values had been stored
+individually.
+\param[in] Objects dmz::HandleContainer of object handles.
+\param[in] AttributeHandle Attribute handle.
+\param[in] Values Array of object velocities values.
+\param[in] Valid Optional array specifying which elements of \a Values should be
+stored. May be NULL in which case all elements are stored.
+\return Returns the number of object attributes that were stored.
+
 
 \fn dmz::ObjectModule::ObjectModule (const dmz::PluginInfo &Info);
 \brief Constructor.
@@ -72,6 +72,12 @@ namespace dmz {
             const ObjectType &Type,
             const ObjectLocalityEnum Locality) = 0;
 
+         virtual Int32 create_objects (
+            const ObjectType &Type,
+            const ObjectLocalityEnum Locality,
+            const Int32 Count,
+            HandleContainer &objects) = 0;
+
          virtual Boolean activate_object (const Handle ObjectHandle) = 0;
 
          virtual Boolean destroy_object (const Handle ObjectHandle) = 0;
@@ -318,6 +324,48 @@ namespace dmz {
             const Handle AttributeHandle,
             Data &value) = 0;
 
+         virtual Int32 lookup_time_stamps (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            Float64 *values,
+            Boolean *found = 0) = 0;
+
+         virtual Int32 lookup_positions (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            Vector *values,
+            Boolean *found = 0) = 0;
+
+         virtual Int32 lookup_orientations (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            Matrix *values,
+            Boolean *found = 0) = 0;
+
+         virtual Int32 lookup_velocities (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            Vector *values,
+            Boolean *found = 0) = 0;
+
+         virtual Int32 store_positions (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            const Vector *Values,
+            const Boolean *Valid = 0) = 0;
+
+         virtual Int32 store_orientations (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            const Matrix *Values,
+            const Boolean *Valid = 0) = 0;
+
+         virtual Int32 store_velocities (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            const Vector *Values,
+            const Boolean *Valid = 0) = 0;
+
       protected:
          ObjectModule (const PluginInfo &Info);
          ~ObjectModule ();
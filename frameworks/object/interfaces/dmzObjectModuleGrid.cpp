@@ -57,8 +57,12 @@ ObjectObserverGrid &observer)
 const Volume &SearchSpace,
 HandleContainer &objects,
 const ObjectTypeSet *IncludeTypes,
-const ObjectTypeSet *ExcludeTypes)
+const ObjectTypeSet *ExcludeTypes,
+const Boolean Sorted)
 \brief Finds all objects contained in the Volume \a SearchSpace.
+\details When \a Sorted is dmz::True the objects are returned in order of increasing
+distance from the origin of the \a SearchSpace. Callers that do not need the objects
+ordered should pass dmz::False to avoid the cost of sorting.
 \param[in] SearchSpace Volume to use when searching for objects.
 \param[out] objects HandleContainer used to return the Handle of all found objects.
 \param[in] IncludeTypes Pointer to an ObjectTypeSet used to filter objects.
@@ -68,5 +72,25 @@ contained in the ObjectTypeSet to be returned in the \a objects HandleContainer.
 If a valid ObjectTypeSet pointer is passed in, a found object must \b not be of an
 ObjectType contained in the ObjectTypeSet to be returned in the \a objects
 HandleContainer.
+\param[in] Sorted Flag indicating if the found objects should be sorted by distance.
+
+\fn void dmz::ObjectModuleGrid::find_nearest_objects (
+const Vector &Origin,
+const Int32 Count,
+const Float64 Radius,
+HandleContainer &objects,
+const ObjectTypeSet *IncludeTypes,
+const ObjectTypeSet *ExcludeTypes)
+\brief Finds the objects nearest to a point.
+\details Only the \a Count nearest objects within \a Radius of the \a Origin are
+returned. They are returned in order of increasing distance from the \a Origin.
+\param[in] Origin Vector containing the point to search from.
+\param[in] Count Maximum number of objects to return.
+\param[in] Radius Maximum distance of a returned object from the \a Origin.
+\param[out] objects HandleContainer used to return the Handle of the found objects.
+\param[in] IncludeTypes Pointer to an ObjectTypeSet used to filter objects.
+See dmz::ObjectModuleGrid::find_objects.
+\param[in] ExcludeTypes Pointer to an ObjectTypeSet used to filter objects.
+See dmz::ObjectModuleGrid::find_objects.
 
 */
@@ -11,6 +11,7 @@ namespace dmz {
    class HandleContainer;
    class ObjectObserverGrid;
    class ObjectTypeSet;
+   class Vector;
    class Volume;
 
    class ObjectModuleGrid {
@@ -32,6 +33,15 @@ namespace dmz {
             const Volume &SearchSpace,
             HandleContainer &objects,
             const ObjectTypeSet *IncludeTypes = 0,
+            const ObjectTypeSet *ExcludeTypes = 0,
+            const Boolean Sorted = True) = 0;
+
+         virtual void find_nearest_objects (
+            const Vector &Origin,
+            const Int32 Count,
+            const Float64 Radius,
+            HandleContainer &objects,
+            const ObjectTypeSet *IncludeTypes = 0,
             const ObjectTypeSet *ExcludeTypes = 0) = 0;
 
       protected:
@@ -1,6 +1,7 @@
 #include <dmzObjectMaskConsts.h>
 #include "dmzObjectModuleBasic.h"
 #include "dmzObjectModuleBasicPrivate.h"
+#include <dmzRuntimeConfigToTypesBase.h>
 #include <dmzRuntimeData.h>
 #include <dmzRuntimeDefinitions.h>
 #include <dmzRuntimeObjectType.h>
@@ -16,8 +17,35 @@
 \class dmz::ObjectModuleBasic
 \ingroup Object
 \brief Basic ObjectModule implementation.
-\details This provides a basic implementation of the ObjectModule. At this time the
-ObjectModuleBasic has no configuration parameters.
+\details This provides a basic implementation of the ObjectModule.
+
+Fixed size attributes (states, flags, time stamps, positions, orientations, velocities,
+accelerations, scales, vectors, and scalars) are stored in dense columns, one per
+attribute handle and attribute type, indexed by a compact per object slot.
+
+When notification coalescing is enabled, changes to time stamps, positions,
+orientations, velocities, accelerations, scales, vectors, and scalars are not sent
+to observers as they are stored. Instead, the changed object attributes are recorded
+and each observer receives a single update per object attribute when the module's
+time slice runs. The previous value sent with the update is the value the attribute
+had before its first change since the last update. Pending updates for an object are
+sent before the object is destroyed. All other attributes are sent immediately.
+
+Changes made while observers are being updated are queued and sent once the current
+update completes. The queued updates are allocated from a pool owned by the module
+that is reused once the queue is emptied. If an update stats message is specified,
+it is sent once per frame with a dmz::Data containing the number of updates queued
+during the frame in the "queued" attribute, the largest number of updates waiting in
+the queue at once in the "peak" attribute, and the bytes reserved by the pool in the
+"pool" attribute.
+\code
+<dmz>
+<dmzObjectModuleBasic>
+   <notification coalesce="true"/>
+   <update-stats message="Object_Update_Stats_Message"/>
+</dmzObjectModuleBasic>
+</dmz>
+\endcode
 \sa ObjectModule
 
 */
@@ -55,18 +83,29 @@ namespace {
 }
 
 //! \cond
-dmz::ObjectModuleBasic::ObjectModuleBasic (const PluginInfo &Info) :
+dmz::ObjectModuleBasic::ObjectModuleBasic (const PluginInfo &Info, Config &local) :
       Plugin (Info),
+      TimeSlice (Info),
       ObjectModule (Info),
       _log (Info),
+      _coalesceUpdates (False),
       _inObsUpdate (False),
       _inStoredObsUpdate (False),
       _obsUpdateList (0),
       _obsUpdateListTail (0),
+      _queuedUpdates (0),
+      _queueDepth (0),
+      _peakQueueDepth (0),
       _objectCache (0),
       _recycleList (0),
+      _nextSlot (0),
+      _slotTableSize (0),
+      _slotTable (0),
       _globalCount (0),
       _handleConverter (Info.get_context ()),
+      _queuedUpdatesHandle (0),
+      _peakQueueDepthHandle (0),
+      _poolSizeHandle (0),
       _defaultHandle (0) {
 
    Definitions defs (Info, &_log);
@@ -74,6 +113,8 @@ dmz::ObjectModuleBasic::ObjectModuleBasic (const PluginInfo &Info) :
    defs.create_message (ObjectCreateMessageName, _createObjMsg);
    defs.create_message (ObjectDestroyMessageName, _removeObjMsg);
    _defaultHandle = defs.create_named_handle (ObjectAttributeDefaultName);
+
+   _init (local);
 }
 
 
@@ -81,8 +122,12 @@ dmz::ObjectModuleBasic::~ObjectModuleBasic () {
 
    _objectCache = 0;
 
+   _release_observer_updates ();
+
    if (_recycleList) { delete _recycleList; _recycleList = 0; }
 
+   if (_slotTable) { delete []_slotTable; _slotTable = 0; }
+
    HashTableHandleIterator it;
 
    SubscriptionStruct *ss (_subscriptionTable.get_first (it));
@@ -138,6 +183,8 @@ dmz::ObjectModuleBasic::update_plugin_state (
 
    if (State == PluginStateShutdown) {
 
+      if (_coalesceUpdates) { _flush_coalesced_updates (); }
+
       HashTableHandleIterator it;
       ObjectStruct *os (0);
 
@@ -169,6 +216,16 @@ dmz::ObjectModuleBasic::discover_plugin (
 }
 
 
+// TimeSlice Interface
+void
+dmz::ObjectModuleBasic::update_time_slice (const Float64 TimeDelta) {
+
+   if (_coalesceUpdates) { _flush_coalesced_updates (); }
+
+   if (_updateStatsMsg) { _send_update_stats (); }
+}
+
+
 // ObjectModule Interface
 dmz::Boolean
 dmz::ObjectModuleBasic::register_global_object_observer (ObjectObserver &observer) {
@@ -213,7 +270,7 @@ dmz::ObjectModuleBasic::release_global_object_observer (ObjectObserver &observer
    if (!_inObsUpdate) { result = immediate_release_global_object_observer (observer); }
    else {
 
-      _add_observer_update (new ReleaseGlobalObserverStruct (observer));
+      _add_observer_update (new (_obsUpdatePool) ReleaseGlobalObserverStruct (observer));
 
       result = True;
    }
@@ -293,7 +350,7 @@ dmz::ObjectModuleBasic::release_object_observer (
    }
    else {
 
-      _add_observer_update (new ReleaseObserverStruct (
+      _add_observer_update (new (_obsUpdatePool) ReleaseObserverStruct (
          AttributeHandle,
          AttributeMask,
          observer));
@@ -313,7 +370,7 @@ dmz::ObjectModuleBasic::release_object_observer_all (ObjectObserver &observer) {
    if (!_inObsUpdate) { result = immediate_release_object_observer_all (observer); }
    else {
 
-      _add_observer_update (new ReleaseObserverAllStruct (observer));
+      _add_observer_update (new (_obsUpdatePool) ReleaseObserverAllStruct (observer));
 
       result = True;
    }
@@ -480,14 +537,11 @@ dmz::ObjectModuleBasic::create_object (
 
    if (Type) {
 
-      ObjectStruct *obj (_recycleList);
-
-      if (obj) { _recycleList = _recycleList->next; obj->reset (); }
-      else { obj = new ObjectStruct; }
+      ObjectStruct *obj (_get_object_struct ());
 
       if (obj) {
 
-         result = obj->get_handle (Type.get_name (), _PluginInfoData.get_context ());
+         result = obj->get_handle (_PluginInfoData.get_context ());
 
          if (result) {
 
@@ -498,17 +552,45 @@ dmz::ObjectModuleBasic::create_object (
                obj->attrTable.store (_defaultHandle, (void *)this);
                store_locality (result, Locality);
             }
-            else {
-
-               result = 0;
-               obj->next = _recycleList; _recycleList = obj;
-            }
+            else { result = 0; _recycle_object_struct (obj); }
          }
-         else {
+         else { result = 0; _recycle_object_struct (obj); }
+      }
+   }
+
+   return result;
+}
+
+
+dmz::Int32
+dmz::ObjectModuleBasic::create_objects (
+      const ObjectType &Type,
+      const ObjectLocalityEnum Locality,
+      const Int32 Count,
+      HandleContainer &objects) {
+
+   Int32 result (0);
 
-            result = 0;
-            obj->next = _recycleList; _recycleList = obj;
+   if (Type) {
+
+      RuntimeContext *context (_PluginInfoData.get_context ());
+
+      for (Int32 ix = 0; ix < Count; ix++) {
+
+         ObjectStruct *obj (_get_object_struct ());
+
+         const Handle ObjectHandle (obj ? obj->get_handle (context) : 0);
+
+         if (ObjectHandle && _objectTable.store (ObjectHandle, obj)) {
+
+            _objectCache = obj;
+            obj->type = Type;
+            obj->locality = Locality;
+            obj->attrTable.store (_defaultHandle, (void *)this);
+            objects.add (ObjectHandle);
+            result++;
          }
+         else if (obj) { _recycle_object_struct (obj); }
       }
    }
 
@@ -538,7 +620,10 @@ dmz::ObjectModuleBasic::activate_object (const Handle ObjectHandle) {
          }
 
          if (!_inObsUpdate) { activate_created_object (obj->handle); }
-         else { _add_observer_update (new CreateObjectStruct (obj->handle)); }
+         else {
+
+            _add_observer_update (new (_obsUpdatePool) CreateObjectStruct (obj->handle));
+         }
 
          result = True;
       }
@@ -560,7 +645,10 @@ dmz::ObjectModuleBasic::destroy_object (const Handle ObjectHandle) {
       result = True;
 
       if (!_inObsUpdate) { immediate_destroy_object (ObjectHandle); }
-      else { _add_observer_update (new DestroyObjectStruct (obj->handle)); }
+      else {
+
+         _add_observer_update (new (_obsUpdatePool) DestroyObjectStruct (obj->handle));
+      }
    }
 
    return result;
@@ -592,7 +680,7 @@ dmz::ObjectModuleBasic::store_uuid (const Handle ObjectHandle, const UUID &Value
          else {
 
             _add_observer_update (
-               new ObjectUUIDStruct (ObjectHandle, obj->uuid, OldUUID));
+               new (_obsUpdatePool) ObjectUUIDStruct (ObjectHandle, obj->uuid, OldUUID));
          }
       }
    }
@@ -638,17 +726,22 @@ dmz::ObjectModuleBasic::clone_object (
 
    if (obj) {
 
-      ObjectStruct *next (_recycleList);
-
-      if (next) { _recycleList = next->next; next->reset (); }
-
-      ObjectStruct *clone (obj->clone (next));
+      ObjectStruct *clone (obj->clone (_get_object_struct ()));
 
       if (clone) {
 
-         result = clone->get_handle (
-            clone->type.get_name (),
-            _PluginInfoData.get_context ());
+         _stateColumns.copy_slot (obj->Slot, clone->Slot);
+         _flagColumns.copy_slot (obj->Slot, clone->Slot);
+         _timeStampColumns.copy_slot (obj->Slot, clone->Slot);
+         _positionColumns.copy_slot (obj->Slot, clone->Slot);
+         _orientationColumns.copy_slot (obj->Slot, clone->Slot);
+         _velocityColumns.copy_slot (obj->Slot, clone->Slot);
+         _accelerationColumns.copy_slot (obj->Slot, clone->Slot);
+         _scaleColumns.copy_slot (obj->Slot, clone->Slot);
+         _vectorColumns.copy_slot (obj->Slot, clone->Slot);
+         _scalarColumns.copy_slot (obj->Slot, clone->Slot);
+
+         result = clone->get_handle (_PluginInfoData.get_context ());
 
          if (result) {
 
@@ -720,7 +813,7 @@ dmz::ObjectModuleBasic::clone_object (
                   }
                }
             }
-            else { clone->next = _recycleList; _recycleList = clone; result = 0; }
+            else { _recycle_object_struct (clone); result = 0; }
          }
       }
    }
@@ -771,17 +864,17 @@ dmz::ObjectModuleBasic::remove_attribute (
 
       if (StateMask & AttributeMask) {
 
-         if (obj->stateTable.lookup (AttributeHandle)) { foundMask |= StateMask; }
+         if (_stateColumns.lookup (AttributeHandle, obj->Slot)) { foundMask |= StateMask; }
       }
 
       if (FlagMask & AttributeMask) {
 
-         if (obj->flagTable.lookup (AttributeHandle)) { foundMask |= FlagMask; }
+         if (_flagColumns.lookup (AttributeHandle, obj->Slot)) { foundMask |= FlagMask; }
       }
 
       if (TimeStampMask & AttributeMask) {
 
-         if (obj->timeStampTable.lookup (AttributeHandle)) {
+         if (_timeStampColumns.lookup (AttributeHandle, obj->Slot)) {
 
             foundMask |= TimeStampMask;
          }
@@ -789,12 +882,12 @@ dmz::ObjectModuleBasic::remove_attribute (
 
       if (PositionMask & AttributeMask) {
 
-         if (obj->positionTable.lookup (AttributeHandle)) { foundMask |= PositionMask; }
+         if (_positionColumns.lookup (AttributeHandle, obj->Slot)) { foundMask |= PositionMask; }
       }
 
       if (OrientationMask & AttributeMask) {
 
-         if (obj->orientationTable.lookup (AttributeHandle)) {
+         if (_orientationColumns.lookup (AttributeHandle, obj->Slot)) {
 
             foundMask |= OrientationMask;
          }
@@ -802,12 +895,12 @@ dmz::ObjectModuleBasic::remove_attribute (
 
       if (VelocityMask & AttributeMask) {
 
-         if (obj->velocityTable.lookup (AttributeHandle)) { foundMask |= VelocityMask; }
+         if (_velocityColumns.lookup (AttributeHandle, obj->Slot)) { foundMask |= VelocityMask; }
       }
 
       if (AccelerationMask & AttributeMask) {
 
-         if (obj->accelerationTable.lookup (AttributeHandle)) {
+         if (_accelerationColumns.lookup (AttributeHandle, obj->Slot)) {
 
             foundMask |= AccelerationMask;
          }
@@ -815,17 +908,17 @@ dmz::ObjectModuleBasic::remove_attribute (
 
       if (ScaleMask & AttributeMask) {
 
-         if (obj->scaleTable.lookup (AttributeHandle)) { foundMask |= ScaleMask; }
+         if (_scaleColumns.lookup (AttributeHandle, obj->Slot)) { foundMask |= ScaleMask; }
       }
 
       if (VectorMask & AttributeMask) {
 
-         if (obj->vectorTable.lookup (AttributeHandle)) { foundMask |= VectorMask; }
+         if (_vectorColumns.lookup (AttributeHandle, obj->Slot)) { foundMask |= VectorMask; }
       }
 
       if (ScalarMask & AttributeMask) {
 
-         if (obj->scalarTable.lookup (AttributeHandle)) { foundMask |= ScalarMask; }
+         if (_scalarColumns.lookup (AttributeHandle, obj->Slot)) { foundMask |= ScalarMask; }
       }
 
       if (TextMask & AttributeMask) {
@@ -852,7 +945,7 @@ dmz::ObjectModuleBasic::remove_attribute (
          }
          else {
 
-            _add_observer_update (new RemoveObjectAttrStruct (
+            _add_observer_update (new (_obsUpdatePool) RemoveObjectAttrStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -947,7 +1040,7 @@ dmz::ObjectModuleBasic::link_objects (
                }
                else {
 
-                  _add_observer_update (new LinkObjectsStruct (
+                  _add_observer_update (new (_obsUpdatePool) LinkObjectsStruct (
                      result,
                      AttributeHandle,
                      super->uuid,
@@ -1048,7 +1141,7 @@ dmz::ObjectModuleBasic::unlink_objects (const Handle LinkHandle) {
          }
          else {
 
-            _add_observer_update (new UnlinkObjectsStruct (
+            _add_observer_update (new (_obsUpdatePool) UnlinkObjectsStruct (
                ls->LinkHandle,
                ls->AttributeHandle,
                super->uuid,
@@ -1163,7 +1256,7 @@ dmz::ObjectModuleBasic::store_link_attribute_object (
          }
          else {
 
-            _add_observer_update (new LinkObjectAttrStruct (
+            _add_observer_update (new (_obsUpdatePool) LinkObjectAttrStruct (
                ls->LinkHandle,
                ls->AttributeHandle,
                super->uuid,
@@ -1311,7 +1404,7 @@ dmz::ObjectModuleBasic::store_locality (
          }
          else {
 
-            _add_observer_update (new ObjectLocalityStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectLocalityStruct (
                obj->uuid,
                ObjectHandle,
                Locality,
@@ -1412,7 +1505,7 @@ dmz::ObjectModuleBasic::store_counter (
          }
          else {
 
-            _add_observer_update (new UpdateCounterStruct (
+            _add_observer_update (new (_obsUpdatePool) UpdateCounterStruct (
                CounterValue,
                obj->uuid,
                ObjectHandle,
@@ -1577,7 +1670,7 @@ dmz::ObjectModuleBasic::store_counter_minimum (
          }
          else {
 
-            _add_observer_update (new UpdateCounterStruct (
+            _add_observer_update (new (_obsUpdatePool) UpdateCounterStruct (
                CounterMin,
                obj->uuid,
                ObjectHandle,
@@ -1673,7 +1766,7 @@ dmz::ObjectModuleBasic::store_counter_maximum (
          }
          else {
 
-            _add_observer_update (new UpdateCounterStruct (
+            _add_observer_update (new (_obsUpdatePool) UpdateCounterStruct (
                CounterMax,
                obj->uuid,
                ObjectHandle,
@@ -1805,7 +1898,7 @@ dmz::ObjectModuleBasic::store_alternate_object_type (
          }
          else {
 
-            _add_observer_update (new AltObjectTypeStruct (
+            _add_observer_update (new (_obsUpdatePool) AltObjectTypeStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -1855,7 +1948,7 @@ dmz::ObjectModuleBasic::store_state (
       result = True;
 
       Mask prevValue;
-      Mask *ptr (obj->stateTable.lookup (AttributeHandle));
+      Mask *ptr (_stateColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -1871,13 +1964,9 @@ dmz::ObjectModuleBasic::store_state (
 
          prevValueExists = False;
 
-         ptr = new Mask (Value);
-
-         if (!obj->stateTable.store (AttributeHandle, ptr)) {
+         ptr = _stateColumns.store (AttributeHandle, obj->Slot, Value);
 
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
@@ -1893,7 +1982,7 @@ dmz::ObjectModuleBasic::store_state (
          }
          else {
 
-            _add_observer_update (new ObjectStateStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectStateStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -1919,7 +2008,7 @@ dmz::ObjectModuleBasic::lookup_state (
 
    if (obj) {
 
-      Mask *ptr (obj->stateTable.lookup (AttributeHandle));
+      Mask *ptr (_stateColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -1943,7 +2032,7 @@ dmz::ObjectModuleBasic::store_flag (
       result = True;
 
       Boolean prevValue;
-      Boolean *ptr (obj->flagTable.lookup (AttributeHandle));
+      Boolean *ptr (_flagColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -1959,13 +2048,9 @@ dmz::ObjectModuleBasic::store_flag (
 
          prevValueExists = False;
 
-         ptr = new Boolean (Value);
-
-         if (!obj->flagTable.store (AttributeHandle, ptr)) {
+         ptr = _flagColumns.store (AttributeHandle, obj->Slot, Value);
 
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
@@ -1981,7 +2066,7 @@ dmz::ObjectModuleBasic::store_flag (
          }
          else {
 
-            _add_observer_update (new ObjectFlagStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectFlagStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2006,7 +2091,7 @@ dmz::ObjectModuleBasic::lookup_flag (
 
    if (obj) {
 
-      Boolean *ptr (obj->flagTable.lookup (AttributeHandle));
+      Boolean *ptr (_flagColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { result = *ptr; }
    }
@@ -2029,8 +2114,8 @@ dmz::ObjectModuleBasic::store_time_stamp (
 
       result = True;
 
-      Float64 prevValue;
-      Float64 *ptr (obj->timeStampTable.lookup (AttributeHandle));
+      Float64 prevValue (0.0);
+      Float64 *ptr (_timeStampColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -2046,18 +2131,22 @@ dmz::ObjectModuleBasic::store_time_stamp (
 
          prevValueExists = False;
 
-         ptr = new Float64 (Value);
-
-         if (!obj->timeStampTable.store (AttributeHandle, ptr)) {
+         ptr = _timeStampColumns.store (AttributeHandle, obj->Slot, Value);
 
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
 
-         if (!_inObsUpdate) {
+         if (_coalesceUpdates) {
+
+            _timeStampColumns.mark_dirty (
+               AttributeHandle,
+               obj->Slot,
+               prevValue,
+               prevValueExists);
+         }
+         else if (!_inObsUpdate) {
 
             update_object_time_stamp (
                obj->uuid,
@@ -2068,7 +2157,7 @@ dmz::ObjectModuleBasic::store_time_stamp (
          }
          else {
 
-            _add_observer_update (new ObjectTimeStampStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectTimeStampStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2094,7 +2183,7 @@ dmz::ObjectModuleBasic::lookup_time_stamp (
 
    if (obj) {
 
-      Float64 *ptr (obj->timeStampTable.lookup (AttributeHandle));
+      Float64 *ptr (_timeStampColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -2118,7 +2207,7 @@ dmz::ObjectModuleBasic::store_position (
       result = True;
 
       Vector prevValue;
-      Vector *ptr (obj->positionTable.lookup (AttributeHandle));
+      Vector *ptr (_positionColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -2134,18 +2223,22 @@ dmz::ObjectModuleBasic::store_position (
 
          prevValueExists = False;
 
-         ptr = new Vector (Value);
+         ptr = _positionColumns.store (AttributeHandle, obj->Slot, Value);
 
-         if (!obj->positionTable.store (AttributeHandle, ptr)) {
-
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
 
-         if (!_inObsUpdate) {
+         if (_coalesceUpdates) {
+
+            _positionColumns.mark_dirty (
+               AttributeHandle,
+               obj->Slot,
+               prevValue,
+               prevValueExists);
+         }
+         else if (!_inObsUpdate) {
 
             update_object_position (
                obj->uuid,
@@ -2156,7 +2249,7 @@ dmz::ObjectModuleBasic::store_position (
          }
          else {
 
-            _add_observer_update (new ObjectPositionStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectPositionStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2182,7 +2275,7 @@ dmz::ObjectModuleBasic::lookup_position (
 
    if (obj) {
 
-      Vector *ptr (obj->positionTable.lookup (AttributeHandle));
+      Vector *ptr (_positionColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -2206,7 +2299,7 @@ dmz::ObjectModuleBasic::store_orientation (
       result = True;
 
       Matrix prevValue;
-      Matrix *ptr (obj->orientationTable.lookup (AttributeHandle));
+      Matrix *ptr (_orientationColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -2222,18 +2315,22 @@ dmz::ObjectModuleBasic::store_orientation (
 
          prevValueExists = False;
 
-         ptr = new Matrix (Value);
-
-         if (!obj->orientationTable.store (AttributeHandle, ptr)) {
+         ptr = _orientationColumns.store (AttributeHandle, obj->Slot, Value);
 
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
 
-         if (!_inObsUpdate) {
+         if (_coalesceUpdates) {
+
+            _orientationColumns.mark_dirty (
+               AttributeHandle,
+               obj->Slot,
+               prevValue,
+               prevValueExists);
+         }
+         else if (!_inObsUpdate) {
 
             update_object_orientation (
                obj->uuid,
@@ -2244,7 +2341,7 @@ dmz::ObjectModuleBasic::store_orientation (
          }
          else {
 
-            _add_observer_update (new ObjectOrientationStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectOrientationStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2270,7 +2367,7 @@ dmz::ObjectModuleBasic::lookup_orientation (
 
    if (obj) {
 
-      Matrix *ptr (obj->orientationTable.lookup (AttributeHandle));
+      Matrix *ptr (_orientationColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -2294,7 +2391,7 @@ dmz::ObjectModuleBasic::store_velocity (
       result = True;
 
       Vector prevValue;
-      Vector *ptr (obj->velocityTable.lookup (AttributeHandle));
+      Vector *ptr (_velocityColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -2310,18 +2407,22 @@ dmz::ObjectModuleBasic::store_velocity (
 
          prevValueExists = False;
 
-         ptr = new Vector (Value);
-
-         if (!obj->velocityTable.store (AttributeHandle, ptr)) {
+         ptr = _velocityColumns.store (AttributeHandle, obj->Slot, Value);
 
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
 
-         if (!_inObsUpdate) {
+         if (_coalesceUpdates) {
+
+            _velocityColumns.mark_dirty (
+               AttributeHandle,
+               obj->Slot,
+               prevValue,
+               prevValueExists);
+         }
+         else if (!_inObsUpdate) {
 
             update_object_velocity (
                obj->uuid,
@@ -2332,7 +2433,7 @@ dmz::ObjectModuleBasic::store_velocity (
          }
          else {
 
-            _add_observer_update (new ObjectVelocityStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectVelocityStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2358,7 +2459,7 @@ dmz::ObjectModuleBasic::lookup_velocity (
 
    if (obj) {
 
-      Vector *ptr (obj->velocityTable.lookup (AttributeHandle));
+      Vector *ptr (_velocityColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -2382,7 +2483,7 @@ dmz::ObjectModuleBasic::store_acceleration (
       result = True;
 
       Vector prevValue;
-      Vector *ptr (obj->accelerationTable.lookup (AttributeHandle));
+      Vector *ptr (_accelerationColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -2398,18 +2499,22 @@ dmz::ObjectModuleBasic::store_acceleration (
 
          prevValueExists = False;
 
-         ptr = new Vector (Value);
+         ptr = _accelerationColumns.store (AttributeHandle, obj->Slot, Value);
 
-         if (!obj->accelerationTable.store (AttributeHandle, ptr)) {
-
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
 
-         if (!_inObsUpdate) {
+         if (_coalesceUpdates) {
+
+            _accelerationColumns.mark_dirty (
+               AttributeHandle,
+               obj->Slot,
+               prevValue,
+               prevValueExists);
+         }
+         else if (!_inObsUpdate) {
 
             update_object_acceleration (
                obj->uuid,
@@ -2420,7 +2525,7 @@ dmz::ObjectModuleBasic::store_acceleration (
          }
          else {
 
-            _add_observer_update (new ObjectAccelerationStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectAccelerationStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2446,7 +2551,7 @@ dmz::ObjectModuleBasic::lookup_acceleration (
 
    if (obj) {
 
-      Vector *ptr (obj->accelerationTable.lookup (AttributeHandle));
+      Vector *ptr (_accelerationColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -2470,7 +2575,7 @@ dmz::ObjectModuleBasic::store_scale (
       result = True;
 
       Vector prevValue;
-      Vector *ptr (obj->scaleTable.lookup (AttributeHandle));
+      Vector *ptr (_scaleColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -2486,18 +2591,22 @@ dmz::ObjectModuleBasic::store_scale (
 
          prevValueExists = False;
 
-         ptr = new Vector (Value);
-
-         if (!obj->scaleTable.store (AttributeHandle, ptr)) {
+         ptr = _scaleColumns.store (AttributeHandle, obj->Slot, Value);
 
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
 
-         if (!_inObsUpdate) {
+         if (_coalesceUpdates) {
+
+            _scaleColumns.mark_dirty (
+               AttributeHandle,
+               obj->Slot,
+               prevValue,
+               prevValueExists);
+         }
+         else if (!_inObsUpdate) {
 
             update_object_scale (
                obj->uuid,
@@ -2508,7 +2617,7 @@ dmz::ObjectModuleBasic::store_scale (
          }
          else {
 
-            _add_observer_update (new ObjectScaleStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectScaleStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2534,7 +2643,7 @@ dmz::ObjectModuleBasic::lookup_scale (
 
    if (obj) {
 
-      Vector *ptr (obj->scaleTable.lookup (AttributeHandle));
+      Vector *ptr (_scaleColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -2558,7 +2667,7 @@ dmz::ObjectModuleBasic::store_vector (
       result = True;
 
       Vector prevValue;
-      Vector *ptr (obj->vectorTable.lookup (AttributeHandle));
+      Vector *ptr (_vectorColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -2574,18 +2683,22 @@ dmz::ObjectModuleBasic::store_vector (
 
          prevValueExists = False;
 
-         ptr = new Vector (Value);
-
-         if (!obj->vectorTable.store (AttributeHandle, ptr)) {
+         ptr = _vectorColumns.store (AttributeHandle, obj->Slot, Value);
 
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
 
-         if (!_inObsUpdate) {
+         if (_coalesceUpdates) {
+
+            _vectorColumns.mark_dirty (
+               AttributeHandle,
+               obj->Slot,
+               prevValue,
+               prevValueExists);
+         }
+         else if (!_inObsUpdate) {
 
             update_object_vector (
                obj->uuid,
@@ -2596,7 +2709,7 @@ dmz::ObjectModuleBasic::store_vector (
          }
          else {
 
-            _add_observer_update (new ObjectVectorStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectVectorStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2622,7 +2735,7 @@ dmz::ObjectModuleBasic::lookup_vector (
 
    if (obj) {
 
-      Vector *ptr (obj->vectorTable.lookup (AttributeHandle));
+      Vector *ptr (_vectorColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -2646,7 +2759,7 @@ dmz::ObjectModuleBasic::store_scalar (
       result = True;
 
       Float64 prevValue (0.0);
-      Float64 *ptr (obj->scalarTable.lookup (AttributeHandle));
+      Float64 *ptr (_scalarColumns.lookup (AttributeHandle, obj->Slot));
 
       Boolean prevValueExists (True);
       Boolean updateObservers (True);
@@ -2662,18 +2775,22 @@ dmz::ObjectModuleBasic::store_scalar (
 
          prevValueExists = False;
 
-         ptr = new Float64 (Value);
-
-         if (!obj->scalarTable.store (AttributeHandle, ptr)) {
+         ptr = _scalarColumns.store (AttributeHandle, obj->Slot, Value);
 
-            result = False;
-            delete ptr; ptr = 0;
-         }
+         if (!ptr) { result = False; }
       }
 
       if (updateObservers && obj->active && ptr) {
 
-         if (!_inObsUpdate) {
+         if (_coalesceUpdates) {
+
+            _scalarColumns.mark_dirty (
+               AttributeHandle,
+               obj->Slot,
+               prevValue,
+               prevValueExists);
+         }
+         else if (!_inObsUpdate) {
 
             update_object_scalar (
                obj->uuid,
@@ -2684,7 +2801,7 @@ dmz::ObjectModuleBasic::store_scalar (
          }
          else {
 
-            _add_observer_update (new ObjectScalarStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectScalarStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2710,7 +2827,7 @@ dmz::ObjectModuleBasic::lookup_scalar (
 
    if (obj) {
 
-      Float64 *ptr (obj->scalarTable.lookup (AttributeHandle));
+      Float64 *ptr (_scalarColumns.lookup (AttributeHandle, obj->Slot));
 
       if (ptr) { value = *ptr; result = True; }
    }
@@ -2772,7 +2889,7 @@ dmz::ObjectModuleBasic::store_text (
          }
          else {
 
-            _add_observer_update (new ObjectTextStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectTextStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2860,7 +2977,7 @@ dmz::ObjectModuleBasic::store_data (
          }
          else {
 
-            _add_observer_update (new ObjectDataStruct (
+            _add_observer_update (new (_obsUpdatePool) ObjectDataStruct (
                obj->uuid,
                ObjectHandle,
                AttributeHandle,
@@ -2895,6 +3012,110 @@ dmz::ObjectModuleBasic::lookup_data (
 }
 
 
+dmz::Int32
+dmz::ObjectModuleBasic::lookup_time_stamps (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      Float64 *values,
+      Boolean *found) {
+
+   return _lookup_batch (Objects, AttributeHandle, _timeStampColumns, values, found);
+}
+
+
+dmz::Int32
+dmz::ObjectModuleBasic::lookup_positions (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      Vector *values,
+      Boolean *found) {
+
+   return _lookup_batch (Objects, AttributeHandle, _positionColumns, values, found);
+}
+
+
+dmz::Int32
+dmz::ObjectModuleBasic::lookup_orientations (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      Matrix *values,
+      Boolean *found) {
+
+   return _lookup_batch (Objects, AttributeHandle, _orientationColumns, values, found);
+}
+
+
+dmz::Int32
+dmz::ObjectModuleBasic::lookup_velocities (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      Vector *values,
+      Boolean *found) {
+
+   return _lookup_batch (Objects, AttributeHandle, _velocityColumns, values, found);
+}
+
+
+dmz::Int32
+dmz::ObjectModuleBasic::store_positions (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      const Vector *Values,
+      const Boolean *Valid) {
+
+   return _store_batch (
+      Objects,
+      AttributeHandle,
+      Values,
+      Valid,
+      _positionColumns,
+      _vectorBatch,
+      _positionTable,
+      &ObjectModuleBasic::store_position,
+      &ObjectObserver::update_object_position);
+}
+
+
+dmz::Int32
+dmz::ObjectModuleBasic::store_orientations (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      const Matrix *Values,
+      const Boolean *Valid) {
+
+   return _store_batch (
+      Objects,
+      AttributeHandle,
+      Values,
+      Valid,
+      _orientationColumns,
+      _matrixBatch,
+      _orientationTable,
+      &ObjectModuleBasic::store_orientation,
+      &ObjectObserver::update_object_orientation);
+}
+
+
+dmz::Int32
+dmz::ObjectModuleBasic::store_velocities (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      const Vector *Values,
+      const Boolean *Valid) {
+
+   return _store_batch (
+      Objects,
+      AttributeHandle,
+      Values,
+      Valid,
+      _velocityColumns,
+      _vectorBatch,
+      _velocityTable,
+      &ObjectModuleBasic::store_velocity,
+      &ObjectObserver::update_object_velocity);
+}
+
+
 // ObjectModuleBasic Interface
 dmz::Boolean
 dmz::ObjectModuleBasic::immediate_release_global_object_observer (
@@ -3089,6 +3310,8 @@ dmz::ObjectModuleBasic::immediate_destroy_object (const Handle ObjectHandle) {
 
       if (obj->active) {
 
+         if (_coalesceUpdates) { _flush_object_updates (*obj); }
+
          HashTableHandleIterator it;
 
          ObjectObserver *obs (_destroyTable.get_first (it));
@@ -3114,7 +3337,7 @@ dmz::ObjectModuleBasic::immediate_destroy_object (const Handle ObjectHandle) {
       _objectTable.remove (ObjectHandle);
 
       _uuidObjTable.remove (obj->uuid);
-      obj->next = _recycleList; _recycleList = obj;
+      _recycle_object_struct (obj);
       if (obj == _objectCache) { _objectCache = 0; }
 
       Data out (_handleConverter.to_data (ObjectHandle));
@@ -3229,62 +3452,52 @@ dmz::ObjectModuleBasic::remove_object_attribute (
 
       if (StateMask & AttrMask) {
 
-         Mask *ptr (obj->stateTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _stateColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (FlagMask & AttrMask) {
 
-         Boolean *ptr (obj->flagTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _flagColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (TimeStampMask & AttrMask) {
 
-         Float64 *ptr (obj->timeStampTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _timeStampColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (PositionMask & AttrMask) {
 
-         Vector *ptr (obj->positionTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _positionColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (OrientationMask & AttrMask) {
 
-         Matrix *ptr (obj->orientationTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _orientationColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (VelocityMask & AttrMask) {
 
-         Vector *ptr (obj->velocityTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _velocityColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (AccelerationMask & AttrMask) {
 
-         Vector *ptr (obj->accelerationTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _accelerationColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (ScaleMask & AttrMask) {
 
-         Vector *ptr (obj->scaleTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _scaleColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (VectorMask & AttrMask) {
 
-         Vector *ptr (obj->vectorTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _vectorColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (ScalarMask & AttrMask) {
 
-         Float64 *ptr (obj->scalarTable.remove (AttributeHandle));
-         if (ptr) { delete ptr; ptr = 0; }
+         _scalarColumns.remove (AttributeHandle, obj->Slot);
       }
 
       if (TextMask & AttrMask) {
@@ -4448,6 +4661,487 @@ dmz::ObjectModuleBasic::update_object_data (
 }
 
 
+template <class T> dmz::Int32
+dmz::ObjectModuleBasic::_lookup_batch (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      ColumnTableStruct<T> &columns,
+      T *values,
+      Boolean *found) {
+
+   Int32 result (0);
+
+   ColumnStruct<T> *column (columns.lookup_column (AttributeHandle));
+
+   HandleContainerIterator it;
+   Handle objectHandle (0);
+   Int32 index (0);
+
+   while (Objects.get_next (it, objectHandle)) {
+
+      ObjectStruct *obj (column ? _lookup_object (objectHandle) : 0);
+      T *ptr (obj ? column->lookup (obj->Slot) : 0);
+
+      if (ptr) { values[index] = *ptr; result++; }
+      if (found) { found[index] = (ptr != 0); }
+
+      index++;
+   }
+
+   return result;
+}
+
+
+template <class T> dmz::Int32
+dmz::ObjectModuleBasic::_store_batch (
+      const HandleContainer &Objects,
+      const Handle AttributeHandle,
+      const T *Values,
+      const Boolean *Valid,
+      ColumnTableStruct<T> &columns,
+      BatchListStruct<T> &batch,
+      HashTableHandleTemplate<ObjectObserverStruct> &obsTable,
+      Boolean (ObjectModuleBasic::*storeFunc) (
+         const Handle,
+         const Handle,
+         const T &),
+      void (ObjectObserver::*updateFunc) (
+         const UUID &,
+         const Handle,
+         const Handle,
+         const T &,
+         const T *)) {
+
+   Int32 result (0);
+
+   const Int32 Count (Objects.get_count ());
+
+   if (AttributeHandle && Values && (Count > 0)) {
+
+      HandleContainerIterator it;
+      Handle objectHandle (0);
+      Int32 index (0);
+
+      if (_inObsUpdate) {
+
+         // Observer updates are already being deferred so let the single value
+         // store queue them in order.
+         while (Objects.get_next (it, objectHandle)) {
+
+            if (!Valid || Valid[index]) {
+
+               if ((this->*storeFunc) (objectHandle, AttributeHandle, Values[index])) {
+
+                  result++;
+               }
+            }
+
+            index++;
+         }
+      }
+      else {
+
+         BatchUpdateStruct<T> *updateList (batch.get_list (Count));
+         Int32 updateCount (0);
+
+         while (Objects.get_next (it, objectHandle)) {
+
+            ObjectStruct *obj (
+               (!Valid || Valid[index]) ? _lookup_object (objectHandle) : 0);
+
+            if (obj) {
+
+               const T &Value (Values[index]);
+               T *ptr (columns.lookup (AttributeHandle, obj->Slot));
+
+               BatchUpdateStruct<T> &update (updateList[updateCount]);
+               Boolean updateObservers (True);
+
+               update.prevValueExists = False;
+
+               if (ptr) {
+
+                  if (Value != *ptr) {
+
+                     update.prevValue = *ptr;
+                     update.prevValueExists = True;
+                     *ptr = Value;
+                  }
+                  else { updateObservers = False; }
+               }
+               else {
+
+                  obj->attrTable.store (AttributeHandle, (void *)this);
+
+                  ptr = columns.store (AttributeHandle, obj->Slot, Value);
+               }
+
+               if (ptr) { result++; }
+
+               if (updateObservers && obj->active && ptr && _coalesceUpdates) {
+
+                  columns.mark_dirty (
+                     AttributeHandle,
+                     obj->Slot,
+                     update.prevValue,
+                     update.prevValueExists);
+
+                  update.prevValueExists = False;
+               }
+               else if (updateObservers && obj->active && ptr) {
+
+                  update.obj = obj;
+                  update.objectHandle = objectHandle;
+                  update.index = index;
+                  updateCount++;
+               }
+               else { update.prevValueExists = False; }
+            }
+
+            index++;
+         }
+
+         if (updateCount > 0) {
+
+            _inObsUpdate = True;
+
+            ObjectObserverStruct *os (obsTable.lookup (AttributeHandle));
+
+            for (Int32 ix = 0; ix < updateCount; ix++) {
+
+               const BatchUpdateStruct<T> &Update (updateList[ix]);
+               const T *PreviousValue (
+                  Update.prevValueExists ? &(Update.prevValue) : 0);
+
+               if (os) {
+
+                  HashTableHandleIterator obsIt;
+
+                  ObjectObserver *obs (os->get_first (obsIt));
+
+                  while (obs) {
+
+                     (obs->*updateFunc) (
+                        Update.obj->uuid,
+                        Update.objectHandle,
+                        AttributeHandle,
+                        Values[Update.index],
+                        PreviousValue);
+
+                     obs = os->get_next (obsIt);
+                  }
+               }
+
+               if (_globalCount > 0) {
+
+                  HashTableHandleIterator obsIt;
+
+                  ObjectObserver *obs (_globalTable.get_first (obsIt));
+
+                  while (obs) {
+
+                     (obs->*updateFunc) (
+                        Update.obj->uuid,
+                        Update.objectHandle,
+                        AttributeHandle,
+                        Values[Update.index],
+                        PreviousValue);
+
+                     obs = _globalTable.get_next (obsIt);
+                  }
+               }
+            }
+
+            _inObsUpdate = False;
+         }
+
+         _update_observers ();
+      }
+   }
+
+   return result;
+}
+
+
+template <class T, class UpdateFunc> void
+dmz::ObjectModuleBasic::_flush_column_slot (
+      ColumnStruct<T> &column,
+      const Int32 Slot,
+      HashTableHandleTemplate<ObjectObserverStruct> &obsTable,
+      UpdateFunc updateFunc) {
+
+   if (column.is_dirty (Slot)) {
+
+      column.dirty[Slot] = False;
+
+      ObjectStruct *obj ((Slot < _slotTableSize) ? _slotTable[Slot] : 0);
+      T *ptr (column.lookup (Slot));
+
+      if (obj && obj->active && ptr) {
+
+         // Observers may store new values while being updated so copy the values out
+         // of the column before sending them.
+         const T Value (*ptr);
+         const T StartValue (column.startValues[Slot]);
+         const Boolean StartPresent (column.startPresent[Slot]);
+
+         if (!StartPresent || (Value != StartValue)) {
+
+            const Handle AttributeHandle (column.AttributeHandle);
+            const T *PreviousValue (StartPresent ? &StartValue : 0);
+
+            ObjectObserverStruct *os (obsTable.lookup (AttributeHandle));
+
+            if (os) {
+
+               HashTableHandleIterator it;
+
+               ObjectObserver *obs (os->get_first (it));
+
+               while (obs) {
+
+                  (obs->*updateFunc) (
+                     obj->uuid,
+                     obj->handle,
+                     AttributeHandle,
+                     Value,
+                     PreviousValue);
+
+                  obs = os->get_next (it);
+               }
+            }
+
+            if (_globalCount > 0) {
+
+               HashTableHandleIterator it;
+
+               ObjectObserver *obs (_globalTable.get_first (it));
+
+               while (obs) {
+
+                  (obs->*updateFunc) (
+                     obj->uuid,
+                     obj->handle,
+                     AttributeHandle,
+                     Value,
+                     PreviousValue);
+
+                  obs = _globalTable.get_next (it);
+               }
+            }
+         }
+      }
+   }
+}
+
+
+template <class T, class UpdateFunc> void
+dmz::ObjectModuleBasic::_flush_columns (
+      ColumnTableStruct<T> &columns,
+      HashTableHandleTemplate<ObjectObserverStruct> &obsTable,
+      UpdateFunc updateFunc) {
+
+   HashTableHandleIterator it;
+   ColumnStruct<T> *column (0);
+
+   while (columns.table.get_next (it, column)) {
+
+      // Attributes changed by observers during the flush are sent with the next flush.
+      const Int32 Count (column->dirtyCount);
+
+      for (Int32 ix = 0; ix < Count; ix++) {
+
+         _flush_column_slot (*column, column->dirtyList[ix], obsTable, updateFunc);
+      }
+
+      for (Int32 ix = Count; ix < column->dirtyCount; ix++) {
+
+         column->dirtyList[ix - Count] = column->dirtyList[ix];
+      }
+
+      column->dirtyCount -= Count;
+   }
+}
+
+
+template <class T, class UpdateFunc> void
+dmz::ObjectModuleBasic::_flush_object_columns (
+      const Int32 Slot,
+      ColumnTableStruct<T> &columns,
+      HashTableHandleTemplate<ObjectObserverStruct> &obsTable,
+      UpdateFunc updateFunc) {
+
+   HashTableHandleIterator it;
+   ColumnStruct<T> *column (0);
+
+   while (columns.table.get_next (it, column)) {
+
+      _flush_column_slot (*column, Slot, obsTable, updateFunc);
+   }
+}
+
+
+void
+dmz::ObjectModuleBasic::_flush_coalesced_updates () {
+
+   if (!_inObsUpdate) {
+
+      _inObsUpdate = True;
+
+      _flush_columns (
+         _timeStampColumns,
+         _timeStampTable,
+         &ObjectObserver::update_object_time_stamp);
+
+      _flush_columns (
+         _positionColumns,
+         _positionTable,
+         &ObjectObserver::update_object_position);
+
+      _flush_columns (
+         _orientationColumns,
+         _orientationTable,
+         &ObjectObserver::update_object_orientation);
+
+      _flush_columns (
+         _velocityColumns,
+         _velocityTable,
+         &ObjectObserver::update_object_velocity);
+
+      _flush_columns (
+         _accelerationColumns,
+         _accelerationTable,
+         &ObjectObserver::update_object_acceleration);
+
+      _flush_columns (
+         _scaleColumns,
+         _scaleTable,
+         &ObjectObserver::update_object_scale);
+
+      _flush_columns (
+         _vectorColumns,
+         _vectorTable,
+         &ObjectObserver::update_object_vector);
+
+      _flush_columns (
+         _scalarColumns,
+         _scalarTable,
+         &ObjectObserver::update_object_scalar);
+
+      _inObsUpdate = False;
+
+      _update_observers ();
+   }
+}
+
+
+void
+dmz::ObjectModuleBasic::_flush_object_updates (const ObjectStruct &Obj) {
+
+   _flush_object_columns (
+      Obj.Slot,
+      _timeStampColumns,
+      _timeStampTable,
+      &ObjectObserver::update_object_time_stamp);
+
+   _flush_object_columns (
+      Obj.Slot,
+      _positionColumns,
+      _positionTable,
+      &ObjectObserver::update_object_position);
+
+   _flush_object_columns (
+      Obj.Slot,
+      _orientationColumns,
+      _orientationTable,
+      &ObjectObserver::update_object_orientation);
+
+   _flush_object_columns (
+      Obj.Slot,
+      _velocityColumns,
+      _velocityTable,
+      &ObjectObserver::update_object_velocity);
+
+   _flush_object_columns (
+      Obj.Slot,
+      _accelerationColumns,
+      _accelerationTable,
+      &ObjectObserver::update_object_acceleration);
+
+   _flush_object_columns (
+      Obj.Slot,
+      _scaleColumns,
+      _scaleTable,
+      &ObjectObserver::update_object_scale);
+
+   _flush_object_columns (
+      Obj.Slot,
+      _vectorColumns,
+      _vectorTable,
+      &ObjectObserver::update_object_vector);
+
+   _flush_object_columns (
+      Obj.Slot,
+      _scalarColumns,
+      _scalarTable,
+      &ObjectObserver::update_object_scalar);
+}
+
+
+dmz::ObjectModuleBasic::ObjectStruct *
+dmz::ObjectModuleBasic::_get_object_struct () {
+
+   ObjectStruct *result (_recycleList);
+
+   if (result) { _recycleList = result->next; result->reset (); }
+   else {
+
+      result = new ObjectStruct (_nextSlot);
+
+      if (_nextSlot >= _slotTableSize) {
+
+         const Int32 NewSize (_slotTableSize > 0 ? _slotTableSize * 2 : 64);
+         ObjectStruct **newTable (new ObjectStruct *[NewSize]);
+
+         for (Int32 ix = 0; ix < NewSize; ix++) {
+
+            newTable[ix] = (ix < _slotTableSize) ? _slotTable[ix] : 0;
+         }
+
+         if (_slotTable) { delete []_slotTable; }
+         _slotTable = newTable;
+         _slotTableSize = NewSize;
+      }
+
+      _slotTable[_nextSlot] = result;
+      _nextSlot++;
+   }
+
+   return result;
+}
+
+
+void
+dmz::ObjectModuleBasic::_recycle_object_struct (ObjectStruct *obj) {
+
+   if (obj) {
+
+      _stateColumns.remove_slot (obj->Slot);
+      _flagColumns.remove_slot (obj->Slot);
+      _timeStampColumns.remove_slot (obj->Slot);
+      _positionColumns.remove_slot (obj->Slot);
+      _orientationColumns.remove_slot (obj->Slot);
+      _velocityColumns.remove_slot (obj->Slot);
+      _accelerationColumns.remove_slot (obj->Slot);
+      _scaleColumns.remove_slot (obj->Slot);
+      _vectorColumns.remove_slot (obj->Slot);
+      _scalarColumns.remove_slot (obj->Slot);
+
+      obj->next = _recycleList; _recycleList = obj;
+   }
+}
+
+
 void
 dmz::ObjectModuleBasic::_unlink_table (const LinkTable &Table) {
 
@@ -4794,6 +5488,8 @@ dmz::ObjectModuleBasic::_dump_object_attributes_to_observer (
       const Mask &AttributeMask,
       ObjectObserver &obs) {
 
+   // Column values are copied before being sent because an observer that stores an
+   // attribute or creates an object may cause the column to reallocate.
    if (AltObjectTypeMask & AttributeMask) {
 
       ObjectType *ptr (Obj.altTypeTable.lookup (AttributeHandle));
@@ -4811,21 +5507,23 @@ dmz::ObjectModuleBasic::_dump_object_attributes_to_observer (
 
    if (StateMask & AttributeMask) {
 
-      Mask *ptr (Obj.stateTable.lookup (AttributeHandle));
+      Mask *ptr (_stateColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_state (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Mask Value (*ptr);
+         obs.update_object_state (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
    if (FlagMask & AttributeMask) {
 
-      Boolean *ptr (Obj.flagTable.lookup (AttributeHandle));
+      Boolean *ptr (_flagColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_flag (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Boolean Value (*ptr);
+         obs.update_object_flag (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
@@ -4955,81 +5653,89 @@ dmz::ObjectModuleBasic::_dump_object_attributes_to_observer (
 
    if (TimeStampMask & AttributeMask) {
 
-      Float64 *ptr (Obj.timeStampTable.lookup (AttributeHandle));
+      Float64 *ptr (_timeStampColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_time_stamp (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Float64 Value (*ptr);
+         obs.update_object_time_stamp (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
    if (PositionMask & AttributeMask) {
 
-      Vector *ptr (Obj.positionTable.lookup (AttributeHandle));
+      Vector *ptr (_positionColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_position (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Vector Value (*ptr);
+         obs.update_object_position (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
    if (OrientationMask & AttributeMask) {
 
-      Matrix *ptr (Obj.orientationTable.lookup (AttributeHandle));
+      Matrix *ptr (_orientationColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_orientation (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Matrix Value (*ptr);
+         obs.update_object_orientation (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
    if (VelocityMask & AttributeMask) {
 
-      Vector *ptr (Obj.velocityTable.lookup (AttributeHandle));
+      Vector *ptr (_velocityColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_velocity (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Vector Value (*ptr);
+         obs.update_object_velocity (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
    if (AccelerationMask & AttributeMask) {
 
-      Vector *ptr (Obj.accelerationTable.lookup (AttributeHandle));
+      Vector *ptr (_accelerationColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_acceleration (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Vector Value (*ptr);
+         obs.update_object_acceleration (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
    if (ScaleMask & AttributeMask) {
 
-      Vector *ptr (Obj.scaleTable.lookup (AttributeHandle));
+      Vector *ptr (_scaleColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_scale (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Vector Value (*ptr);
+         obs.update_object_scale (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
    if (VectorMask & AttributeMask) {
 
-      Vector *ptr (Obj.vectorTable.lookup (AttributeHandle));
+      Vector *ptr (_vectorColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_vector (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Vector Value (*ptr);
+         obs.update_object_vector (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
    if (ScalarMask & AttributeMask) {
 
-      Float64 *ptr (Obj.scalarTable.lookup (AttributeHandle));
+      Float64 *ptr (_scalarColumns.lookup (AttributeHandle, Obj.Slot));
 
       if (ptr) {
 
-         obs.update_object_scalar (Obj.uuid, Obj.handle, AttributeHandle, *ptr, 0);
+         const Float64 Value (*ptr);
+         obs.update_object_scalar (Obj.uuid, Obj.handle, AttributeHandle, Value, 0);
       }
    }
 
@@ -5062,6 +5768,10 @@ dmz::ObjectModuleBasic::_add_observer_update (ObsUpdateStruct *ptr) {
 
       if (!_obsUpdateListTail) { _obsUpdateList = _obsUpdateListTail = ptr; }
       else { _obsUpdateListTail->next = ptr; _obsUpdateListTail = ptr; }
+
+      _queuedUpdates++;
+      _queueDepth++;
+      if (_queueDepth > _peakQueueDepth) { _peakQueueDepth = _queueDepth; }
    }
 }
 
@@ -5081,12 +5791,67 @@ dmz::ObjectModuleBasic::_update_observers () {
          current = current->next;
       }
 
-      delete _obsUpdateList; _obsUpdateList = 0;
-      _obsUpdateListTail = 0;
+      _release_observer_updates ();
 
       _inStoredObsUpdate = False;
    }
 }
+
+
+void
+dmz::ObjectModuleBasic::_release_observer_updates () {
+
+   // Updates are allocated from the pool so they are destroyed in place and the pool
+   // memory is reused by the next set of updates.
+   while (_obsUpdateList) {
+
+      ObsUpdateStruct *current (_obsUpdateList);
+      _obsUpdateList = current->next;
+      current->~ObsUpdateStruct ();
+   }
+
+   _obsUpdateListTail = 0;
+   _queueDepth = 0;
+
+   _obsUpdatePool.reset ();
+}
+
+
+void
+dmz::ObjectModuleBasic::_send_update_stats () {
+
+   Data out;
+
+   out.store_int32 (_queuedUpdatesHandle, 0, _queuedUpdates);
+   out.store_int32 (_peakQueueDepthHandle, 0, _peakQueueDepth);
+   out.store_int32 (_poolSizeHandle, 0, _obsUpdatePool.reserved);
+
+   _queuedUpdates = 0;
+   _peakQueueDepth = _queueDepth;
+
+   _updateStatsMsg.send (&out);
+}
+
+
+void
+dmz::ObjectModuleBasic::_init (Config &local) {
+
+   _coalesceUpdates = config_to_boolean ("notification.coalesce", local, False);
+
+   const String StatsMessageName (config_to_string ("update-stats.message", local));
+
+   if (StatsMessageName) {
+
+      Definitions defs (get_plugin_runtime_context (), &_log);
+
+      defs.create_message (StatsMessageName, _updateStatsMsg);
+      _queuedUpdatesHandle = defs.create_named_handle ("queued");
+      _peakQueueDepthHandle = defs.create_named_handle ("peak");
+      _poolSizeHandle = defs.create_named_handle ("pool");
+   }
+
+   if (!_coalesceUpdates && !_updateStatsMsg) { stop_time_slice (); }
+}
 //! \endcond
 
 extern "C" {
@@ -5097,7 +5862,7 @@ create_dmzObjectModuleBasic (
       dmz::Config &local,
       dmz::Config &global) {
 
-   return new dmz::ObjectModuleBasic (Info);
+   return new dmz::ObjectModuleBasic (Info, local);
 }
 
 };
@@ -10,16 +10,20 @@
 #include <dmzRuntimePlugin.h>
 #include <dmzRuntimePluginInfo.h>
 #include <dmzRuntimeObjectType.h>
+#include <dmzRuntimeTimeSlice.h>
 #include <dmzTypesBase.h>
 #include <dmzTypesDeleteListTemplate.h>
 #include <dmzTypesHashTableStringTemplate.h>
 #include <dmzTypesHashTableHandleTemplate.h>
 #include <dmzTypesHashTableUUIDTemplate.h>
+#include <dmzTypesMask.h>
 #include <dmzTypesMatrix.h>
 #include <dmzTypesUUID.h>
+#include <dmzTypesVector.h>
 
 namespace dmz {
 
+   class Config;
    class Data;
    class Mask;
    class ObjectObserver;
@@ -32,21 +36,91 @@ namespace dmz {
    typedef HashTableHandleTemplate<ObjectObserver> ObjectObserverStruct;
    //! \endcond
 
-   class ObjectModuleBasic : public Plugin, protected ObjectModule {
+   class ObjectModuleBasic :
+         public Plugin,
+         public TimeSlice,
+         protected ObjectModule {
 
       public:
          //! \cond
+         struct ObsUpdatePoolStruct {
+
+            struct BlockStruct {
+
+               BlockStruct *next;
+               const Int32 Size;
+               Int32 used;
+               char *buffer;
+
+               BlockStruct (const Int32 TheSize) :
+                     next (0),
+                     Size (TheSize),
+                     used (0),
+                     buffer (new char[TheSize]) {;}
+
+               ~BlockStruct () { if (buffer) { delete []buffer; buffer = 0; } }
+            };
+
+            BlockStruct *head;
+            BlockStruct *current;
+            Int32 reserved;
+
+            ObsUpdatePoolStruct () : head (0), current (0), reserved (0) {;}
+            ~ObsUpdatePoolStruct () { current = 0; delete_list (head); }
+
+            void *allocate (const Int32 TheSize) {
+
+               // Keep every allocation aligned for the largest member type.
+               const Int32 Size ((TheSize + 15) & ~15);
+
+               while (current && ((current->used + Size) > current->Size)) {
+
+                  current = current->next;
+               }
+
+               if (!current) {
+
+                  current = new BlockStruct (Size > 16384 ? Size : 16384);
+                  current->next = head;
+                  head = current;
+                  reserved += current->Size;
+               }
+
+               void *result (current->buffer + current->used);
+               current->used += Size;
+
+               return result;
+            }
+
+            void reset () {
+
+               BlockStruct *block (head);
+
+               while (block) { block->used = 0; block = block->next; }
+
+               current = head;
+            }
+         };
+
          struct ObsUpdateStruct {
 
             ObsUpdateStruct *next;
 
             ObsUpdateStruct () : next (0) {;}
-            virtual ~ObsUpdateStruct () { delete_list (next); }
+            virtual ~ObsUpdateStruct () {;}
 
             virtual void update (ObjectModuleBasic &module) = 0;
+
+            static void *operator new (size_t Size, ObsUpdatePoolStruct &pool) {
+
+               return pool.allocate (Int32 (Size));
+            }
+
+            static void operator delete (void *ptr, ObsUpdatePoolStruct &pool) {;}
+            static void operator delete (void *ptr) {;}
          };
 
-         ObjectModuleBasic (const PluginInfo &Info);
+         ObjectModuleBasic (const PluginInfo &Info, Config &local);
          ~ObjectModuleBasic ();
 
          // Plugin Interface
@@ -58,6 +132,9 @@ namespace dmz {
             const PluginDiscoverEnum Mode,
             const Plugin *PluginPtr);
 
+         // TimeSlice Interface
+         virtual void update_time_slice (const Float64 TimeDelta);
+
          // ObjectModule Interface
          virtual Boolean register_global_object_observer (ObjectObserver &observer);
          virtual Boolean release_global_object_observer (ObjectObserver &observer);
@@ -97,6 +174,12 @@ namespace dmz {
             const ObjectType &Type,
             const ObjectLocalityEnum Locality);
 
+         virtual Int32 create_objects (
+            const ObjectType &Type,
+            const ObjectLocalityEnum Locality,
+            const Int32 Count,
+            HandleContainer &objects);
+
          virtual Boolean activate_object (const Handle ObjectHandle);
 
          virtual Boolean destroy_object (const Handle ObjectHandle);
@@ -343,6 +426,48 @@ namespace dmz {
             const Handle AttributeHandle,
             Data &value);
 
+         virtual Int32 lookup_time_stamps (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            Float64 *values,
+            Boolean *found = 0);
+
+         virtual Int32 lookup_positions (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            Vector *values,
+            Boolean *found = 0);
+
+         virtual Int32 lookup_orientations (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            Matrix *values,
+            Boolean *found = 0);
+
+         virtual Int32 lookup_velocities (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            Vector *values,
+            Boolean *found = 0);
+
+         virtual Int32 store_positions (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            const Vector *Values,
+            const Boolean *Valid = 0);
+
+         virtual Int32 store_orientations (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            const Matrix *Values,
+            const Boolean *Valid = 0);
+
+         virtual Int32 store_velocities (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            const Vector *Values,
+            const Boolean *Valid = 0);
+
          // ObjectModuleBasic Interface
          Boolean immediate_release_global_object_observer (ObjectObserver &observer);
 
@@ -564,10 +689,260 @@ namespace dmz {
             }
          };
 
+         template <class T> struct ColumnStruct {
+
+            const Handle AttributeHandle;
+            Int32 size;
+            Int32 count;
+            T *values;
+            Boolean *present;
+
+            Int32 dirtySize;
+            Boolean *dirty;
+            T *startValues;
+            Boolean *startPresent;
+            Int32 dirtyListSize;
+            Int32 dirtyCount;
+            Int32 *dirtyList;
+
+            ColumnStruct (const Handle TheAttributeHandle) :
+                  AttributeHandle (TheAttributeHandle),
+                  size (0),
+                  count (0),
+                  values (0),
+                  present (0),
+                  dirtySize (0),
+                  dirty (0),
+                  startValues (0),
+                  startPresent (0),
+                  dirtyListSize (0),
+                  dirtyCount (0),
+                  dirtyList (0) {;}
+
+            ~ColumnStruct () {
+
+               if (values) { delete []values; values = 0; }
+               if (present) { delete []present; present = 0; }
+               if (dirty) { delete []dirty; dirty = 0; }
+               if (startValues) { delete []startValues; startValues = 0; }
+               if (startPresent) { delete []startPresent; startPresent = 0; }
+               if (dirtyList) { delete []dirtyList; dirtyList = 0; }
+            }
+
+            Boolean is_dirty (const Int32 Slot) const {
+
+               return (Slot < dirtySize) && dirty[Slot];
+            }
+
+            void mark_dirty (
+                  const Int32 Slot,
+                  const T &StartValue,
+                  const Boolean StartPresent) {
+
+               if (!is_dirty (Slot)) {
+
+                  if (Slot >= dirtySize) { grow_dirty (size > Slot ? size : Slot + 1); }
+
+                  if (dirtyCount >= dirtyListSize) {
+
+                     const Int32 NewSize (dirtyListSize > 0 ? dirtyListSize * 2 : 64);
+                     Int32 *newList (new Int32[NewSize]);
+
+                     for (Int32 ix = 0; ix < dirtyCount; ix++) {
+
+                        newList[ix] = dirtyList[ix];
+                     }
+
+                     if (dirtyList) { delete []dirtyList; }
+                     dirtyList = newList;
+                     dirtyListSize = NewSize;
+                  }
+
+                  dirty[Slot] = True;
+                  startValues[Slot] = StartValue;
+                  startPresent[Slot] = StartPresent;
+                  dirtyList[dirtyCount] = Slot;
+                  dirtyCount++;
+               }
+            }
+
+            void grow_dirty (const Int32 MinSize) {
+
+               Boolean *newDirty (new Boolean[MinSize]);
+               T *newStartValues (new T[MinSize]);
+               Boolean *newStartPresent (new Boolean[MinSize]);
+
+               for (Int32 ix = 0; ix < MinSize; ix++) {
+
+                  if (ix < dirtySize) {
+
+                     newDirty[ix] = dirty[ix];
+                     newStartValues[ix] = startValues[ix];
+                     newStartPresent[ix] = startPresent[ix];
+                  }
+                  else { newDirty[ix] = newStartPresent[ix] = False; }
+               }
+
+               if (dirty) { delete []dirty; }
+               if (startValues) { delete []startValues; }
+               if (startPresent) { delete []startPresent; }
+
+               dirty = newDirty;
+               startValues = newStartValues;
+               startPresent = newStartPresent;
+               dirtySize = MinSize;
+            }
+
+            T *lookup (const Int32 Slot) {
+
+               return ((Slot < size) && present[Slot]) ? &(values[Slot]) : 0;
+            }
+
+            T *store (const Int32 Slot, const T &Value) {
+
+               if (Slot >= size) { grow (Slot + 1); }
+
+               if (!present[Slot]) { present[Slot] = True; count++; }
+
+               values[Slot] = Value;
+
+               return &(values[Slot]);
+            }
+
+            Boolean remove (const Int32 Slot) {
+
+               Boolean result (False);
+
+               if ((Slot < size) && present[Slot]) {
+
+                  present[Slot] = False;
+                  values[Slot] = T ();
+                  count--;
+                  result = True;
+               }
+
+               if (is_dirty (Slot)) { dirty[Slot] = False; }
+
+               return result;
+            }
+
+            void grow (const Int32 MinSize) {
+
+               Int32 newSize (size > 0 ? size : 64);
+
+               while (newSize < MinSize) { newSize *= 2; }
+
+               T *newValues (new T[newSize]);
+               Boolean *newPresent (new Boolean[newSize]);
+
+               for (Int32 ix = 0; ix < newSize; ix++) {
+
+                  if (ix < size) {
+
+                     newValues[ix] = values[ix];
+                     newPresent[ix] = present[ix];
+                  }
+                  else { newPresent[ix] = False; }
+               }
+
+               if (values) { delete []values; }
+               if (present) { delete []present; }
+
+               values = newValues;
+               present = newPresent;
+               size = newSize;
+            }
+         };
+
+         template <class T> struct ColumnTableStruct {
+
+            HashTableHandleTemplate<ColumnStruct<T> > table;
+            ColumnStruct<T> *cache;
+
+            ColumnTableStruct () : cache (0) {;}
+            ~ColumnTableStruct () { cache = 0; table.empty (); }
+
+            ColumnStruct<T> *lookup_column (const Handle AttributeHandle) {
+
+               if (!cache || (cache->AttributeHandle != AttributeHandle)) {
+
+                  ColumnStruct<T> *column (table.lookup (AttributeHandle));
+
+                  if (column) { cache = column; }
+                  else { return 0; }
+               }
+
+               return cache;
+            }
+
+            T *lookup (const Handle AttributeHandle, const Int32 Slot) {
+
+               ColumnStruct<T> *column (lookup_column (AttributeHandle));
+
+               return column ? column->lookup (Slot) : 0;
+            }
+
+            T *store (const Handle AttributeHandle, const Int32 Slot, const T &Value) {
+
+               ColumnStruct<T> *column (lookup_column (AttributeHandle));
+
+               if (!column) {
+
+                  column = new ColumnStruct<T> (AttributeHandle);
+
+                  if (!table.store (AttributeHandle, column)) { delete column; column = 0; }
+               }
+
+               return column ? column->store (Slot, Value) : 0;
+            }
+
+            Boolean remove (const Handle AttributeHandle, const Int32 Slot) {
+
+               ColumnStruct<T> *column (lookup_column (AttributeHandle));
+
+               return column ? column->remove (Slot) : False;
+            }
+
+            void mark_dirty (
+                  const Handle AttributeHandle,
+                  const Int32 Slot,
+                  const T &StartValue,
+                  const Boolean StartPresent) {
+
+               ColumnStruct<T> *column (lookup_column (AttributeHandle));
+
+               if (column) { column->mark_dirty (Slot, StartValue, StartPresent); }
+            }
+
+            void remove_slot (const Int32 Slot) {
+
+               HashTableHandleIterator it;
+               ColumnStruct<T> *column (0);
+
+               while (table.get_next (it, column)) { column->remove (Slot); }
+            }
+
+            void copy_slot (const Int32 FromSlot, const Int32 ToSlot) {
+
+               HashTableHandleIterator it;
+               ColumnStruct<T> *column (0);
+
+               while (table.get_next (it, column)) {
+
+                  T *ptr (column->lookup (FromSlot));
+
+                  if (ptr) { const T Value (*ptr); column->store (ToSlot, Value); }
+                  else { column->remove (ToSlot); }
+               }
+            }
+         };
+
          struct ObjectStruct {
 
             ObjectStruct *next;
 
+            const Int32 Slot;
+
             Handle handle;
 
             UUID uuid;
@@ -589,27 +964,12 @@ namespace dmz {
 
             HashTableHandleTemplate<CounterStruct> counterTable;
             HashTableHandleTemplate<ObjectType> altTypeTable;
-            HashTableHandleTemplate<Mask> stateTable;
-            HashTableHandleTemplate<Boolean> flagTable;
-            HashTableHandleTemplate<Float64> timeStampTable;
-            HashTableHandleTemplate<Vector> positionTable;
-            HashTableHandleTemplate<Matrix> orientationTable;
-            HashTableHandleTemplate<Vector> velocityTable;
-            HashTableHandleTemplate<Vector> accelerationTable;
-            HashTableHandleTemplate<Vector> scaleTable;
-            HashTableHandleTemplate<Vector> vectorTable;
-            HashTableHandleTemplate<Float64> scalarTable;
             HashTableHandleTemplate<String> textTable;
             HashTableHandleTemplate<Data> dataTable;
 
-            Handle get_handle (const String &TypeName, RuntimeContext *context) {
-
-               if (!handlePtr) {
+            Handle get_handle (RuntimeContext *context) {
 
-                  String name (TypeName ? TypeName + "." : "UnknownType.");
-
-                  handlePtr = new RuntimeHandle (name + "EntityObject", context);
-               }
+               if (!handlePtr) { handlePtr = new RuntimeHandle (context); }
 
                if (handlePtr) { handle = handlePtr->get_runtime_handle (); }
                else { handle = 0; }
@@ -633,16 +993,6 @@ namespace dmz {
                linkTable.clear ();
                counterTable.empty ();
                altTypeTable.empty ();
-               stateTable.empty ();
-               flagTable.empty ();
-               timeStampTable.empty ();
-               positionTable.empty ();
-               orientationTable.empty ();
-               velocityTable.empty ();
-               accelerationTable.empty ();
-               scaleTable.empty ();
-               vectorTable.empty ();
-               scalarTable.empty ();
                textTable.empty ();
                dataTable.empty ();
             }
@@ -651,9 +1001,6 @@ namespace dmz {
 
                ObjectStruct *result (obj);
 
-               if (!result) { result = new ObjectStruct; }
-               else { result->reset (); }
-
                if (result) {
 
                   result->active = False;
@@ -673,16 +1020,6 @@ namespace dmz {
 
                   result->counterTable.copy (counterTable);
                   result->altTypeTable.copy (altTypeTable);
-                  result->stateTable.copy (stateTable);
-                  result->flagTable.copy (flagTable);
-                  result->timeStampTable.copy (timeStampTable);
-                  result->positionTable.copy (positionTable);
-                  result->orientationTable.copy (orientationTable);
-                  result->velocityTable.copy (velocityTable);
-                  result->accelerationTable.copy (accelerationTable);
-                  result->scaleTable.copy (scaleTable);
-                  result->vectorTable.copy (vectorTable);
-                  result->scalarTable.copy (scalarTable);
                   result->textTable.copy (textTable);
                   result->dataTable.copy (dataTable);
                }
@@ -690,8 +1027,9 @@ namespace dmz {
                return result;
             }
 
-            ObjectStruct () :
+            ObjectStruct (const Int32 TheSlot) :
                   next (0),
+                  Slot (TheSlot),
                   handle (0),
                   handlePtr (0),
                   active (False),
@@ -722,7 +1060,96 @@ namespace dmz {
             ~SubscriptionStruct () { table.empty (); }
          };
 
+         template <class T> struct BatchUpdateStruct {
+
+            ObjectStruct *obj;
+            Handle objectHandle;
+            Int32 index;
+            T prevValue;
+            Boolean prevValueExists;
+
+            BatchUpdateStruct () :
+                  obj (0),
+                  objectHandle (0),
+                  index (0),
+                  prevValueExists (False) {;}
+         };
+
+         // Scratch list reused by each batch store so the hot path does not allocate.
+         template <class T> struct BatchListStruct {
+
+            BatchUpdateStruct<T> *list;
+            Int32 size;
+
+            BatchListStruct () : list (0), size (0) {;}
+            ~BatchListStruct () { if (list) { delete []list; list = 0; } }
+
+            BatchUpdateStruct<T> *get_list (const Int32 Count) {
+
+               if (Count > size) {
+
+                  Int32 newSize (size > 0 ? size : 64);
+
+                  while (newSize < Count) { newSize *= 2; }
+
+                  if (list) { delete []list; list = 0; }
+                  list = new BatchUpdateStruct<T>[newSize];
+                  size = list ? newSize : 0;
+               }
+
+               return list;
+            }
+         };
+
+         template <class T> Int32 _lookup_batch (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            ColumnTableStruct<T> &columns,
+            T *values,
+            Boolean *found);
+
+         template <class T> Int32 _store_batch (
+            const HandleContainer &Objects,
+            const Handle AttributeHandle,
+            const T *Values,
+            const Boolean *Valid,
+            ColumnTableStruct<T> &columns,
+            BatchListStruct<T> &batch,
+            HashTableHandleTemplate<ObjectObserverStruct> &obsTable,
+            Boolean (ObjectModuleBasic::*storeFunc) (
+               const Handle,
+               const Handle,
+               const T &),
+            void (ObjectObserver::*updateFunc) (
+               const UUID &,
+               const Handle,
+               const Handle,
+               const T &,
+               const T *));
+
+         template <class T, class UpdateFunc> void _flush_column_slot (
+            ColumnStruct<T> &column,
+            const Int32 Slot,
+            HashTableHandleTemplate<ObjectObserverStruct> &obsTable,
+            UpdateFunc updateFunc);
+
+         template <class T, class UpdateFunc> void _flush_columns (
+            ColumnTableStruct<T> &columns,
+            HashTableHandleTemplate<ObjectObserverStruct> &obsTable,
+            UpdateFunc updateFunc);
+
+         template <class T, class UpdateFunc> void _flush_object_columns (
+            const Int32 Slot,
+            ColumnTableStruct<T> &columns,
+            HashTableHandleTemplate<ObjectObserverStruct> &obsTable,
+            UpdateFunc updateFunc);
+
+         void _flush_coalesced_updates ();
+         void _flush_object_updates (const ObjectStruct &Obj);
+
          ObjectStruct *_lookup_object (const Handle ObjectHandle);
+         ObjectStruct *_get_object_struct ();
+         void _recycle_object_struct (ObjectStruct *obj);
 
          void _unlink_table (const LinkTable &Table);
 
@@ -754,16 +1181,42 @@ namespace dmz {
 
          void _add_observer_update (ObsUpdateStruct *ptr);
          void _update_observers ();
+         void _release_observer_updates ();
+         void _send_update_stats ();
+
+         void _init (Config &local);
 
          Log _log;
 
+         Boolean _coalesceUpdates;
          Boolean _inObsUpdate;
          Boolean _inStoredObsUpdate;
          ObsUpdateStruct *_obsUpdateList;
          ObsUpdateStruct *_obsUpdateListTail;
+         ObsUpdatePoolStruct _obsUpdatePool;
+         Int32 _queuedUpdates;
+         Int32 _queueDepth;
+         Int32 _peakQueueDepth;
 
          ObjectStruct *_objectCache;
          ObjectStruct *_recycleList;
+         Int32 _nextSlot;
+         Int32 _slotTableSize;
+         ObjectStruct **_slotTable;
+
+         ColumnTableStruct<Mask> _stateColumns;
+         ColumnTableStruct<Boolean> _flagColumns;
+         ColumnTableStruct<Float64> _timeStampColumns;
+         ColumnTableStruct<Vector> _positionColumns;
+         ColumnTableStruct<Matrix> _orientationColumns;
+         ColumnTableStruct<Vector> _velocityColumns;
+         ColumnTableStruct<Vector> _accelerationColumns;
+         ColumnTableStruct<Vector> _scaleColumns;
+         ColumnTableStruct<Vector> _vectorColumns;
+         ColumnTableStruct<Float64> _scalarColumns;
+
+         BatchListStruct<Vector> _vectorBatch;
+         BatchListStruct<Matrix> _matrixBatch;
 
          Int32 _globalCount;
          HashTableHandleTemplate<ObjectObserver> _globalTable;
@@ -802,6 +1255,10 @@ namespace dmz {
          DataConverterHandle _handleConverter;
          Message _createObjMsg;
          Message _removeObjMsg;
+         Message _updateStatsMsg;
+         Handle _queuedUpdatesHandle;
+         Handle _peakQueueDepthHandle;
+         Handle _poolSizeHandle;
 
          Handle _defaultHandle;
          //! \endcond
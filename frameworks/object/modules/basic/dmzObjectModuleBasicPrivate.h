@@ -295,7 +295,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Int64 Value;
-      const Int64 *PrevValue;
+      const Int64 PrevValue;
+      const Boolean PrevValueExists;
 
       UpdateCounterStruct (
             const CounterStructEnum TheType,
@@ -309,12 +310,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Int64 (*ThePrevValue) : 0) {;}
-
-      virtual ~UpdateCounterStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Int64 ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -325,7 +322,7 @@ namespace {
                ObjectHandle,
                AttributeHandle,
                Value,
-               PrevValue);
+               PrevValueExists ? &PrevValue : 0);
          }
          else if (Type == CounterMin) {
 
@@ -334,7 +331,7 @@ namespace {
                ObjectHandle,
                AttributeHandle,
                Value,
-               PrevValue);
+               PrevValueExists ? &PrevValue : 0);
          }
          else if (Type == CounterMax) {
 
@@ -343,7 +340,7 @@ namespace {
                ObjectHandle,
                AttributeHandle,
                Value,
-               PrevValue);
+               PrevValueExists ? &PrevValue : 0);
          }
       }
    };
@@ -354,7 +351,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const ObjectType Value;
-      const ObjectType *PrevValue;
+      const ObjectType PrevValue;
+      const Boolean PrevValueExists;
 
       AltObjectTypeStruct (
             const UUID &TheIdentity,
@@ -366,12 +364,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new ObjectType (*ThePrevValue) : 0) {;}
-
-      virtual ~AltObjectTypeStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : ObjectType ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -380,7 +374,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -390,7 +384,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Mask Value;
-      const Mask *PrevValue;
+      const Mask PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectStateStruct (
             const UUID &TheIdentity,
@@ -402,12 +397,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Mask (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectStateStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Mask ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -416,7 +407,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -426,7 +417,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Boolean Value;
-      const Boolean *PrevValue;
+      const Boolean PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectFlagStruct (
             const UUID &TheIdentity,
@@ -438,12 +430,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Boolean (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectFlagStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Boolean ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -452,7 +440,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -462,7 +450,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Float64 Value;
-      const Float64 *PrevValue;
+      const Float64 PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectTimeStampStruct (
             const UUID &TheIdentity,
@@ -474,12 +463,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Float64 (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectTimeStampStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Float64 ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -488,7 +473,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -498,7 +483,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Vector Value;
-      const Vector *PrevValue;
+      const Vector PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectPositionStruct (
             const UUID &TheIdentity,
@@ -510,12 +496,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Vector (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectPositionStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Vector ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -524,7 +506,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -534,7 +516,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Matrix Value;
-      const Matrix *PrevValue;
+      const Matrix PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectOrientationStruct (
             const UUID &TheIdentity,
@@ -546,12 +529,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Matrix (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectOrientationStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Matrix ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -560,7 +539,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -570,7 +549,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Vector Value;
-      const Vector *PrevValue;
+      const Vector PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectVelocityStruct (
             const UUID &TheIdentity,
@@ -582,12 +562,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Vector (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectVelocityStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Vector ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -596,7 +572,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -606,7 +582,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Vector Value;
-      const Vector *PrevValue;
+      const Vector PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectAccelerationStruct (
             const UUID &TheIdentity,
@@ -618,12 +595,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Vector (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectAccelerationStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Vector ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -632,7 +605,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -642,7 +615,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Vector Value;
-      const Vector *PrevValue;
+      const Vector PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectScaleStruct (
             const UUID &TheIdentity,
@@ -654,12 +628,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Vector (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectScaleStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Vector ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -668,7 +638,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -678,7 +648,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Vector Value;
-      const Vector *PrevValue;
+      const Vector PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectVectorStruct (
             const UUID &TheIdentity,
@@ -690,12 +661,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Vector (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectVectorStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Vector ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -704,7 +671,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -714,7 +681,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Float64 Value;
-      const Float64 *PrevValue;
+      const Float64 PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectScalarStruct (
             const UUID &TheIdentity,
@@ -726,12 +694,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Float64 (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectScalarStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Float64 ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -740,7 +704,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -750,7 +714,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const String Value;
-      const String *PrevValue;
+      const String PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectTextStruct (
             const UUID &TheIdentity,
@@ -762,12 +727,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new String (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectTextStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : String ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -776,7 +737,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 
@@ -786,7 +747,8 @@ namespace {
       const Handle ObjectHandle;
       const Handle AttributeHandle;
       const Data Value;
-      const Data *PrevValue;
+      const Data PrevValue;
+      const Boolean PrevValueExists;
 
       ObjectDataStruct (
             const UUID &TheIdentity,
@@ -798,12 +760,8 @@ namespace {
             ObjectHandle (TheObjectHandle),
             AttributeHandle (TheAttributeHandle),
             Value (TheValue),
-            PrevValue (ThePrevValue ? new Data (*ThePrevValue) : 0) {;}
-
-      virtual ~ObjectDataStruct () {
-
-         if (PrevValue) { delete PrevValue; PrevValue = 0; }
-      }
+            PrevValue (ThePrevValue ? *ThePrevValue : Data ()),
+            PrevValueExists (ThePrevValue != 0) {;}
 
       virtual void update (ObjectModuleBasic &module) {
 
@@ -812,7 +770,7 @@ namespace {
             ObjectHandle,
             AttributeHandle,
             Value,
-            PrevValue);
+            PrevValueExists ? &PrevValue : 0);
       }
    };
 }
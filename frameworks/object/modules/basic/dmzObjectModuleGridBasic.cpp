@@ -232,111 +232,49 @@ dmz::ObjectModuleGridBasic::find_objects (
       const Volume &SearchSpace,
       HandleContainer &objects,
       const ObjectTypeSet *IncludeTypes,
-      const ObjectTypeSet *ExcludeTypes) {
+      const ObjectTypeSet *ExcludeTypes,
+      const Boolean Sorted) {
 
    Vector origin, min, max;
    SearchSpace.get_extents (origin, min, max);
-   Int32 minX = 0, minY = 0, maxX = 0, maxY = 0;
-   _map_point_to_coord (min, minX, minY);
-   _map_point_to_coord (max, maxX, maxY);
-
-   ObjectStruct *list (0);
-
-//   HandleContainer found;
-
-   for (Int32 ix = minX; ix <= maxX; ix++) {
-
-      for (Int32 jy = minY; jy <= maxY; jy++) {
-
-         HashTableHandleIterator it;
-         GridStruct *cell = &(_grid[_map_coord (ix, jy)]);
-         ObjectStruct *current = cell->objTable.get_first (it);
-
-         while (current) {
-
-            Boolean test (True);
-
-            if (IncludeTypes && !IncludeTypes->contains_type (current->Type)) {
-
-               test = False;
-            }
-            else if (ExcludeTypes && ExcludeTypes->contains_type (current->Type)) {
-
-               test = False;
-            }
-
-            if (test && SearchSpace.contains_point (current->pos)) {
 
-#if 0
-if (!found.add_handle (current->Object)) {
+   _hits.reset ();
+   _find_objects (&SearchSpace, origin, 0.0, min, max, IncludeTypes, ExcludeTypes);
 
-_log.error << "origin: " << origin << endl
-   << "minX: " << minX << endl
-   << "minY: " << minY << endl
-   << "maxX: " << maxX << endl
-   << "maxY: " << maxY << endl;
+   if (Sorted) { _hits.sort (); }
 
-
-HandleContainer cc;
-   for (Int32 xx = minX; xx <= maxX; xx++) {
-
-      for (Int32 yy = minY; yy <= maxY; yy++) {
-Boolean s = cc.add_handle ((Handle)_map_coord (xx, yy));
-_log.error << (s ? "" : "##### NOT UNIQUE ") << xx << " " << yy << " = " << _map_coord (xx, yy) << endl;
-      }
-   }
+   _hits.get_handles (objects);
+   _hits.reset ();
 }
-#endif // 0
-
-               current->distanceSquared = (origin - current->pos).magnitude_squared ();
-
-               current->next = 0;
-
-               if (!list) { list = current; }
-               else {
-
-                  ObjectStruct *p = 0, *c = list;
 
-                  Boolean done (False);
 
-                  while (!done) {
-
-                     if (c->distanceSquared > current->distanceSquared) {
-
-                        if (!c->next) { c->next = current; done = True; }
-                        else {
-
-                           p = c; c = c->next;
-
-                           if (!c) { p->next = current; done = True; }
-                        }
-                     }
-                     else {
-
-                        if (p) { p->next = current; }
-                        else { list = current; }
+void
+dmz::ObjectModuleGridBasic::find_nearest_objects (
+      const Vector &Origin,
+      const Int32 Count,
+      const Float64 Radius,
+      HandleContainer &objects,
+      const ObjectTypeSet *IncludeTypes,
+      const ObjectTypeSet *ExcludeTypes) {
 
-                        current->next = c;
-                        done = True;
-                     }
-                  }
-               }
-            }
+   if ((Count > 0) && (Radius >= 0.0)) {
 
-            current = cell->objTable.get_next (it);
-         }
-      }
-   }
+      const Vector Offset (Radius, Radius, Radius);
 
-   while (list) {
+      _hits.reset (Count);
 
-      if (!objects.add (list->Object)) {
+      _find_objects (
+         0,
+         Origin,
+         Radius * Radius,
+         Origin - Offset,
+         Origin + Offset,
+         IncludeTypes,
+         ExcludeTypes);
 
-         _log.error << "Loop detected in object list for object: " << list->Object
-            << endl;
-         list = 0;
-      }
-      else { list = list->next; }
+      _hits.sort ();
+      _hits.get_handles (objects);
+      _hits.reset ();
    }
 }
 
@@ -472,6 +410,59 @@ dmz::ObjectModuleGridBasic::_remove_object_from_grid (ObjectStruct &obj) {
 }
 
 
+// Collects hits inside SearchSpace or, if it is NULL, within the radius of Origin.
+void
+dmz::ObjectModuleGridBasic::_find_objects (
+      const Volume *SearchSpace,
+      const Vector &Origin,
+      const Float64 RadiusSquared,
+      const Vector &Min,
+      const Vector &Max,
+      const ObjectTypeSet *IncludeTypes,
+      const ObjectTypeSet *ExcludeTypes) {
+
+   Int32 minX = 0, minY = 0, maxX = 0, maxY = 0;
+   _map_point_to_coord (Min, minX, minY);
+   _map_point_to_coord (Max, maxX, maxY);
+
+   for (Int32 ix = minX; ix <= maxX; ix++) {
+
+      for (Int32 jy = minY; jy <= maxY; jy++) {
+
+         HashTableHandleIterator it;
+         GridStruct *cell = &(_grid[_map_coord (ix, jy)]);
+         ObjectStruct *current (0);
+
+         while (cell->objTable.get_next (it, current)) {
+
+            Boolean test (True);
+
+            if (IncludeTypes && !IncludeTypes->contains_type (current->Type)) {
+
+               test = False;
+            }
+            else if (ExcludeTypes && ExcludeTypes->contains_type (current->Type)) {
+
+               test = False;
+            }
+
+            if (test) {
+
+               const Float64 Distance ((Origin - current->pos).magnitude_squared ());
+
+               if (SearchSpace ?
+                     SearchSpace->contains_point (current->pos) :
+                     (Distance <= RadiusSquared)) {
+
+                  _hits.add (current->Object, Distance);
+               }
+            }
+         }
+      }
+   }
+}
+
+
 void
 dmz::ObjectModuleGridBasic::_update_observer (
       const Volume &SearchSpace,
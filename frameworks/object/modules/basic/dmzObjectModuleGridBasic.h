@@ -2,6 +2,7 @@
 #define DMZ_OBJECT_MODULE_GRID_BASIC_DOT_H
 
 #include <dmzObjectModuleGrid.h>
+#include "dmzObjectModuleGridHitList.h"
 #include <dmzObjectObserverGrid.h>
 #include <dmzObjectObserverUtil.h>
 #include <dmzRuntimeLog.h>
@@ -41,6 +42,15 @@ namespace dmz {
             const Volume &SearchSpace,
             HandleContainer &objects,
             const ObjectTypeSet *IncludeTypes,
+            const ObjectTypeSet *ExcludeTypes,
+            const Boolean Sorted);
+
+         virtual void find_nearest_objects (
+            const Vector &Origin,
+            const Int32 Count,
+            const Float64 Radius,
+            HandleContainer &objects,
+            const ObjectTypeSet *IncludeTypes,
             const ObjectTypeSet *ExcludeTypes);
 
          // Object Observer Interface
@@ -68,15 +78,10 @@ namespace dmz {
 
             Int32 place;
 
-            Float64 distanceSquared;
-            ObjectStruct *next;
-
             ObjectStruct (const Handle TheObject, const ObjectType &TheType) :
                   Object (TheObject),
                   Type (TheType),
-                  place (-1),
-                  distanceSquared (0.0),
-                  next (0) {;}
+                  place (-1) {;}
          };
 
          struct ObserverStruct {
@@ -111,6 +116,15 @@ namespace dmz {
          Int32 _map_point (const Vector &Point);
          void _remove_object_from_grid (ObjectStruct &obj);
 
+         void _find_objects (
+            const Volume *SearchSpace,
+            const Vector &Origin,
+            const Float64 RadiusSquared,
+            const Vector &Min,
+            const Vector &Max,
+            const ObjectTypeSet *IncludeTypes,
+            const ObjectTypeSet *ExcludeTypes);
+
          void _update_observer (
             const Volume &SearchSpace,
             const ObjectStruct &Obj,
@@ -135,6 +149,7 @@ namespace dmz {
          HashTableHandleTemplate<ObserverStruct> _obsTable;
 
          GridStruct *_grid;
+         ObjectModuleGridHitList _hits;
          //! \endcond
 
       private:
@@ -0,0 +1,210 @@
+#ifndef DMZ_OBJECT_MODULE_GRID_HIT_LIST_DOT_H
+#define DMZ_OBJECT_MODULE_GRID_HIT_LIST_DOT_H
+
+#include <dmzTypesBase.h>
+#include <dmzTypesHandleContainer.h>
+
+//! \cond
+namespace dmz {
+
+   class ObjectModuleGridHitList {
+
+      public:
+         ObjectModuleGridHitList ();
+         ~ObjectModuleGridHitList ();
+
+         void reset (const Int32 Limit = 0);
+         Int32 get_count () const;
+         Boolean is_full () const;
+         Float64 get_max_distance_squared () const;
+
+         void add (const Handle Object, const Float64 DistanceSquared);
+         void sort ();
+         void get_handles (HandleContainer &objects) const;
+
+      protected:
+         struct HitStruct {
+
+            Handle object;
+            Float64 distanceSquared;
+         };
+
+         void _grow ();
+         void _swap (const Int32 A, const Int32 B);
+         void _sift_up (const Int32 Start);
+         void _sift_down (const Int32 Start, const Int32 Count);
+
+         HitStruct *_list;
+         Int32 _size;
+         Int32 _count;
+         Int32 _limit;
+
+      private:
+         ObjectModuleGridHitList (const ObjectModuleGridHitList &);
+         ObjectModuleGridHitList &operator= (const ObjectModuleGridHitList &);
+   };
+};
+
+
+inline
+dmz::ObjectModuleGridHitList::ObjectModuleGridHitList () :
+      _list (0),
+      _size (0),
+      _count (0),
+      _limit (0) {;}
+
+
+inline
+dmz::ObjectModuleGridHitList::~ObjectModuleGridHitList () {
+
+   if (_list) { delete []_list; _list = 0; }
+}
+
+
+// A positive Limit keeps only the Limit nearest hits in a bounded max heap.
+inline void
+dmz::ObjectModuleGridHitList::reset (const Int32 Limit) {
+
+   _count = 0;
+   _limit = Limit > 0 ? Limit : 0;
+}
+
+
+inline dmz::Int32
+dmz::ObjectModuleGridHitList::get_count () const { return _count; }
+
+
+inline dmz::Boolean
+dmz::ObjectModuleGridHitList::is_full () const {
+
+   return (_limit > 0) && (_count >= _limit);
+}
+
+
+// Only meaningful once the bounded heap is full. The root holds the farthest hit.
+inline dmz::Float64
+dmz::ObjectModuleGridHitList::get_max_distance_squared () const {
+
+   return _count > 0 ? _list[0].distanceSquared : 0.0;
+}
+
+
+inline void
+dmz::ObjectModuleGridHitList::add (const Handle Object, const Float64 DistanceSquared) {
+
+   if (!_limit || (_count < _limit)) {
+
+      if (_count >= _size) { _grow (); }
+
+      _list[_count].object = Object;
+      _list[_count].distanceSquared = DistanceSquared;
+      _count++;
+
+      if (_limit) { _sift_up (_count - 1); }
+   }
+   else if (DistanceSquared < _list[0].distanceSquared) {
+
+      _list[0].object = Object;
+      _list[0].distanceSquared = DistanceSquared;
+      _sift_down (0, _count);
+   }
+}
+
+
+// Heap sort so the nearest hit is first.
+inline void
+dmz::ObjectModuleGridHitList::sort () {
+
+   if (!_limit) {
+
+      for (Int32 ix = (_count / 2) - 1; ix >= 0; ix--) { _sift_down (ix, _count); }
+   }
+
+   for (Int32 ix = _count - 1; ix > 0; ix--) {
+
+      _swap (0, ix);
+      _sift_down (0, ix);
+   }
+}
+
+
+inline void
+dmz::ObjectModuleGridHitList::get_handles (HandleContainer &objects) const {
+
+   for (Int32 ix = 0; ix < _count; ix++) { objects.add (_list[ix].object); }
+}
+
+
+inline void
+dmz::ObjectModuleGridHitList::_grow () {
+
+   const Int32 Size (_size < 64 ? 64 : _size * 2);
+   HitStruct *list = new HitStruct[Size];
+
+   for (Int32 ix = 0; ix < _count; ix++) { list[ix] = _list[ix]; }
+
+   if (_list) { delete []_list; }
+   _list = list;
+   _size = Size;
+}
+
+
+inline void
+dmz::ObjectModuleGridHitList::_swap (const Int32 A, const Int32 B) {
+
+   const HitStruct Tmp (_list[A]);
+   _list[A] = _list[B];
+   _list[B] = Tmp;
+}
+
+
+inline void
+dmz::ObjectModuleGridHitList::_sift_up (const Int32 Start) {
+
+   Int32 child (Start);
+
+   while (child > 0) {
+
+      const Int32 Parent ((child - 1) / 2);
+
+      if (_list[Parent].distanceSquared < _list[child].distanceSquared) {
+
+         _swap (Parent, child);
+         child = Parent;
+      }
+      else { child = 0; }
+   }
+}
+
+
+inline void
+dmz::ObjectModuleGridHitList::_sift_down (const Int32 Start, const Int32 Count) {
+
+   Int32 parent (Start);
+   Boolean done (False);
+
+   while (!done) {
+
+      Int32 largest (parent);
+      const Int32 Left ((parent * 2) + 1);
+      const Int32 Right (Left + 1);
+
+      if ((Left < Count) &&
+            (_list[Left].distanceSquared > _list[largest].distanceSquared)) {
+
+         largest = Left;
+      }
+
+      if ((Right < Count) &&
+            (_list[Right].distanceSquared > _list[largest].distanceSquared)) {
+
+         largest = Right;
+      }
+
+      if (largest != parent) { _swap (parent, largest); parent = largest; }
+      else { done = True; }
+   }
+}
+//! \endcond
+
+#endif // DMZ_OBJECT_MODULE_GRID_HIT_LIST_DOT_H
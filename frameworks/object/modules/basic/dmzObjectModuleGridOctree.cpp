@@ -0,0 +1,1007 @@
+#include <dmzObjectAttributeMasks.h>
+#include "dmzObjectModuleGridOctree.h"
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzTypesVolume.h>
+
+#include <math.h>
+
+/*!
+
+\class dmz::ObjectModuleGridOctree
+\ingroup Object
+\brief Adaptive three dimensional ObjectModuleGrid implementation.
+\details Space is divided into cubic root cells that are stored in a hash table so
+that the grid has no fixed world bounds. Only root cells that contain objects are
+allocated. A root cell is the top of an octree. A leaf node that holds more than
+the node limit of objects is split into eight children. A node whose subtree falls
+to half the node limit or less is merged back into a single leaf. Dense areas are
+subdivided while sparse areas use a few large nodes. All three axes are used so
+airborne objects above a ground cluster are not placed in the same cell.
+\code
+<dmz>
+<dmzObjectModuleGridOctree>
+   <root size="Edge length of a root cell. Defaults to 1024"/>
+   <node limit="Objects in a leaf before it is split. Defaults to 16"
+      depth="Maximum depth of a root cell octree. Defaults to 8"/>
+</dmzObjectModuleGridOctree>
+</dmz>
+\endcode
+
+*/
+
+//! \cond
+static const dmz::Int32 LocalCoordLimit = 0x00100000;
+static const dmz::UInt64 LocalCoordMask = 0x001FFFFF;
+static const dmz::UInt64 LocalKeyFlag = 0x8000000000000000ULL;
+
+static inline dmz::Int32
+local_child_index (const dmz::Vector &Center, const dmz::Vector &Point) {
+
+   return (Point.get_x () >= Center.get_x () ? 1 : 0) |
+      (Point.get_y () >= Center.get_y () ? 2 : 0) |
+      (Point.get_z () >= Center.get_z () ? 4 : 0);
+}
+
+
+static inline dmz::Float64
+local_distance_squared (
+      const dmz::Vector &Min,
+      const dmz::Vector &Max,
+      const dmz::Vector &Point) {
+
+   dmz::Float64 result (0.0);
+
+   for (dmz::Int32 ix = 0; ix < 3; ix++) {
+
+      const dmz::VectorComponentEnum Axis = (dmz::VectorComponentEnum)ix;
+      const dmz::Float64 Value (Point.get (Axis));
+      dmz::Float64 offset (0.0);
+
+      if (Value < Min.get (Axis)) { offset = Min.get (Axis) - Value; }
+      else if (Value > Max.get (Axis)) { offset = Value - Max.get (Axis); }
+
+      result += offset * offset;
+   }
+
+   return result;
+}
+
+
+static inline dmz::Boolean
+local_overlaps (
+      const dmz::Vector &NodeMin,
+      const dmz::Vector &NodeMax,
+      const dmz::Vector &Min,
+      const dmz::Vector &Max) {
+
+   return (NodeMin.get_x () <= Max.get_x ()) && (NodeMax.get_x () >= Min.get_x ()) &&
+      (NodeMin.get_y () <= Max.get_y ()) && (NodeMax.get_y () >= Min.get_y ()) &&
+      (NodeMin.get_z () <= Max.get_z ()) && (NodeMax.get_z () >= Min.get_z ());
+}
+
+
+dmz::ObjectModuleGridOctree::ObjectModuleGridOctree (
+      const PluginInfo &Info,
+      Config &local) :
+      Plugin (Info),
+      ObjectModuleGrid (Info),
+      ObjectObserverUtil (Info, local),
+      _log (Info),
+      _rootSize (1024.0),
+      _nodeLimit (16),
+      _mergeLimit (8),
+      _maxDepth (8) {
+
+   _init (local);
+}
+
+
+dmz::ObjectModuleGridOctree::~ObjectModuleGridOctree () {
+
+   _rootTable.empty ();
+   _objTable.empty ();
+   _obsTable.empty ();
+}
+
+
+// Plugin Interface
+void
+dmz::ObjectModuleGridOctree::update_plugin_state (
+      const PluginStateEnum State,
+      const UInt32 Level) {
+
+   if (State == PluginStateInit) {
+
+   }
+   else if (State == PluginStateStart) {
+
+   }
+   else if (State == PluginStateStop) {
+
+   }
+   else if (State == PluginStateShutdown) {
+
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::discover_plugin (
+      const PluginDiscoverEnum Mode,
+      const Plugin *PluginPtr) {
+
+   if (Mode == PluginDiscoverAdd) {
+
+   }
+   else if (Mode == PluginDiscoverRemove) {
+
+   }
+}
+
+
+// ObjectModuleGrid Interface
+dmz::Boolean
+dmz::ObjectModuleGridOctree::register_object_observer_grid (
+      ObjectObserverGrid &observer) {
+
+   Boolean result (False);
+
+   ObserverStruct *os (_obsTable.lookup (observer.get_object_observer_grid_handle ()));
+
+   if (!os) {
+
+      os = new ObserverStruct (observer);
+
+      if (_obsTable.store (os->ObsHandle, os)) {
+
+         result = update_object_observer_grid (observer);
+      }
+      else { delete os; os = 0; }
+   }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::ObjectModuleGridOctree::update_object_observer_grid (ObjectObserverGrid &observer) {
+
+   Boolean result (False);
+
+   ObserverStruct *os (_obsTable.lookup (observer.get_object_observer_grid_handle ()));
+
+   if (os) {
+
+      const Volume &SearchSpace = os->obs.get_observer_volume ();
+
+      Vector origin, min, max;
+      SearchSpace.get_extents (origin, min, max);
+
+      RangeStruct range;
+      _map_extents (min, max, range);
+
+      Boolean updateExtents (!os->attached);
+
+      for (Int32 ix = 0; ix < 3; ix++) {
+
+         if ((range.min[ix] != os->min[ix]) || (range.max[ix] != os->max[ix])) {
+
+            updateExtents = True;
+         }
+      }
+
+      if (updateExtents) {
+
+         if (os->attached) { _attach_observer (*os, False); }
+
+         for (Int32 ix = 0; ix < 3; ix++) {
+
+            os->min[ix] = range.min[ix];
+            os->max[ix] = range.max[ix];
+         }
+
+         _attach_observer (*os, True);
+      }
+
+      HandleContainer current (os->objects);
+      HandleContainerIterator it;
+      Handle handle (0);
+
+      while (current.get_next (it, handle)) {
+
+         ObjectStruct *obj (_objTable.lookup (handle));
+
+         if (!obj) { os->objects.remove (handle); }
+         else if (!SearchSpace.contains_point (obj->pos) && os->objects.remove (handle)) {
+
+            observer.update_object_grid_state (
+               ObjectGridStateExit,
+               obj->Object,
+               obj->Type,
+               obj->pos);
+         }
+      }
+
+      RootStruct *root (_get_first_root (range));
+
+      while (root) {
+
+         _find_objects (root->node, SearchSpace, origin, min, max, 0, 0, os);
+         root = _get_next_root (range);
+      }
+
+      result = True;
+   }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::ObjectModuleGridOctree::release_object_observer_grid (
+      ObjectObserverGrid &observer) {
+
+   Boolean result (False);
+
+   ObserverStruct *os (_obsTable.remove (observer.get_object_observer_grid_handle ()));
+
+   if (os) {
+
+      if (os->attached) { _attach_observer (*os, False); }
+
+      delete os; os = 0;
+      result = True;
+   }
+
+   return result;
+}
+
+
+void
+dmz::ObjectModuleGridOctree::find_objects (
+      const Volume &SearchSpace,
+      HandleContainer &objects,
+      const ObjectTypeSet *IncludeTypes,
+      const ObjectTypeSet *ExcludeTypes,
+      const Boolean Sorted) {
+
+   Vector origin, min, max;
+   SearchSpace.get_extents (origin, min, max);
+
+   RangeStruct range;
+   _map_extents (min, max, range);
+
+   _hits.reset ();
+
+   RootStruct *root (_get_first_root (range));
+
+   while (root) {
+
+      _find_objects (
+         root->node,
+         SearchSpace,
+         origin,
+         min,
+         max,
+         IncludeTypes,
+         ExcludeTypes,
+         0);
+
+      root = _get_next_root (range);
+   }
+
+   if (Sorted) { _hits.sort (); }
+
+   _hits.get_handles (objects);
+   _hits.reset ();
+}
+
+
+void
+dmz::ObjectModuleGridOctree::find_nearest_objects (
+      const Vector &Origin,
+      const Int32 Count,
+      const Float64 Radius,
+      HandleContainer &objects,
+      const ObjectTypeSet *IncludeTypes,
+      const ObjectTypeSet *ExcludeTypes) {
+
+   if ((Count > 0) && (Radius >= 0.0)) {
+
+      const Vector Offset (Radius, Radius, Radius);
+
+      RangeStruct range;
+      _map_extents (Origin - Offset, Origin + Offset, range);
+
+      _hits.reset (Count);
+
+      RootStruct *root (_get_first_root (range));
+
+      while (root) {
+
+         _find_nearest (root->node, Origin, Radius * Radius, IncludeTypes, ExcludeTypes);
+         root = _get_next_root (range);
+      }
+
+      _hits.sort ();
+      _hits.get_handles (objects);
+      _hits.reset ();
+   }
+}
+
+
+// Object Observer Interface
+void
+dmz::ObjectModuleGridOctree::create_object (
+      const UUID &Identity,
+      const Handle ObjectHandle,
+      const ObjectType &Type,
+      const ObjectLocalityEnum Locality) {
+
+   ObjectStruct *os = new ObjectStruct (ObjectHandle, Type);
+
+   if (!_objTable.store (ObjectHandle, os)) { delete os; os = 0; }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::destroy_object (
+      const UUID &Identity,
+      const Handle ObjectHandle) {
+
+   ObjectStruct *os (_objTable.remove (ObjectHandle));
+
+   if (os) {
+
+      if (os->root) {
+
+         HashTableHandleIterator it;
+         ObserverStruct *obs (0);
+
+         while (os->root->obsTable.get_next (it, obs)) {
+
+            obs->objects.remove (ObjectHandle);
+         }
+
+         _remove_object (*os, os->root, os->node);
+      }
+
+      delete os; os = 0;
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::update_object_position (
+      const UUID &Identity,
+      const Handle ObjectHandle,
+      const Handle AttributeHandle,
+      const Vector &Value,
+      const Vector *PreviousValue) {
+
+   ObjectStruct *current (_objTable.lookup (ObjectHandle));
+
+   if (current) {
+
+      current->pos = Value;
+
+      RootStruct *oldRoot (current->root);
+      NodeStruct *oldNode (current->node);
+
+      RootStruct *root (_lookup_root (Value, True));
+      NodeStruct *node (root ? _lookup_leaf (root->node, Value) : 0);
+
+      if (node && (node != oldNode)) { _insert_object (*current, root, node); }
+
+      if (root && (root != oldRoot) && oldRoot) {
+
+         HandleContainer tested;
+
+         _update_observers (root, *current, &tested);
+         _update_observers (oldRoot, *current, &tested);
+      }
+      else if (root) { _update_observers (root, *current, 0); }
+
+      // Removal happens last since it may free the old root.
+      if (oldNode && (oldNode != current->node)) {
+
+         _remove_object (*current, oldRoot, oldNode);
+      }
+   }
+}
+
+
+dmz::Boolean
+dmz::ObjectModuleGridOctree::_in_range (
+      const Int32 Coord[3],
+      const RangeStruct &Range) const {
+
+   return (Coord[0] >= Range.min[0]) && (Coord[0] <= Range.max[0]) &&
+      (Coord[1] >= Range.min[1]) && (Coord[1] <= Range.max[1]) &&
+      (Coord[2] >= Range.min[2]) && (Coord[2] <= Range.max[2]);
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_map_point_to_coord (
+      const Vector &Point,
+      Int32 coord[3]) const {
+
+   for (Int32 ix = 0; ix < 3; ix++) {
+
+      const Float64 Value (
+         floor (Point.get (VectorComponentEnum (ix)) / _rootSize));
+
+      if (Value < Float64 (-LocalCoordLimit)) { coord[ix] = -LocalCoordLimit; }
+      else if (Value >= Float64 (LocalCoordLimit)) { coord[ix] = LocalCoordLimit - 1; }
+      else { coord[ix] = Int32 (Value); }
+   }
+}
+
+
+dmz::UInt64
+dmz::ObjectModuleGridOctree::_map_coord (const Int32 Coord[3]) const {
+
+   return LocalKeyFlag |
+      ((UInt64 (Coord[0] + LocalCoordLimit) & LocalCoordMask) << 42) |
+      ((UInt64 (Coord[1] + LocalCoordLimit) & LocalCoordMask) << 21) |
+      (UInt64 (Coord[2] + LocalCoordLimit) & LocalCoordMask);
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_map_extents (
+      const Vector &Min,
+      const Vector &Max,
+      RangeStruct &range) {
+
+   _map_point_to_coord (Min, range.min);
+   _map_point_to_coord (Max, range.max);
+   _init_range (range);
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_init_range (RangeStruct &range) const {
+
+   Float64 cells (1.0);
+
+   for (Int32 ix = 0; ix < 3; ix++) {
+
+      range.coord[ix] = range.min[ix];
+      cells *= Float64 (range.max[ix] - range.min[ix] + 1);
+   }
+
+   // Walk the root table instead of the range when it is the smaller of the two.
+   range.scanTable = (cells > Float64 (_rootTable.get_count ()));
+}
+
+
+dmz::ObjectModuleGridOctree::RootStruct *
+dmz::ObjectModuleGridOctree::_get_first_root (RangeStruct &range) {
+
+   RootStruct *result (0);
+
+   range.it.reset ();
+
+   if (range.scanTable) {
+
+      result = _rootTable.get_first (range.it);
+
+      if (result && !_in_range (result->coord, range)) {
+
+         result = _get_next_root (range);
+      }
+   }
+   else {
+
+      for (Int32 ix = 0; ix < 3; ix++) { range.coord[ix] = range.min[ix]; }
+
+      result = _rootTable.lookup (_map_coord (range.coord));
+
+      if (!result) { result = _get_next_root (range); }
+   }
+
+   return result;
+}
+
+
+dmz::ObjectModuleGridOctree::RootStruct *
+dmz::ObjectModuleGridOctree::_get_next_root (RangeStruct &range) {
+
+   RootStruct *result (0);
+   Boolean done (False);
+
+   while (!done) {
+
+      if (range.scanTable) {
+
+         result = _rootTable.get_next (range.it);
+
+         if (!result || _in_range (result->coord, range)) { done = True; }
+      }
+      else if (_next_coord (range)) {
+
+         result = _rootTable.lookup (_map_coord (range.coord));
+
+         if (result) { done = True; }
+      }
+      else { result = 0; done = True; }
+   }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::ObjectModuleGridOctree::_next_coord (RangeStruct &range) {
+
+   Boolean result (False);
+
+   for (Int32 ix = 2; !result && (ix >= 0); ix--) {
+
+      if (range.coord[ix] < range.max[ix]) { range.coord[ix]++; result = True; }
+      else { range.coord[ix] = range.min[ix]; }
+   }
+
+   return result;
+}
+
+
+dmz::ObjectModuleGridOctree::RootStruct *
+dmz::ObjectModuleGridOctree::_lookup_root (const Vector &Point, const Boolean Create) {
+
+   Int32 coord[3];
+   _map_point_to_coord (Point, coord);
+   const UInt64 Key (_map_coord (coord));
+
+   RootStruct *result (_rootTable.lookup (Key));
+
+   if (!result && Create) {
+
+      const Vector Min (
+         Float64 (coord[0]) * _rootSize,
+         Float64 (coord[1]) * _rootSize,
+         Float64 (coord[2]) * _rootSize);
+
+      const Vector Max (Min + Vector (_rootSize, _rootSize, _rootSize));
+
+      result = new RootStruct (Key, coord, Min, Max);
+
+      if (_rootTable.store (Key, result)) {
+
+         HashTableHandleIterator it;
+         ObserverStruct *os (0);
+
+         while (_obsTable.get_next (it, os)) {
+
+            RangeStruct range;
+
+            for (Int32 ix = 0; ix < 3; ix++) {
+
+               range.min[ix] = os->min[ix];
+               range.max[ix] = os->max[ix];
+            }
+
+            if (os->attached && _in_range (coord, range)) {
+
+               result->obsTable.store (os->ObsHandle, os);
+            }
+         }
+      }
+      else { delete result; result = 0; }
+   }
+
+   return result;
+}
+
+
+dmz::ObjectModuleGridOctree::NodeStruct *
+dmz::ObjectModuleGridOctree::_lookup_leaf (NodeStruct &root, const Vector &Point) {
+
+   NodeStruct *result (&root);
+
+   while (!result->leaf) {
+
+      const Int32 Index (local_child_index (result->Center, Point));
+
+      if (!result->child[Index]) {
+
+         Vector min (result->Min), max (result->Max);
+
+         if (Index & 1) { min.set_x (result->Center.get_x ()); }
+         else { max.set_x (result->Center.get_x ()); }
+
+         if (Index & 2) { min.set_y (result->Center.get_y ()); }
+         else { max.set_y (result->Center.get_y ()); }
+
+         if (Index & 4) { min.set_z (result->Center.get_z ()); }
+         else { max.set_z (result->Center.get_z ()); }
+
+         result->child[Index] = new NodeStruct (
+            result,
+            Index,
+            result->Level + 1,
+            min,
+            max);
+      }
+
+      result = result->child[Index];
+   }
+
+   return result;
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_insert_object (
+      ObjectStruct &obj,
+      RootStruct *root,
+      NodeStruct *node) {
+
+   if (root && node && node->objTable.store (obj.Object, &obj)) {
+
+      obj.root = root;
+      obj.node = node;
+
+      for (NodeStruct *current = node; current; current = current->parent) {
+
+         current->count++;
+      }
+
+      if ((node->objTable.get_count () > _nodeLimit) && (node->Level < _maxDepth)) {
+
+         _split_node (*node);
+      }
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_remove_object (
+      ObjectStruct &obj,
+      RootStruct *root,
+      NodeStruct *node) {
+
+   if (root && node && node->objTable.remove (obj.Object)) {
+
+      if (obj.node == node) { obj.root = 0; obj.node = 0; }
+
+      for (NodeStruct *current = node; current; current = current->parent) {
+
+         current->count--;
+      }
+
+      NodeStruct *current (node);
+
+      while (current->parent && (current->count <= 0)) {
+
+         NodeStruct *parent (current->parent);
+         parent->child[current->Index] = 0;
+         delete current; current = 0;
+         current = parent;
+      }
+
+      NodeStruct *target (0);
+
+      for (NodeStruct *ptr = current; ptr; ptr = ptr->parent) {
+
+         if (!ptr->leaf && (ptr->count <= _mergeLimit)) { target = ptr; }
+      }
+
+      if (target) { _merge_node (*target); }
+
+      if (root->node.count <= 0) {
+
+         if (_rootTable.remove (root->Key)) { delete root; root = 0; }
+      }
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_split_node (NodeStruct &node) {
+
+   node.leaf = False;
+
+   HashTableHandleIterator it;
+   ObjectStruct *obj (0);
+
+   while (node.objTable.get_next (it, obj)) {
+
+      NodeStruct *leaf (_lookup_leaf (node, obj->pos));
+
+      if (leaf->objTable.store (obj->Object, obj)) {
+
+         obj->node = leaf;
+         leaf->count++;
+      }
+   }
+
+   node.objTable.clear ();
+
+   for (Int32 ix = 0; ix < 8; ix++) {
+
+      NodeStruct *child (node.child[ix]);
+
+      if (child && (child->objTable.get_count () > _nodeLimit) &&
+            (child->Level < _maxDepth)) {
+
+         _split_node (*child);
+      }
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_merge_node (NodeStruct &node) {
+
+   for (Int32 ix = 0; ix < 8; ix++) {
+
+      if (node.child[ix]) {
+
+         _collect_objects (*(node.child[ix]), node);
+         delete node.child[ix]; node.child[ix] = 0;
+      }
+   }
+
+   node.leaf = True;
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_collect_objects (NodeStruct &node, NodeStruct &target) {
+
+   HashTableHandleIterator it;
+   ObjectStruct *obj (0);
+
+   while (node.objTable.get_next (it, obj)) {
+
+      if (target.objTable.store (obj->Object, obj)) { obj->node = &target; }
+   }
+
+   node.objTable.clear ();
+
+   for (Int32 ix = 0; ix < 8; ix++) {
+
+      if (node.child[ix]) { _collect_objects (*(node.child[ix]), target); }
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_find_objects (
+      NodeStruct &node,
+      const Volume &SearchSpace,
+      const Vector &Origin,
+      const Vector &Min,
+      const Vector &Max,
+      const ObjectTypeSet *IncludeTypes,
+      const ObjectTypeSet *ExcludeTypes,
+      ObserverStruct *os) {
+
+   if (local_overlaps (node.Min, node.Max, Min, Max)) {
+
+      if (node.leaf) {
+
+         HashTableHandleIterator it;
+         ObjectStruct *current (0);
+
+         while (node.objTable.get_next (it, current)) {
+
+            Boolean test (True);
+
+            if (IncludeTypes && !IncludeTypes->contains_type (current->Type)) {
+
+               test = False;
+            }
+            else if (ExcludeTypes && ExcludeTypes->contains_type (current->Type)) {
+
+               test = False;
+            }
+
+            if (!test) {;}
+            else if (os) { _update_observer (SearchSpace, *current, *os); }
+            else if (SearchSpace.contains_point (current->pos)) {
+
+               _hits.add (current->Object, (Origin - current->pos).magnitude_squared ());
+            }
+         }
+      }
+      else {
+
+         for (Int32 ix = 0; ix < 8; ix++) {
+
+            if (node.child[ix]) {
+
+               _find_objects (
+                  *(node.child[ix]),
+                  SearchSpace,
+                  Origin,
+                  Min,
+                  Max,
+                  IncludeTypes,
+                  ExcludeTypes,
+                  os);
+            }
+         }
+      }
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_find_nearest (
+      NodeStruct &node,
+      const Vector &Origin,
+      const Float64 RadiusSquared,
+      const ObjectTypeSet *IncludeTypes,
+      const ObjectTypeSet *ExcludeTypes) {
+
+   const Float64 Limit (
+      _hits.is_full () && (_hits.get_max_distance_squared () < RadiusSquared) ?
+         _hits.get_max_distance_squared () : RadiusSquared);
+
+   if (local_distance_squared (node.Min, node.Max, Origin) <= Limit) {
+
+      if (node.leaf) {
+
+         HashTableHandleIterator it;
+         ObjectStruct *current (0);
+
+         while (node.objTable.get_next (it, current)) {
+
+            Boolean test (True);
+
+            if (IncludeTypes && !IncludeTypes->contains_type (current->Type)) {
+
+               test = False;
+            }
+            else if (ExcludeTypes && ExcludeTypes->contains_type (current->Type)) {
+
+               test = False;
+            }
+
+            if (test) {
+
+               const Float64 Distance ((Origin - current->pos).magnitude_squared ());
+
+               if (Distance <= RadiusSquared) { _hits.add (current->Object, Distance); }
+            }
+         }
+      }
+      else {
+
+         // Start with the octant holding the origin so the heap fills with near hits
+         // and prunes the rest of the nodes sooner.
+         const Int32 First (local_child_index (node.Center, Origin));
+
+         for (Int32 ix = 0; ix < 8; ix++) {
+
+            NodeStruct *child (node.child[First ^ ix]);
+
+            if (child) {
+
+               _find_nearest (*child, Origin, RadiusSquared, IncludeTypes, ExcludeTypes);
+            }
+         }
+      }
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_attach_observer (
+      ObserverStruct &os,
+      const Boolean Attach) {
+
+   RangeStruct range;
+
+   for (Int32 ix = 0; ix < 3; ix++) {
+
+      range.min[ix] = os.min[ix];
+      range.max[ix] = os.max[ix];
+   }
+
+   _init_range (range);
+
+   RootStruct *root (_get_first_root (range));
+
+   while (root) {
+
+      if (Attach) { root->obsTable.store (os.ObsHandle, &os); }
+      else { root->obsTable.remove (os.ObsHandle); }
+
+      root = _get_next_root (range);
+   }
+
+   os.attached = Attach;
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_update_observers (
+      RootStruct *root,
+      const ObjectStruct &Obj,
+      HandleContainer *tested) {
+
+   if (root) {
+
+      HashTableHandleIterator it;
+      ObserverStruct *os (0);
+
+      while (root->obsTable.get_next (it, os)) {
+
+         if (!tested || tested->add (os->ObsHandle)) {
+
+            _update_observer (os->obs.get_observer_volume (), Obj, *os);
+         }
+      }
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_update_observer (
+      const Volume &SearchSpace,
+      const ObjectStruct &Obj,
+      ObserverStruct &os) {
+
+   const Boolean Contains = SearchSpace.contains_point (Obj.pos);
+
+   if (Contains && os.objects.add (Obj.Object)) {
+
+      os.obs.update_object_grid_state (
+         ObjectGridStateEnter,
+         Obj.Object,
+         Obj.Type,
+         Obj.pos);
+   }
+   else if (!Contains && os.objects.remove (Obj.Object)) {
+
+      os.obs.update_object_grid_state (
+         ObjectGridStateExit,
+         Obj.Object,
+         Obj.Type,
+         Obj.pos);
+   }
+}
+
+
+void
+dmz::ObjectModuleGridOctree::_init (Config &local) {
+
+   _rootSize = config_to_float64 ("root.size", local, _rootSize);
+   _nodeLimit = config_to_int32 ("node.limit", local, _nodeLimit);
+   _maxDepth = config_to_int32 ("node.depth", local, _maxDepth);
+
+   if (_rootSize <= 0.0) { _rootSize = 1024.0; }
+   if (_nodeLimit < 2) { _nodeLimit = 2; }
+   if (_maxDepth < 0) { _maxDepth = 0; }
+   else if (_maxDepth > 24) { _maxDepth = 24; }
+
+   _mergeLimit = _nodeLimit / 2;
+
+   _log.info << "root cell size: " << _rootSize << endl;
+   _log.info << "node limit: " << _nodeLimit << " depth: " << _maxDepth << endl;
+
+   activate_default_object_attribute (
+      ObjectCreateMask | ObjectDestroyMask | ObjectPositionMask);
+}
+//! \endcond
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzObjectModuleGridOctree (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::ObjectModuleGridOctree (Info, local);
+}
+
+};
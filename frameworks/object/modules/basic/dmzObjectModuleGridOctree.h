@@ -0,0 +1,248 @@
+#ifndef DMZ_OBJECT_MODULE_GRID_OCTREE_DOT_H
+#define DMZ_OBJECT_MODULE_GRID_OCTREE_DOT_H
+
+#include <dmzObjectModuleGrid.h>
+#include "dmzObjectModuleGridHitList.h"
+#include <dmzObjectObserverGrid.h>
+#include <dmzObjectObserverUtil.h>
+#include <dmzRuntimeLog.h>
+#include <dmzRuntimeObjectType.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzTypesHandleContainer.h>
+#include <dmzTypesHashTableHandleTemplate.h>
+#include <dmzTypesHashTableUInt64Template.h>
+#include <dmzTypesVector.h>
+
+namespace dmz {
+
+   class ObjectModuleGridOctree :
+         public Plugin,
+         public ObjectModuleGrid,
+         public ObjectObserverUtil {
+
+      public:
+         //! \cond
+         ObjectModuleGridOctree (const PluginInfo &Info, Config &local);
+         ~ObjectModuleGridOctree ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level);
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr);
+
+         // ObjectModuleGrid Interface
+         virtual Boolean register_object_observer_grid (ObjectObserverGrid &observer);
+         virtual Boolean update_object_observer_grid (ObjectObserverGrid &observer);
+         virtual Boolean release_object_observer_grid (ObjectObserverGrid &observer);
+
+         virtual void find_objects (
+            const Volume &SearchSpace,
+            HandleContainer &objects,
+            const ObjectTypeSet *IncludeTypes,
+            const ObjectTypeSet *ExcludeTypes,
+            const Boolean Sorted);
+
+         virtual void find_nearest_objects (
+            const Vector &Origin,
+            const Int32 Count,
+            const Float64 Radius,
+            HandleContainer &objects,
+            const ObjectTypeSet *IncludeTypes,
+            const ObjectTypeSet *ExcludeTypes);
+
+         // Object Observer Interface
+         virtual void create_object (
+            const UUID &Identity,
+            const Handle ObjectHandle,
+            const ObjectType &Type,
+            const ObjectLocalityEnum Locality);
+
+         virtual void destroy_object (const UUID &Identity, const Handle ObjectHandle);
+
+         virtual void update_object_position (
+            const UUID &Identity,
+            const Handle ObjectHandle,
+            const Handle AttributeHandle,
+            const Vector &Value,
+            const Vector *PreviousValue);
+
+      protected:
+         struct NodeStruct;
+         struct RootStruct;
+
+         struct ObjectStruct {
+
+            const Handle Object;
+            const ObjectType Type;
+            Vector pos;
+
+            RootStruct *root;
+            NodeStruct *node;
+
+            ObjectStruct (const Handle TheObject, const ObjectType &TheType) :
+                  Object (TheObject),
+                  Type (TheType),
+                  root (0),
+                  node (0) {;}
+         };
+
+         struct NodeStruct {
+
+            NodeStruct *parent;
+            const Int32 Index;
+            const Int32 Level;
+            const Vector Min;
+            const Vector Max;
+            const Vector Center;
+            Boolean leaf;
+            Int32 count;
+            NodeStruct *child[8];
+            HashTableHandleTemplate<ObjectStruct> objTable;
+
+            NodeStruct (
+                  NodeStruct *theParent,
+                  const Int32 TheIndex,
+                  const Int32 TheLevel,
+                  const Vector &TheMin,
+                  const Vector &TheMax) :
+                  parent (theParent),
+                  Index (TheIndex),
+                  Level (TheLevel),
+                  Min (TheMin),
+                  Max (TheMax),
+                  Center ((TheMin + TheMax) * 0.5),
+                  leaf (True),
+                  count (0) {
+
+               for (Int32 ix = 0; ix < 8; ix++) { child[ix] = 0; }
+            }
+
+            ~NodeStruct () {
+
+               objTable.clear ();
+               for (Int32 ix = 0; ix < 8; ix++) { if (child[ix]) { delete child[ix]; } }
+            }
+         };
+
+         struct ObserverStruct {
+
+            const Handle ObsHandle;
+            ObjectObserverGrid &obs;
+            HandleContainer objects;
+            Boolean attached;
+            Int32 min[3];
+            Int32 max[3];
+
+            ObserverStruct (ObjectObserverGrid &theObs) :
+                  ObsHandle (theObs.get_object_observer_grid_handle ()),
+                  obs (theObs),
+                  attached (False) {
+
+               for (Int32 ix = 0; ix < 3; ix++) { min[ix] = max[ix] = 0; }
+            }
+         };
+
+         struct RootStruct {
+
+            const UInt64 Key;
+            Int32 coord[3];
+            NodeStruct node;
+            HashTableHandleTemplate<ObserverStruct> obsTable;
+
+            RootStruct (
+                  const UInt64 TheKey,
+                  const Int32 TheCoord[3],
+                  const Vector &TheMin,
+                  const Vector &TheMax) :
+                  Key (TheKey),
+                  node (0, 0, 0, TheMin, TheMax) {
+
+               for (Int32 ix = 0; ix < 3; ix++) { coord[ix] = TheCoord[ix]; }
+            }
+
+            ~RootStruct () { obsTable.clear (); }
+         };
+
+         struct RangeStruct {
+
+            Int32 min[3];
+            Int32 max[3];
+            Int32 coord[3];
+            Boolean scanTable;
+            HashTableUInt64Iterator it;
+         };
+
+         Boolean _in_range (const Int32 Coord[3], const RangeStruct &Range) const;
+         void _map_point_to_coord (const Vector &Point, Int32 coord[3]) const;
+         UInt64 _map_coord (const Int32 Coord[3]) const;
+         void _map_extents (const Vector &Min, const Vector &Max, RangeStruct &range);
+         void _init_range (RangeStruct &range) const;
+         RootStruct *_get_first_root (RangeStruct &range);
+         RootStruct *_get_next_root (RangeStruct &range);
+         Boolean _next_coord (RangeStruct &range);
+
+         RootStruct *_lookup_root (const Vector &Point, const Boolean Create);
+         NodeStruct *_lookup_leaf (NodeStruct &root, const Vector &Point);
+         void _insert_object (ObjectStruct &obj, RootStruct *root, NodeStruct *node);
+         void _remove_object (ObjectStruct &obj, RootStruct *root, NodeStruct *node);
+         void _split_node (NodeStruct &node);
+         void _merge_node (NodeStruct &node);
+         void _collect_objects (NodeStruct &node, NodeStruct &target);
+
+         void _find_objects (
+            NodeStruct &node,
+            const Volume &SearchSpace,
+            const Vector &Origin,
+            const Vector &Min,
+            const Vector &Max,
+            const ObjectTypeSet *IncludeTypes,
+            const ObjectTypeSet *ExcludeTypes,
+            ObserverStruct *os);
+
+         void _find_nearest (
+            NodeStruct &node,
+            const Vector &Origin,
+            const Float64 RadiusSquared,
+            const ObjectTypeSet *IncludeTypes,
+            const ObjectTypeSet *ExcludeTypes);
+
+         void _attach_observer (ObserverStruct &os, const Boolean Attach);
+
+         void _update_observers (
+            RootStruct *root,
+            const ObjectStruct &Obj,
+            HandleContainer *tested);
+
+         void _update_observer (
+            const Volume &SearchSpace,
+            const ObjectStruct &Obj,
+            ObserverStruct &os);
+
+         void _init (Config &local);
+
+         Log _log;
+
+         Float64 _rootSize;
+         Int32 _nodeLimit;
+         Int32 _mergeLimit;
+         Int32 _maxDepth;
+
+         ObjectModuleGridHitList _hits;
+
+         HashTableHandleTemplate<ObjectStruct> _objTable;
+         HashTableHandleTemplate<ObserverStruct> _obsTable;
+         HashTableUInt64Template<RootStruct> _rootTable;
+         //! \endcond
+
+      private:
+         ObjectModuleGridOctree ();
+         ObjectModuleGridOctree (const ObjectModuleGridOctree &);
+         ObjectModuleGridOctree &operator= (const ObjectModuleGridOctree &);
+   };
+};
+
+#endif // DMZ_OBJECT_MODULE_GRID_OCTREE_DOT_H
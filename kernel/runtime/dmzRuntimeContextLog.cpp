@@ -61,6 +61,20 @@ dmz::RuntimeContextLog::update_time_slice () {
 
          while (current) {
 
+            HashTableHandleIterator it;
+
+            LogObserver *obs = _obsTable.get_first (it);
+
+            while (obs) {
+
+               obs->store_log_message (
+                  current->LogName,
+                  current->Level,
+                  current->Message);
+
+               obs = _obsTable.get_next (it);
+            }
+
             current = current->next;
          }
 
@@ -147,6 +161,7 @@ dmz::RuntimeContextLog::write_message (
       _mutex.lock ();
          if (_eventsTail) { _eventsTail->next = event; _eventsTail = event; }
          else { _events = _eventsTail = event; }
+         _eventsToProcess = True;
       _mutex.unlock ();
    }
 }
@@ -1,6 +1,11 @@
 #include "dmzRuntimeContextDefinitions.h"
 #include "dmzRuntimeContextMessaging.h"
 #include "dmzRuntimeMessageContext.h"
+#include <dmzSystem.h>
+
+
+static const dmz::UInt32 LocalDefaultDelayedQueueSize (4096);
+static const dmz::UInt32 LocalDefaultDelayedRetry (64);
 
 dmz::Message
 dmz::RuntimeContextDefinitions::create_message (
@@ -62,14 +67,21 @@ dmz::RuntimeContextMessaging::RuntimeContextMessaging (
       RuntimeContextDefinitions &defs,
       RuntimeContext *context) :
       log (context ? context->get_log_context () : 0),
-      head (0),
-      tail (0),
+      delayedQueue (new SlotQueue (LocalDefaultDelayedQueueSize)),
+      delayedTable (0),
+      delayedRetry (LocalDefaultDelayedRetry),
+      delayedPeak (0),
+      delayedSent (0),
+      delayedDropped (0),
+      overflowHead (0),
+      overflowTail (0),
       messageCount (0),
       key (theKey),
       obsHandleTable (&obsHandleLock),
       obsNameTable (&obsNameLock),
       monostateErrorTable (&monostateErrorLock) {
 
+   delayedTable = new DelayedStruct[delayedQueue->get_size ()];
    globalType = defs.create_message ("Global_Message", "", context, this);
    key.ref ();
    if (log) { log->ref (); }
@@ -85,9 +97,17 @@ dmz::RuntimeContextMessaging::~RuntimeContextMessaging () {
 
    if (log) { log->unref (); }
 
-   listLock.lock ();
-   if (head) { delete head; head = tail = 0; }
-   listLock.unlock ();
+   while (overflowHead) {
+
+      DelayedStruct *tmp (overflowHead);
+      overflowHead = overflowHead->next;
+      delete tmp; tmp = 0;
+   }
+
+   overflowTail = 0;
+
+   if (delayedTable) { delete []delayedTable; delayedTable = 0; }
+   if (delayedQueue) { delete delayedQueue; delayedQueue = 0; }
 }
 
 
@@ -212,46 +232,190 @@ dmz::RuntimeContextMessaging::send (
 }
 
 
+/*!
+
+\brief Queues a message to be sent from the main thread.
+\details Safe to call from any thread. The message and a copy of \a InData are stored in
+a recycled slot of a bounded lock free queue. When the queue is full, threads other than
+the main thread yield and retry a limited number of times before the message is dropped.
+The first dropped message is logged. The main thread never waits since it is the thread
+that drains the queue. Its messages are put on an overflow list instead and are sent
+after the queue has been drained.
+
+*/
 void
 dmz::RuntimeContextMessaging::send_delayed (
       const Message &Type,
       const Handle ObserverHandle,
       const Data *InData) const {
 
-   if (Type.get_message_context ()) {
+   if (Type.get_message_context () && delayedQueue && delayedTable) {
 
       RuntimeContextMessaging *self ((RuntimeContextMessaging *)this);
 
-      MessageStruct *ms (new MessageStruct (Type, ObserverHandle, InData));
+      const Boolean MainThread (key.is_main_thread ());
+
+      UInt32 index (0);
+      Boolean reserved (delayedQueue->reserve (index));
+
+      if (!reserved && !MainThread) {
+
+         for (UInt32 count = 0; !reserved && (count < delayedRetry); count++) {
+
+            sleep (0.0);
+            reserved = delayedQueue->reserve (index);
+         }
+      }
+
+      if (reserved) {
+
+         DelayedStruct &ds (delayedTable[index]);
+
+         ds.type = Type;
+         ds.observerHandle = ObserverHandle;
+         ds.hasData = InData ? True : False;
+         if (InData) { ds.data = *InData; }
+
+         delayedQueue->commit (index);
+      }
+      else if (MainThread) {
+
+         DelayedStruct *ds (new DelayedStruct);
+
+         if (ds) {
+
+            ds->type = Type;
+            ds->observerHandle = ObserverHandle;
+            ds->hasData = InData ? True : False;
+            if (InData) { ds->data = *InData; }
+
+            if (self->overflowTail) { self->overflowTail->next = ds; }
+            else { self->overflowHead = ds; }
+            self->overflowTail = ds;
+         }
+      }
+      else if ((delayedQueue->drop () == 1) && log) {
+
+         String out ("Delayed message queue is full. Dropping message: ");
+         out << Type.get_name () << ". Further drops are only counted.";
+         log->write_kernel_message (LogLevelWarn, out);
+      }
+   }
+}
+
+
+/*!
 
-      if (ms) {
+\brief Resizes the delayed message queue.
+\details Any messages waiting in the queue are sent first. This function should only be
+called from the main thread during initialization, before other threads start sending
+messages.
+\param[in] Size Number of slots. Rounded up to the next power of two.
+\return Returns dmz::True if the queue was resized.
 
-         self->listLock.lock ();
-         if (tail) { self->tail->next = ms; self->tail = ms; }
-         else { self->head = self->tail = ms; }
-         self->listLock.unlock ();
+*/
+dmz::Boolean
+dmz::RuntimeContextMessaging::set_delayed_queue_size (const UInt32 Size) {
+
+   Boolean result (False);
+
+   if (Size && key.is_main_thread ()) {
+
+      update_time_slice ();
+
+      SlotQueue *queue (new SlotQueue (Size));
+
+      if (queue) {
+
+         if (delayedQueue) {
+
+            // Keep the totals of the queue being replaced.
+            const UInt32 Peak (delayedQueue->get_peak_count ());
+            if (Peak > delayedPeak) { delayedPeak = Peak; }
+            delayedSent += delayedQueue->get_release_count ();
+            delayedDropped += delayedQueue->get_drop_count ();
+         }
+
+         if (delayedTable) { delete []delayedTable; delayedTable = 0; }
+         if (delayedQueue) { delete delayedQueue; delayedQueue = 0; }
+
+         delayedQueue = queue;
+         delayedTable = new DelayedStruct[delayedQueue->get_size ()];
+         result = True;
       }
    }
+
+   return result;
+}
+
+
+//! Gets the delayed message queue statistics.
+void
+dmz::RuntimeContextMessaging::get_delayed_queue_stats (MessageQueueStats &stats) const {
+
+   stats.peak = delayedPeak;
+   stats.sent = delayedSent;
+   stats.dropped = delayedDropped;
+
+   if (delayedQueue) {
+
+      stats.size = delayedQueue->get_size ();
+      stats.count = delayedQueue->get_count ();
+      stats.full = delayedQueue->get_full_count ();
+
+      const UInt32 Peak (delayedQueue->get_peak_count ());
+      if (Peak > stats.peak) { stats.peak = Peak; }
+      stats.sent += delayedQueue->get_release_count ();
+      stats.dropped += delayedQueue->get_drop_count ();
+   }
 }
 
 
-//! Sends messages from other threads.
+/*!
+
+\brief Sends messages from other threads.
+\details Only the messages waiting at the start of the call are sent, followed by the
+messages the main thread put on the overflow list. Messages queued by observers while
+the queue is being drained are sent on the next call.
+
+*/
 void
 dmz::RuntimeContextMessaging::update_time_slice () {
 
-   if (head) {
+   const UInt32 Count (delayedQueue ? delayedQueue->get_count () : 0);
 
-      listLock.lock ();
-      MessageStruct *ms = head; head = tail = 0;
-      listLock.unlock ();
+   DelayedStruct *overflow (overflowHead);
+   overflowHead = overflowTail = 0;
 
-      while (ms) {
+   if (Count) {
 
-         ms->Type.send (ms->ObserverHandle, ms->DataPtr, 0);
-         ms = ms->next;
+      UInt32 index (0);
+
+      for (UInt32 ix = 0; (ix < Count) && delayedQueue->peek (index); ix++) {
+
+         DelayedStruct &ds (delayedTable[index]);
+
+         ds.type.send (ds.observerHandle, ds.hasData ? &(ds.data) : 0, 0);
+
+         // Release the references held by the slot so the message and runtime
+         // contexts are not kept alive by a recycled slot.
+         ds.type.set_message_context (0);
+         ds.observerHandle = 0;
+         ds.hasData = False;
+         ds.data.clear ();
+         ds.data.set_runtime_context (0);
+
+         delayedQueue->release (index);
       }
+   }
+
+   while (overflow) {
+
+      DelayedStruct *ds (overflow);
+      overflow = overflow->next;
 
-      delete ms; ms = 0;
+      ds->type.send (ds->observerHandle, ds->hasData ? &(ds->data) : 0, 0);
+      delete ds; ds = 0;
    }
 }
 
@@ -7,8 +7,8 @@
 #include <dmzRuntimeData.h>
 #include <dmzRuntimeHandleAllocator.h>
 #include <dmzRuntimeMessaging.h>
-#include <dmzSystemMutex.h>
 #include <dmzSystemRefCount.h>
+#include <dmzSystemSlotQueue.h>
 #include <dmzTypesHashTableStringTemplate.h>
 #include <dmzTypesHashTableHandleTemplate.h>
 
@@ -22,27 +22,15 @@ namespace dmz {
    class RuntimeContextMessaging : public RefCountDeleteOnZero {
 
       public:
-         struct MessageStruct {
-
-            const Message Type;
-            const Handle ObserverHandle;
-            const Data *DataPtr;
-            MessageStruct *next;
-
-            MessageStruct (
-                  const Message &TheType,
-                  const Handle TheHandle,
-                  const Data *TheData) :
-                  Type (TheType),
-                  ObserverHandle (TheHandle),
-                  DataPtr (TheData ? new Data (*TheData) : 0),
-                  next (0) {;}
-
-            ~MessageStruct () {
-
-               if (DataPtr) { delete DataPtr; DataPtr = 0; }
-               if (next) { delete next; next = 0; }
-            }
+         struct DelayedStruct {
+
+            Message type;
+            Handle observerHandle;
+            Boolean hasData;
+            Data data;
+            DelayedStruct *next;
+
+            DelayedStruct () : observerHandle (0), hasData (False), next (0) {;}
          };
 
          RuntimeContextMessaging (
@@ -64,15 +52,23 @@ namespace dmz {
             const Handle ObserverHandle,
             const Data *InData) const;
 
+         Boolean set_delayed_queue_size (const UInt32 Size);
+         void get_delayed_queue_stats (MessageQueueStats &stats) const;
+
          void update_time_slice ();
          Boolean add_observer (MessageObserver &obs);
          Boolean remove_observer (MessageObserver &obs);
 
          RuntimeContextLog *log;
 
-         Mutex listLock; //!< Lock.
-         MessageStruct *head; //!< Message type list head.
-         MessageStruct *tail; //!< Message type list tail.
+         SlotQueue *delayedQueue; //!< Queue of messages sent from other threads.
+         DelayedStruct *delayedTable; //!< Recycled delayed message slots.
+         UInt32 delayedRetry; //!< Attempts made by other threads when queue is full.
+         UInt32 delayedPeak; //!< Peak depth of queues replaced by a resize.
+         UInt64 delayedSent; //!< Messages sent from queues replaced by a resize.
+         UInt64 delayedDropped; //!< Messages dropped by queues replaced by a resize.
+         DelayedStruct *overflowHead; //!< Main thread messages sent when queue was full.
+         DelayedStruct *overflowTail; //!< End of overflow list.
 
          UInt32 messageCount; //!< Message count.
          Message globalType; //!< Global message type.
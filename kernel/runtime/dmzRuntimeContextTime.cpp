@@ -2,9 +2,37 @@
 #include <dmzRuntimeTime.h>
 #include <dmzSystem.h>
 #include <dmzSystemStreamFile.h>
-#include <math.h> // for modf
+#include <math.h> // for modf and fabs
 
 static const dmz::Float64 LocalMinFrequency (0.0001);
+static const dmz::Int32 LocalWorkListSize (32);
+static const dmz::Float64 LocalDefaultSpinTime (0.002);
+static const dmz::Float64 LocalFirstJitterBucket (0.0001);
+static const dmz::Float64 LocalMaxSpinWindow (0.005);
+
+
+//! Constructor.
+dmz::TimeSliceWorker::TimeSliceWorker (RuntimeContextTime &context) :
+      _context (context) {;}
+
+
+//! Runs staged time slices until the time context signals the worker to quit.
+void
+dmz::TimeSliceWorker::run_thread_function () {
+
+   Boolean done (False);
+
+   while (!done) {
+
+      _context.workStart.wait ();
+
+      if (_context.workerQuit) { done = True; }
+      else { _context.run_work (); }
+
+      _context.workDone.post ();
+   }
+}
+
 
 //! Constructor.
 dmz::RuntimeContextTime::RuntimeContextTime () :
@@ -16,17 +44,31 @@ dmz::RuntimeContextTime::RuntimeContextTime () :
       timeFactor (1.0),
       targetFrequency (0.0),
       targetFrameLength (0.0),
+      pacing (FramePacingSleep),
+      spinTime (LocalDefaultSpinTime),
+      spinWindow (LocalDefaultSpinTime),
+      clock (0),
       head (0),
       tail (0),
       timeSliceCount (0),
       timeSliceHead (0),
-      timeSliceNext (0) {;}
+      timeSliceNext (0),
+      threadCount (0),
+      workerList (0),
+      workerQuit (False),
+      workNext (0),
+      workCount (0),
+      workSize (0),
+      workList (0) {;}
 
 //! Destructor.
 dmz::RuntimeContextTime::~RuntimeContextTime () {
 
    if (head) { delete head; head = tail = 0; }
 
+   _set_thread_count (0);
+   if (workList) { delete []workList; workList = 0; }
+
    timeSliceHead = 0;
    timeSliceNext = 0;
    timeSliceIndexTable.empty ();
@@ -66,6 +108,21 @@ dmz::RuntimeContextTime::update_time_slice () {
             }
             else { targetFrameLength = 0.0; }
          }
+         else if (tmp->Which == ThreadCount) {
+
+            _set_thread_count (tmp->Value > 0.0 ? UInt32 (tmp->Value) : 0);
+         }
+         else if (tmp->Which == Pacing) {
+
+            pacing = (tmp->Value > 0.0) ? FramePacingHybrid : FramePacingSleep;
+         }
+         else if (tmp->Which == SpinTime) {
+
+            spinTime = (tmp->Value > 0.0) ? tmp->Value : 0.0;
+            if (spinTime > LocalMaxSpinWindow) { spinTime = LocalMaxSpinWindow; }
+            spinWindow = spinTime;
+         }
+         else if (tmp->Which == ResetStats) { stats.reset (); }
 
          tmp = tmp->next;
       }
@@ -73,22 +130,19 @@ dmz::RuntimeContextTime::update_time_slice () {
       delete top; top = 0;
    }
 
-   Float64 sleepDelta (0.0);
-   const Float64 EndFrameTime (get_time ());
+   const Float64 EndFrameTime (get_clock_time ());
 
-   if (targetFrequency > LocalMinFrequency) {
+   if (targetFrequency > LocalMinFrequency) { _pace_frame (EndFrameTime); }
 
-      sleepDelta  = targetFrameLength - (EndFrameTime - previousRealTime);
-      sleep (sleepDelta); // - 0.00007);
-   }
-
-   const Float64 StartFrameTime (get_time ());
+   const Float64 StartFrameTime (get_clock_time ());
 
    Float64 realDeltaTime (targetFrameLength);
 
    // First update prevents the first frame from being too large.
    if (!firstUpdate) {
 
+      _update_stats (StartFrameTime - previousRealTime);
+
       if (currentTimeUpdated) { realDeltaTime = currentTime - previousTime; }
       else {
 
@@ -130,6 +184,78 @@ dmz::RuntimeContextTime::set_target_frequency (const Float64 Value) {
 }
 
 
+//! Sets frame pacing mode.
+void
+dmz::RuntimeContextTime::set_pacing (const FramePacingEnum Mode) {
+
+   _add_update (new updateStruct (Pacing, Mode == FramePacingHybrid ? 1.0 : 0.0));
+}
+
+
+//! Sets minimum busy wait window for hybrid frame pacing.
+void
+dmz::RuntimeContextTime::set_spin_time (const Float64 Value) {
+
+   _add_update (new updateStruct (SpinTime, Value));
+}
+
+
+//! Resets frame timing statistics.
+void
+dmz::RuntimeContextTime::reset_stats () {
+
+   _add_update (new updateStruct (ResetStats, 0.0));
+}
+
+
+//! Sets the frame clock. The next frame is not measured. Called from the main thread.
+void
+dmz::RuntimeContextTime::set_clock (FrameClock *theClock) {
+
+   clock = theClock;
+   firstUpdate = True;
+   previousRealTime = get_clock_time ();
+}
+
+
+//! Returns the frame clock time or the system time if no frame clock is set.
+dmz::Float64
+dmz::RuntimeContextTime::get_clock_time () {
+
+   return clock ? clock->get_frame_clock_time () : get_time ();
+}
+
+
+//! Sets the number of worker threads used to run thread safe time slices.
+void
+dmz::RuntimeContextTime::set_thread_count (const UInt32 Value) {
+
+   _add_update (new updateStruct (ThreadCount, Float64 (Value)));
+}
+
+
+//! Runs staged time slices. Invoked from the main thread and the worker threads.
+void
+dmz::RuntimeContextTime::run_work () {
+
+   Boolean done (False);
+
+   while (!done) {
+
+      workLock.lock ();
+      const Int32 Index (workNext < workCount ? workNext++ : -1);
+      workLock.unlock ();
+
+      if (Index >= 0) {
+
+         TimeSliceWorkStruct &work (workList[Index]);
+         work.timeSlice->timeSlice.update_time_slice (work.delta);
+      }
+      else { done = True; }
+   }
+}
+
+
 dmz::Int32
 dmz::RuntimeContextTime::move_time_slice_to_end (const Handle TheHandle) {
 
@@ -254,7 +380,7 @@ dmz::RuntimeContextTime::start_time_slice (TimeSliceStruct &timeSlice) {
    if (!timeSlice.continuous) {
 
       timeSlice.nextTimeSlice =
-         timeSlice.timeInterval + (timeSlice.system ? get_time () : currentTime);
+         timeSlice.timeInterval + (timeSlice.system ? get_clock_time () : currentTime);
    }
 
    return True;
@@ -302,6 +428,104 @@ dmz::RuntimeContextTime::_add_update (updateStruct *ptr) {
 }
 
 
+/*!
+
+\brief Waits until the target frame length has elapsed since the previous frame.
+\details In hybrid mode the system sleep call is used for all but the last part of the
+frame and the rest is spent in a busy wait on the monotonic clock. The busy wait yields
+the processor on each pass so that other threads on the same core may run. The busy
+wait window grows when the system sleep call wakes up late and slowly shrinks back to
+the configured minimum. The window is never larger than the value returned by
+_max_spin_window so that a single late wake up does not turn most of the frame into
+a busy wait.
+
+*/
+void
+dmz::RuntimeContextTime::_pace_frame (const Float64 EndFrameTime) {
+
+   const Float64 TargetTime (previousRealTime + targetFrameLength);
+
+   if (TargetTime <= EndFrameTime) { if (!firstUpdate) { stats.overruns++; } }
+   else if (pacing == FramePacingHybrid) {
+
+      const Float64 MaxWindow (_max_spin_window ());
+      if (spinWindow > MaxWindow) { spinWindow = MaxWindow; }
+
+      const Float64 WakeTime (TargetTime - spinWindow);
+
+      if (WakeTime > EndFrameTime) {
+
+         if (clock) { clock->frame_clock_sleep (WakeTime - EndFrameTime); }
+         else { system_sleep (WakeTime - EndFrameTime); }
+
+         const Float64 Late (get_clock_time () - WakeTime);
+
+         if (Late > spinWindow) {
+
+            spinWindow = Late * 1.5;
+            if (spinWindow > MaxWindow) { spinWindow = MaxWindow; }
+         }
+         else if (spinWindow > spinTime) {
+
+            spinWindow *= 0.99;
+            if (spinWindow < spinTime) { spinWindow = spinTime; }
+         }
+      }
+
+      while (get_clock_time () < TargetTime) {
+
+         if (clock) { clock->frame_clock_yield (); }
+         else { system_yield (); }
+      }
+   }
+   else if (clock) { clock->frame_clock_sleep (TargetTime - EndFrameTime); }
+   else { sleep (TargetTime - EndFrameTime); }
+}
+
+
+//! Returns the largest busy wait window allowed for the current target frame length.
+dmz::Float64
+dmz::RuntimeContextTime::_max_spin_window () const {
+
+   const Float64 HalfFrame (targetFrameLength * 0.5);
+
+   return HalfFrame < LocalMaxSpinWindow ? HalfFrame : LocalMaxSpinWindow;
+}
+
+
+void
+dmz::RuntimeContextTime::_update_stats (const Float64 Period) {
+
+   stats.lastPeriod = Period;
+   stats.targetPeriod = (targetFrequency > LocalMinFrequency) ? targetFrameLength : 0.0;
+   stats.spinTime = (pacing == FramePacingHybrid) ? spinWindow : 0.0;
+
+   if (!stats.frames || (Period < stats.minPeriod)) { stats.minPeriod = Period; }
+   if (!stats.frames || (Period > stats.maxPeriod)) { stats.maxPeriod = Period; }
+
+   stats.frames++;
+   stats.averagePeriod += (Period - stats.averagePeriod) / Float64 (stats.frames);
+
+   if (stats.targetPeriod > 0.0) {
+
+      const Float64 Jitter (fabs (Period - stats.targetPeriod));
+
+      if (Jitter > stats.maxJitter) { stats.maxJitter = Jitter; }
+
+      Int32 bucket (0);
+      Float64 limit (LocalFirstJitterBucket);
+
+      while ((bucket < (FrameJitterBucketCount - 1)) && (Jitter >= limit)) {
+
+         bucket++;
+         limit *= 2.0;
+      }
+
+      stats.jitter[bucket]++;
+   }
+}
+
+
 void
 dmz::RuntimeContextTime::_update_time_slice (
       const Float64 RealTime,
@@ -317,10 +541,13 @@ dmz::RuntimeContextTime::_update_time_slice (
 
          if (current->active) {
 
+            Boolean ready (False);
+            Float64 delta (0.0);
+
             if (current->continuous) {
 
-               current->timeSlice.update_time_slice (
-                  current->system ? RealDelta : deltaTime);
+               ready = True;
+               delta = current->system ? RealDelta : deltaTime;
 
                if (current->mode == TimeSliceModeSingle) { stop_time_slice (*current); }
             }
@@ -330,8 +557,8 @@ dmz::RuntimeContextTime::_update_time_slice (
 
                if (current->nextTimeSlice <= TheTime) {
 
-                  const Float64 TempDelta (
-                     current->timeInterval + (TheTime - current->nextTimeSlice));
+                  ready = True;
+                  delta = current->timeInterval + (TheTime - current->nextTimeSlice);
 
                   if (current->mode == TimeSliceModeSingle) {
 
@@ -356,15 +583,160 @@ dmz::RuntimeContextTime::_update_time_slice (
                         }
                      }
                   }
+               }
+            }
+
+            if (ready) {
+
+               if (threadCount && current->threadSafe) {
+
+                  if (!_stage_time_slice (*current, delta)) {
+
+                     _run_stage ();
+                     _stage_time_slice (*current, delta);
+                  }
+               }
+               else {
+
+                  _run_stage ();
 
                   // This must be the last usage of current because it may be deleted in
                   // the update_time_slice call
-                  current->timeSlice.update_time_slice (TempDelta);
+                  current->timeSlice.update_time_slice (delta);
                }
             }
          }
 
          current = timeSliceNext;
       }
+
+      _run_stage ();
+   }
+}
+
+
+void
+dmz::RuntimeContextTime::_set_thread_count (const UInt32 Count) {
+
+   if (Count != threadCount) {
+
+      if (workerList) {
+
+         workerQuit = True;
+         workStart.post (threadCount);
+
+         for (UInt32 ix = 0; ix < threadCount; ix++) { workDone.wait (); }
+
+         for (UInt32 ix = 0; ix < threadCount; ix++) {
+
+            delete workerList[ix]; workerList[ix] = 0;
+         }
+
+         delete []workerList; workerList = 0;
+         workerQuit = False;
+         threadCount = 0;
+      }
+
+      if (Count) {
+
+         workerList = new TimeSliceWorker *[Count];
+
+         for (UInt32 ix = 0; ix < Count; ix++) {
+
+            TimeSliceWorker *worker (new TimeSliceWorker (*this));
+
+            if (create_thread (*worker)) {
+
+               workerList[threadCount] = worker;
+               threadCount++;
+            }
+            else { delete worker; worker = 0; }
+         }
+
+         if (!threadCount) { delete []workerList; workerList = 0; }
+      }
+   }
+}
+
+
+dmz::Boolean
+dmz::RuntimeContextTime::_stage_time_slice (
+      TimeSliceStruct &timeSlice,
+      const Float64 Delta) {
+
+   Boolean result (True);
+
+   if (workCount > 0) {
+
+      HandleContainerIterator it;
+      Handle resource (0);
+
+      while (result && timeSlice.writeSet.get_next (it, resource)) {
+
+         if (workWriteSet.contains (resource) || workReadSet.contains (resource)) {
+
+            result = False;
+         }
+      }
+
+      it.reset ();
+
+      while (result && timeSlice.readSet.get_next (it, resource)) {
+
+         if (workWriteSet.contains (resource)) { result = False; }
+      }
+   }
+
+   if (result) {
+
+      if (workCount >= workSize) {
+
+         const Int32 NewSize (workSize ? workSize * 2 : LocalWorkListSize);
+         TimeSliceWorkStruct *list (new TimeSliceWorkStruct[NewSize]);
+
+         for (Int32 ix = 0; ix < workCount; ix++) { list[ix] = workList[ix]; }
+
+         if (workList) { delete []workList; }
+         workList = list;
+         workSize = NewSize;
+      }
+
+      workList[workCount].timeSlice = &timeSlice;
+      workList[workCount].delta = Delta;
+      workCount++;
+
+      if (timeSlice.readSet.get_count ()) { workReadSet += timeSlice.readSet; }
+      if (timeSlice.writeSet.get_count ()) { workWriteSet += timeSlice.writeSet; }
+   }
+
+   return result;
+}
+
+
+//! Runs the staged time slices and waits for them to finish.
+void
+dmz::RuntimeContextTime::_run_stage () {
+
+   if (workCount == 1) {
+
+      workList[0].timeSlice->timeSlice.update_time_slice (workList[0].delta);
+   }
+   else if (workCount > 1) {
+
+      const UInt32 Workers (
+         threadCount < UInt32 (workCount - 1) ? threadCount : UInt32 (workCount - 1));
+
+      workNext = 0;
+      workStart.post (Workers);
+      run_work ();
+
+      for (UInt32 ix = 0; ix < Workers; ix++) { workDone.wait (); }
+   }
+
+   if (workCount) {
+
+      workCount = 0;
+      workReadSet.clear ();
+      workWriteSet.clear ();
    }
 }
@@ -1,10 +1,15 @@
 #ifndef DMZ_RUNTIME_CONTEXT_TIME_DOT_H
 #define DMZ_RUNTIME_CONTEXT_TIME_DOT_H
 
+#include <dmzRuntimeTime.h>
 #include <dmzRuntimeTimeSlice.h>
 #include <dmzSystemMutex.h>
 #include <dmzSystemRefCount.h>
+#include <dmzSystemSemaphore.h>
+#include <dmzSystemSpinLock.h>
+#include <dmzSystemThread.h>
 #include <dmzTypesBase.h>
+#include <dmzTypesHandleContainer.h>
 #include <dmzTypesHashTableHandleTemplate.h>
 #include <dmzTypesMath.h>
 
@@ -26,6 +31,10 @@ namespace dmz {
       Boolean continuous;
       Boolean system;
 
+      Boolean threadSafe;
+      HandleContainer readSet;
+      HandleContainer writeSet;
+
       TimeSliceStruct *next;
       TimeSliceStruct *prev;
 
@@ -52,6 +61,7 @@ namespace dmz {
             timeSlice (theTimeSlice),
             continuous (False),
             system (False),
+            threadSafe (False),
             next (0),
             prev (0) { update (); }
 
@@ -74,11 +84,41 @@ namespace dmz {
       }
    };
 
+   struct TimeSliceWorkStruct {
+
+      TimeSliceStruct *timeSlice;
+      Float64 delta;
+
+      TimeSliceWorkStruct () : timeSlice (0), delta (0.0) {;}
+   };
+
+   class RuntimeContextTime;
+
+   class TimeSliceWorker : public ThreadFunction {
+
+      public:
+         TimeSliceWorker (RuntimeContextTime &context);
+         virtual ~TimeSliceWorker () {;}
+
+         virtual void run_thread_function ();
+
+      protected:
+         RuntimeContextTime &_context; //!< Time context.
+   };
+
    class RuntimeContextTime : public RefCountDeleteOnZero {
 
       public:
          //! Which attribute to update enum.
-         enum WhichEnum { Current, Factor, Frequency };
+         enum WhichEnum {
+            Current,
+            Factor,
+            Frequency,
+            ThreadCount,
+            Pacing,
+            SpinTime,
+            ResetStats
+         };
 
          struct updateStruct {
 
@@ -101,6 +141,13 @@ namespace dmz {
          void set_current_time (const Float64 Value);
          void set_time_factor (const Float64 Value);
          void set_target_frequency (const Float64 Value);
+         void set_thread_count (const UInt32 Value);
+         void set_pacing (const FramePacingEnum Mode);
+         void set_spin_time (const Float64 Value);
+         void reset_stats ();
+         void set_clock (FrameClock *theClock);
+
+         Float64 get_clock_time ();
 
          Int32 move_time_slice_to_end (const Handle TheHandle);
 
@@ -125,6 +172,12 @@ namespace dmz {
          Float64 targetFrequency; //!< Target frequency.
          Float64 targetFrameLength; //!< Target frame length.
 
+         FramePacingEnum pacing; //!< Frame pacing mode.
+         Float64 spinTime; //!< Minimum busy wait window for hybrid pacing.
+         Float64 spinWindow; //!< Current busy wait window for hybrid pacing.
+         FrameStats stats; //!< Frame timing statistics.
+         FrameClock *clock; //!< Optional clock used in place of the system clock.
+
          Mutex lock; //!< Lock.
          updateStruct *head; //!< Head of update list.
          updateStruct *tail; //!< Tail of update list.
@@ -134,11 +187,32 @@ namespace dmz {
          TimeSliceStruct *timeSliceHead;
          TimeSliceStruct *timeSliceNext;
 
+         UInt32 threadCount; //!< Number of worker threads.
+         TimeSliceWorker **workerList; //!< Worker threads.
+         Boolean workerQuit; //!< Signals worker threads to exit.
+         Semaphore workStart; //!< Posted once per worker when a stage is ready.
+         Semaphore workDone; //!< Posted by each worker when the stage is finished.
+         SpinLock workLock; //!< Lock for claiming staged time slices.
+         Int32 workNext; //!< Next staged time slice to run.
+         Int32 workCount; //!< Number of staged time slices.
+         Int32 workSize; //!< Size of the stage array.
+         TimeSliceWorkStruct *workList; //!< Stage of time slices run in parallel.
+         HandleContainer workReadSet; //!< Resources read by the current stage.
+         HandleContainer workWriteSet; //!< Resources written by the current stage.
+
+         void run_work ();
+
       private:
          ~RuntimeContextTime ();
 
          void _add_update (updateStruct *ptr);
+         void _pace_frame (const Float64 EndFrameTime);
+         Float64 _max_spin_window () const;
+         void _update_stats (const Float64 Period);
          void _update_time_slice (const Float64 RealTime, const Float64 RealDelta);
+         void _set_thread_count (const UInt32 Count);
+         Boolean _stage_time_slice (TimeSliceStruct &timeSlice, const Float64 Delta);
+         void _run_stage ();
    };
 };
 
@@ -2,16 +2,15 @@
 #include <dmzRuntimeData.h>
 #include <dmzRuntimeDefinitions.h>
 #include "dmzRuntimeIteratorState.h"
+#include <dmzSystemRefCount.h>
 #include <dmzSystemStream.h>
-#include <dmzTypesHashTableHandleTemplate.h>
-#include <dmzTypesHashTableUInt32Template.h>
 #include <dmzTypesMask.h>
 #include <dmzTypesMatrix.h>
 #include <dmzTypesString.h>
 #include <dmzTypesUUID.h>
 #include <dmzTypesVector.h>
 
-#include <string.h> // for memset and memcpy
+#include <string.h> // for memset, memcpy, and memcmp
 
 using namespace dmz;
 
@@ -41,6 +40,13 @@ void local_string_to (const String &From, Float64 &to) { to = string_to_float64
 static inline
 void local_string_to (const String &From, String &to) { to = From; }
 
+// Number of element bytes stored in the attribute before a buffer is allocated.
+// Large enough for a Vector.
+static const Int32 LocalBufferSize (24);
+
+// Number of attributes stored in the body before an attribute array is allocated.
+static const Int32 LocalAttrCount (4);
+
 struct attrStruct {
 
    const BaseTypeEnum Type;
@@ -58,157 +64,272 @@ static const attrStruct UInt32At (BaseTypeUInt32, sizeof (UInt32));
 static const attrStruct UInt64At (BaseTypeUInt64, sizeof (UInt64));
 static const attrStruct Float32At (BaseTypeFloat32, sizeof (Float32));
 static const attrStruct Float64At (BaseTypeFloat64, sizeof (Float64));
-static const attrStruct StringAt (BaseTypeString, sizeof (UInt32));
+static const attrStruct StringAt (BaseTypeString, sizeof (String *));
+
+
+static const attrStruct *
+local_get_attr (const BaseTypeEnum Type) {
+
+   const attrStruct *result (0);
+
+   if (Type == BaseTypeBoolean) { result = &BooleanAt; }
+   else if (Type == BaseTypeUInt32) { result = &UInt32At; }
+   else if (Type == BaseTypeUInt64) { result = &UInt64At; }
+   else if (Type == BaseTypeInt32) { result = &Int32At; }
+   else if (Type == BaseTypeInt64) { result = &Int64At; }
+   else if (Type == BaseTypeFloat32) { result = &Float32At; }
+   else if (Type == BaseTypeFloat64) { result = &Float64At; }
+   else if (Type == BaseTypeString) { result = &StringAt; }
+
+   return result;
+}
 
+// Plain struct so the attribute array may be grown with memcpy. The elements are
+// stored in the local buffer until they out grow it. String elements are stored as
+// String pointers owned by the attribute.
 struct dataStruct {
 
-   const Handle AttrHandle;
-   const attrStruct &Attr;
-   char *data;
+   Handle attrHandle;
+   const attrStruct *attr;
    Int32 size;
+   Int32 capacity;
+   char *heap;
+   union { Float64 align; char local[LocalBufferSize]; } buffer;
+
+   void init (const Handle TheHandle, const attrStruct &TheAttr) {
+
+      attrHandle = TheHandle;
+      attr = &TheAttr;
+      size = 0;
+      capacity = LocalBufferSize;
+      heap = 0;
+      memset (buffer.local, 0, LocalBufferSize);
+   }
+
+   void copy (const dataStruct &Value) {
+
+      init (Value.attrHandle, *(Value.attr));
+
+      if (Value.size > capacity) {
+
+         heap = new char[Value.size];
+
+         if (heap) { capacity = Value.size; }
+      }
+
+      if (Value.size <= capacity) {
+
+         size = Value.size;
+         memcpy (get_data (), Value.get_data (), size);
+
+         if (attr->Type == BaseTypeString) {
+
+            String **strings ((String **)get_data ());
+            const Int32 Count (get_element_count ());
+
+            for (Int32 ix = 0; ix < Count; ix++) {
+
+               if (strings[ix]) { strings[ix] = new String (*(strings[ix])); }
+            }
+         }
+      }
+   }
+
+   void release () {
+
+      if (attr->Type == BaseTypeString) {
+
+         String **strings ((String **)get_data ());
+         const Int32 Count (get_element_count ());
+
+         for (Int32 ix = 0; ix < Count; ix++) {
 
-   dataStruct (const Handle TheHandle, const attrStruct &TheAttr) :
-         AttrHandle (TheHandle),
-         Attr (TheAttr), data (0), size (0) {;}
+            if (strings[ix]) { delete strings[ix]; strings[ix] = 0; }
+         }
+      }
 
-   dataStruct (const dataStruct &Value) :
-         AttrHandle (Value.AttrHandle),
-         Attr (Value.Attr),
-         data (0),
-         size (0) { *this = Value; }
+      if (heap) { delete []heap; heap = 0; }
+      size = 0;
+      capacity = LocalBufferSize;
+   }
 
-   ~dataStruct () { if (data) { delete []data; data = 0; } }
+   char *get_data () { return heap ? heap : buffer.local; }
+   const char *get_data () const { return heap ? heap : buffer.local; }
 
-   Int32 get_element_count () const { return Attr.Size ? (size / Attr.Size) : 0; }
+   Int32 get_element_count () const { return attr->Size ? (size / attr->Size) : 0; }
 
    Boolean validate_offset (const Int32 Offset) {
 
       Boolean result (False);
-      const Int32 ElementSizeof (Attr.Size);
 
       if (Offset >= 0) {
 
-         if ((Offset + ElementSizeof) > size) {
+         const Int32 NewSize (Offset + attr->Size);
 
-            const Int32 NewSize = Offset + ElementSizeof;
-            char *ptr = new char[NewSize];
+         if (NewSize > capacity) {
 
-            if (ptr) {
+            Int32 newCapacity (capacity * 2);
+            if (newCapacity < NewSize) { newCapacity = NewSize; }
 
-               memset (ptr, 0, NewSize);
+            char *ptr = new char[newCapacity];
 
-               if (data && size) {
+            if (ptr) {
 
-                  memcpy (ptr, data, size);
-                  delete [](data); data = 0;
-               }
+               memset (ptr, 0, newCapacity);
+               if (size) { memcpy (ptr, get_data (), size); }
+               if (heap) { delete []heap; heap = 0; }
 
-               data = ptr;
-               size = NewSize;
-               result = True;
+               heap = ptr;
+               capacity = newCapacity;
             }
          }
-         else if (data) { result = True; }
+
+         if (NewSize <= capacity) {
+
+            if (NewSize > size) { size = NewSize; }
+            result = True;
+         }
       }
 
       return result;
    }
 
-   Boolean store_string_handle (const Int32 Element, const UInt32 StrHandle) {
-
-      Boolean result (False);
-      const Int32 ElementSizeof = Attr.Size;
-      const Int32 Offset = Element * ElementSizeof;
+   String *lookup_string (const Int32 Element) const {
 
-      const Boolean Validated (validate_offset (Offset));
+      String *result (0);
+      const Int32 Offset (Element * attr->Size);
 
-      if (data && Validated) {
+      if ((Offset >= 0) && ((Offset + attr->Size) <= size)) {
 
-         *((UInt32 *)(&(data[Offset]))) = StrHandle;
-         result = True;
+         result = *((String **)(&(get_data ()[Offset])));
       }
 
       return result;
    }
 
-   UInt32 lookup_string_handle (const Int32 Element) const {
+   String *create_string (const Int32 Element) {
+
+      String *result (0);
+      const Int32 Offset (Element * attr->Size);
 
-      UInt32 result (0);
-      const Int32 ElementSizeof = Attr.Size;
-      const Int32 Offset = Element * ElementSizeof;
+      if (validate_offset (Offset)) {
 
-      if (data && (Offset >= 0) && ((Offset + ElementSizeof) <= size)) {
+         String *&str (*((String **)(&(get_data ()[Offset]))));
 
-         result = *((UInt32 *)(&(data[Offset])));
+         if (!str) { str = new String; }
+
+         result = str;
       }
 
       return result;
    }
 
-   dataStruct &operator= (const dataStruct &Value) {
+   Boolean operator== (const dataStruct &Value) const {
+
+      return (attr == Value.attr) && (size == Value.size) &&
+         !memcmp (get_data (), Value.get_data (), size);
+   }
+
+   Boolean operator!= (const dataStruct &Value) const { return !(*this == Value); }
+};
 
-      if (size != Value.size) {
 
-         if (data) { delete []data; data = 0; }
-         size = Value.size;
+// Attribute storage shared between Data objects until one of them is changed.
+struct bodyStruct : public RefCountDeleteOnZero {
 
-         if (size) { data = new char[size]; }
+   Boolean shared;
+   Int32 count;
+   Int32 capacity;
+   dataStruct *list;
+   dataStruct local[LocalAttrCount];
 
-         if (data) { memset (data, 0, size); }
-      }
+   bodyStruct () :
+         shared (False),
+         count (0),
+         capacity (LocalAttrCount),
+         list (local) {;}
+
+   ~bodyStruct () {
+
+      for (Int32 ix = 0; ix < count; ix++) { list[ix].release (); }
+
+      if (list != local) { delete []list; list = 0; }
+      count = 0;
+   }
+
+   Boolean grow (const Int32 Needed) {
+
+      if (Needed > capacity) {
+
+         Int32 newCapacity (capacity * 2);
+         if (newCapacity < Needed) { newCapacity = Needed; }
 
-      if (data && Value.data) {
+         dataStruct *ptr (new dataStruct[newCapacity]);
 
-         memcpy (data, Value.data, size);
+         if (ptr) {
+
+            if (count) { memcpy (ptr, list, count * sizeof (dataStruct)); }
+            if (list != local) { delete []list; }
+
+            list = ptr;
+            capacity = newCapacity;
+         }
       }
 
-      return *this;
+      return Needed <= capacity;
    }
 
-   Boolean operator== (const dataStruct &Value) {
+   bodyStruct *clone () const {
 
-      Boolean result (False);
+      bodyStruct *result (new bodyStruct);
+
+      if (result && result->grow (count)) {
 
-      if (!data && !Value.data) { result = True; }
-      else if (data && Value.data && (Value.size == size) && (&Value.Attr == &Attr)) {
+         for (Int32 ix = 0; ix < count; ix++) { result->list[ix].copy (list[ix]); }
 
-         result = !memcmp (data, Value.data, size);
+         result->count = count;
       }
 
       return result;
    }
 
-   Boolean operator!= (const dataStruct &Value) { return !(*this == Value); }
-};
+   dataStruct *lookup (const Handle AttrHandle, Int32 &cache) {
+
+      dataStruct *result (0);
 
+      if ((cache < count) && (list[cache].attrHandle == AttrHandle)) {
 
-struct stringStruct {
+         result = &(list[cache]);
+      }
+      else if (((cache + 1) < count) && (list[cache + 1].attrHandle == AttrHandle)) {
 
-   UInt32 count;
-   HashTableUInt32Template<String> table;
+         cache++;
+         result = &(list[cache]);
+      }
 
-   stringStruct () : count (0) {;}
-   ~stringStruct () { table.empty (); }
+      for (Int32 ix = 0; !result && (ix < count); ix++) {
 
-   UInt32 get_next_handle () {
+         if (list[ix].attrHandle == AttrHandle) { result = &(list[ix]); cache = ix; }
+      }
 
-      count++;
-      while (table.lookup (count)) { count++; if (!count) { count++; } }
-      return count;
+      return result;
    }
 
-   stringStruct &operator= (const stringStruct &Table) {
+   dataStruct *add (const Handle AttrHandle, const attrStruct &Attr) {
 
-      count = Table.count;
+      dataStruct *result (0);
 
-      table.empty ();
-      table.copy (Table.table);
+      if (grow (count + 1)) {
 
-      return *this;
+         result = &(list[count]);
+         result->init (AttrHandle, Attr);
+         count++;
+      }
+
+      return result;
    }
 };
 
-typedef stringStruct * stringStructPtr;
 
 template <class T> class dataConvertTemplate {
 
@@ -216,17 +337,8 @@ template <class T> class dataConvertTemplate {
       dataConvertTemplate (const BaseTypeEnum Type);
       ~dataConvertTemplate () {;}
 
-      Boolean write (
-         const T &Value,
-         const Int32 Element,
-         stringStructPtr &table,
-         dataStruct &ds);
-
-      Boolean read (
-         const dataStruct &Ds,
-         const Int32 Element,
-         const stringStruct *Table,
-         T &data);
+      Boolean write (const T &Value, const Int32 Element, dataStruct &ds);
+      Boolean read (const dataStruct &Ds, const Int32 Element, T &data);
 
    protected:
       const BaseTypeEnum _Type;
@@ -243,18 +355,22 @@ template <class T> inline Boolean
 dataConvertTemplate<T>::write (
       const T &Value,
       const dmz::Int32 Element,
-      stringStructPtr &table,
       dataStruct &ds) {
 
    Boolean result (False);
 
-   const Int32 Offset = Element * ds.Attr.Size;
-   const BaseTypeEnum Type = ds.Attr.Type;
+   const Int32 Offset = Element * ds.attr->Size;
+   const BaseTypeEnum Type = ds.attr->Type;
+
+   if (Type == BaseTypeString) {
 
-   const Boolean Validated (ds.validate_offset (Offset));
-   char *ptr (ds.data);
+      String *str (ds.create_string (Element));
+
+      if (str) { str->flush () << Value; result = True; }
+   }
+   else if (ds.validate_offset (Offset)) {
 
-   if (ptr && Validated) {
+      char *ptr (ds.get_data ());
 
       result = True;
 
@@ -275,27 +391,6 @@ dataConvertTemplate<T>::write (
       else if (Type == BaseTypeUInt32) { *((UInt32 *)(&(ptr[Offset]))) = UInt32 (Value); }
       else if (Type == BaseTypeInt64) { *((Int64 *)(&(ptr[Offset]))) = Int64 (Value); }
       else if (Type == BaseTypeUInt64) { *((UInt64 *)(&(ptr[Offset]))) = UInt64 (Value); }
-      else if (Type == BaseTypeString) {
-
-         if (!table) { table = new stringStruct; }
-
-         if (table) {
-
-            UInt32 &handle (*((UInt32 *)(&(ptr[Offset]))));
-
-            String *str (0);
-
-            if (!handle) {
-
-               handle = table->get_next_handle ();
-               str = new String;
-               if (!table->table.store (handle, str)) { delete str; str = 0; }
-            }
-            else { str = table->table.lookup (handle); }
-
-            if (str) { str->flush () << Value; }
-         }
-      }
    }
 
    return result;
@@ -306,34 +401,33 @@ template <class T> inline Boolean
 dataConvertTemplate<T>::read (
       const dataStruct &Ds,
       const Int32 Element,
-      const stringStruct *Table,
       T &data) {
 
    Boolean result (False);
 
-   const Int32 ElementSizeof = Ds.Attr.Size;
+   const Int32 ElementSizeof = Ds.attr->Size;
    const Int32 Offset = Element * ElementSizeof;
-   const BaseTypeEnum Type = Ds.Attr.Type;
+   const BaseTypeEnum Type = Ds.attr->Type;
 
    if ((Offset >= 0) && ((Offset + ElementSizeof) <= Ds.size)) {
 
-      result = True;
+      const char *Ptr (Ds.get_data ());
 
-      if (Type == _Type) { data = *((T *)(&(Ds.data[Offset]))); }
-      else if (Type == BaseTypeFloat64) { data = T (*((Float64 *)(&(Ds.data[Offset])))); }
-      else if (Type == BaseTypeFloat32) { data = T (*((Float32 *)(&(Ds.data[Offset])))); }
-      else if (Type == BaseTypeInt32) { data = T (*((Int32 *)(&(Ds.data[Offset])))); }
-      else if (Type == BaseTypeBoolean) { data = T (*((UInt32 *)(&(Ds.data[Offset])))); }
-      else if (Type == BaseTypeUInt32) { data = T (*((UInt32 *)(&(Ds.data[Offset])))); }
-      else if (Type == BaseTypeInt64) { data = T (*((Int64 *)(&(Ds.data[Offset])))); }
-      else if (Type == BaseTypeUInt64) { data = T (*((UInt64 *)(&(Ds.data[Offset])))); }
-      else if (Table && (Type == BaseTypeString)) {
+      result = True;
 
-         const UInt32 Handle (UInt32 (*(&(Ds.data[Offset]))));
+      if (Type == _Type) { data = *((T *)(&(Ptr[Offset]))); }
+      else if (Type == BaseTypeFloat64) { data = T (*((Float64 *)(&(Ptr[Offset])))); }
+      else if (Type == BaseTypeFloat32) { data = T (*((Float32 *)(&(Ptr[Offset])))); }
+      else if (Type == BaseTypeInt32) { data = T (*((Int32 *)(&(Ptr[Offset])))); }
+      else if (Type == BaseTypeBoolean) { data = T (*((UInt32 *)(&(Ptr[Offset])))); }
+      else if (Type == BaseTypeUInt32) { data = T (*((UInt32 *)(&(Ptr[Offset])))); }
+      else if (Type == BaseTypeInt64) { data = T (*((Int64 *)(&(Ptr[Offset])))); }
+      else if (Type == BaseTypeUInt64) { data = T (*((UInt64 *)(&(Ptr[Offset])))); }
+      else if (Type == BaseTypeString) {
 
-         String *ptr = Table->table.lookup (Handle);
+         String *str (Ds.lookup_string (Element));
 
-         if (ptr) { local_string_to (*ptr, data); }
+         if (str) { local_string_to (*str, data); }
       }
    }
 
@@ -341,6 +435,44 @@ dataConvertTemplate<T>::read (
 }
 
 
+template <class T> static inline Boolean
+local_write_array (
+      dataConvertTemplate<T> &convert,
+      const Int32 Count,
+      const void *Values,
+      dataStruct &ds) {
+
+   Boolean result (True);
+   const T *Array ((const T *)Values);
+
+   for (Int32 ix = 0; result && (ix < Count); ix++) {
+
+      result = convert.write (Array[ix], ix, ds);
+   }
+
+   return result;
+}
+
+
+template <class T> static inline Boolean
+local_read_array (
+      dataConvertTemplate<T> &convert,
+      const dataStruct &Ds,
+      const Int32 Count,
+      void *values) {
+
+   Boolean result (True);
+   T *array ((T *)values);
+
+   for (Int32 ix = 0; result && (ix < Count); ix++) {
+
+      result = convert.read (Ds, ix, array[ix]);
+   }
+
+   return result;
+}
+
+
 static dataConvertTemplate<UInt32> booleanConvert (BaseTypeBoolean);
 static dataConvertTemplate<Int32> int32Convert (BaseTypeInt32);
 static dataConvertTemplate<Int64> int64Convert (BaseTypeInt64);
@@ -353,43 +485,59 @@ static dataConvertTemplate<Float64> float64Convert (BaseTypeFloat64);
 
 struct Data::State {
 
-   HashTableHandleTemplate<dataStruct> dataTable;
    RuntimeContext *context;
-   dataStruct *cache;
-   stringStruct *stringTable;
+   bodyStruct *body;
+   Int32 cache;
 
    State (RuntimeContext *theContext) :
          context (theContext),
-         cache (0),
-         stringTable (0) { if (context) { context->ref (); } }
+         body (0),
+         cache (0) { if (context) { context->ref (); } }
 
    void empty () {
 
       cache = 0;
-      dataTable.empty ();
-      if (stringTable) { delete stringTable; stringTable = 0; }
+      if (body) { body->unref (); body = 0; }
    }
 
    ~State () { empty (); if (context) { context->unref (); } }
 
+   // Called before the body is changed. A shared body is copied unless this is the
+   // last Data object using it.
+   void make_unique () {
+
+      if (body && body->shared) {
+
+         if (body->ref () > 2) {
+
+            bodyStruct *copy (body->clone ());
+
+            body->unref ();
+
+            if (copy) { body->unref (); body = copy; }
+         }
+         else { body->shared = False; body->unref (); }
+      }
+   }
+
+   // Passing in an AttrPtr means the attribute is about to be changed.
    dataStruct *get_data (const Handle AttrHandle, const attrStruct *AttrPtr = 0) {
 
       dataStruct *ds (0);
 
-      if (cache && (cache->AttrHandle == AttrHandle)) { ds = cache; }
+      if (AttrPtr) { make_unique (); }
 
-      if (!ds) {
+      if (body && (!AttrPtr || !body->shared)) { ds = body->lookup (AttrHandle, cache); }
 
-         ds = dataTable.lookup (AttrHandle);
+      if (!ds && AttrPtr && AttrHandle) {
 
-         if (!ds && AttrPtr && AttrHandle) {
+         if (!body) { body = new bodyStruct; }
 
-            ds = new dataStruct (AttrHandle, *AttrPtr);
+         if (body && !body->shared) {
 
-            if (!dataTable.store (AttrHandle, ds)) { delete ds; ds = 0; }
+            ds = body->add (AttrHandle, *AttrPtr);
+            if (ds) { cache = body->count - 1; }
          }
-
-         if (ds) { cache = ds; }
       }
 
       return ds;
@@ -397,16 +545,11 @@ struct Data::State {
 
    void to_string (const dataStruct &Ds, const Int32 Element, String &str) {
 
-      if (stringTable && Ds.Attr.Type == BaseTypeString) {
+      if (Ds.attr->Type == BaseTypeString) {
 
-         const UInt32 StrHandle (Ds.lookup_string_handle (Element));
+         String *ptr (Ds.lookup_string (Element));
 
-         if (StrHandle) {
-
-            String *ptr (stringTable->table.lookup (StrHandle));
-
-            if (ptr) { str = *ptr; }
-         }
+         if (ptr) { str = *ptr; }
       }
    }
 
@@ -423,15 +566,13 @@ struct Data::State {
          if (context) { context->ref (); }
       }
 
-      dataTable.empty ();
-      dataTable.copy (Value.dataTable);
+      if (Value.body != body) {
 
-      if (Value.stringTable) {
+         if (Value.body) { Value.body->ref (); Value.body->shared = True; }
+         if (body) { body->unref (); }
 
-         if (!stringTable) { stringTable = new stringStruct; }
-         if (stringTable) { *stringTable = *(Value.stringTable); }
+         body = Value.body;
       }
-      else if (stringTable) { delete stringTable; stringTable = 0; }
 
       return *this;
    };
@@ -508,24 +649,28 @@ dmz::Data::operator== (const Data &Value) const {
 
    Boolean result (False);
 
-   if (_state.dataTable.get_count () == Value._state.dataTable.get_count ()) {
+   bodyStruct *body (_state.body);
+   bodyStruct *compareBody (Value._state.body);
+
+   if (body == compareBody) { result = True; }
+   else if (get_attribute_count () == Value.get_attribute_count ()) {
 
       result = True;
-      HashTableHandleIterator it;
+      const Int32 Count (body ? body->count : 0);
 
-      dataStruct *ds (_state.dataTable.get_first (it));
+      for (Int32 ix = 0; result && (ix < Count); ix++) {
 
-      while (result && ds) {
+         const dataStruct *Ds (&(body->list[ix]));
 
-         dataStruct *compareDs (Value._state.dataTable.lookup (it.get_hash_key ()));
+         dataStruct *compareDs (Value._state.get_data (Ds->attrHandle));
 
          if (compareDs) {
 
-            if (compareDs->Attr.Type == ds->Attr.Type) {
+            if (compareDs->attr->Type == Ds->attr->Type) {
 
-               if (ds->Attr.Type == BaseTypeString) {
+               if (Ds->attr->Type == BaseTypeString) {
 
-                  const Int32 ElementCount (ds->get_element_count ());
+                  const Int32 ElementCount (Ds->get_element_count ());
                   Int32 elCount (0);
                   Boolean keepChecking (True);
 
@@ -536,7 +681,7 @@ dmz::Data::operator== (const Data &Value) const {
 
                         String str1, str2;
 
-                        _state.to_string (*ds, elCount, str1);
+                        _state.to_string (*Ds, elCount, str1);
                         Value._state.to_string (*compareDs, elCount, str2);
 
                         if (str1 != str2) { keepChecking = False; result = False; }
@@ -544,12 +689,10 @@ dmz::Data::operator== (const Data &Value) const {
                      }
                   }
                }
-               else if (*ds != *compareDs) {
+               else if (*Ds != *compareDs) {
 
                   result = False;
                }
-
-               ds = _state.dataTable.get_next (it);
             }
             else { result = False; }
          }
@@ -574,7 +717,7 @@ dmz::Data::operator!= (const Data &Value) const { return !(*this == Value); }
 
 */
 dmz::Boolean
-dmz::Data::operator! () const { return _state.dataTable.get_count () == 0; }
+dmz::Data::operator! () const { return get_attribute_count () == 0; }
 
 
 //! Gets RuntimeContext stored in Data object.
@@ -617,12 +760,9 @@ Returns zero if the Data object is empty.
 dmz::Handle
 dmz::Data::get_first_attribute (RuntimeIterator &it) const {
 
-   Handle result (0);
-
-   dataStruct *ptr = _state.dataTable.get_first (it.state.it);
-   if (ptr) { result = ptr->AttrHandle; _state.cache = ptr; }
+   it.state.index = 0;
 
-   return result;
+   return get_next_attribute (it);
 }
 
 
@@ -639,8 +779,15 @@ dmz::Data::get_next_attribute (RuntimeIterator &it) const {
 
    Handle result (0);
 
-   dataStruct *ptr = _state.dataTable.get_next (it.state.it);
-   if (ptr) { result = ptr->AttrHandle; _state.cache = ptr; }
+   bodyStruct *body (_state.body);
+   const Int32 Index (it.state.index);
+
+   if (body && (Index >= 0) && (Index < body->count)) {
+
+      result = body->list[Index].attrHandle;
+      _state.cache = Index;
+      it.state.index = Index + 1;
+   }
 
    return result;
 }
@@ -648,7 +795,10 @@ dmz::Data::get_next_attribute (RuntimeIterator &it) const {
 
 //! Returns number of attributes defined in the Data object.
 dmz::Int32
-dmz::Data::get_attribute_count () const { return _state.dataTable.get_count (); }
+dmz::Data::get_attribute_count () const {
+
+   return _state.body ? _state.body->count : 0;
+}
 
 
 /*!
@@ -667,7 +817,7 @@ dmz::Data::lookup_attribute_element_count (const Handle AttrHandle) const {
 
    if (ds) {
 
-      const Int32 ElementSizeof (ds->Attr.Size);
+      const Int32 ElementSizeof (ds->attr->Size);
       if (ElementSizeof) { result = ds->size / ElementSizeof; }
    }
 
@@ -689,7 +839,7 @@ dmz::Data::lookup_attribute_base_type_enum (const Handle AttrHandle) const {
 
    dataStruct *ds = _state.get_data (AttrHandle);
 
-   if (ds) { result = ds->Attr.Type; }
+   if (ds) { result = ds->attr->Type; }
 
    return result;
 }
@@ -716,7 +866,7 @@ dmz::Data::store_boolean (
 
    if (ds) {
 
-      result = booleanConvert.write (Value ? 1 : 0, Element, _state.stringTable, *ds);
+      result = booleanConvert.write (Value ? 1 : 0, Element, *ds);
    }
 
    return result;
@@ -747,7 +897,7 @@ dmz::Data::lookup_boolean (
 
       UInt32 uvalue (0);
 
-      if (booleanConvert.read (*ds, Element, _state.stringTable, uvalue)) {
+      if (booleanConvert.read (*ds, Element, uvalue)) {
 
          value = (uvalue > 0) ? True : False;
          result = True;
@@ -776,7 +926,7 @@ dmz::Data::store_uint32 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle, &UInt32At);
-   if (ds) { result = uint32Convert.write (Value, Element, _state.stringTable, *ds); }
+   if (ds) { result = uint32Convert.write (Value, Element, *ds); }
 
    return result;
 }
@@ -800,7 +950,7 @@ dmz::Data::lookup_uint32 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle);
-   if (ds) { result = uint32Convert.read (*ds, Element, _state.stringTable, value); }
+   if (ds) { result = uint32Convert.read (*ds, Element, value); }
 
    return result;
 }
@@ -824,7 +974,7 @@ dmz::Data::store_uint64 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle, &UInt64At);
-   if (ds) { result = uint64Convert.write (Value, Element, _state.stringTable, *ds); }
+   if (ds) { result = uint64Convert.write (Value, Element, *ds); }
 
    return result;
 }
@@ -848,7 +998,7 @@ dmz::Data::lookup_uint64 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle);
-   if (ds) { result = uint64Convert.read (*ds, Element, _state.stringTable, value); }
+   if (ds) { result = uint64Convert.read (*ds, Element, value); }
 
    return result;
 }
@@ -869,7 +1019,7 @@ dmz::Data::store_int32 (const Handle AttrHandle, const Int32 Element, const Int3
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle, &Int32At);
-   if (ds) { result = int32Convert.write (Value, Element, _state.stringTable, *ds); }
+   if (ds) { result = int32Convert.write (Value, Element, *ds); }
 
    return result;
 }
@@ -893,7 +1043,7 @@ dmz::Data::lookup_int32 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle);
-   if (ds) { result = int32Convert.read (*ds, Element, _state.stringTable, value); }
+   if (ds) { result = int32Convert.read (*ds, Element, value); }
 
    return result;
 }
@@ -914,7 +1064,7 @@ dmz::Data::store_int64 (const Handle AttrHandle, const Int32 Element, const Int6
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle, &Int64At);
-   if (ds) { result = int64Convert.write (Value, Element, _state.stringTable, *ds); }
+   if (ds) { result = int64Convert.write (Value, Element, *ds); }
 
    return result;
 }
@@ -938,7 +1088,7 @@ dmz::Data::lookup_int64 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle);
-   if (ds) { result = int64Convert.read (*ds, Element, _state.stringTable, value); }
+   if (ds) { result = int64Convert.read (*ds, Element, value); }
 
    return result;
 }
@@ -962,7 +1112,7 @@ dmz::Data::store_float32 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle, &Float32At);
-   if (ds) { result = float32Convert.write (Value, Element, _state.stringTable, *ds); }
+   if (ds) { result = float32Convert.write (Value, Element, *ds); }
 
    return result;
 }
@@ -986,7 +1136,7 @@ dmz::Data::lookup_float32 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle);
-   if (ds) { result = float32Convert.read (*ds, Element, _state.stringTable, value); }
+   if (ds) { result = float32Convert.read (*ds, Element, value); }
 
    return result;
 }
@@ -1010,7 +1160,7 @@ dmz::Data::store_float64 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle, &Float64At);
-   if (ds) { result = float64Convert.write (Value, Element, _state.stringTable, *ds); }
+   if (ds) { result = float64Convert.write (Value, Element, *ds); }
 
    return result;
 }
@@ -1034,7 +1184,7 @@ dmz::Data::lookup_float64 (
    Boolean result (False);
 
    dataStruct *ds = _state.get_data (AttrHandle);
-   if (ds) { result = float64Convert.read (*ds, Element, _state.stringTable, value); }
+   if (ds) { result = float64Convert.read (*ds, Element, value); }
 
    return result;
 }
@@ -1061,75 +1211,48 @@ dmz::Data::store_string (
 
    if (ds) {
 
-      const BaseTypeEnum Type = ds->Attr.Type;
+      const BaseTypeEnum Type = ds->attr->Type;
 
       if (Type == BaseTypeString) {
 
-         UInt32 handle (ds->lookup_string_handle (Element));
-
-         String *ptr (0);
-
-         if (!_state.stringTable) { _state.stringTable = new stringStruct; }
-
-         if (_state.stringTable) {
-
-            if (!handle) {
-
-               handle = _state.stringTable->get_next_handle ();
-
-               if (handle) {
+         String *ptr (ds->create_string (Element));
 
-                  if (ds->store_string_handle (Element, handle)) {
-
-                     ptr = new String;
-
-                     if (!_state.stringTable->table.store (handle, ptr)) {
-
-                        delete ptr; ptr = 0; handle = 0;
-                     }
-                  }
-                  else { handle = 0; }
-               }
-            }
-            else { ptr = _state.stringTable->table.lookup (handle); }
-
-            if (ptr) { *ptr = Value; result = True; }
-         }
+         if (ptr) { *ptr = Value; result = True; }
       }
       else if (Type == BaseTypeFloat64) {
 
          const Float64 Converted (string_to_float64 (Value));
-         result = float64Convert.write (Converted, Element, _state.stringTable, *ds);
+         result = float64Convert.write (Converted, Element, *ds);
       }
       else if (Type == BaseTypeFloat32) {
 
          const Float32 Converted (string_to_float32 (Value));
-         result = float32Convert.write (Converted, Element, _state.stringTable, *ds);
+         result = float32Convert.write (Converted, Element, *ds);
       }
       else if (Type == BaseTypeInt32) {
 
          const Int32 Converted (string_to_int32 (Value));
-         result = int32Convert.write (Converted, Element, _state.stringTable, *ds);
+         result = int32Convert.write (Converted, Element, *ds);
       }
       else if (Type == BaseTypeUInt32) {
 
          const UInt32 Converted (string_to_uint32 (Value));
-         result = uint32Convert.write (Converted, Element, _state.stringTable, *ds);
+         result = uint32Convert.write (Converted, Element, *ds);
       }
       else if (Type == BaseTypeInt64) {
 
          const Int64 Converted (string_to_int64 (Value));
-         result = int64Convert.write (Converted, Element, _state.stringTable, *ds);
+         result = int64Convert.write (Converted, Element, *ds);
       }
       else if (Type == BaseTypeUInt64) {
 
          const UInt64 Converted (string_to_uint64 (Value));
-         result = uint64Convert.write (Converted, Element, _state.stringTable, *ds);
+         result = uint64Convert.write (Converted, Element, *ds);
       }
       else if (Type == BaseTypeBoolean) {
 
          const UInt32 Converted (string_to_boolean (Value) ? 1 : 0);
-         result = booleanConvert.write (Converted, Element, _state.stringTable, *ds);
+         result = booleanConvert.write (Converted, Element, *ds);
       }
    }
 
@@ -1156,17 +1279,9 @@ dmz::Data::store_string (
 
    if (!_state.get_data (AttrHandle)) {
 
-      const attrStruct *Attr (&StringAt);
-
-      if (Type == BaseTypeBoolean) { Attr = &BooleanAt; }
-      else if (Type == BaseTypeUInt32) { Attr = &UInt32At; }
-      else if (Type == BaseTypeUInt64) { Attr = &UInt64At; }
-      else if (Type == BaseTypeInt32) { Attr = &Int32At; }
-      else if (Type == BaseTypeInt64) { Attr = &Int64At; }
-      else if (Type == BaseTypeFloat32) { Attr = &Float32At; }
-      else if (Type == BaseTypeFloat64) { Attr = &Float64At; }
+      const attrStruct *Attr (local_get_attr (Type));
 
-      _state.get_data (AttrHandle, Attr);
+      _state.get_data (AttrHandle, Attr ? Attr : &StringAt);
    }
 
    return store_string (AttrHandle, Element, Value);
@@ -1194,24 +1309,17 @@ dmz::Data::lookup_string (
 
    if (ds) {
 
-      const BaseTypeEnum Type = ds->Attr.Type;
+      const BaseTypeEnum Type = ds->attr->Type;
 
       if (Type == BaseTypeString) {
 
-         UInt32 strHandle (ds->lookup_string_handle (Element));
-
-         if (strHandle && _state.stringTable) {
-
-            String *ptr = _state.stringTable->table.lookup (strHandle);
+         String *ptr (ds->lookup_string (Element));
 
-            if (ptr) { value = *ptr; result = True; }
-         }
+         if (ptr) { value = *ptr; result = True; }
 
          if (!result) {
 
-            const Int32 AtSize (ds->Attr.Size);
-
-            if ((Element >= 0) && ((Element < AtSize) || (AtSize == 0))) {
+            if ((Element >= 0) && (Element < ds->get_element_count ())) {
 
                value.flush () << "";
                result = True;
@@ -1221,43 +1329,43 @@ dmz::Data::lookup_string (
       else if (Type == BaseTypeFloat64) {
 
          Float64 converted (0.0);
-         result = float64Convert.read (*ds, Element, _state.stringTable, converted);
+         result = float64Convert.read (*ds, Element, converted);
          value.flush () << converted;
       }
       else if (Type == BaseTypeFloat32) {
 
          Float32 converted (0.0f);
-         result = float32Convert.read (*ds, Element, _state.stringTable, converted);
+         result = float32Convert.read (*ds, Element, converted);
          value.flush () << converted;
       }
       else if (Type == BaseTypeInt32) {
 
          Int32 converted (0);
-         result = int32Convert.read (*ds, Element, _state.stringTable, converted);
+         result = int32Convert.read (*ds, Element, converted);
          value.flush () << converted;
       }
       else if (Type == BaseTypeUInt32) {
 
          UInt32 converted (0);
-         result = uint32Convert.read (*ds, Element, _state.stringTable, converted);
+         result = uint32Convert.read (*ds, Element, converted);
          value.flush () << converted;
       }
       else if (Type == BaseTypeInt64) {
 
          Int64 converted (0);
-         result = int64Convert.read (*ds, Element, _state.stringTable, converted);
+         result = int64Convert.read (*ds, Element, converted);
          value.flush () << converted;
       }
       else if (Type == BaseTypeUInt64) {
 
          UInt64 converted (0);
-         result = uint64Convert.read (*ds, Element, _state.stringTable, converted);
+         result = uint64Convert.read (*ds, Element, converted);
          value.flush () << converted;
       }
       else if (Type == BaseTypeBoolean) {
 
          UInt32 converted (0);
-         result = booleanConvert.read (*ds, Element, _state.stringTable, converted);
+         result = booleanConvert.read (*ds, Element, converted);
          value.flush () << (converted > 0 ? "true" : "false");
       }
    }
@@ -1294,9 +1402,9 @@ dmz::Data::store_vector (
       const Int32 Offset (Element * 3);
 
       result =
-         float64Convert.write (Value.get_x (), Offset, _state.stringTable, *ds) &&
-         float64Convert.write (Value.get_y (), Offset + 1, _state.stringTable, *ds) &&
-         float64Convert.write (Value.get_z (), Offset + 2, _state.stringTable, *ds);
+         float64Convert.write (Value.get_x (), Offset, *ds) &&
+         float64Convert.write (Value.get_y (), Offset + 1, *ds) &&
+         float64Convert.write (Value.get_z (), Offset + 2, *ds);
    }
 
    return result;
@@ -1333,9 +1441,9 @@ dmz::Data::lookup_vector (
 
       Float64 x (0.0), y (0.0), z (0.0);
 
-      if (float64Convert.read (*ds, Offset, _state.stringTable, x) &&
-            float64Convert.read (*ds, Offset + 1, _state.stringTable, y) &&
-            float64Convert.read (*ds, Offset + 2, _state.stringTable, z)) {
+      if (float64Convert.read (*ds, Offset, x) &&
+            float64Convert.read (*ds, Offset + 1, y) &&
+            float64Convert.read (*ds, Offset + 2, z)) {
 
          value.set_xyz (x, y, z);
          result = True;
@@ -1376,15 +1484,15 @@ dmz::Data::store_matrix (
       Value.to_array (array);
 
       result =
-         float64Convert.write (array[0], Offset, _state.stringTable, *ds) &&
-         float64Convert.write (array[1], Offset + 1, _state.stringTable, *ds) &&
-         float64Convert.write (array[2], Offset + 2, _state.stringTable, *ds) &&
-         float64Convert.write (array[3], Offset + 3, _state.stringTable, *ds) &&
-         float64Convert.write (array[4], Offset + 4, _state.stringTable, *ds) &&
-         float64Convert.write (array[5], Offset + 5, _state.stringTable, *ds) &&
-         float64Convert.write (array[6], Offset + 6, _state.stringTable, *ds) &&
-         float64Convert.write (array[7], Offset + 7, _state.stringTable, *ds) &&
-         float64Convert.write (array[8], Offset + 8, _state.stringTable, *ds);
+         float64Convert.write (array[0], Offset, *ds) &&
+         float64Convert.write (array[1], Offset + 1, *ds) &&
+         float64Convert.write (array[2], Offset + 2, *ds) &&
+         float64Convert.write (array[3], Offset + 3, *ds) &&
+         float64Convert.write (array[4], Offset + 4, *ds) &&
+         float64Convert.write (array[5], Offset + 5, *ds) &&
+         float64Convert.write (array[6], Offset + 6, *ds) &&
+         float64Convert.write (array[7], Offset + 7, *ds) &&
+         float64Convert.write (array[8], Offset + 8, *ds);
    }
 
    return result;
@@ -1420,15 +1528,15 @@ dmz::Data::lookup_matrix (
       const Int32 Offset (Element * 9);
       Float64 array[9] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
 
-      if (float64Convert.read (*ds, Offset, _state.stringTable, array[0]) &&
-            float64Convert.read (*ds, Offset + 1, _state.stringTable, array[1]) &&
-            float64Convert.read (*ds, Offset + 2, _state.stringTable, array[2]) &&
-            float64Convert.read (*ds, Offset + 3, _state.stringTable, array[3]) &&
-            float64Convert.read (*ds, Offset + 4, _state.stringTable, array[4]) &&
-            float64Convert.read (*ds, Offset + 5, _state.stringTable, array[5]) &&
-            float64Convert.read (*ds, Offset + 6, _state.stringTable, array[6]) &&
-            float64Convert.read (*ds, Offset + 7, _state.stringTable, array[7]) &&
-            float64Convert.read (*ds, Offset + 8, _state.stringTable, array[8])) {
+      if (float64Convert.read (*ds, Offset, array[0]) &&
+            float64Convert.read (*ds, Offset + 1, array[1]) &&
+            float64Convert.read (*ds, Offset + 2, array[2]) &&
+            float64Convert.read (*ds, Offset + 3, array[3]) &&
+            float64Convert.read (*ds, Offset + 4, array[4]) &&
+            float64Convert.read (*ds, Offset + 5, array[5]) &&
+            float64Convert.read (*ds, Offset + 6, array[6]) &&
+            float64Convert.read (*ds, Offset + 7, array[7]) &&
+            float64Convert.read (*ds, Offset + 8, array[8])) {
 
          value.from_array (array);
 
@@ -1539,29 +1647,19 @@ dmz::Data::store_mask (const Handle AttrHandle, const Mask &Value) {
 
    dataStruct *ds = _state.get_data (AttrHandle, &UInt32At);
 
-   if (ds && (ds->Attr.Type == BaseTypeUInt32)) {
+   if (ds && (ds->attr->Type == BaseTypeUInt32)) {
 
-      const Int32 ElementSize (ds->Attr.Size);
-      const Int32 Size (Value.get_size () * ElementSize);
+      const Int32 ElementSize (ds->attr->Size);
+      const Int32 Size (Value.get_size ());
 
-      if (Size > ds->size) {
+      if (Size > 0) { ds->validate_offset ((Size - 1) * ElementSize); }
 
-         if (ds->data) { delete [](ds->data); ds->data = 0; }
-         ds->size = 0;
+      if (ds->size) { memset (ds->get_data (), '\0', ds->size); }
 
-         ds->data = new char[Size];
-         if (ds->data) {
-
-            ds->size = Size;
-            memset (ds->data, '\0', ds->size);
-         }
-      }
-      else if (ds->data) { memset (ds->data, '\0', ds->size); }
-
-      if (ds->data && (ElementSize > 0)) {
+      if (ds->size && (ElementSize > 0)) {
 
          const Int32 Count = ds->size / ElementSize;
-         UInt32 *ptr = (UInt32 *)(ds->data);
+         UInt32 *ptr = (UInt32 *)(ds->get_data ());
 
          for (Int32 ix = 0; ix < Count; ix++) {
 
@@ -1594,9 +1692,9 @@ dmz::Data::lookup_mask (const Handle AttrHandle, Mask &value) const {
 
    dataStruct *ds = _state.get_data (AttrHandle);
 
-   if (ds && (ds->Attr.Type == BaseTypeUInt32)) {
+   if (ds && (ds->attr->Type == BaseTypeUInt32)) {
 
-      const Int32 ElementSize (ds->Attr.Size);
+      const Int32 ElementSize (ds->attr->Size);
 
       if (ElementSize > 0) {
 
@@ -1607,7 +1705,7 @@ dmz::Data::lookup_mask (const Handle AttrHandle, Mask &value) const {
 
           result = True;
 
-          UInt32 *ptr ((UInt32 *)(ds->data));
+          UInt32 *ptr ((UInt32 *)(ds->get_data ()));
 
           if (ptr) {
 
@@ -1623,6 +1721,154 @@ dmz::Data::lookup_mask (const Handle AttrHandle, Mask &value) const {
 }
 
 
+/*!
+
+\brief Stores an array of elements in an attribute.
+\details The elements are copied in one operation when the attribute has the same
+type as the array. Otherwise each element is converted to the type of the attribute.
+dmz::Boolean elements are passed as dmz::UInt32 values. String arrays are not supported.
+\param[in] AttrHandle Attribute handle.
+\param[in] Type BaseTypeEnum of the elements in \a Values.
+\param[in] Count Number of elements to store starting at element zero.
+\param[in] Values Pointer to the elements.
+\return Returns dmz::True if all the elements were successfully stored.
+
+*/
+dmz::Boolean
+dmz::Data::store_array (
+      const Handle AttrHandle,
+      const BaseTypeEnum Type,
+      const Int32 Count,
+      const void *Values) {
+
+   Boolean result (False);
+
+   const attrStruct *Attr (local_get_attr (Type));
+
+   dataStruct *ds (
+      (Attr && (Attr != &StringAt) && Values && (Count > 0)) ?
+         _state.get_data (AttrHandle, Attr) :
+         0);
+
+   if (ds) {
+
+      if (ds->attr == Attr) {
+
+         if (ds->validate_offset ((Count - 1) * Attr->Size)) {
+
+            memcpy (ds->get_data (), Values, Count * Attr->Size);
+            result = True;
+         }
+      }
+      else if (Type == BaseTypeBoolean) {
+
+         result = local_write_array (booleanConvert, Count, Values, *ds);
+      }
+      else if (Type == BaseTypeUInt32) {
+
+         result = local_write_array (uint32Convert, Count, Values, *ds);
+      }
+      else if (Type == BaseTypeUInt64) {
+
+         result = local_write_array (uint64Convert, Count, Values, *ds);
+      }
+      else if (Type == BaseTypeInt32) {
+
+         result = local_write_array (int32Convert, Count, Values, *ds);
+      }
+      else if (Type == BaseTypeInt64) {
+
+         result = local_write_array (int64Convert, Count, Values, *ds);
+      }
+      else if (Type == BaseTypeFloat32) {
+
+         result = local_write_array (float32Convert, Count, Values, *ds);
+      }
+      else if (Type == BaseTypeFloat64) {
+
+         result = local_write_array (float64Convert, Count, Values, *ds);
+      }
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Looks up an array of elements from an attribute.
+\details The elements are copied in one operation when the attribute has the same
+type as the array. Otherwise each element is converted from the type of the attribute.
+dmz::Boolean elements are returned as dmz::UInt32 values. String arrays are not
+supported.
+\param[in] AttrHandle Attribute handle.
+\param[in] Type BaseTypeEnum of the elements in \a values.
+\param[in] Count Number of elements to look up starting at element zero.
+\param[out] values Pointer to the array that receives the elements.
+\return Returns dmz::True if all the elements were successfully retrieved. Returns
+dmz::False if the attribute has less than \a Count elements.
+
+*/
+dmz::Boolean
+dmz::Data::lookup_array (
+      const Handle AttrHandle,
+      const BaseTypeEnum Type,
+      const Int32 Count,
+      void *values) const {
+
+   Boolean result (False);
+
+   const attrStruct *Attr (local_get_attr (Type));
+
+   dataStruct *ds (
+      (Attr && (Attr != &StringAt) && values && (Count > 0)) ?
+         _state.get_data (AttrHandle) :
+         0);
+
+   if (ds) {
+
+      if (ds->attr == Attr) {
+
+         if ((Count * Attr->Size) <= ds->size) {
+
+            memcpy (values, ds->get_data (), Count * Attr->Size);
+            result = True;
+         }
+      }
+      else if (Type == BaseTypeBoolean) {
+
+         result = local_read_array (booleanConvert, *ds, Count, values);
+      }
+      else if (Type == BaseTypeUInt32) {
+
+         result = local_read_array (uint32Convert, *ds, Count, values);
+      }
+      else if (Type == BaseTypeUInt64) {
+
+         result = local_read_array (uint64Convert, *ds, Count, values);
+      }
+      else if (Type == BaseTypeInt32) {
+
+         result = local_read_array (int32Convert, *ds, Count, values);
+      }
+      else if (Type == BaseTypeInt64) {
+
+         result = local_read_array (int64Convert, *ds, Count, values);
+      }
+      else if (Type == BaseTypeFloat32) {
+
+         result = local_read_array (float32Convert, *ds, Count, values);
+      }
+      else if (Type == BaseTypeFloat64) {
+
+         result = local_read_array (float64Convert, *ds, Count, values);
+      }
+   }
+
+   return result;
+}
+
+
 //! Write a Data object to the Stream.
 Stream &
 operator<< (Stream &stream, const Data &Value) {
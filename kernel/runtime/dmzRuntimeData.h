@@ -173,6 +173,18 @@ namespace dmz {
          Boolean store_mask (const Handle AttrHandle, const Mask &Value);
          Boolean lookup_mask (const Handle AttrHandle, Mask &value) const;
 
+         Boolean store_array (
+            const Handle AttrHandle,
+            const BaseTypeEnum Type,
+            const Int32 Count,
+            const void *Values);
+
+         Boolean lookup_array (
+            const Handle AttrHandle,
+            const BaseTypeEnum Type,
+            const Int32 Count,
+            void *values) const;
+
       protected:
          struct State;
          State &_state; //!< Internal state.
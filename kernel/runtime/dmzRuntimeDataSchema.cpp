@@ -0,0 +1,500 @@
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeConfigToTypesBase.h>
+#include "dmzRuntimeContext.h"
+#include <dmzRuntimeData.h>
+#include <dmzRuntimeDataSchema.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimeLog.h>
+#include <dmzTypesBase.h>
+#include <dmzTypesHashTableStringTemplate.h>
+#include <dmzTypesString.h>
+
+/*!
+
+\class dmz::DataSchema
+\ingroup Runtime
+\brief Maps the attributes of a Data object to a fixed binary layout.
+\details A DataSchema is a list of fields. Each field has a name, a base type, an
+element count, and a byte offset in the layout. The named handles of the fields are
+created once when the fields are added so reading and writing the layout does not
+look up any names. The elements of each field are copied between the layout and the
+Data object as a single array. The Data objects written by the schema are ordinary
+Data objects and may be used by any Data consumer. \n \n
+The layout may be a C struct by passing the offset of each member when the field is
+added:
+\code
+struct InputStruct { dmz::Float64 axis[2]; dmz::UInt32 buttons; };
+
+dmz::DataSchema schema (context, &log);
+schema.add_field ("axis", dmz::BaseTypeFloat64, 2, offsetof (InputStruct, axis));
+schema.add_field ("buttons", dmz::BaseTypeUInt32, 1, offsetof (InputStruct, buttons));
+
+InputStruct input = { { 0.5, -0.5 }, 3 };
+dmz::Data data;
+schema.write_data (&input, data);
+\endcode
+The fields may also be defined in a Config:
+\code
+<schema>
+   <field name="Field Name" type="Base Type" count="Element Count"/>
+</schema>
+\endcode
+Only numeric base types and dmz::BaseTypeBoolean are supported. Boolean elements are
+stored in the layout as dmz::UInt32 values.
+
+*/
+
+//! \cond
+namespace {
+
+struct fieldStruct {
+
+   const dmz::String Name;
+   const dmz::Int32 Index;
+   const dmz::Handle AttrHandle;
+   const dmz::BaseTypeEnum Type;
+   const dmz::Int32 Count;
+   const dmz::Int32 Offset;
+
+   fieldStruct (
+         const dmz::String &TheName,
+         const dmz::Int32 TheIndex,
+         const dmz::Handle TheHandle,
+         const dmz::BaseTypeEnum TheType,
+         const dmz::Int32 TheCount,
+         const dmz::Int32 TheOffset) :
+         Name (TheName),
+         Index (TheIndex),
+         AttrHandle (TheHandle),
+         Type (TheType),
+         Count (TheCount),
+         Offset (TheOffset) {;}
+};
+
+
+static dmz::Int32
+local_element_size (const dmz::BaseTypeEnum Type) {
+
+   dmz::Int32 result (0);
+
+   if (Type == dmz::BaseTypeBoolean) { result = sizeof (dmz::UInt32); }
+   else if (Type == dmz::BaseTypeUInt32) { result = sizeof (dmz::UInt32); }
+   else if (Type == dmz::BaseTypeUInt64) { result = sizeof (dmz::UInt64); }
+   else if (Type == dmz::BaseTypeInt32) { result = sizeof (dmz::Int32); }
+   else if (Type == dmz::BaseTypeInt64) { result = sizeof (dmz::Int64); }
+   else if (Type == dmz::BaseTypeFloat32) { result = sizeof (dmz::Float32); }
+   else if (Type == dmz::BaseTypeFloat64) { result = sizeof (dmz::Float64); }
+
+   return result;
+}
+
+};
+
+
+struct dmz::DataSchema::State {
+
+   RuntimeContext *context;
+   Definitions defs;
+   Log *log;
+   HashTableStringTemplate<fieldStruct> nameTable;
+   fieldStruct **list;
+   Int32 count;
+   Int32 capacity;
+   Int32 size;
+
+   State (
+         RuntimeContext *theContext,
+         Log *theLog) :
+         context (theContext),
+         defs (theContext),
+         log (theLog),
+         list (0),
+         count (0),
+         capacity (0),
+         size (0) { if (context) { context->ref (); } }
+
+   ~State () {
+
+      nameTable.clear ();
+
+      if (list) {
+
+         for (Int32 ix = 0; ix < count; ix++) { delete list[ix]; list[ix] = 0; }
+         delete []list; list = 0;
+      }
+
+      if (context) { context->unref (); context = 0; }
+   }
+
+   fieldStruct *get_field (const Int32 Field) const {
+
+      return ((Field >= 0) && (Field < count)) ? list[Field] : 0;
+   }
+
+   Boolean add (fieldStruct *field) {
+
+      if (count >= capacity) {
+
+         const Int32 NewCapacity (capacity ? capacity * 2 : 8);
+         fieldStruct **ptr (new fieldStruct *[NewCapacity]);
+
+         if (ptr) {
+
+            for (Int32 ix = 0; ix < count; ix++) { ptr[ix] = list[ix]; }
+            if (list) { delete []list; }
+
+            list = ptr;
+            capacity = NewCapacity;
+         }
+      }
+
+      Boolean result (False);
+
+      if ((count < capacity) && nameTable.store (field->Name, field)) {
+
+         list[count] = field;
+         count++;
+         result = True;
+      }
+
+      return result;
+   }
+};
+//! \endcond
+
+
+/*!
+
+\brief Constructor.
+\param[in] context Pointer to the runtime context.
+\param[in] log Pointer to the Log to be used for logging. May be NULL.
+
+*/
+dmz::DataSchema::DataSchema (
+      RuntimeContext *context,
+      Log *log) :
+      _state (*(new State (context, log))) {
+}
+
+
+//! Destructor.
+dmz::DataSchema::~DataSchema () { delete &_state; }
+
+
+/*!
+
+\brief Adds the fields defined in a Config.
+\details Each \b field child of \a Source defines a field that is appended to the
+layout. The \b count attribute defaults to one.
+\param[in] Source Config containing the field definitions.
+\return Returns dmz::True if all the fields were successfully added.
+
+*/
+dmz::Boolean
+dmz::DataSchema::add_fields (const Config &Source) {
+
+   Boolean result (True);
+
+   Config fieldList;
+
+   if (Source.lookup_all_config ("field", fieldList)) {
+
+      ConfigIterator it;
+      Config field;
+
+      while (fieldList.get_next_config (it, field)) {
+
+         const Int32 Field (add_field (
+            config_to_string ("name", field),
+            config_to_base_type_enum ("type", field, BaseTypeUnknown),
+            config_to_int32 ("count", field, 1)));
+
+         if (Field < 0) { result = False; }
+      }
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Adds a field to the layout.
+\param[in] Name String containing the name of the attribute's named handle.
+\param[in] Type BaseTypeEnum of the field's elements.
+\param[in] ElementCount Number of elements in the field.
+\param[in] Offset Byte offset of the field in the layout. If the offset is negative,
+the field is appended to the end of the layout and aligned to the size of its
+elements. The offset must be a multiple of the size of the field's elements.
+\return Returns the index of the field. Returns -1 if the field could not be added.
+
+*/
+dmz::Int32
+dmz::DataSchema::add_field (
+      const String &Name,
+      const BaseTypeEnum Type,
+      const Int32 ElementCount,
+      const Int32 Offset) {
+
+   Int32 result (-1);
+
+   const Int32 ElementSize (local_element_size (Type));
+
+   if (!ElementSize) {
+
+      if (_state.log) {
+
+         _state.log->error << "Unsupported type: " << base_type_enum_to_string (Type)
+            << " for schema field: " << Name << endl;
+      }
+   }
+   else if (ElementCount <= 0) {
+
+      if (_state.log) {
+
+         _state.log->error << "Invalid element count: " << ElementCount
+            << " for schema field: " << Name << endl;
+      }
+   }
+   else if ((Offset >= 0) && (Offset % ElementSize)) {
+
+      if (_state.log) {
+
+         _state.log->error << "Offset: " << Offset << " is not aligned for schema field: "
+            << Name << endl;
+      }
+   }
+   else if (_state.nameTable.lookup (Name)) {
+
+      if (_state.log) {
+
+         _state.log->error << "Duplicate schema field: " << Name << endl;
+      }
+   }
+   else {
+
+      const Handle AttrHandle (_state.defs.create_named_handle (Name));
+
+      Int32 offset (Offset);
+
+      if (offset < 0) {
+
+         offset = _state.size;
+         if (offset % ElementSize) { offset += ElementSize - (offset % ElementSize); }
+      }
+
+      fieldStruct *field (
+         AttrHandle ?
+            new fieldStruct (Name, _state.count, AttrHandle, Type, ElementCount, offset) :
+            0);
+
+      if (field && _state.add (field)) {
+
+         result = _state.count - 1;
+
+         const Int32 End (offset + (ElementSize * ElementCount));
+         if (End > _state.size) { _state.size = End; }
+      }
+      else if (field) { delete field; field = 0; }
+   }
+
+   return result;
+}
+
+
+//! Returns the number of fields in the layout.
+dmz::Int32
+dmz::DataSchema::get_field_count () const { return _state.count; }
+
+
+/*!
+
+\brief Looks up the index of a field.
+\param[in] Name String containing the name of the field.
+\return Returns the index of the field. Returns -1 if the field is not found.
+
+*/
+dmz::Int32
+dmz::DataSchema::lookup_field (const String &Name) const {
+
+   fieldStruct *field (_state.nameTable.lookup (Name));
+   return field ? field->Index : -1;
+}
+
+
+/*!
+
+\brief Gets the attribute handle of a field.
+\param[in] Field Index of the field.
+\return Returns the named handle of the field. Returns zero if the field is not found.
+
+*/
+dmz::Handle
+dmz::DataSchema::get_field_handle (const Int32 Field) const {
+
+   fieldStruct *field (_state.get_field (Field));
+   return field ? field->AttrHandle : 0;
+}
+
+
+/*!
+
+\brief Gets the base type of a field.
+\param[in] Field Index of the field.
+\return Returns the BaseTypeEnum of the field. Returns dmz::BaseTypeUnknown if the
+field is not found.
+
+*/
+dmz::BaseTypeEnum
+dmz::DataSchema::get_field_type (const Int32 Field) const {
+
+   fieldStruct *field (_state.get_field (Field));
+   return field ? field->Type : BaseTypeUnknown;
+}
+
+
+/*!
+
+\brief Gets the element count of a field.
+\param[in] Field Index of the field.
+\return Returns the number of elements in the field. Returns zero if the field is not
+found.
+
+*/
+dmz::Int32
+dmz::DataSchema::get_field_element_count (const Int32 Field) const {
+
+   fieldStruct *field (_state.get_field (Field));
+   return field ? field->Count : 0;
+}
+
+
+/*!
+
+\brief Gets the byte offset of a field in the layout.
+\param[in] Field Index of the field.
+\return Returns the offset of the field. Returns -1 if the field is not found.
+
+*/
+dmz::Int32
+dmz::DataSchema::get_field_offset (const Int32 Field) const {
+
+   fieldStruct *field (_state.get_field (Field));
+   return field ? field->Offset : -1;
+}
+
+
+//! Returns the number of bytes used by the layout.
+dmz::Int32
+dmz::DataSchema::get_size () const { return _state.size; }
+
+
+/*!
+
+\brief Reads all the fields from a Data object in to a layout.
+\param[in] InData Data object to read.
+\param[out] buffer Pointer to the layout. Must be at least dmz::DataSchema::get_size
+bytes.
+\return Returns dmz::True if all the fields were successfully read.
+
+*/
+dmz::Boolean
+dmz::DataSchema::read_data (const Data &InData, void *buffer) const {
+
+   Boolean result (buffer && _state.count ? True : False);
+
+   for (Int32 ix = 0; buffer && (ix < _state.count); ix++) {
+
+      if (!read_field (ix, InData, buffer)) { result = False; }
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Writes all the fields from a layout to a Data object.
+\param[in] Buffer Pointer to the layout.
+\param[out] outData Data object to write to.
+\return Returns dmz::True if all the fields were successfully written.
+
+*/
+dmz::Boolean
+dmz::DataSchema::write_data (const void *Buffer, Data &outData) const {
+
+   Boolean result (Buffer && _state.count ? True : False);
+
+   if (_state.context) { outData.set_runtime_context (_state.context); }
+
+   for (Int32 ix = 0; Buffer && (ix < _state.count); ix++) {
+
+      if (!write_field (ix, Buffer, outData)) { result = False; }
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Reads a single field from a Data object in to a layout.
+\param[in] Field Index of the field.
+\param[in] InData Data object to read.
+\param[out] buffer Pointer to the layout.
+\return Returns dmz::True if the field was successfully read.
+
+*/
+dmz::Boolean
+dmz::DataSchema::read_field (
+      const Int32 Field,
+      const Data &InData,
+      void *buffer) const {
+
+   Boolean result (False);
+
+   fieldStruct *field (_state.get_field (Field));
+
+   if (field && buffer) {
+
+      result = InData.lookup_array (
+         field->AttrHandle,
+         field->Type,
+         field->Count,
+         ((char *)buffer) + field->Offset);
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Writes a single field from a layout to a Data object.
+\param[in] Field Index of the field.
+\param[in] Buffer Pointer to the layout.
+\param[out] outData Data object to write to.
+\return Returns dmz::True if the field was successfully written.
+
+*/
+dmz::Boolean
+dmz::DataSchema::write_field (
+      const Int32 Field,
+      const void *Buffer,
+      Data &outData) const {
+
+   Boolean result (False);
+
+   fieldStruct *field (_state.get_field (Field));
+
+   if (field && Buffer) {
+
+      result = outData.store_array (
+         field->AttrHandle,
+         field->Type,
+         field->Count,
+         ((const char *)Buffer) + field->Offset);
+   }
+
+   return result;
+}
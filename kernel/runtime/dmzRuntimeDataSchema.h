@@ -0,0 +1,58 @@
+#ifndef DMZ_RUNTIME_DATA_SCHEMA_DOT_H
+#define DMZ_RUNTIME_DATA_SCHEMA_DOT_H
+
+#include <dmzKernelExport.h>
+#include <dmzTypesBase.h>
+
+namespace dmz {
+
+   class Config;
+   class Data;
+   class Log;
+   class RuntimeContext;
+   class String;
+
+   class DMZ_KERNEL_LINK_SYMBOL DataSchema {
+
+      public:
+         DataSchema (RuntimeContext *context, Log *log = 0);
+         ~DataSchema ();
+
+         Boolean add_fields (const Config &Source);
+
+         Int32 add_field (
+            const String &Name,
+            const BaseTypeEnum Type,
+            const Int32 ElementCount = 1,
+            const Int32 Offset = -1);
+
+         Int32 get_field_count () const;
+         Int32 lookup_field (const String &Name) const;
+         Handle get_field_handle (const Int32 Field) const;
+         BaseTypeEnum get_field_type (const Int32 Field) const;
+         Int32 get_field_element_count (const Int32 Field) const;
+         Int32 get_field_offset (const Int32 Field) const;
+         Int32 get_size () const;
+
+         Boolean read_data (const Data &InData, void *buffer) const;
+         Boolean write_data (const void *Buffer, Data &outData) const;
+
+         Boolean read_field (const Int32 Field, const Data &InData, void *buffer) const;
+
+         Boolean write_field (
+            const Int32 Field,
+            const void *Buffer,
+            Data &outData) const;
+
+      protected:
+         struct State;
+         State &_state; //!< Internal state.
+
+      private:
+         DataSchema ();
+         DataSchema (const DataSchema &);
+         DataSchema &operator= (const DataSchema &);
+   };
+};
+
+#endif // DMZ_RUNTIME_DATA_SCHEMA_DOT_H
@@ -141,6 +141,8 @@ dmz::EventType::set_type (const Handle TypeHandle, RuntimeContext *context) {
 /*!
 
 \brief Test if event type is a related type.
+\details Each type is numbered with a pre-order interval that is rebuilt when
+new types are defined so the test is two integer comparisons.
 \param[in] Type EventType to test against.
 \return Returns dmz::True if \a Type is the same or a parent.
 
@@ -148,20 +150,7 @@ dmz::EventType::set_type (const Handle TypeHandle, RuntimeContext *context) {
 dmz::Boolean
 dmz::EventType::is_of_type (const EventType &Type) const {
 
-   Boolean result (False);
-
-   EventType current (_context);
-
-   if (Type) {
-
-      while (current && !result) {
-
-         if (Type == current) { result = True; }
-         else { current.become_parent (); }
-      }
-   }
-
-   return result;
+   return _context ? _context->is_of_type (Type._context) : False;
 }
 
 
@@ -389,12 +378,14 @@ dmz::EventType::get_type_context () const { return _context; }
 struct dmz::EventTypeSet::State {
 
    HashTableHandleTemplate<EventType> table;
+   TypeIntervalList intervals;
 
    ~State () { table.empty (); }
 
    State &operator= (const State &Value) {
 
       table.copy (Value.table);
+      intervals.invalidate ();
       return *this;
    }
 };
@@ -457,7 +448,8 @@ dmz::EventTypeSet::add_event_type (const EventType &Type) {
 
       result = _state.table.store (ptr->get_handle (), ptr);
 
-      if (!result) { delete ptr; ptr = 0; }
+      if (result) { _state.intervals.invalidate (); }
+      else { delete ptr; ptr = 0; }
    }
 
    return result;
@@ -483,7 +475,8 @@ dmz::EventTypeSet::add_event_type (const String &Name, RuntimeContext *context)
 
       result = _state.table.store (ptr->get_handle (), ptr);
 
-      if (!result) { delete ptr; ptr = 0; }
+      if (result) { _state.intervals.invalidate (); }
+      else { delete ptr; ptr = 0; }
    }
 
    return result;
@@ -509,7 +502,8 @@ dmz::EventTypeSet::add_event_type (const Handle TypeHandle, RuntimeContext *cont
 
       result = _state.table.store (ptr->get_handle (), ptr);
 
-      if (!result) { delete ptr; ptr = 0; }
+      if (result) { _state.intervals.invalidate (); }
+      else { delete ptr; ptr = 0; }
    }
 
    return result;
@@ -555,6 +549,7 @@ dmz::EventTypeSet::remove_event_type (const EventType &Type) {
    if (ptr)  {
 
       delete ptr; ptr = 0;
+      _state.intervals.invalidate ();
       result = True;
    }
 
@@ -579,7 +574,12 @@ dmz::EventTypeSet::remove_event_type (const String &Name, RuntimeContext *contex
 
    EventType *ptr (_state.table.remove (tmp.get_handle ()));
 
-   if (ptr)  { delete ptr; ptr = 0; result = True; }
+   if (ptr)  {
+
+      delete ptr; ptr = 0;
+      _state.intervals.invalidate ();
+      result = True;
+   }
 
    return result;
 }
@@ -602,7 +602,12 @@ dmz::EventTypeSet::remove_event_type (const Handle TypeHandle, RuntimeContext *c
 
    EventType *ptr (_state.table.remove (tmp.get_handle ()));
 
-   if (ptr)  { delete ptr; ptr = 0; result = True; }
+   if (ptr)  {
+
+      delete ptr; ptr = 0;
+      _state.intervals.invalidate ();
+      result = True;
+   }
 
    return result;
 }
@@ -611,6 +616,8 @@ dmz::EventTypeSet::remove_event_type (const Handle TypeHandle, RuntimeContext *c
 /*!
 
 \brief Tests if event type is stored in set.
+\details The set keeps a sorted list of the type intervals it covers so the
+test is a binary search instead of a walk up the parent chain.
 \param[in] Type EventType to use in test.
 \return Returns dmz::True if the \a Type or one of its parents is contained in the set.
 
@@ -622,7 +629,9 @@ dmz::EventTypeSet::contains_type (const EventType &Type) const {
 
    EventType current (Type);
 
-   Boolean done (current ? False : True);
+   Boolean done (
+      !current || !_state.table.get_count () ||
+      _state.intervals.contains (_state.table, current.get_type_context (), result));
 
    while (!done) {
 
@@ -20,7 +20,7 @@ struct dmz::RuntimeHandle::RuntimeHandleState {
    Handle handle;
    HandleAllocator *allocator;
 
-   RuntimeHandleState (const String &Info, RuntimeContext *context) :
+   RuntimeHandleState (const String *Info, RuntimeContext *context) :
          handle (0),
          allocator (0) {
 
@@ -31,19 +31,23 @@ struct dmz::RuntimeHandle::RuntimeHandleState {
          if (allocator) {
 
             allocator->ref ();
-            handle = allocator->get_next_handle (Info);
+            handle = Info ?
+               allocator->get_next_handle (*Info) :
+               allocator->get_next_handle ();
          }
       }
    }
 
-   RuntimeHandleState (const String &Info, HandleAllocator *theAllocator) :
+   RuntimeHandleState (const String *Info, HandleAllocator *theAllocator) :
          handle (0),
          allocator (theAllocator) {
 
       if (allocator) {
 
          allocator->ref ();
-         handle = allocator->get_next_handle (Info);
+         handle = Info ?
+            allocator->get_next_handle (*Info) :
+            allocator->get_next_handle ();
       }
    }
 
@@ -69,7 +73,7 @@ It will not be unique with handles allocated using a HandleAllocator.
 
 */
 dmz::RuntimeHandle::RuntimeHandle (const String &Info, RuntimeContext *context) :
-      __state (*(new RuntimeHandleState (Info, context))) {;}
+      __state (*(new RuntimeHandleState (&Info, context))) {;}
 
 
 /*!
@@ -82,7 +86,32 @@ It will not be unique with handles allocated using other HandleAllocators.
 
 */
 dmz::RuntimeHandle::RuntimeHandle (const String &Info, HandleAllocator *allocator) :
-      __state (*(new RuntimeHandleState (Info, allocator))) {;}
+      __state (*(new RuntimeHandleState (&Info, allocator))) {;}
+
+
+/*!
+
+\brief Anonymous unique runtime handle constructor.
+\details This constructor will create a handle that is unique within the runtime
+without storing a description. Use it when many handles are allocated and their
+descriptions are only needed for debugging. dmz::RuntimeHandle::get_handle_info
+returns a description built from the handle value.
+\param[in] context Pointer to the runtime context.
+
+*/
+dmz::RuntimeHandle::RuntimeHandle (RuntimeContext *context) :
+      __state (*(new RuntimeHandleState ((const String *)0, context))) {;}
+
+
+/*!
+
+\brief Anonymous unique handle from a given HandleAllocator constructor.
+\param[in] allocator Pointer to the HandleAllocator to use in handle creation.
+\see dmz::RuntimeHandle::RuntimeHandle(RuntimeContext *)
+
+*/
+dmz::RuntimeHandle::RuntimeHandle (HandleAllocator *allocator) :
+      __state (*(new RuntimeHandleState ((const String *)0, allocator))) {;}
 
 
 //! Destructor. Release allocated handle.
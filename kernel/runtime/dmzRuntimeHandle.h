@@ -14,6 +14,8 @@ namespace dmz {
       public:
          RuntimeHandle (const String &Info, RuntimeContext *context);
          RuntimeHandle (const String &Info, HandleAllocator *allocator);
+         explicit RuntimeHandle (RuntimeContext *context);
+         explicit RuntimeHandle (HandleAllocator *allocator);
          ~RuntimeHandle ();
 
          Handle get_runtime_handle () const;
@@ -19,6 +19,7 @@ struct dmz::HandleAllocator::State {
 
    const Handle MinHandle;
    const Handle MaxHandle;
+   const String Anonymous;
    Handle count;
    Mutex lock;
    HashTableHandleTemplate<String> table;
@@ -35,13 +36,22 @@ struct dmz::HandleAllocator::State {
       if (MaxHandle && (MaxHandle < count)) { count = MaxHandle; }
    }
 
-   ~State () { table.empty (); }
+   ~State () {
 
-   Handle save_handle (const Handle TheHandle, const String &Info) {
+      HashTableHandleIterator it;
+      String *ptr (0);
+
+      while (table.get_next (it, ptr)) { if (ptr != &Anonymous) { delete ptr; } }
+
+      table.clear ();
+   }
+
+   // Anonymous handles share the Anonymous string so no info is allocated for them.
+   Handle save_handle (const Handle TheHandle, const String *Info) {
 
       Handle result (0);
 
-      String *ptr = new String (Info);
+      String *ptr = Info ? new String (*Info) : (String *)&Anonymous;
 
       if (ptr) {
 
@@ -49,11 +59,50 @@ struct dmz::HandleAllocator::State {
 
             result = TheHandle;
          }
-         else { delete ptr; ptr = 0; }
+         else if (ptr != &Anonymous) { delete ptr; ptr = 0; }
       }
 
       return result;
    }
+
+   // Must be called with the lock held.
+   Handle next_handle (const String *Info) {
+
+      Handle handle (0);
+
+      const Handle Range (MaxHandle ? (MaxHandle - MinHandle) + 1 : 0 - MinHandle);
+      Handle tried (0);
+
+      while (!handle && (tried < Range)) {
+
+         if ((MaxHandle && (MaxHandle < count)) || (count < MinHandle)) {
+
+            count = MinHandle;
+         }
+
+         if (!table.lookup (count)) { handle = save_handle (count, Info); }
+
+         count++;
+         tried++;
+      }
+
+      return handle;
+   }
+
+   // Must be called with the lock held.
+   Handle request_handle (const Handle RequestedHandle, const String *Info) {
+
+      Handle handle (0);
+
+      if ((RequestedHandle < MinHandle) || (MaxHandle && (RequestedHandle > MaxHandle))) {
+
+         handle = next_handle (Info);
+      }
+      else if (table.lookup (RequestedHandle)) { handle = next_handle (Info); }
+      else { handle = save_handle (RequestedHandle, Info); }
+
+      return handle;
+   }
 };
 
 
@@ -95,39 +144,31 @@ dmz::HandleAllocator::~HandleAllocator () { delete &_state; }
 dmz::Handle
 dmz::HandleAllocator::get_next_handle (const String &Info) {
 
-   Handle handle (0);
-
-   Boolean done (False);
-
    _state.lock.lock ();
+   const Handle Result (_state.next_handle (&Info));
+   _state.lock.unlock ();
 
-   do {
-
-      if (!_state.table.lookup (_state.count)) {
-
-         done = True;
-         handle = _state.save_handle (_state.count, Info);
-         _state.count++;
-      }
-      else {
-
-         _state.count++;
+   return Result;
+}
 
-         if (_state.MaxHandle && (_state.MaxHandle < _state.count)) {
 
-            _state.count = _state.MinHandle;
-         }
-         else if (_state.count < _state.MinHandle) {
+/*!
 
-            _state.count = _state.MinHandle;
-         }
-      }
+\brief Returns next anonymous Handle.
+\details No information string is stored for an anonymous handle. Calling
+dmz::HandleAllocator::lookup_info with an anonymous handle returns a name built from
+the handle value.
+\return Returns new handle. Will return zero if the allocator is out of handles.
 
-   } while (!done);
+*/
+dmz::Handle
+dmz::HandleAllocator::get_next_handle () {
 
+   _state.lock.lock ();
+   const Handle Result (_state.next_handle (0));
    _state.lock.unlock ();
 
-   return handle;
+   return Result;
 }
 
 
@@ -147,22 +188,32 @@ dmz::HandleAllocator::request_handle (
       const Handle RequestedHandle,
       const String &Info) {
 
-   dmz::Handle handle (0);
-
    _state.lock.lock ();
+   const Handle Result (_state.request_handle (RequestedHandle, &Info));
+   _state.lock.unlock ();
 
-   if ((RequestedHandle > _state.MaxHandle) || (RequestedHandle < _state.MinHandle)) {
+   return Result;
+}
 
-      handle = get_next_handle (Info);
-   }
-   else {
-      if (_state.table.lookup (RequestedHandle)) { handle = get_next_handle (Info); }
-      else { handle = _state.save_handle (RequestedHandle, Info); }
-   }
 
+/*!
+
+\brief Requests specific anonymous handle.
+\param[in] RequestedHandle Handle being requested.
+\return Returns new handle. Will return zero if the allocator is out of handles. The
+allocator will do its best to return the requested handle. It may return a different
+handle from the one requested if the handle has already been allocator or if it is
+outside the range of the allocator.
+
+*/
+dmz::Handle
+dmz::HandleAllocator::request_handle (const Handle RequestedHandle) {
+
+   _state.lock.lock ();
+   const Handle Result (_state.request_handle (RequestedHandle, 0));
    _state.lock.unlock ();
 
-   return handle;
+   return Result;
 }
 
 
@@ -171,6 +222,7 @@ dmz::HandleAllocator::request_handle (
 \brief Returns the String associated with the allocated handle.
 \param[in] TheHandle Allocated handle.
 \return Returns a String containing the information associated with the allocated handle.
+A name is synthesized for anonymous handles.
 
 */
 dmz::String
@@ -180,9 +232,11 @@ dmz::HandleAllocator::lookup_info (const Handle TheHandle) {
 
    _state.lock.lock ();
    String *ptr = _state.table.lookup (TheHandle);
-   if (ptr) { result = *ptr; }
+   if (ptr && (ptr != &(_state.Anonymous))) { result = *ptr; }
    _state.lock.unlock ();
 
+   if (ptr == &(_state.Anonymous)) { result << "Anonymous." << TheHandle; }
+
    return result;
 }
 
@@ -207,7 +261,8 @@ dmz::HandleAllocator::release_handle (const Handle TheHandle) {
 
    if (ptr) {
 
-      delete ptr; ptr = 0;
+      if (ptr != &(_state.Anonymous)) { delete ptr; }
+      ptr = 0;
       result = True;
    }
 
@@ -20,7 +20,9 @@ namespace dmz {
          ~HandleAllocator ();
 
          Handle get_next_handle (const String &Info);
+         Handle get_next_handle ();
          Handle request_handle (const Handle RequestedHandle, const String &Info);
+         Handle request_handle (const Handle RequestedHandle);
          String lookup_info (const Handle TheHandle);
          Boolean release_handle (const Handle TheHandle);
 
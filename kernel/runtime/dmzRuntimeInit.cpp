@@ -57,6 +57,11 @@ static void local_init_message (
    RuntimeContext *context,
    Log *log);
 
+static void local_init_message_queue (
+   const Config &Init,
+   RuntimeContext *context,
+   Log *log);
+
 static void local_init_time (
    const Config &Init,
    RuntimeContext *context,
@@ -438,6 +443,26 @@ local_init_message (
 }
 
 
+void
+local_init_message_queue (const Config &Init, RuntimeContext *context, Log *log) {
+
+   RuntimeContextMessaging *rcm (context ? context->get_messaging_context () : 0);
+
+   if (rcm) {
+
+      const UInt32 Size (config_to_uint32 ("size", Init, 0));
+
+      if (Size && rcm->set_delayed_queue_size (Size) && log) {
+
+         log->debug << "Using delayed message queue size: "
+            << rcm->delayedQueue->get_size () << endl;
+      }
+
+      rcm->delayedRetry = config_to_uint32 ("retry", Init, rcm->delayedRetry);
+   }
+}
+
+
 void
 local_init_time (const Config &Init, RuntimeContext *context, Log *log) {
 
@@ -464,6 +489,33 @@ local_init_time (const Config &Init, RuntimeContext *context, Log *log) {
       rtt.set_target_frame_frequency (frequency);
    }
 
+   if (Init.lookup_attribute ("pacing.mode", data)) {
+
+      const FramePacingEnum Mode (
+         data.get_lower () == "hybrid" ? FramePacingHybrid : FramePacingSleep);
+
+      rtt.set_frame_pacing (Mode);
+
+      if (log) {
+
+         log->debug << "Using " << (Mode == FramePacingHybrid ? "hybrid" : "sleep")
+            << " frame pacing" << endl;
+      }
+   }
+
+   if (Init.lookup_attribute ("pacing.spin", data)) {
+
+      rtt.set_frame_spin_time (string_to_float64 (data));
+   }
+
+   if (Init.lookup_attribute ("threads.value", data)) {
+
+      const UInt32 Threads (string_to_uint32 (data));
+      rtt.set_time_slice_thread_count (Threads);
+
+      if (log) { log->debug << "Using time slice worker threads: " << Threads << endl; }
+   }
+
    if (log) {
 
       log->debug << "Using " << (usingDefaultFactor ? "default " : "") << "time factor: "
@@ -604,6 +656,10 @@ An XML example for defining the various runtime types and time settings:
    <time>
       <factor value="1.0"/>
       <frequency value="60"/>
+      <!-- Frame pacing mode "sleep" or "hybrid" and minimum busy wait in seconds -->
+      <pacing mode="hybrid" spin="0.002"/>
+      <!-- Worker threads for thread safe time slices -->
+      <threads value="0"/>
    </time>
 
    <!-- State definition -->
@@ -622,6 +678,9 @@ An XML example for defining the various runtime types and time settings:
    <!-- dmz::Message definition -->
    <message name="Message Name" parent="Parent Name"/>
 
+   <!-- Queue for messages sent from threads other than the main thread -->
+   <message-queue size="4096" retry="64"/>
+
    <!-- dmz::Resources definition -->
    <resource-map>
       <!-- Search Path Group -->
@@ -653,6 +712,7 @@ dmz::runtime_init (const Config &Init, RuntimeContext *context, Log *log) {
    Config oconfig;
    Config sconfig;
    Config mconfig;
+   Config qconfig;
    Config tconfig;
    Config rconfig;
 
@@ -660,6 +720,7 @@ dmz::runtime_init (const Config &Init, RuntimeContext *context, Log *log) {
    Init.lookup_all_config ("object-type", oconfig);
    Init.lookup_all_config ("state", sconfig);
    Init.lookup_all_config ("message", mconfig);
+   Init.lookup_all_config_merged ("message-queue", qconfig);
    Init.lookup_all_config_merged ("time", tconfig);
    Init.lookup_all_config_merged ("resource-map", rconfig);
 
@@ -730,6 +791,8 @@ dmz::runtime_init (const Config &Init, RuntimeContext *context, Log *log) {
       if (mconfig) { local_init_message (mconfig, context, log); }
       else if (log) { log->debug << "Message type config not found" << endl; }
 
+      if (qconfig) { local_init_message_queue (qconfig, context, log); }
+
       if (tconfig) { local_init_time (tconfig, context, log); }
       else if (log) { log->debug << "Runtime time data not found" << endl; }
 
@@ -20,5 +20,5 @@ dmz::RuntimeIterator::~RuntimeIterator () { delete &state; }
 
 //! Resets the iterator.
 void
-dmz::RuntimeIterator::reset () { state.it.reset (); }
+dmz::RuntimeIterator::reset () { state.it.reset (); state.index = 0; }
 
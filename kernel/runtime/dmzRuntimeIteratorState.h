@@ -8,6 +8,9 @@
 struct dmz::RuntimeIterator::State {
 
    HashTableHandleIterator it;
+   Int32 index;
+
+   State () : index (0) {;}
 };
 //! \endcond
 
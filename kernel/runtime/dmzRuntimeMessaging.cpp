@@ -30,6 +30,13 @@ will be ignored.
 \brief Sets the Message's monostate mode.
 \details Defined in dmzRuntimeMessaging.h
 
+\struct dmz::MessageQueueStats
+\ingroup Runtime
+\brief Statistics for the queue of messages sent from threads other than the main
+thread.
+\details Defined in dmzRuntimeMessaging.h
+\sa dmz::get_message_queue_stats
+
 */
 
 
@@ -754,3 +761,41 @@ be NULL if no data was sent.
 be NULL.
 
 */
+
+
+/*!
+
+\brief Gets the delayed message queue statistics.
+\ingroup Runtime
+\details Defined in dmzRuntimeMessaging.h. Messages sent from any thread other than the
+main thread are placed in a bounded queue and sent from the main thread on the next
+frame. The statistics may be used by sending threads to detect back pressure. The
+queue size and the number of retries a sending thread makes when the queue is full
+are set in the runtime config:
+\code
+<dmz>
+<runtime>
+   <message-queue size="4096" retry="64"/>
+</runtime>
+</dmz>
+\endcode
+\param[in] context Pointer to the runtime context.
+\param[out] stats MessageQueueStats to store the statistics.
+\return Returns dmz::True if the statistics were found.
+
+*/
+dmz::Boolean
+dmz::get_message_queue_stats (RuntimeContext *context, MessageQueueStats &stats) {
+
+   Boolean result (False);
+
+   RuntimeContextMessaging *rcm (context ? context->get_messaging_context () : 0);
+
+   if (rcm) {
+
+      rcm->get_delayed_queue_stats (stats);
+      result = True;
+   }
+
+   return result;
+}
@@ -21,6 +21,24 @@ namespace dmz {
       MessageMonostateOff //!< Disables message's monostate.
    };
 
+   struct MessageQueueStats {
+
+      UInt32 size; //!< Number of slots in the delayed message queue.
+      UInt32 count; //!< Number of messages waiting in the queue.
+      UInt32 peak; //!< Largest number of messages waiting in the queue.
+      UInt32 full; //!< Number of times a sending thread found the queue full.
+      UInt64 sent; //!< Number of delayed messages sent from the queue.
+      UInt64 dropped; //!< Number of delayed messages dropped.
+
+      MessageQueueStats () :
+            size (0),
+            count (0),
+            peak (0),
+            full (0),
+            sent (0),
+            dropped (0) {;}
+   };
+
    class DMZ_KERNEL_LINK_SYMBOL Message {
 
       public:
@@ -150,6 +168,10 @@ namespace dmz {
       const String &DefaultValue,
       RuntimeContext *context,
       Log *log = 0);
+
+   DMZ_KERNEL_LINK_SYMBOL Boolean get_message_queue_stats (
+      RuntimeContext *context,
+      MessageQueueStats &stats);
 };
 
 #endif // DMZ_RUNTIME_MESSAGING_DOT_H
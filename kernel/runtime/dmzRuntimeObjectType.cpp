@@ -141,6 +141,8 @@ dmz::ObjectType::set_type (const Handle TypeHandle, RuntimeContext *context) {
 /*!
 
 \brief Test if object type is a related type.
+\details Each type is numbered with a pre-order interval that is rebuilt when
+new types are defined so the test is two integer comparisons.
 \param[in] Type ObjectType to test against.
 \return Returns dmz::True if \a Type is the same or a parent.
 
@@ -148,20 +150,7 @@ dmz::ObjectType::set_type (const Handle TypeHandle, RuntimeContext *context) {
 dmz::Boolean
 dmz::ObjectType::is_of_type (const ObjectType &Type) const {
 
-   Boolean result (False);
-
-   ObjectType current (_context);
-
-   if (Type) {
-
-      while (current && !result) {
-
-         if (Type == current) { result = True; }
-         else { current.become_parent (); }
-      }
-   }
-
-   return result;
+   return _context ? _context->is_of_type (Type._context) : False;
 }
 
 
@@ -390,12 +379,14 @@ dmz::ObjectType::get_type_context () const { return _context; }
 struct dmz::ObjectTypeSet::State {
 
    HashTableHandleTemplate<ObjectType> table;
+   TypeIntervalList intervals;
 
    ~State () { table.empty (); }
 
    State &operator= (const State &Value) {
 
       table.copy (Value.table);
+      intervals.invalidate ();
       return *this;
    }
 };
@@ -451,7 +442,8 @@ dmz::ObjectTypeSet::add_object_type (const ObjectType &Type) {
 
       result = _state.table.store (ptr->get_handle (), ptr);
 
-      if (!result) { delete ptr; ptr = 0; }
+      if (result) { _state.intervals.invalidate (); }
+      else { delete ptr; ptr = 0; }
    }
 
    return result;
@@ -477,7 +469,8 @@ dmz::ObjectTypeSet::add_object_type (const String &Name, RuntimeContext *context
 
       result = _state.table.store (ptr->get_handle (), ptr);
 
-      if (!result) { delete ptr; ptr = 0; }
+      if (result) { _state.intervals.invalidate (); }
+      else { delete ptr; ptr = 0; }
    }
 
    return result;
@@ -503,7 +496,8 @@ dmz::ObjectTypeSet::add_object_type (const Handle TypeHandle, RuntimeContext *co
 
       result = _state.table.store (ptr->get_handle (), ptr);
 
-      if (!result) { delete ptr; ptr = 0; }
+      if (result) { _state.intervals.invalidate (); }
+      else { delete ptr; ptr = 0; }
    }
 
    return result;
@@ -549,6 +543,7 @@ dmz::ObjectTypeSet::remove_object_type (const ObjectType &Type) {
    if (ptr)  {
 
       delete ptr; ptr = 0;
+      _state.intervals.invalidate ();
       result = True;
    }
 
@@ -573,7 +568,12 @@ dmz::ObjectTypeSet::remove_object_type (const String &Name, RuntimeContext *cont
 
    ObjectType *ptr (_state.table.remove (tmp.get_handle ()));
 
-   if (ptr)  { delete ptr; ptr = 0; result = True; }
+   if (ptr)  {
+
+      delete ptr; ptr = 0;
+      _state.intervals.invalidate ();
+      result = True;
+   }
 
    return result;
 }
@@ -598,7 +598,12 @@ dmz::ObjectTypeSet::remove_object_type (
 
    ObjectType *ptr (_state.table.remove (tmp.get_handle ()));
 
-   if (ptr)  { delete ptr; ptr = 0; result = True; }
+   if (ptr)  {
+
+      delete ptr; ptr = 0;
+      _state.intervals.invalidate ();
+      result = True;
+   }
 
    return result;
 }
@@ -607,6 +612,8 @@ dmz::ObjectTypeSet::remove_object_type (
 /*!
 
 \brief Tests if object type is stored in set.
+\details The set keeps a sorted list of the type intervals it covers so the
+test is a binary search instead of a walk up the parent chain.
 \param[in] Type ObjectType to use in test.
 \return Returns dmz::True if the \a Type or one of its parents is contained in the set.
 
@@ -618,7 +625,9 @@ dmz::ObjectTypeSet::contains_type (const ObjectType &Type) const {
 
    ObjectType current (Type);
 
-   Boolean done (current ? False : True);
+   Boolean done (
+      !current || !_state.table.get_count () ||
+      _state.intervals.contains (_state.table, current.get_type_context (), result));
 
    while (!done) {
 
@@ -21,6 +21,13 @@ Time in the runtime is decoupled from system time. It may be set to run in real
 faster than real time, slower than real time, and even backwards. The current runtime
 time may be set as well.
 
+
+\class dmz::FrameClock
+\ingroup Runtime
+\brief Clock used by the runtime to measure and pace frames.
+\details Derived classes may be passed to dmz::Time::set_frame_clock to replace the
+system clock, for example to drive frame pacing from a simulated clock in tests.
+
 */
 
 /*!
@@ -202,3 +209,145 @@ dmz::Time::get_target_frame_frequency () const {
    return result;
 }
 
+
+/*!
+
+\brief Sets the frame pacing mode.
+\details When a target frame frequency is set, the runtime waits at the end of each
+frame until the target frame length has elapsed. dmz::FramePacingSleep uses
+dmz::sleep for the wait. dmz::FramePacingHybrid uses the system sleep call for most of
+the wait and then busy waits on the monotonic clock for the remainder. Hybrid pacing
+gives a more accurate frame period at the cost of some CPU time. The change takes
+effect at the start of the next frame.
+\param[in] Mode dmz::FramePacingEnum specifying the pacing mode.
+
+*/
+void
+dmz::Time::set_frame_pacing (const FramePacingEnum Mode) {
+
+   if (_context) { _context->set_pacing (Mode); }
+}
+
+
+//! Returns the frame pacing mode.
+dmz::FramePacingEnum
+dmz::Time::get_frame_pacing () const {
+
+   FramePacingEnum result (FramePacingSleep);
+
+   if (_context) { result = _context->pacing; }
+
+   return result;
+}
+
+
+/*!
+
+\brief Sets the minimum busy wait window used by hybrid frame pacing.
+\details The runtime grows the window when the system sleep call wakes up late and
+shrinks it back to \a Value when the system sleep call is accurate. The window, and
+\a Value, are capped at five milliseconds or half the target frame length, whichever
+is smaller.
+\param[in] Value Minimum busy wait window in seconds.
+
+*/
+void
+dmz::Time::set_frame_spin_time (const Float64 Value) {
+
+   if (_context) { _context->set_spin_time (Value); }
+}
+
+
+//! Returns the minimum busy wait window used by hybrid frame pacing in seconds.
+dmz::Float64
+dmz::Time::get_frame_spin_time () const {
+
+   Float64 result (0.0);
+
+   if (_context) { result = _context->spinTime; }
+
+   return result;
+}
+
+
+/*!
+
+\brief Sets the clock used to measure and pace frames.
+\details By default the runtime uses dmz::get_time, dmz::system_sleep and
+dmz::system_yield. The clock is not owned by the runtime and must outlive it or be
+removed by passing NULL. The measurement of the next frame is skipped so that no
+period spans two clocks. Must be called from the main thread.
+\param[in] clock Pointer to the FrameClock. NULL restores the default clock.
+
+*/
+void
+dmz::Time::set_frame_clock (FrameClock *clock) {
+
+   if (_context) { _context->set_clock (clock); }
+}
+
+
+//! Returns the clock set with dmz::Time::set_frame_clock or NULL if none is set.
+dmz::FrameClock *
+dmz::Time::get_frame_clock () const {
+
+   FrameClock *result (0);
+
+   if (_context) { result = _context->clock; }
+
+   return result;
+}
+
+
+/*!
+
+\brief Gets frame timing statistics.
+\details The period of a frame is measured from the start of one frame to the start of
+the next. The jitter histogram holds the absolute difference between the period and
+the target period. The first bucket counts differences under 0.1 milliseconds and
+each following bucket doubles the limit. The last bucket counts everything over
+6.4 milliseconds. The jitter histogram and overrun count are only updated when a
+target frame frequency is set. The statistics are updated by the main thread.
+\param[out] stats FrameStats to store the statistics.
+\sa dmz::Time::reset_frame_stats
+
+*/
+void
+dmz::Time::get_frame_stats (FrameStats &stats) const {
+
+   if (_context) { stats = _context->stats; }
+   else { stats.reset (); }
+}
+
+
+//! Resets the frame timing statistics at the start of the next frame.
+void
+dmz::Time::reset_frame_stats () { if (_context) { _context->reset_stats (); } }
+
+
+/*!
+
+\brief Sets the number of worker threads used to run thread safe time slices.
+\details The change takes effect at the start of the next frame. A \a Value of zero
+runs all time slices from the main thread.
+\param[in] Value Number of worker threads.
+\sa dmz::TimeSlice::set_time_slice_thread_safe
+
+*/
+void
+dmz::Time::set_time_slice_thread_count (const UInt32 Value) {
+
+   if (_context) { _context->set_thread_count (Value); }
+}
+
+
+//! Returns the number of worker threads used to run thread safe time slices.
+dmz::UInt32
+dmz::Time::get_time_slice_thread_count () const {
+
+   UInt32 result (0);
+
+   if (_context) { result = _context->threadCount; }
+
+   return result;
+}
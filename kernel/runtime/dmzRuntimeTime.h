@@ -10,6 +10,59 @@ namespace dmz {
    class RuntimeContextTime;
    class PluginInfo;
 
+   enum FramePacingEnum {
+      FramePacingSleep, //!< Sleeps for the remainder of the frame.
+      FramePacingHybrid, //!< Sleeps for most of the frame and busy waits for the rest.
+   };
+
+   //! Number of buckets in the frame jitter histogram.
+   const Int32 FrameJitterBucketCount = 8;
+
+   struct FrameStats {
+
+      UInt64 frames; //!< Number of frames measured.
+      UInt64 overruns; //!< Number of frames that took longer than the target period.
+      Float64 targetPeriod; //!< Target frame period in seconds. Zero if free running.
+      Float64 lastPeriod; //!< Period of the last frame in seconds.
+      Float64 minPeriod; //!< Shortest frame period in seconds.
+      Float64 maxPeriod; //!< Longest frame period in seconds.
+      Float64 averagePeriod; //!< Average frame period in seconds.
+      Float64 maxJitter; //!< Largest difference from the target period in seconds.
+      Float64 spinTime; //!< Current busy wait window used by hybrid pacing in seconds.
+      //! Histogram of the absolute difference from the target period.
+      UInt64 jitter[FrameJitterBucketCount];
+
+      FrameStats () { reset (); }
+
+      void reset () {
+
+         frames = overruns = 0;
+         targetPeriod = lastPeriod = minPeriod = maxPeriod = averagePeriod = 0.0;
+         maxJitter = spinTime = 0.0;
+         for (Int32 ix = 0; ix < FrameJitterBucketCount; ix++) { jitter[ix] = 0; }
+      }
+   };
+
+   class FrameClock {
+
+      public:
+         virtual ~FrameClock () {;} //!< Destructor.
+
+         //! Returns the current monotonic time in seconds.
+         virtual Float64 get_frame_clock_time () = 0;
+         //! Sleeps for \a Time seconds. The call may return late.
+         virtual void frame_clock_sleep (const Float64 Time) = 0;
+         //! Called on each pass of the busy wait used by hybrid frame pacing.
+         virtual void frame_clock_yield () = 0;
+
+      protected:
+         FrameClock () {;} //!< Constructor.
+
+      private:
+         FrameClock (const FrameClock &);
+         FrameClock &operator= (const FrameClock &);
+   };
+
    class DMZ_KERNEL_LINK_SYMBOL Time {
 
       public:
@@ -28,6 +81,21 @@ namespace dmz {
          void set_target_frame_frequency (const Float64 Value);
          Float64 get_target_frame_frequency () const;
 
+         void set_frame_pacing (const FramePacingEnum Mode);
+         FramePacingEnum get_frame_pacing () const;
+
+         void set_frame_spin_time (const Float64 Value);
+         Float64 get_frame_spin_time () const;
+
+         void set_frame_clock (FrameClock *clock);
+         FrameClock *get_frame_clock () const;
+
+         void get_frame_stats (FrameStats &stats) const;
+         void reset_frame_stats ();
+
+         void set_time_slice_thread_count (const UInt32 Value);
+         UInt32 get_time_slice_thread_count () const;
+
       protected:
          RuntimeContextTime *_context; //!< Time context pointer.
 
@@ -38,6 +38,20 @@ back has been made, the time slice may be scheduled for invocation again by call
 dmz::TimeSlice::start_time_slice(). Any time slice call may be halted by calling
 dmz::TimeSlice::stop_time_slice().
 A time interval of zero will be called every time slice if repeating.
+\n\n
+By default all time slices are invoked one after another from the main thread. When
+the runtime has been given worker threads with dmz::Time::set_time_slice_thread_count,
+a time slice that has been flagged with dmz::TimeSlice::set_time_slice_thread_safe
+may be invoked from a worker thread at the same time as other thread safe time slices.
+Consecutive thread safe time slices are grouped into a stage that is run in parallel.
+The runtime waits for the stage to finish before invoking the next time slice that is
+not thread safe. Two thread safe time slices are not placed in the same stage if one
+of them writes a resource the other reads or writes. Resources are arbitrary handles
+such as a plugin or object attribute handle and are declared with
+dmz::TimeSlice::add_time_slice_read and dmz::TimeSlice::add_time_slice_write.
+A thread safe time slice must not create, start, stop, or destroy time slices from
+its dmz::TimeSlice::update_time_slice call. Messages sent from a worker thread are
+delivered on the main thread on the next frame.
 
 */
 
@@ -284,6 +298,80 @@ dmz::TimeSlice::get_time_slice_interval () const {
 }
 
 
+/*!
+
+\brief Flags the time slice as safe to invoke from a worker thread.
+\details Only takes effect when the runtime has worker threads.
+\param[in] Value dmz::True if dmz::TimeSlice::update_time_slice may be invoked from a
+worker thread in parallel with other thread safe time slices.
+
+*/
+void
+dmz::TimeSlice::set_time_slice_thread_safe (const Boolean Value) {
+
+   if (__state.key && __state.key->is_main_thread () && __state.timeSlice) {
+
+      __state.timeSlice->threadSafe = Value;
+   }
+}
+
+
+//! Returns dmz::True if the time slice may be invoked from a worker thread.
+dmz::Boolean
+dmz::TimeSlice::is_time_slice_thread_safe () const {
+
+   return __state.timeSlice ? __state.timeSlice->threadSafe : False;
+}
+
+
+/*!
+
+\brief Declares a resource the time slice reads.
+\details A thread safe time slice will not be run in parallel with a time slice that
+writes the resource.
+\param[in] Resource Handle of the resource.
+
+*/
+void
+dmz::TimeSlice::add_time_slice_read (const Handle Resource) {
+
+   if (__state.key && __state.key->is_main_thread () && __state.timeSlice && Resource) {
+
+      __state.timeSlice->readSet.add (Resource);
+   }
+}
+
+
+/*!
+
+\brief Declares a resource the time slice writes.
+\details A thread safe time slice will not be run in parallel with a time slice that
+reads or writes the resource.
+\param[in] Resource Handle of the resource.
+
+*/
+void
+dmz::TimeSlice::add_time_slice_write (const Handle Resource) {
+
+   if (__state.key && __state.key->is_main_thread () && __state.timeSlice && Resource) {
+
+      __state.timeSlice->writeSet.add (Resource);
+   }
+}
+
+
+//! Removes all declared resources.
+void
+dmz::TimeSlice::clear_time_slice_resources () {
+
+   if (__state.key && __state.key->is_main_thread () && __state.timeSlice) {
+
+      __state.timeSlice->readSet.clear ();
+      __state.timeSlice->writeSet.clear ();
+   }
+}
+
+
 /*!
 
 \brief Starts time slice.
@@ -36,6 +36,13 @@ namespace dmz {
          void set_time_slice_interval (const Float64 TimeInterval);
          Float64 get_time_slice_interval () const;
 
+         void set_time_slice_thread_safe (const Boolean Value);
+         Boolean is_time_slice_thread_safe () const;
+
+         void add_time_slice_read (const Handle Resource);
+         void add_time_slice_write (const Handle Resource);
+         void clear_time_slice_resources ();
+
          void start_time_slice ();
          void stop_time_slice ();
          void remove_time_slice ();
@@ -11,6 +11,38 @@
 
 namespace dmz {
 
+   class TypeContext;
+
+   //! \cond
+   // Shared by every TypeContext descended from the same root. Each type in the tree
+   // is given a pre-order interval [first, last] so that a type is a descendant of
+   // another when its first value falls inside the other's interval. The intervals
+   // are rebuilt lazily the next time they are needed after the tree has changed.
+   class TypeTree : public RefCountDeleteOnZero {
+
+      public:
+         TypeTree (TypeContext *theRoot);
+
+         SpinLock lock;
+
+         TypeContext *root;
+         UInt32 generation;
+         UInt32 numbered;
+
+         void invalidate ();
+         void update ();
+
+      protected:
+         ~TypeTree () {;}
+         Int32 _number (TypeContext *context, Int32 count);
+
+      private:
+         TypeTree ();
+         TypeTree (const TypeTree &);
+         TypeTree &operator= (const TypeTree &);
+   };
+   //! \endcond
+
    class TypeContext : public RefCountDeleteOnZero {
 
       public:
@@ -29,6 +61,13 @@ namespace dmz {
          ConfigContext *config;
          HashTableHandleTemplate<TypeContext> table;
 
+         TypeTree *tree;
+         Int32 first;
+         Int32 last;
+         UInt32 generation;
+
+         Boolean is_of_type (TypeContext *type);
+
       protected:
          ~TypeContext ();
 
@@ -37,8 +76,97 @@ namespace dmz {
          TypeContext (const TypeContext &);
          TypeContext &operator= (const TypeContext &);
    };
+
+   //! \cond
+   // Sorted, non-overlapping list of the intervals covered by the types in an
+   // ObjectTypeSet or EventTypeSet. Types from a different tree or types that
+   // are no longer attached to their tree make the list invalid so that callers
+   // fall back to walking the parent chain.
+   class TypeIntervalList {
+
+      public:
+         TypeIntervalList ();
+         ~TypeIntervalList ();
+
+         void invalidate () { _tree = 0; }
+
+         template <class T> Boolean contains (
+            const HashTableHandleTemplate<T> &Table,
+            TypeContext *context,
+            Boolean &found);
+
+      protected:
+         template <class T> Boolean _build (const HashTableHandleTemplate<T> &Table);
+
+         TypeTree *_tree;
+         UInt32 _generation;
+         Boolean _valid;
+         Int32 _count;
+         Int32 _size;
+         Int32 *_list;
+
+      private:
+         TypeIntervalList (const TypeIntervalList &);
+         TypeIntervalList &operator= (const TypeIntervalList &);
+   };
+   //! \endcond
 };
 
+
+inline
+dmz::TypeTree::TypeTree (TypeContext *theRoot) :
+      root (theRoot),
+      generation (1),
+      numbered (0) {;}
+
+
+inline void
+dmz::TypeTree::invalidate () {
+
+   lock.lock ();
+   generation++;
+   lock.unlock ();
+}
+
+
+// Must be called with the tree lock held.
+inline void
+dmz::TypeTree::update () {
+
+   if (numbered != generation) {
+
+      numbered = generation;
+      if (root) { _number (root, 0); }
+   }
+}
+
+
+inline dmz::Int32
+dmz::TypeTree::_number (TypeContext *context, Int32 count) {
+
+   context->lock.lock ();
+
+   context->first = count;
+   context->generation = numbered;
+   count++;
+
+   HashTableHandleIterator it;
+   TypeContext *child (context->table.get_first (it));
+
+   while (child) {
+
+      count = _number (child, count);
+      child = context->table.get_next (it);
+   }
+
+   context->last = count - 1;
+
+   context->lock.unlock ();
+
+   return count;
+}
+
+
 inline
 dmz::TypeContext::TypeContext (
       const String &TheName,
@@ -48,15 +176,23 @@ dmz::TypeContext::TypeContext (
       Name (TheName),
       Handle (TheName + ".Type", context),
       parent (theParent),
-      config (theConfig) {
+      config (theConfig),
+      tree (0),
+      first (0),
+      last (0),
+      generation (0) {
 
    if (config) { config->ref (); }
    if (theParent) {
 
       theParent->lock.lock ();
       if (theParent->table.store (Handle.get_runtime_handle (), this)) { this->ref (); }
+      tree = theParent->tree;
       theParent->lock.unlock ();
    }
+
+   if (tree) { tree->ref (); tree->invalidate (); }
+   else { tree = new TypeTree (this); }
 }
 
 
@@ -86,6 +222,209 @@ dmz::TypeContext::~TypeContext () {
 
    lock.unlock ();
 
+   if (tree) {
+
+      tree->lock.lock ();
+      if (tree->root == this) { tree->root = 0; }
+      tree->generation++;
+      tree->lock.unlock ();
+      tree->unref ();
+      tree = 0;
+   }
+}
+
+
+inline dmz::Boolean
+dmz::TypeContext::is_of_type (TypeContext *type) {
+
+   Boolean result (False);
+
+   if (type == this) { result = True; }
+   else if (type && (type->tree == tree)) {
+
+      Boolean numbered (False);
+
+      tree->lock.lock ();
+      tree->update ();
+
+      if ((generation == tree->numbered) && (type->generation == tree->numbered)) {
+
+         numbered = True;
+         result = (type->first <= first) && (first <= type->last);
+      }
+
+      tree->lock.unlock ();
+
+      if (!numbered) {
+
+         // Detached from the tree so walk the parent chain.
+         lock.lock ();
+         TypeContext *current (parent);
+         if (current) { current->ref (); }
+         lock.unlock ();
+
+         while (current && !result) {
+
+            if (current == type) { result = True; }
+
+            current->lock.lock ();
+            TypeContext *next (current->parent);
+            if (next) { next->ref (); }
+            current->lock.unlock ();
+
+            current->unref ();
+            current = next;
+         }
+
+         if (current) { current->unref (); current = 0; }
+      }
+   }
+
+   return result;
+}
+
+
+inline
+dmz::TypeIntervalList::TypeIntervalList () :
+      _tree (0),
+      _generation (0),
+      _valid (False),
+      _count (0),
+      _size (0),
+      _list (0) {;}
+
+
+inline
+dmz::TypeIntervalList::~TypeIntervalList () {
+
+   if (_list) { delete []_list; _list = 0; }
+}
+
+
+/*
+Looks up the interval containing the context. Returns dmz::False if the list
+could not be used for the test in which case the caller must fall back to
+walking the parent chain. The \a found argument is only set when dmz::True
+is returned.
+*/
+template <class T> inline dmz::Boolean
+dmz::TypeIntervalList::contains (
+      const HashTableHandleTemplate<T> &Table,
+      TypeContext *context,
+      Boolean &found) {
+
+   Boolean result (False);
+
+   TypeTree *tree (context ? context->tree : 0);
+
+   if (tree) {
+
+      tree->lock.lock ();
+      tree->update ();
+
+      if ((_tree != tree) || (_generation != tree->numbered)) {
+
+         _tree = tree;
+         _generation = tree->numbered;
+         _valid = _build (Table);
+      }
+
+      if (_valid && (context->generation == tree->numbered)) {
+
+         const Int32 Value (context->first);
+
+         Int32 low (0);
+         Int32 high (_count - 1);
+         Int32 place (-1);
+
+         while (low <= high) {
+
+            const Int32 Mid ((low + high) >> 1);
+
+            if (_list[Mid * 2] <= Value) { place = Mid; low = Mid + 1; }
+            else { high = Mid - 1; }
+         }
+
+         found = (place >= 0) && (Value <= _list[(place * 2) + 1]);
+         result = True;
+      }
+
+      tree->lock.unlock ();
+   }
+
+   return result;
+}
+
+
+// Must be called with the tree lock held and the tree up to date.
+template <class T> inline dmz::Boolean
+dmz::TypeIntervalList::_build (const HashTableHandleTemplate<T> &Table) {
+
+   Boolean result (True);
+
+   _count = 0;
+
+   const Int32 Size (Table.get_count ());
+
+   if (Size > _size) {
+
+      if (_list) { delete []_list; _list = 0; }
+      _list = new Int32[Size * 2];
+      _size = _list ? Size : 0;
+   }
+
+   HashTableHandleIterator it;
+   T *ptr (Table.get_first (it));
+
+   while (ptr && result && (_count < _size)) {
+
+      TypeContext *current (ptr->get_type_context ());
+
+      if (current && (current->tree == _tree) &&
+            (current->generation == _tree->numbered)) {
+
+         // Insertion sort on the interval start.
+         const Int32 First (current->first);
+         Int32 place (_count);
+
+         while ((place > 0) && (_list[(place - 1) * 2] > First)) {
+
+            _list[place * 2] = _list[(place - 1) * 2];
+            _list[(place * 2) + 1] = _list[((place - 1) * 2) + 1];
+            place--;
+         }
+
+         _list[place * 2] = First;
+         _list[(place * 2) + 1] = current->last;
+         _count++;
+      }
+      else { result = False; }
+
+      ptr = Table.get_next (it);
+   }
+
+   if (ptr) { result = False; }
+
+   if (result && (_count > 1)) {
+
+      // Pre-order intervals are either nested or disjoint so dropping the intervals
+      // contained in the one before leaves a sorted disjoint list.
+      Int32 count (1);
+
+      for (Int32 ix = 1; ix < _count; ix++) {
+
+         if (_list[ix * 2] > _list[((count - 1) * 2) + 1]) {
+
+            _list[count * 2] = _list[ix * 2];
+            _list[(count * 2) + 1] = _list[(ix * 2) + 1];
+            count++;
+         }
+      }
+
+      _count = count;
+   }
+
+   return result;
 }
 
 #endif // DMZ_RUNTIME_TYPE_CONTEXT_DOT_H
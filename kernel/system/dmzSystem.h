@@ -18,6 +18,8 @@ namespace dmz {
    DMZ_KERNEL_LINK_SYMBOL ByteOrderEnum get_byte_order ();
    DMZ_KERNEL_LINK_SYMBOL Float64 get_time ();
    DMZ_KERNEL_LINK_SYMBOL void sleep (const Float64 Time);
+   DMZ_KERNEL_LINK_SYMBOL void system_sleep (const Float64 Time);
+   DMZ_KERNEL_LINK_SYMBOL void system_yield ();
    DMZ_KERNEL_LINK_SYMBOL String get_env (const String &Name);
    DMZ_KERNEL_LINK_SYMBOL void set_env (const String &Name, const String &Value);
    DMZ_KERNEL_LINK_SYMBOL Float64 random ();
@@ -1,5 +1,6 @@
 #include <dmzSystem.h>
 #include <dmzSystemMarshal.h>
+#include "dmzSystemMarshalLocal.h"
 #include <dmzTypesMatrix.h>
 #include <dmzTypesString.h>
 #include <dmzTypesUUID.h>
@@ -109,33 +110,45 @@ struct dmz::Marshal::State {
          return GrowSize > ExtendSize ? GrowSize : ExtendSize;
    }
 
+   // Divides instead of multiplying so a hostile Count can not overflow the size.
+   Boolean fits (const Int32 ValueSize, const Int32 Count) const {
+
+      return (ValueSize > 0) && (Count > 0) &&
+         (Count <= ((MaxInt32 - place) / ValueSize));
+   }
+
    void write (
          const Int32 ValueSize,
          char *value,
          const WriteEnum WriteMode = NormalWrite) {
 
-      if ((place + ValueSize) > size) { grow (grow_size (place + ValueSize)); }
+      write_array (ValueSize, 1, value, WriteMode);
+   }
+
+   void write_array (
+         const Int32 ValueSize,
+         const Int32 Count,
+         const char *values,
+         const WriteEnum WriteMode = NormalWrite) {
 
-      if (buffer && ((place + ValueSize) <= size)) {
+      if (fits (ValueSize, Count)) {
 
-         if (!swap || (WriteMode == RawWrite)) {
+         const Int32 Total (ValueSize * Count);
 
-            for (Int32 ix = 0; ix < ValueSize; ix++) {
+         if ((place + Total) > size) { grow (grow_size (place + Total)); }
 
-               buffer[place] = value[ix];
-               place++;
-            }
-         }
-         else {
+         if (buffer && ((place + Total) <= size)) {
 
-            for (Int32 ix = (ValueSize - 1); ix >= 0; ix--) {
+            marshal_copy (
+               ValueSize,
+               Count,
+               values,
+               buffer + place,
+               swap && (WriteMode == NormalWrite));
 
-               buffer[place] = value[ix];
-               place++;
-            }
+            place += Total;
+            if (place > length) { length = place; }
          }
-
-         if (place > length) { length = place; }
       }
    }
 };
@@ -410,17 +423,20 @@ dmz::Marshal::set_next_fixed_string (const String &Value, const Int32 Size) {
 
    if (buffer) {
 
-      if ((_state.place + Size) > _state.size) {
+      if (_state.fits (1, Size)) {
 
-         _state.grow (_state.grow_size (_state.place + Size));
-      }
+         if ((_state.place + Size) > _state.size) {
 
-      if (_state.buffer && ((_state.place + Size) < _state.size)) {
+            _state.grow (_state.grow_size (_state.place + Size));
+         }
+
+         if (_state.buffer && ((_state.place + Size) < _state.size)) {
 
-         memcpy (&(_state.buffer[_state.place]), buffer, Size);
+            memcpy (&(_state.buffer[_state.place]), buffer, Size);
 
-         _state.place += Size;
-         if (_state.place > _state.length) { _state.length = _state.place; }
+            _state.place += Size;
+            if (_state.place > _state.length) { _state.length = _state.place; }
+         }
       }
    }
    else { for (Int32 ix = 0; ix < Size; ix++) { set_next_uint8 (0); } }
@@ -452,9 +468,7 @@ values.
 void
 dmz::Marshal::set_next_vector32 (const Vector &Value) {
 
-   set_next_float32 ((Float32)Value.get_x ());
-   set_next_float32 ((Float32)Value.get_y ());
-   set_next_float32 ((Float32)Value.get_z ());
+   set_next_vector32_array (1, &Value);
 }
 
 
@@ -471,7 +485,7 @@ dmz::Marshal::set_next_matrix32 (const Matrix &Value) {
 
    Float32 data[9];
    Value.to_array32 (data);
-   for (Int32 ix = 0; ix < 9; ix++) { set_next_float32 (data[ix]); }
+   set_next_float32_array (9, data);
 }
 
 
@@ -479,9 +493,7 @@ dmz::Marshal::set_next_matrix32 (const Matrix &Value) {
 void
 dmz::Marshal::set_next_vector (const Vector &Value) {
 
-   set_next_float64 (Value.get_x ());
-   set_next_float64 (Value.get_y ());
-   set_next_float64 (Value.get_z ());
+   set_next_vector_array (1, &Value);
 }
 
 
@@ -491,6 +503,145 @@ dmz::Marshal::set_next_matrix (const Matrix &Value) {
 
    Float64 data[9];
    Value.to_array (data);
-   for (Int32 ix = 0; ix < 9; ix++) { set_next_float64 (data[ix]); }
+   set_next_float64_array (9, data);
+}
+
+
+/*!
+
+\brief Marshals an array of dmz::Int16 values at the current place in the storage buffer.
+\details The storage buffer is grown once for the whole array and the values are
+byte swapped in a single pass if needed.
+\param[in] Count Number of values in \a Values.
+\param[in] Values Array of values to be marshalled.
+
+*/
+void
+dmz::Marshal::set_next_int16_array (const Int32 Count, const Int16 *Values) {
+
+   if (Values) { _state.write_array (sizeof (Int16), Count, (const char *)Values); }
+}
+
+
+//! Marshals an array of dmz::Int32 values. \sa dmz::Marshal::set_next_int16_array.
+void
+dmz::Marshal::set_next_int32_array (const Int32 Count, const Int32 *Values) {
+
+   if (Values) { _state.write_array (sizeof (Int32), Count, (const char *)Values); }
+}
+
+
+//! Marshals an array of dmz::Int64 values. \sa dmz::Marshal::set_next_int16_array.
+void
+dmz::Marshal::set_next_int64_array (const Int32 Count, const Int64 *Values) {
+
+   if (Values) { _state.write_array (sizeof (Int64), Count, (const char *)Values); }
+}
+
+
+//! Marshals an array of dmz::UInt16 values. \sa dmz::Marshal::set_next_int16_array.
+void
+dmz::Marshal::set_next_uint16_array (const Int32 Count, const UInt16 *Values) {
+
+   if (Values) { _state.write_array (sizeof (UInt16), Count, (const char *)Values); }
+}
+
+
+//! Marshals an array of dmz::UInt32 values. \sa dmz::Marshal::set_next_int16_array.
+void
+dmz::Marshal::set_next_uint32_array (const Int32 Count, const UInt32 *Values) {
+
+   if (Values) { _state.write_array (sizeof (UInt32), Count, (const char *)Values); }
+}
+
+
+//! Marshals an array of dmz::UInt64 values. \sa dmz::Marshal::set_next_int16_array.
+void
+dmz::Marshal::set_next_uint64_array (const Int32 Count, const UInt64 *Values) {
+
+   if (Values) { _state.write_array (sizeof (UInt64), Count, (const char *)Values); }
+}
+
+
+//! Marshals an array of dmz::Float32 values. \sa dmz::Marshal::set_next_int16_array.
+void
+dmz::Marshal::set_next_float32_array (const Int32 Count, const Float32 *Values) {
+
+   if (Values) { _state.write_array (sizeof (Float32), Count, (const char *)Values); }
+}
+
+
+//! Marshals an array of dmz::Float64 values. \sa dmz::Marshal::set_next_int16_array.
+void
+dmz::Marshal::set_next_float64_array (const Int32 Count, const Float64 *Values) {
+
+   if (Values) { _state.write_array (sizeof (Float64), Count, (const char *)Values); }
+}
+
+
+/*!
+
+\brief Marshals an array of dmz::Vector values as 32 bit floats.
+\details The vectors are converted in fixed sized blocks so the byte swapping is done in
+bulk.
+\param[in] Count Number of vectors in \a Values.
+\param[in] Values Array of vectors to be marshalled.
+
+*/
+void
+dmz::Marshal::set_next_vector32_array (const Int32 Count, const Vector *Values) {
+
+   if (Values && _state.fits (3 * Int32 (sizeof (Float32)), Count)) {
+
+      const Int32 BlockSize (32);
+      Float32 data[BlockSize * 3];
+
+      const Int32 Needed (_state.place + (Count * 3 * Int32 (sizeof (Float32))));
+      if (Needed > _state.size) { _state.grow (_state.grow_size (Needed)); }
+
+      for (Int32 ix = 0; ix < Count; ix += BlockSize) {
+
+         const Int32 Size ((Count - ix) < BlockSize ? (Count - ix) : BlockSize);
+
+         for (Int32 jy = 0; jy < Size; jy++) {
+
+            const Vector &Value (Values[ix + jy]);
+            data[(jy * 3)] = Float32 (Value.get_x ());
+            data[(jy * 3) + 1] = Float32 (Value.get_y ());
+            data[(jy * 3) + 2] = Float32 (Value.get_z ());
+         }
+
+         set_next_float32_array (Size * 3, data);
+      }
+   }
 }
 
+
+//! Marshals an array of dmz::Vector values as native 64 bit floats.
+void
+dmz::Marshal::set_next_vector_array (const Int32 Count, const Vector *Values) {
+
+   if (Values && _state.fits (3 * Int32 (sizeof (Float64)), Count)) {
+
+      const Int32 BlockSize (32);
+      Float64 data[BlockSize * 3];
+
+      const Int32 Needed (_state.place + (Count * 3 * Int32 (sizeof (Float64))));
+      if (Needed > _state.size) { _state.grow (_state.grow_size (Needed)); }
+
+      for (Int32 ix = 0; ix < Count; ix += BlockSize) {
+
+         const Int32 Size ((Count - ix) < BlockSize ? (Count - ix) : BlockSize);
+
+         for (Int32 jy = 0; jy < Size; jy++) {
+
+            const Vector &Value (Values[ix + jy]);
+            data[(jy * 3)] = Value.get_x ();
+            data[(jy * 3) + 1] = Value.get_y ();
+            data[(jy * 3) + 2] = Value.get_z ();
+         }
+
+         set_next_float64_array (Size * 3, data);
+      }
+   }
+}
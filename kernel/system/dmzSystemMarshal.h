@@ -63,6 +63,21 @@ namespace dmz {
          void set_next_vector (const Vector &Value);
          void set_next_matrix (const Matrix &Value);
 
+         // Marshals arrays of values in a single pass
+         void set_next_int16_array (const Int32 Count, const Int16 *Values);
+         void set_next_int32_array (const Int32 Count, const Int32 *Values);
+         void set_next_int64_array (const Int32 Count, const Int64 *Values);
+
+         void set_next_uint16_array (const Int32 Count, const UInt16 *Values);
+         void set_next_uint32_array (const Int32 Count, const UInt32 *Values);
+         void set_next_uint64_array (const Int32 Count, const UInt64 *Values);
+
+         void set_next_float32_array (const Int32 Count, const Float32 *Values);
+         void set_next_float64_array (const Int32 Count, const Float64 *Values);
+
+         void set_next_vector32_array (const Int32 Count, const Vector *Values);
+         void set_next_vector_array (const Int32 Count, const Vector *Values);
+
       protected:
          struct State;
          State &_state; //!< Internal state.
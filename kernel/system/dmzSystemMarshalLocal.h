@@ -0,0 +1,73 @@
+#ifndef DMZ_SYSTEM_MARSHAL_LOCAL_DOT_H
+#define DMZ_SYSTEM_MARSHAL_LOCAL_DOT_H
+
+#include <dmzTypesBase.h>
+#include <string.h> // for memcpy
+
+namespace dmz {
+
+   // Copies Count elements of ElementSize bytes from source to target. When Swap is
+   // true the bytes of each element are reversed. The fixed size loops are written so
+   // the compiler can turn them in to byte swap instructions and vectorize them.
+   inline void
+   marshal_copy (
+         const Int32 ElementSize,
+         const Int32 Count,
+         const char *source,
+         char *target,
+         const Boolean Swap) {
+
+      if (!Swap || (ElementSize == 1)) { memcpy (target, source, ElementSize * Count); }
+      else if (ElementSize == 2) {
+
+         for (Int32 ix = 0; ix < Count; ix++) {
+
+            UInt16 value;
+            memcpy (&value, source + (ix * 2), 2);
+            value = UInt16 ((value >> 8) | (value << 8));
+            memcpy (target + (ix * 2), &value, 2);
+         }
+      }
+      else if (ElementSize == 4) {
+
+         for (Int32 ix = 0; ix < Count; ix++) {
+
+            UInt32 value;
+            memcpy (&value, source + (ix * 4), 4);
+            value = (value >> 24) | ((value >> 8) & 0x0000FF00) |
+               ((value << 8) & 0x00FF0000) | (value << 24);
+            memcpy (target + (ix * 4), &value, 4);
+         }
+      }
+      else if (ElementSize == 8) {
+
+         for (Int32 ix = 0; ix < Count; ix++) {
+
+            UInt32 high, low;
+            memcpy (&high, source + (ix * 8), 4);
+            memcpy (&low, source + (ix * 8) + 4, 4);
+            high = (high >> 24) | ((high >> 8) & 0x0000FF00) |
+               ((high << 8) & 0x00FF0000) | (high << 24);
+            low = (low >> 24) | ((low >> 8) & 0x0000FF00) |
+               ((low << 8) & 0x00FF0000) | (low << 24);
+            memcpy (target + (ix * 8), &low, 4);
+            memcpy (target + (ix * 8) + 4, &high, 4);
+         }
+      }
+      else {
+
+         for (Int32 ix = 0; ix < Count; ix++) {
+
+            const char *in (source + (ix * ElementSize));
+            char *out (target + (ix * ElementSize));
+
+            for (Int32 jy = 0; jy < ElementSize; jy++) {
+
+               out[jy] = in[ElementSize - 1 - jy];
+            }
+         }
+      }
+   }
+};
+
+#endif // DMZ_SYSTEM_MARSHAL_LOCAL_DOT_H
@@ -0,0 +1,29 @@
+#ifndef DMZ_SYSTEM_SEMAPHORE_DOT_H
+#define DMZ_SYSTEM_SEMAPHORE_DOT_H
+
+#include <dmzKernelExport.h>
+#include <dmzTypesBase.h>
+
+namespace dmz {
+
+   class DMZ_KERNEL_LINK_SYMBOL Semaphore {
+
+      public:
+         Semaphore (const UInt32 Count = 0);
+         ~Semaphore ();
+
+         Boolean try_wait ();
+         void wait ();
+         void post (const UInt32 Count = 1);
+
+      protected:
+         struct State;
+         State &_state; //!< Internal state.
+
+      private:
+         Semaphore (const Semaphore &);
+         Semaphore &operator= (const Semaphore &);
+   };
+};
+
+#endif // DMZ_SYSTEM_SEMAPHORE_DOT_H
@@ -0,0 +1,105 @@
+#include <dmzSystemSemaphore.h>
+
+#include <pthread.h>
+
+/*!
+
+\class dmz::Semaphore
+\ingroup System
+\brief Counting semaphore.
+\details Provides a platform independent interface for blocking a thread until another
+thread signals that work is available. Unlike a dmz::Mutex, a Semaphore may be posted
+from a different thread than the one waiting on it.
+
+*/
+
+struct dmz::Semaphore::State {
+
+   pthread_mutex_t mutex;
+   pthread_cond_t cond;
+   UInt32 count;
+
+   State (const UInt32 Count) : count (Count) {
+
+      pthread_mutex_init (&mutex, 0);
+      pthread_cond_init (&cond, 0);
+   }
+
+   ~State () {
+
+      pthread_cond_destroy (&cond);
+      pthread_mutex_destroy (&mutex);
+   }
+};
+
+
+/*!
+
+\brief Constructor.
+\param[in] Count Initial count of the semaphore.
+
+*/
+dmz::Semaphore::Semaphore (const UInt32 Count) : _state (*(new State (Count))) {;}
+
+
+//! Destructor.
+dmz::Semaphore::~Semaphore () { delete &_state; }
+
+
+/*!
+
+\brief Attempts to decrement the semaphore.
+\details This function is non-blocking.
+\return Returns dmz::True if the count was greater than zero and was decremented.
+
+*/
+dmz::Boolean
+dmz::Semaphore::try_wait () {
+
+   Boolean result (False);
+
+   pthread_mutex_lock (&(_state.mutex));
+
+   if (_state.count > 0) { _state.count--; result = True; }
+
+   pthread_mutex_unlock (&(_state.mutex));
+
+   return result;
+}
+
+
+//! Blocks until the count is greater than zero and then decrements it.
+void
+dmz::Semaphore::wait () {
+
+   pthread_mutex_lock (&(_state.mutex));
+
+   while (_state.count == 0) { pthread_cond_wait (&(_state.cond), &(_state.mutex)); }
+
+   _state.count--;
+
+   pthread_mutex_unlock (&(_state.mutex));
+}
+
+
+/*!
+
+\brief Increments the semaphore.
+\param[in] Count Amount to add to the count. Up to \a Count waiting threads are woken.
+
+*/
+void
+dmz::Semaphore::post (const UInt32 Count) {
+
+   if (Count) {
+
+      pthread_mutex_lock (&(_state.mutex));
+
+      _state.count += Count;
+
+      if (Count == 1) { pthread_cond_signal (&(_state.cond)); }
+      else { pthread_cond_broadcast (&(_state.cond)); }
+
+      pthread_mutex_unlock (&(_state.mutex));
+   }
+}
@@ -0,0 +1,36 @@
+#include <dmzSystemSemaphore.h>
+#include <windows.h>
+
+struct dmz::Semaphore::State {
+
+   HANDLE semaphore;
+
+   State (const UInt32 Count) :
+         semaphore (CreateSemaphore (0, LONG (Count), 0x7FFFFFFF, 0)) {;}
+
+   ~State () { if (semaphore) { CloseHandle (semaphore); semaphore = 0; } }
+};
+
+
+dmz::Semaphore::Semaphore (const UInt32 Count) : _state (*(new State (Count))) {;}
+
+
+dmz::Semaphore::~Semaphore () { delete &_state; }
+
+
+dmz::Boolean
+dmz::Semaphore::try_wait () {
+
+   return WaitForSingleObject (_state.semaphore, 0) == WAIT_OBJECT_0;
+}
+
+
+void
+dmz::Semaphore::wait () { WaitForSingleObject (_state.semaphore, INFINITE); }
+
+
+void
+dmz::Semaphore::post (const UInt32 Count) {
+
+   if (Count) { ReleaseSemaphore (_state.semaphore, LONG (Count), 0); }
+}
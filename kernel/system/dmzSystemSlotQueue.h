@@ -0,0 +1,41 @@
+#ifndef DMZ_SYSTEM_SLOT_QUEUE_DOT_H
+#define DMZ_SYSTEM_SLOT_QUEUE_DOT_H
+
+#include <dmzKernelExport.h>
+#include <dmzTypesBase.h>
+
+namespace dmz {
+
+   class DMZ_KERNEL_LINK_SYMBOL SlotQueue {
+
+      public:
+         SlotQueue (const UInt32 Size);
+         ~SlotQueue ();
+
+         UInt32 get_size () const;
+         UInt32 get_count () const;
+         UInt32 get_full_count () const;
+         UInt32 get_peak_count () const;
+         UInt64 get_release_count () const;
+         UInt64 get_drop_count () const;
+
+         Boolean reserve (UInt32 &index);
+         void commit (const UInt32 Index);
+
+         Boolean peek (UInt32 &index) const;
+         void release (const UInt32 Index);
+
+         UInt64 drop ();
+
+      protected:
+         struct State;
+         State &_state; //!< Internal state.
+
+      private:
+         SlotQueue ();
+         SlotQueue (const SlotQueue &);
+         SlotQueue &operator= (const SlotQueue &);
+   };
+};
+
+#endif // DMZ_SYSTEM_SLOT_QUEUE_DOT_H
@@ -0,0 +1,259 @@
+#include <dmzSystem.h>
+#include <dmzSystemSlotQueue.h>
+#include <atomic_ops.h>
+
+/*!
+
+\class dmz::SlotQueue
+\ingroup System
+\brief Bounded lock free multiple producer single consumer queue of slot indices.
+\details The SlotQueue does not store any values itself. It hands out indices into a
+caller owned array of \a Size elements. A producer on any thread reserves an index,
+fills in the matching element and then commits it. The single consumer peeks at the
+oldest committed index, reads the element and then releases the index so it may be
+reused. Because the elements are owned by the caller they may be allocated once and
+recycled for the life of the queue.
+\code
+dmz::UInt32 index (0);
+
+if (queue.reserve (index)) { table[index] = value; queue.commit (index); }
+
+while (queue.peek (index)) { process (table[index]); queue.release (index); }
+\endcode
+
+*/
+
+struct dmz::SlotQueue::State {
+
+   const UInt32 Size;
+   const UInt32 Mask;
+   volatile AO_t *sequence;
+   UInt32 *position;
+   volatile AO_t enqueue;
+   volatile AO_t dequeue;
+   volatile AO_t full;
+   volatile AO_t peak;
+   volatile AO_t released;
+   volatile AO_t dropped;
+
+   static UInt32 round_size (const UInt32 Value) {
+
+      UInt32 result (2);
+      while ((result < Value) && (result < 0x80000000)) { result = result << 1; }
+      return result;
+   }
+
+   State (const UInt32 TheSize) :
+         Size (round_size (TheSize)),
+         Mask (Size - 1),
+         sequence (new AO_t[Size]),
+         position (new UInt32[Size]),
+         enqueue (0),
+         dequeue (0),
+         full (0),
+         peak (0),
+         released (0),
+         dropped (0) {
+
+      for (UInt32 ix = 0; ix < Size; ix++) { sequence[ix] = ix; position[ix] = ix; }
+   }
+
+   ~State () {
+
+      delete []sequence; sequence = 0;
+      delete []position; position = 0;
+   }
+};
+
+
+/*!
+
+\brief Constructor.
+\param[in] Size Number of slots in the queue. The size is rounded up to the next
+power of two.
+
+*/
+dmz::SlotQueue::SlotQueue (const UInt32 Size) : _state (*(new State (Size))) {;}
+
+
+//! Destructor.
+dmz::SlotQueue::~SlotQueue () { delete &_state; }
+
+
+//! Returns the number of slots in the queue.
+dmz::UInt32
+dmz::SlotQueue::get_size () const { return _state.Size; }
+
+
+/*!
+
+\brief Returns the number of reserved and committed slots.
+\details The count is a snapshot and may already be out of date if producers are
+running on other threads.
+
+*/
+dmz::UInt32
+dmz::SlotQueue::get_count () const {
+
+   const UInt32 Enqueue (UInt32 (AO_load_acquire (&(_state.enqueue))));
+   const UInt32 Dequeue (UInt32 (AO_load_acquire (&(_state.dequeue))));
+   return Enqueue - Dequeue;
+}
+
+
+//! Returns the number of times dmz::SlotQueue::reserve found the queue full.
+dmz::UInt32
+dmz::SlotQueue::get_full_count () const {
+
+   return UInt32 (AO_load_acquire (&(_state.full)));
+}
+
+
+//! Returns the largest number of slots that have been reserved at the same time.
+dmz::UInt32
+dmz::SlotQueue::get_peak_count () const {
+
+   return UInt32 (AO_load_acquire (&(_state.peak)));
+}
+
+
+//! Returns the number of slots passed to dmz::SlotQueue::release.
+dmz::UInt64
+dmz::SlotQueue::get_release_count () const {
+
+   return UInt64 (AO_load_acquire (&(_state.released)));
+}
+
+
+//! Returns the number of times dmz::SlotQueue::drop has been called.
+dmz::UInt64
+dmz::SlotQueue::get_drop_count () const {
+
+   return UInt64 (AO_load_acquire (&(_state.dropped)));
+}
+
+
+/*!
+
+\brief Reserves a slot.
+\details This function may be called from any thread and does not block.
+The reserved slot must be passed to dmz::SlotQueue::commit once its element has been
+filled in.
+\param[out] index Index of the reserved slot.
+\return Returns dmz::True if a slot was reserved. Returns dmz::False if the queue
+is full.
+
+*/
+dmz::Boolean
+dmz::SlotQueue::reserve (UInt32 &index) {
+
+   Boolean result (False);
+   Boolean done (False);
+
+   UInt32 pos (UInt32 (AO_load_acquire (&(_state.enqueue))));
+
+   while (!done) {
+
+      const UInt32 Index (pos & _state.Mask);
+      const UInt32 Seq (UInt32 (AO_load_acquire (&(_state.sequence[Index]))));
+      const Int32 Diff (Int32 (Seq - pos));
+
+      if (Diff == 0) {
+
+         if (AO_compare_and_swap_full (&(_state.enqueue), AO_t (pos), AO_t (pos + 1))) {
+
+            _state.position[Index] = pos;
+            index = Index;
+            result = done = True;
+
+            const UInt32 Depth (pos + 1 - UInt32 (AO_load_acquire (&(_state.dequeue))));
+            AO_t peak (AO_load_acquire (&(_state.peak)));
+
+            while ((AO_t (Depth) > peak) &&
+                  !AO_compare_and_swap_full (&(_state.peak), peak, AO_t (Depth))) {
+
+               peak = AO_load_acquire (&(_state.peak));
+            }
+         }
+         else { pos = UInt32 (AO_load_acquire (&(_state.enqueue))); }
+      }
+      else if (Diff < 0) {
+
+         AO_fetch_and_add1 (&(_state.full));
+         done = True;
+      }
+      else { pos = UInt32 (AO_load_acquire (&(_state.enqueue))); }
+   }
+
+   return result;
+}
+
+
+//! Makes a reserved slot visible to the consumer.
+void
+dmz::SlotQueue::commit (const UInt32 Index) {
+
+   AO_store_release (
+      &(_state.sequence[Index & _state.Mask]),
+      AO_t (_state.position[Index & _state.Mask] + 1));
+}
+
+
+/*!
+
+\brief Gets the oldest committed slot.
+\details Only one thread may consume from the queue. The slot stays at the head of
+the queue until it is passed to dmz::SlotQueue::release.
+\param[out] index Index of the oldest committed slot.
+\return Returns dmz::True if a committed slot is available.
+
+*/
+dmz::Boolean
+dmz::SlotQueue::peek (UInt32 &index) const {
+
+   Boolean result (False);
+
+   const UInt32 Pos (UInt32 (_state.dequeue));
+   const UInt32 Index (Pos & _state.Mask);
+
+   if (UInt32 (AO_load_acquire (&(_state.sequence[Index]))) == (Pos + 1)) {
+
+      index = Index;
+      result = True;
+   }
+
+   return result;
+}
+
+
+//! Returns the slot at the head of the queue so that it may be reserved again.
+void
+dmz::SlotQueue::release (const UInt32 Index) {
+
+   const UInt32 Pos (UInt32 (_state.dequeue));
+
+   if ((Pos & _state.Mask) == (Index & _state.Mask)) {
+
+      AO_store_release (&(_state.dequeue), AO_t (Pos + 1));
+      AO_store_release (
+         &(_state.sequence[Index & _state.Mask]),
+         AO_t (Pos + _state.Size));
+
+      AO_fetch_and_add1 (&(_state.released));
+   }
+}
+
+
+/*!
+
+\brief Records a value that could not be queued.
+\details This function may be called from any thread. Producers call it when they give
+up on a full queue so that the number of lost values may be reported.
+\return Returns the number of values dropped including this one.
+
+*/
+dmz::UInt64
+dmz::SlotQueue::drop () {
+
+   return UInt64 (AO_fetch_and_add1 (&(_state.dropped))) + 1;
+}
@@ -0,0 +1,211 @@
+#include <dmzSystem.h>
+#include <dmzSystemSlotQueue.h>
+#include <windows.h>
+
+static inline LONG
+local_load_acquire (const volatile LONG *Value) {
+
+   const LONG Result (*Value);
+   MemoryBarrier ();
+   return Result;
+}
+
+
+static inline void
+local_store_release (volatile LONG *target, const LONG Value) {
+
+   InterlockedExchange (target, Value);
+}
+
+
+struct dmz::SlotQueue::State {
+
+   const UInt32 Size;
+   const UInt32 Mask;
+   volatile LONG *sequence;
+   UInt32 *position;
+   volatile LONG enqueue;
+   volatile LONG dequeue;
+   volatile LONG full;
+   volatile LONG peak;
+   volatile LONGLONG released;
+   volatile LONGLONG dropped;
+
+   static UInt32 round_size (const UInt32 Value) {
+
+      UInt32 result (2);
+      while ((result < Value) && (result < 0x80000000)) { result = result << 1; }
+      return result;
+   }
+
+   State (const UInt32 TheSize) :
+         Size (round_size (TheSize)),
+         Mask (Size - 1),
+         sequence (new LONG[Size]),
+         position (new UInt32[Size]),
+         enqueue (0),
+         dequeue (0),
+         full (0),
+         peak (0),
+         released (0),
+         dropped (0) {
+
+      for (UInt32 ix = 0; ix < Size; ix++) {
+
+         sequence[ix] = LONG (ix);
+         position[ix] = ix;
+      }
+   }
+
+   ~State () {
+
+      delete []sequence; sequence = 0;
+      delete []position; position = 0;
+   }
+};
+
+
+dmz::SlotQueue::SlotQueue (const UInt32 Size) : _state (*(new State (Size))) {;}
+
+
+dmz::SlotQueue::~SlotQueue () { delete &_state; }
+
+
+dmz::UInt32
+dmz::SlotQueue::get_size () const { return _state.Size; }
+
+
+dmz::UInt32
+dmz::SlotQueue::get_count () const {
+
+   const UInt32 Enqueue (UInt32 (local_load_acquire (&(_state.enqueue))));
+   const UInt32 Dequeue (UInt32 (local_load_acquire (&(_state.dequeue))));
+   return Enqueue - Dequeue;
+}
+
+
+dmz::UInt32
+dmz::SlotQueue::get_full_count () const {
+
+   return UInt32 (local_load_acquire (&(_state.full)));
+}
+
+
+dmz::UInt32
+dmz::SlotQueue::get_peak_count () const {
+
+   return UInt32 (local_load_acquire (&(_state.peak)));
+}
+
+
+dmz::UInt64
+dmz::SlotQueue::get_release_count () const {
+
+   return UInt64 (InterlockedCompareExchange64 (&(_state.released), 0, 0));
+}
+
+
+dmz::UInt64
+dmz::SlotQueue::get_drop_count () const {
+
+   return UInt64 (InterlockedCompareExchange64 (&(_state.dropped), 0, 0));
+}
+
+
+dmz::Boolean
+dmz::SlotQueue::reserve (UInt32 &index) {
+
+   Boolean result (False);
+   Boolean done (False);
+
+   UInt32 pos (UInt32 (local_load_acquire (&(_state.enqueue))));
+
+   while (!done) {
+
+      const UInt32 Index (pos & _state.Mask);
+      const UInt32 Seq (UInt32 (local_load_acquire (&(_state.sequence[Index]))));
+      const Int32 Diff (Int32 (Seq - pos));
+
+      if (Diff == 0) {
+
+         if (LONG (pos) == InterlockedCompareExchange (
+               &(_state.enqueue), LONG (pos + 1), LONG (pos))) {
+
+            _state.position[Index] = pos;
+            index = Index;
+            result = done = True;
+
+            const UInt32 Depth (
+               pos + 1 - UInt32 (local_load_acquire (&(_state.dequeue))));
+            LONG peak (local_load_acquire (&(_state.peak)));
+
+            while ((Depth > UInt32 (peak)) &&
+                  (peak != InterlockedCompareExchange (
+                     &(_state.peak), LONG (Depth), peak))) {
+
+               peak = local_load_acquire (&(_state.peak));
+            }
+         }
+         else { pos = UInt32 (local_load_acquire (&(_state.enqueue))); }
+      }
+      else if (Diff < 0) {
+
+         InterlockedIncrement (&(_state.full));
+         done = True;
+      }
+      else { pos = UInt32 (local_load_acquire (&(_state.enqueue))); }
+   }
+
+   return result;
+}
+
+
+void
+dmz::SlotQueue::commit (const UInt32 Index) {
+
+   local_store_release (
+      &(_state.sequence[Index & _state.Mask]),
+      LONG (_state.position[Index & _state.Mask] + 1));
+}
+
+
+dmz::Boolean
+dmz::SlotQueue::peek (UInt32 &index) const {
+
+   Boolean result (False);
+
+   const UInt32 Pos (UInt32 (_state.dequeue));
+   const UInt32 Index (Pos & _state.Mask);
+
+   if (UInt32 (local_load_acquire (&(_state.sequence[Index]))) == (Pos + 1)) {
+
+      index = Index;
+      result = True;
+   }
+
+   return result;
+}
+
+
+void
+dmz::SlotQueue::release (const UInt32 Index) {
+
+   const UInt32 Pos (UInt32 (_state.dequeue));
+
+   if ((Pos & _state.Mask) == (Index & _state.Mask)) {
+
+      local_store_release (&(_state.dequeue), LONG (Pos + 1));
+      local_store_release (
+         &(_state.sequence[Index & _state.Mask]),
+         LONG (Pos + _state.Size));
+
+      InterlockedIncrement64 (&(_state.released));
+   }
+}
+
+
+dmz::UInt64
+dmz::SlotQueue::drop () {
+
+   return UInt64 (InterlockedIncrement64 (&(_state.dropped)));
+}
@@ -6,6 +6,8 @@
 #endif // __linux
 
 #include <sys/time.h> // for time functions
+#include <errno.h>
+#include <sched.h>
 #include <stdlib.h> // for setenv
 #include <unistd.h>
 
@@ -53,7 +55,8 @@ dmz::get_system_name () {
 
 \brief Gets time at the highest resolution supported by the system.
 \details Defined in dmzSystem.h. Returns a dmz::Float64 containing the number of seconds
-since the application was started.
+since the application was started. The time is taken from a monotonic clock so it is
+not affected by changes to the system's wall clock.
 \return Returns the time in seconds as a dmz::Float64.
 
 */
@@ -79,7 +82,7 @@ dmz::get_time () {
    static Float64 firstTime (0.0);
 
    struct timespec tv;
-   clock_gettime (CLOCK_REALTIME, &tv);
+   clock_gettime (CLOCK_MONOTONIC, &tv);
 
    if (firstCall) {
 
@@ -125,7 +128,7 @@ dmz::sleep (const Float64 Time) {
    if (Time > 0.00001) {
 
       struct timespec ctime;
-      clock_gettime (CLOCK_REALTIME, &ctime);
+      clock_gettime (CLOCK_MONOTONIC, &ctime);
 
       struct timespec mstop = ctime;
       const Int32 MSec = Int32 (Time);
@@ -159,7 +162,7 @@ dmz::sleep (const Float64 Time) {
          }
          else { nanosleep (&ms, 0); }
 
-         if (!done) { clock_gettime (CLOCK_REALTIME, &ctime); }
+         if (!done) { clock_gettime (CLOCK_MONOTONIC, &ctime); }
       }
    }
    else { ::sleep (0); }
@@ -172,6 +175,43 @@ dmz::sleep (const Float64 Time) {
 }
 
 
+/*!
+
+\brief Puts current thread to sleep using only the system's sleep call.
+\details Defined in dmzSystem.h. Unlike dmz::sleep, this function never busy waits so
+the thread may wake up later than requested by up to the granularity of the system's
+scheduler. It is intended for callers that do their own busy wait for the remainder
+of an interval.
+\param[in] Time Number of seconds to sleep.
+
+*/
+void
+dmz::system_sleep (const Float64 Time) {
+
+   if (Time > 0.0) {
+
+      struct timespec tv;
+      tv.tv_sec = time_t (Time);
+      tv.tv_nsec = long ((Time - Float64 (tv.tv_sec)) * Float64 (1.0e9));
+
+      struct timespec remaining;
+
+      while ((nanosleep (&tv, &remaining) != 0) && (errno == EINTR)) { tv = remaining; }
+   }
+}
+
+
+/*!
+
+\brief Gives up the rest of the current thread's time slice.
+\details Defined in dmzSystem.h. Intended for busy waits so that other threads on the
+same core may run.
+
+*/
+void
+dmz::system_yield () { sched_yield (); }
+
+
 /*!
 
 \brief Sets an environment variable.
@@ -1,5 +1,6 @@
 #include <dmzSystem.h>
 #include <dmzSystemUnmarshal.h>
+#include "dmzSystemMarshalLocal.h"
 #include <dmzTypesBase.h>
 #include <dmzTypesMatrix.h>
 #include <dmzTypesString.h>
@@ -12,7 +13,9 @@
 \ingroup System
 \brief Unmarshals data from a buffer in a given byte order.
 \details This class is used to unmarshal data in to a desired byte order, either big or
-little endian.
+little endian. The buffer being unmarshalled is borrowed, not copied, so it must remain
+valid while it is being read. dmz::Unmarshal::get_next_buffer may be used to access
+sections of the buffer in place.
 \sa dmz::Marshal.
 
 */
@@ -61,27 +64,42 @@ struct dmz::Unmarshal::State {
       return *this;
    }
 
+   // Divides instead of multiplying so a hostile Count can not overflow the size.
+   Boolean remaining (const Int32 ValueSize, const Int32 Count) const {
+
+      return buffer && (ValueSize > 0) && (Count >= 0) &&
+         (Count <= ((length - place) / ValueSize));
+   }
+
    void read (const Int32 ValueSize, char *value, const ReadEnum ReadMode = NormalRead) {
 
-      if (buffer && (place + ValueSize) <= length) {
+      read_array (ValueSize, 1, value, ReadMode);
+   }
 
-         if (!swap || (ReadMode == RawRead)) {
+   Boolean read_array (
+         const Int32 ValueSize,
+         const Int32 Count,
+         char *values,
+         const ReadEnum ReadMode = NormalRead) {
 
-            for (Int32 ix = 0; ix < ValueSize; ix++) {
+      Boolean result (False);
 
-               value[ix] = buffer[place];
-               place++;
-            }
-         }
-         else {
+      if (remaining (ValueSize, Count)) {
 
-            for (Int32 ix = (ValueSize - 1); ix >= 0; ix--) {
+         const Int32 Total (ValueSize * Count);
 
-               value[ix] = buffer[place];
-               place++;
-            }
-         }
+         marshal_copy (
+            ValueSize,
+            Count,
+            buffer + place,
+            values,
+            swap && (ReadMode == NormalRead));
+
+         place += Total;
+         result = True;
       }
+
+      return result;
    }
 };
 
@@ -351,7 +369,7 @@ dmz::Unmarshal::get_next_fixed_string (const Int32 Size, String &value) {
 
       Int32 realSize (Size);
 
-      if ((_state.place + Size) >= _state.length) {
+      if (Size >= (_state.length - _state.place)) {
 
          realSize = _state.length - _state.place;
       }
@@ -390,9 +408,7 @@ dmz::Unmarshal::get_next_uuid (UUID &value) {
 void
 dmz::Unmarshal::get_next_vector32 (Vector &value) {
 
-   value.set_x (get_next_float32 ());
-   value.set_y (get_next_float32 ());
-   value.set_z (get_next_float32 ());
+   if (!get_next_vector32_array (1, &value)) { value.set_xyz (0.0, 0.0, 0.0); }
 }
 
 
@@ -406,8 +422,8 @@ dmz::Unmarshal::get_next_vector32 (Vector &value) {
 void
 dmz::Unmarshal::get_next_matrix32 (Matrix &value) {
 
-   Float32 data[9];
-   for (Int32 ix = 0; ix < 9; ix++) { data[ix] = get_next_float32 (); }
+   Float32 data[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+   get_next_float32_array (9, data);
    value.from_array32 (data);
 }
 
@@ -416,9 +432,7 @@ dmz::Unmarshal::get_next_matrix32 (Matrix &value) {
 void
 dmz::Unmarshal::get_next_vector (Vector &value) {
 
-   value.set_x (get_next_float64 ());
-   value.set_y (get_next_float64 ());
-   value.set_z (get_next_float64 ());
+   if (!get_next_vector_array (1, &value)) { value.set_xyz (0.0, 0.0, 0.0); }
 }
 
 
@@ -426,8 +440,180 @@ dmz::Unmarshal::get_next_vector (Vector &value) {
 void
 dmz::Unmarshal::get_next_matrix (Matrix &value) {
 
-   Float64 data[9];
-   for (Int32 ix = 0; ix < 9; ix++) { data[ix] = get_next_float64 (); }
+   Float64 data[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+   get_next_float64_array (9, data);
    value.from_array (data);
 }
 
+
+/*!
+
+\brief Unmarshals an array of dmz::Int16 values from the buffer.
+\details The values are copied and byte swapped in a single pass. If the buffer does
+not contain \a Count values, nothing is read and \a values is not modified.
+\param[in] Count Number of values to unmarshal.
+\param[out] values Array to store the unmarshalled values.
+\return Returns dmz::True if \a Count values were unmarshalled.
+
+*/
+dmz::Boolean
+dmz::Unmarshal::get_next_int16_array (const Int32 Count, Int16 *values) {
+
+   return values ? _state.read_array (sizeof (Int16), Count, (char *)values) : False;
+}
+
+
+//! Unmarshals an array of dmz::Int32 values. \sa dmz::Unmarshal::get_next_int16_array.
+dmz::Boolean
+dmz::Unmarshal::get_next_int32_array (const Int32 Count, Int32 *values) {
+
+   return values ? _state.read_array (sizeof (Int32), Count, (char *)values) : False;
+}
+
+
+//! Unmarshals an array of dmz::Int64 values. \sa dmz::Unmarshal::get_next_int16_array.
+dmz::Boolean
+dmz::Unmarshal::get_next_int64_array (const Int32 Count, Int64 *values) {
+
+   return values ? _state.read_array (sizeof (Int64), Count, (char *)values) : False;
+}
+
+
+//! Unmarshals an array of dmz::UInt16 values. \sa dmz::Unmarshal::get_next_int16_array.
+dmz::Boolean
+dmz::Unmarshal::get_next_uint16_array (const Int32 Count, UInt16 *values) {
+
+   return values ? _state.read_array (sizeof (UInt16), Count, (char *)values) : False;
+}
+
+
+//! Unmarshals an array of dmz::UInt32 values. \sa dmz::Unmarshal::get_next_int16_array.
+dmz::Boolean
+dmz::Unmarshal::get_next_uint32_array (const Int32 Count, UInt32 *values) {
+
+   return values ? _state.read_array (sizeof (UInt32), Count, (char *)values) : False;
+}
+
+
+//! Unmarshals an array of dmz::UInt64 values. \sa dmz::Unmarshal::get_next_int16_array.
+dmz::Boolean
+dmz::Unmarshal::get_next_uint64_array (const Int32 Count, UInt64 *values) {
+
+   return values ? _state.read_array (sizeof (UInt64), Count, (char *)values) : False;
+}
+
+
+//! Unmarshals an array of dmz::Float32 values. \sa dmz::Unmarshal::get_next_int16_array.
+dmz::Boolean
+dmz::Unmarshal::get_next_float32_array (const Int32 Count, Float32 *values) {
+
+   return values ? _state.read_array (sizeof (Float32), Count, (char *)values) : False;
+}
+
+
+//! Unmarshals an array of dmz::Float64 values. \sa dmz::Unmarshal::get_next_int16_array.
+dmz::Boolean
+dmz::Unmarshal::get_next_float64_array (const Int32 Count, Float64 *values) {
+
+   return values ? _state.read_array (sizeof (Float64), Count, (char *)values) : False;
+}
+
+
+/*!
+
+\brief Unmarshals an array of dmz::Vector values stored as 32 bit floats.
+\details The vectors are read in fixed sized blocks so the byte swapping is done in
+bulk. If the buffer does not contain \a Count vectors, nothing is read.
+\param[in] Count Number of vectors to unmarshal.
+\param[out] values Array to store the unmarshalled vectors.
+\return Returns dmz::True if \a Count vectors were unmarshalled.
+
+*/
+dmz::Boolean
+dmz::Unmarshal::get_next_vector32_array (const Int32 Count, Vector *values) {
+
+   Boolean result (False);
+
+   if (values && _state.remaining (3 * Int32 (sizeof (Float32)), Count)) {
+
+      const Int32 BlockSize (32);
+      Float32 data[BlockSize * 3];
+
+      result = True;
+
+      for (Int32 ix = 0; result && (ix < Count); ix += BlockSize) {
+
+         const Int32 Size ((Count - ix) < BlockSize ? (Count - ix) : BlockSize);
+
+         result = get_next_float32_array (Size * 3, data);
+
+         for (Int32 jy = 0; result && (jy < Size); jy++) {
+
+            values[ix + jy].set_xyz (
+               data[(jy * 3)],
+               data[(jy * 3) + 1],
+               data[(jy * 3) + 2]);
+         }
+      }
+   }
+
+   return result;
+}
+
+
+//! Unmarshals an array of dmz::Vector values stored as native 64 bit floats.
+dmz::Boolean
+dmz::Unmarshal::get_next_vector_array (const Int32 Count, Vector *values) {
+
+   Boolean result (False);
+
+   if (values && _state.remaining (3 * Int32 (sizeof (Float64)), Count)) {
+
+      const Int32 BlockSize (32);
+      Float64 data[BlockSize * 3];
+
+      result = True;
+
+      for (Int32 ix = 0; result && (ix < Count); ix += BlockSize) {
+
+         const Int32 Size ((Count - ix) < BlockSize ? (Count - ix) : BlockSize);
+
+         result = get_next_float64_array (Size * 3, data);
+
+         for (Int32 jy = 0; result && (jy < Size); jy++) {
+
+            values[ix + jy].set_xyz (
+               data[(jy * 3)],
+               data[(jy * 3) + 1],
+               data[(jy * 3) + 2]);
+         }
+      }
+   }
+
+   return result;
+}
+
+
+/*!
+
+\brief Returns the next section of the buffer without copying it.
+\details The returned pointer points directly in to the buffer being unmarshalled and
+the read place is advanced past the section. No byte swapping is done.
+\param[in] Size Number of bytes in the section.
+\return Returns a pointer to the section. Returns NULL if the buffer does not contain
+\a Size more bytes.
+
+*/
+char *
+dmz::Unmarshal::get_next_buffer (const Int32 Size) {
+
+   char *result (0);
+
+   if (_state.remaining (1, Size)) {
+
+      result = _state.buffer + _state.place;
+      _state.place += Size;
+   }
+
+   return result;
+}
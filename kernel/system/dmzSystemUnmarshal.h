@@ -60,6 +60,24 @@ namespace dmz {
          void get_next_vector (Vector &value);
          void get_next_matrix (Matrix &value);
 
+         // Unmarshals arrays of values in a single pass
+         Boolean get_next_int16_array (const Int32 Count, Int16 *values);
+         Boolean get_next_int32_array (const Int32 Count, Int32 *values);
+         Boolean get_next_int64_array (const Int32 Count, Int64 *values);
+
+         Boolean get_next_uint16_array (const Int32 Count, UInt16 *values);
+         Boolean get_next_uint32_array (const Int32 Count, UInt32 *values);
+         Boolean get_next_uint64_array (const Int32 Count, UInt64 *values);
+
+         Boolean get_next_float32_array (const Int32 Count, Float32 *values);
+         Boolean get_next_float64_array (const Int32 Count, Float64 *values);
+
+         Boolean get_next_vector32_array (const Int32 Count, Vector *values);
+         Boolean get_next_vector_array (const Int32 Count, Vector *values);
+
+         // Returns a section of the buffer in place without copying
+         char *get_next_buffer (const Int32 Size);
+
       protected:
          struct State;
          State &_state; //!< Internal state.
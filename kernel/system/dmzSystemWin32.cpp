@@ -73,6 +73,18 @@ dmz::sleep (const Float64 Time) {
 }
 
 
+void
+dmz::system_sleep (const Float64 Time) {
+
+   if (localFirstCall) { local_init (); }
+   if (Time > 0.0) { Sleep (DWORD (Time * 1000.0)); }
+}
+
+
+void
+dmz::system_yield () { SwitchToThread (); }
+
+
 void
 dmz::set_env (const String &Name, const String &Value) {
 
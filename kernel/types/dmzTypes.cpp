@@ -66,11 +66,11 @@ const dmz::Int16 dmz::MaxInt16 = SHRT_MAX;
 //! Maximum UInt16 Value
 const dmz::UInt16 dmz::MaxUInt16 = USHRT_MAX;
 //! Minimum Int32 Value
-const dmz::Int32 dmz::MinInt32 = LONG_MIN;
+const dmz::Int32 dmz::MinInt32 = INT_MIN;
 //! Maximum Int32 Value
-const dmz::Int32 dmz::MaxInt32 = LONG_MAX;
+const dmz::Int32 dmz::MaxInt32 = INT_MAX;
 //! Maximum UInt32 Value
-const dmz::UInt32 dmz::MaxUInt32 = ULONG_MAX;
+const dmz::UInt32 dmz::MaxUInt32 = UINT_MAX;
 //! Minimum Int64 Value
 const dmz::Int64 dmz::MinInt64 = LLONG_MIN;
 //! Maximum Int64 Value
@@ -2,93 +2,119 @@
 #include <dmzTypesHashTableString.h>
 #include <dmzTypesString.h>
 
-static inline dmz::Int32
-local_hash (const dmz::UInt32 Value) {
+// Integer keys are used as their own hash as the old table did. Handles are
+// allocated sequentially so neighbouring handles land in neighbouring slots.
+static inline dmz::UInt32
+local_hash (const dmz::UInt32 Value) { return Value; }
 
-   dmz::Int32 result (Value);
-   if (result < 0) { result = -result; }
-   return result;
+
+static inline dmz::UInt32
+local_hash (const dmz::UInt64 Value) {
+
+   return dmz::UInt32 (Value) ^ dmz::UInt32 (Value >> 32);
 }
 
 
-static inline dmz::Int32
-local_hash (const dmz::UInt64 Value) {
+// Returns dmz::True when equal hashes mean equal keys so the key stored in the
+// element does not need to be compared.
+static inline dmz::Boolean
+local_hash_is_key (const dmz::UInt32 Value) { return dmz::True; }
+
+
+static inline dmz::Boolean
+local_hash_is_key (const dmz::UInt64 Value) { return dmz::False; }
+
+
+static inline dmz::UInt32
+local_hash_bytes (const dmz::UInt8 *Buffer, const dmz::Int32 Length) {
+
+   // 32 bit FNV-1a.
+   dmz::UInt32 result (2166136261u);
+
+   for (dmz::Int32 ix = 0; ix < Length; ix++) {
+
+      result ^= dmz::UInt32 (Buffer[ix]);
+      result *= 16777619u;
+   }
 
-   dmz::UInt32 *ptr = (dmz::UInt32 *)&Value;
-   dmz::Int32 result = (dmz::Int32)ptr[0] ^ ptr[1];
-   if (result < 0) { result = -result; }
    return result;
 }
 
 
 #ifdef DMZ_TYPES_STRING_DOT_H
-static inline dmz::Int32
+static inline dmz::UInt32
 local_hash (const dmz::String &Value) {
 
-   dmz::Int32 result (0);
    dmz::Int32 len (0);
    const char *buf = Value.get_buffer (len);
 
-   result = (5 * len);
-
-   for (dmz::Int32 ix = 0; ix < len; ix++) {
-
-      result = ((result << 1) + dmz::Int32 (buf[ix]));
-   }
+   return local_hash_bytes ((const dmz::UInt8 *)buf, buf ? len : 0);
+}
 
-   if (result < 0) { result = -result; }
 
-   return result;
-}
+static inline dmz::Boolean
+local_hash_is_key (const dmz::String &Value) { return dmz::False; }
 #endif
 
 
 #ifdef DMZ_TYPES_UUID_DOT_H
-static inline dmz::Int32
+static inline dmz::UInt32
 local_hash (const dmz::UUID &Value) {
 
-   dmz::Int32 result (0);
-
    dmz::UInt8 array[16];
 
    Value.to_array (array);
 
-   for (dmz::Int32 ix = 0; ix < 16; ix++) {
-
-      result = ((result << 2) + dmz::Int32 (array[ix]));
-   }
+   return local_hash_bytes (array, 16);
+}
 
-   if (result < 0) { result = -result; }
 
-   return result;
-}
+static inline dmz::Boolean
+local_hash_is_key (const dmz::UUID &Value) { return dmz::False; }
 #endif
 
 
 namespace {
 
+   const dmz::Int32 EmptySlot (-1);
+   const dmz::Int32 RemovedSlot (-2);
+
+   // The slots hold the hash and a copy of the data so that probes and lookups of
+   // integer keys do not need to touch the elements.
+   struct SlotStruct {
+
+      dmz::UInt32 hash;
+      dmz::Int32 index;
+      void *data;
+   };
+
+   // Elements are stored densely and never move once stored. The prev and next
+   // indices thread the iteration order through the elements so that they may be
+   // reordered with move (). A removed element keeps its prev and next indices so
+   // iteration may continue from an element that was removed. Removed elements are
+   // queued on the free list and reused oldest first.
    struct DataStruct {
 
-      DataStruct *prev;
-      DataStruct *next;
       dmz::String key;
       void *data;
-      dmz::Boolean dirty;
+      dmz::Int32 prev;
+      dmz::Int32 next;
+      dmz::Int32 nextFree;
 
       DataStruct () :
-         prev (0),
-         next (0),
          key (0),
          data (0),
-         dirty (dmz::False) {;}
+         prev (-1),
+         next (-1),
+         nextFree (-1) {;}
 
       void clear () {
 
-         prev = 0;
-         next = 0;
          key.flush ();
          data = 0;
-         dirty = dmz::False;
+         prev = -1;
+         next = -1;
+         nextFree = -1;
       }
    };
 };
@@ -111,11 +137,13 @@ struct dmz::HashTableStringIterator::idata {
    Int32 index;
    String key;
    UInt32 growCount;
+   UInt32 reuseCount;
 
    idata () :
       index (-1),
       key (0),
-      growCount (0) {;}
+      growCount (0),
+      reuseCount (0) {;}
 
    idata (const idata &Id);
    void clear () {
@@ -123,6 +151,7 @@ struct dmz::HashTableStringIterator::idata {
       index = -1;
       key.flush ();
       growCount = 0;
+      reuseCount = 0;
    }
 
    void reset ();
@@ -158,66 +187,227 @@ dmz::HashTableStringIterator::reset () { data.index = -1; }
 struct dmz::HashTableString::State {
 
    UInt32 growCount;
+   UInt32 reuseCount;
    Int32 size;
    Int32 count;
+   Int32 used;
+   Int32 removed;
+   Int32 removedLimit;
+   Int32 freeHead;
+   Int32 freeTail;
    Boolean autoGrow;
+   UInt32 slotMask;
+   SlotStruct *slots;
    DataStruct *table;
-   DataStruct *head;
-   DataStruct *tail;
+   Int32 head;
+   Int32 tail;
 
    State () :
       growCount (0),
+      reuseCount (0),
       size (0),
       count (0),
+      used (0),
+      removed (0),
+      removedLimit (0),
+      freeHead (-1),
+      freeTail (-1),
       autoGrow (True),
+      slotMask (0),
+      slots (0),
       table (0),
-      head (0),
-      tail (0) {;}
+      head (-1),
+      tail (-1) {;}
+
+   ~State () { free_table (); }
+
+   void free_table () {
+
+      if (table) { delete []table; table = 0; }
+      if (slots) { delete []slots; slots = 0; }
+   }
+
+   // Each hash value starts its probe on an even slot so the slots behave as
+   // buckets of two. Sequential keys then fill every other slot and a probe that
+   // misses ends on the next slot instead of running to the end of the sequence.
+   UInt32 get_slot (const UInt32 Hash) const { return (Hash << 1) & slotMask; }
+
+   // There are at least twice as many slots as the table size and the removed slots
+   // are limited to a quarter of them so there is always an empty slot to end the
+   // probe.
+   Int32 find_slot (const String &Key, const UInt32 Hash) const {
+
+      Int32 result (-1);
+
+      if (slots) {
 
-   ~State () { if (table) { delete []table; table = 0; } }
+         UInt32 slot (get_slot (Hash));
+
+         while (slots[slot].index != EmptySlot) {
+
+            const SlotStruct &Slot = slots[slot];
+
+            if ((Slot.hash == Hash) && (Slot.index >= 0) &&
+                  (local_hash_is_key (Key) || (table[Slot.index].key == Key))) {
+
+               result = Int32 (slot);
+               break;
+            }
+
+            slot = (slot + 1) & slotMask;
+         }
+      }
+
+      return result;
+   }
 
    Boolean find_index (const String &Key, Int32 &index) const {
 
-      Boolean result (False);
+      const Int32 Slot (find_slot (Key, local_hash (Key)));
 
-      if (table) {
+      index = (Slot >= 0) ? slots[Slot].index : -1;
+
+      return Slot >= 0;
+   }
 
-         index = local_hash (Key) % size;
-         Boolean done (False);
-         const Int32 StartIndex (index);
+   // Returns the first removed or empty slot on the probe for the key or -1 if the
+   // key is already stored.
+   Int32 find_free_slot (const String &Key, const UInt32 Hash) const {
 
-         while (!done) {
+      Int32 result (-1);
+      Boolean found (False);
+      UInt32 slot (get_slot (Hash));
 
-            if ((table[index].key == Key) && table[index].data) { result = done = True; }
-            else if (!table[index].dirty) { done = True; }
-            else { index++; if (index >= size) { index = 0; } }
-            if (StartIndex == index) { done = True; }
+      while (!found && (slots[slot].index != EmptySlot)) {
+
+         const SlotStruct &Slot = slots[slot];
+
+         if (Slot.index == RemovedSlot) { if (result < 0) { result = Int32 (slot); } }
+         else if ((Slot.hash == Hash) &&
+               (local_hash_is_key (Key) || (table[Slot.index].key == Key))) {
+
+            found = True;
          }
 
-         if (!result) { index = -1; }
+         slot = (slot + 1) & slotMask;
       }
 
+      if (found) { result = -1; }
+      else if (result < 0) { result = Int32 (slot); }
+
       return result;
    }
 
-   void clear () {
+   void insert (const Int32 Slot, const String &Key, const UInt32 Hash, void *data) {
 
-      if (table) {
+      Int32 index (used);
+
+      if (freeHead >= 0) {
+
+         index = freeHead;
+         freeHead = table[index].nextFree;
+         if (freeHead < 0) { freeTail = -1; }
+         reuseCount++;
+      }
+      else { used++; }
+
+      DataStruct &el = table[index];
+      el.key = Key;
+      el.data = data;
+      el.prev = tail;
+      el.next = -1;
+      el.nextFree = -1;
+
+      if (tail >= 0) { table[tail].next = index; }
+      else { head = index; }
+      tail = index;
+
+      if (slots[Slot].index == RemovedSlot) { removed--; }
+      slots[Slot].hash = Hash;
+      slots[Slot].index = index;
+      slots[Slot].data = data;
+
+      count++;
+   }
+
+   // Rebuilds the slots with room for Size elements and drops the removed slots.
+   // The elements keep their indices so iterators are not affected.
+   Boolean rebuild (const Int32 Size) {
+
+      Boolean result (False);
+
+      UInt32 slotCount (2);
+
+      while ((slotCount < UInt32 (Size) * 2) && (slotCount < 0x80000000)) {
+
+         slotCount = slotCount << 1;
+      }
+
+      DataStruct *newTable (Size != size ? new DataStruct[Size] : table);
+      SlotStruct *newSlots (new SlotStruct[slotCount]);
+
+      if (newSlots && newTable) {
 
-         for (Int32 ix = 0; ix < size; ix++) {
+         result = True;
+
+         if (newTable != table) {
+
+            for (Int32 ix = 0; ix < used; ix++) { newTable[ix] = table[ix]; }
+            if (table) { delete []table; }
+            table = newTable;
+         }
+
+         for (UInt32 ix = 0; ix < slotCount; ix++) { newSlots[ix].index = EmptySlot; }
+
+         for (UInt32 ix = 0; slots && (ix <= slotMask); ix++) {
+
+            const SlotStruct &Slot = slots[ix];
+
+            if (Slot.index >= 0) {
+
+               UInt32 slot ((Slot.hash << 1) & (slotCount - 1));
+
+               while (newSlots[slot].index != EmptySlot) {
 
-            table[ix].clear ();
+                  slot = (slot + 1) & (slotCount - 1);
+               }
+
+               newSlots[slot] = Slot;
+            }
          }
+
+         if (slots) { delete []slots; }
+         slots = newSlots;
+         slotMask = slotCount - 1;
+         size = Size;
+         removed = 0;
+         removedLimit = Int32 (slotCount >> 2);
       }
+      else {
 
-      count = 0;
+         if (newTable && (newTable != table)) { delete []newTable; newTable = 0; }
+         if (newSlots) { delete []newSlots; newSlots = 0; }
+      }
 
-      head = tail = 0;
+      return result;
    }
 
-   Int32 find_ptr_index (DataStruct *data) const {
+   void clear () {
+
+      if (table) {
 
-      return Int32 (data - table);
+         for (Int32 ix = 0; ix < used; ix++) { table[ix].clear (); }
+      }
+
+      if (slots) {
+
+         for (UInt32 ix = 0; ix <= slotMask; ix++) { slots[ix].index = EmptySlot; }
+      }
+
+      growCount++;
+      count = used = removed = 0;
+      freeHead = freeTail = -1;
+      head = tail = -1;
    }
 };
 
@@ -281,54 +471,52 @@ dmz::HashTableString::move (
 
    if (_state.find_index (Key, index)) {
 
-      DataStruct &current = _state.table[index];
-      DataStruct *target (0);
+      DataStruct *table (_state.table);
+      DataStruct &current = table[index];
+      Int32 target (-1);
 
       if (TargetKey) {
 
          Int32 targetIndex (-1);
 
-         if (_state.find_index (*TargetKey, targetIndex)) {
-
-            target = &(_state.table[targetIndex]);
-         }
+         if (_state.find_index (*TargetKey, targetIndex)) { target = targetIndex; }
       }
       else if (Before) { target = SingleStep ? current.prev : _state.head; }
       else { target = SingleStep ? current.next : _state.tail; }
 
-      if (target && (target != &current)) {
+      if ((target >= 0) && (target != index)) {
 
-         if (current.next) { current.next->prev = current.prev; }
+         if (current.next >= 0) { table[current.next].prev = current.prev; }
          else { _state.tail = current.prev; }
 
-         if (current.prev) { current.prev->next = current.next; }
+         if (current.prev >= 0) { table[current.prev].next = current.next; }
          else { _state.head = current.next; }
- 
+
          if (Before) {
 
             current.next = target;
 
-            if (target->prev) {
+            if (table[target].prev >= 0) {
 
-               target->prev->next = &current;
-               current.prev = target->prev;
+               table[table[target].prev].next = index;
+               current.prev = table[target].prev;
             }
-            else { _state.head = &current; current.prev = 0; }
+            else { _state.head = index; current.prev = -1; }
 
-            target->prev = &current;
+            table[target].prev = index;
          }
          else {
 
             current.prev = target;
 
-            if (target->next) {
+            if (table[target].next >= 0) {
 
-               target->next->prev = &current;
-               current.next = target->next;
+               table[table[target].next].prev = index;
+               current.next = table[target].next;
             }
-            else { _state.tail = &current; current.next = 0; }
+            else { _state.tail = index; current.next = -1; }
 
-            target->next = &current;
+            table[target].next = index;
          }
 
          result = True;
@@ -347,39 +535,52 @@ dmz::HashTableString::get_next (HashTableStringIterator &it, const Boolean Prev)
 
    if (_state.table) {
 
+      // index is out of range, some one is probably using an iterator from a
+      // different table, just reset to prevent from going out of bounds.
+      if (it.data.index >= _state.used) { it.data.index = -1; }
+
       if (it.data.growCount != _state.growCount) {
 
-         if ((it.data.index >= 0) && !_state.find_index (it.data.key, it.data.index)) {
+         // The table has been cleared or resized with set_table_size so the index
+         // no longer refers to the element. Start at the beginning again.
+         it.data.index = -1;
+         it.data.growCount = _state.growCount;
+         it.data.reuseCount = _state.reuseCount;
+      }
+      else if (it.data.reuseCount != _state.reuseCount) {
+
+         // A removed element has been reused since the last call. If it was the one
+         // the iterator was pointing at, its links now belong to a different key.
+         if ((it.data.index >= 0) && !(_state.table[it.data.index].key == it.data.key) &&
+               !_state.find_index (it.data.key, it.data.index)) {
 
-            // if the table has grown and the key can not be resolved
-            // the table must have grown and the element we were pointing at was
-            //  removed! So we just start at the beginning again.
             it.data.index = -1;
          }
 
-         it.data.growCount = _state.growCount;
+         it.data.reuseCount = _state.reuseCount;
       }
 
-      // index is out of range, some one is probably using an iterator from a
-      // different table, just reset to prevent from going out of bounds.
-      if (it.data.index >= _state.size) { it.data.index = -1; }
+      const DataStruct *Table (_state.table);
 
-      DataStruct *cur = (it.data.index >= 0) ?
-         &(_state.table[it.data.index]) :
+      Int32 cur = (it.data.index >= 0) ?
+         it.data.index :
          (Prev ? _state.tail : _state.head);
 
-      if (cur && (it.data.index >= 0)) {
+      if ((cur >= 0) && (it.data.index >= 0)) {
+
+         cur = Prev ? Table[cur].prev : Table[cur].next;
 
-         cur = Prev ? cur->prev : cur->next;
+         while ((cur >= 0) && !Table[cur].data) {
 
-         while (cur && !cur->data) { cur = Prev ? cur->prev : cur->next; }
+            cur = Prev ? Table[cur].prev : Table[cur].next;
+         }
       }
 
-      if (cur) {
+      if (cur >= 0) {
 
-         data = cur->data;
-         it.data.index = _state.find_ptr_index (cur);
-         it.data.key = cur->key;
+         data = Table[cur].data;
+         it.data.index = cur;
+         it.data.key = Table[cur].key;
       }
    }
 
@@ -392,12 +593,10 @@ void *
 dmz::HashTableString::lookup (const String &Key) const {
 
    void *data (0);
-   Int32 index (-1);
 
-   if (_state.table && _state.find_index (Key, index)) {
+   const Int32 Slot (_state.find_slot (Key, local_hash (Key)));
 
-      data = _state.table[index].data;
-   }
+   if (Slot >= 0) { data = _state.slots[Slot].data; }
 
    return data;
 }
@@ -415,54 +614,23 @@ dmz::HashTableString::store (const String &Key, void *data) {
 
       if (_state.size >= (_state.count + 1)) {
 
-         Int32 index = local_hash (Key) % _state.size;
-         const Int32 StartIndex (index);
-         Boolean done (False);
-
-         Int32 foundIndex (-1);
-
-         while (!done) {
+         const UInt32 Hash (local_hash (Key));
 
-            if (!_state.table[index].data && (foundIndex < 0)) { foundIndex = index; }
+         Int32 slot (_state.find_free_slot (Key, Hash));
 
-            if (!_state.table[index].dirty) { done = True; }
-            else {
+         if ((slot >= 0) && (_state.slots[slot].index == EmptySlot) &&
+               (_state.removed >= _state.removedLimit)) {
 
-               if ((_state.table[index].key == Key) && _state.table[index].data) {
-
-                  done = True;
-                  foundIndex = -1;
-               }
-               else {
-
-                  index++;
-                  if (index >= _state.size) { index = 0; }
-                  if (index == StartIndex) { done = True; }
-               }
-            }
+            // Removed slots are lengthening the probes and none were on this one.
+            // Drop them without growing and find the slot again.
+            _state.rebuild (_state.size);
+            slot = _state.find_free_slot (Key, Hash);
          }
 
-         if (foundIndex >= 0) {
+         if (slot >= 0) {
 
+            _state.insert (slot, Key, Hash, data);
             result = True;
-            _state.count++;
-
-            _state.table[foundIndex].prev = 0;
-            _state.table[foundIndex].next = 0;
-            _state.table[foundIndex].key = Key;
-            _state.table[foundIndex].data = data;
-            _state.table[foundIndex].dirty = True;
-
-            if (_state.tail) {
-
-               _state.table[foundIndex].prev = _state.tail;
-               _state.tail->next = &(_state.table[foundIndex]);
-               _state.tail = &(_state.table[foundIndex]);
-            }
-            else {
-
-               _state.head = _state.tail = &(_state.table[foundIndex]);
-            }
          }
       }
    }
@@ -476,19 +644,28 @@ void *
 dmz::HashTableString::remove (const String &Key) {
 
    void *data (0);
-   Int32 index (-1);
 
-   if (_state.table && _state.find_index (Key, index)) {
+   const Int32 Slot (_state.table ? _state.find_slot (Key, local_hash (Key)) : -1);
 
-      DataStruct &el = _state.table[index];
+   if (Slot >= 0) {
+
+      const Int32 Index (_state.slots[Slot].index);
+      DataStruct &el = _state.table[Index];
       data = el.data;
       el.data = 0;
 
-      if (el.prev) { el.prev->next = el.next; }
+      if (el.prev >= 0) { _state.table[el.prev].next = el.next; }
       else { _state.head = el.next; }
-      if (el.next) { el.next->prev = el.prev; }
+      if (el.next >= 0) { _state.table[el.next].prev = el.prev; }
       else { _state.tail = el.prev; }
 
+      if (_state.freeTail >= 0) { _state.table[_state.freeTail].nextFree = Index; }
+      else { _state.freeHead = Index; }
+      _state.freeTail = Index;
+
+      _state.slots[Slot].index = RemovedSlot;
+      _state.slots[Slot].data = 0;
+      _state.removed++;
       _state.count--;
    }
 
@@ -507,7 +684,7 @@ dmz::HashTableString::grow (const Int32 Size) {
       if (!Size) {
 
          if (!_state.size) { newSize = 1; }
-         else { newSize = _state.size; newSize = newSize << 1; }
+         else if (_state.size < 0x40000000) { newSize = _state.size << 1; }
       }
       else {
 
@@ -515,7 +692,7 @@ dmz::HashTableString::grow (const Int32 Size) {
 
             newSize = _state.size;
             if (!newSize) { newSize = 1; }
-            while ((newSize < Size) && (newSize <= 0x80000000)) {
+            while ((newSize < Size) && (newSize < 0x40000000)) {
 
                newSize = newSize << 1;
             }
@@ -523,41 +700,7 @@ dmz::HashTableString::grow (const Int32 Size) {
       }
    }
 
-   if (newSize) {
-
-      _state.growCount++;
-
-      const Int32 OldSize (_state.size);
-      const Int32 OldCount (_state.count);
-      DataStruct *table (_state.table);
-
-      _state.size = 0;
-      _state.count = 0;
-      _state.table = new DataStruct[newSize];
-
-      if (table && _state.table) {
-
-         _state.size = newSize;
-
-         DataStruct *cur (_state.head);
-         _state.tail = _state.head = 0;
-
-         while (cur) {
-
-            store (cur->key, cur->data);
-            cur = cur->next;
-         }
-
-         delete []table; table = 0;
-      }
-      else if (_state.table) { _state.size = newSize; }
-      else if (table) {
-
-         _state.table = table;
-         _state.size = OldSize;
-         _state.count = OldCount;
-      }
-   }
+   if (newSize) { _state.rebuild (newSize); }
 }
 
 
@@ -565,17 +708,18 @@ dmz::HashTableString::grow (const Int32 Size) {
 void
 dmz::HashTableString::set_table_size (const Int32 Size) {
 
-   if (_state.table) { delete []_state.table; _state.table = 0; }
+   _state.free_table ();
+   _state.growCount++;
    _state.size = 0;
    _state.count = 0;
-   _state.head = _state.tail = 0;
-
-   if (Size) {
-
-      _state.table = new DataStruct[Size];
-
-      if (_state.table) { _state.size = Size; }
-   }
+   _state.used = 0;
+   _state.removed = 0;
+   _state.removedLimit = 0;
+   _state.freeHead = _state.freeTail = -1;
+   _state.slotMask = 0;
+   _state.head = _state.tail = -1;
+
+   if (Size) { _state.rebuild (Size); }
 }
 
 
@@ -1,5 +1,4 @@
 #include <dmzTypesMask.h>
-#include <stdlib.h>
 #include <string.h>
 
 /*!
@@ -10,67 +9,62 @@
 \details The dmz::Mask is a bit mask of dynamic size. Rather than be limited to 32
 or 64 bit flags as with typical bit masks that use unsigned integers, a dmz::Mask
 is able to accommodate as may bit flags as memory will allow. The dmz::Mask supports
-most typical bitwise operations.
+most typical bitwise operations. Masks of up to 256 bits are stored inside the
+dmz::Mask object so creating and copying them does not allocate memory. Larger masks
+are stored on the heap.
 \htmlonly Lua bindings are <a href="dmzlua.html#dmz.mask">available</a>.
 \endhtmlonly
 */
 
-struct dmz::Mask::State {
-
-   Int32 size;
-   UInt32 *mask;
-   State () : size (0), mask (0) {;}
-   ~State () { empty (); }
-   void empty () { if (mask) { delete []mask; mask = 0; size = 0; } }
-   void clear () { if (mask) { memset (mask, '\0', size * sizeof (UInt32)); } }
-
-   void grow_buffer (const Int32 Size) {
-
-      if ((Size >= 0) && (Size > size)) {
-
-         empty ();
-         mask = new UInt32[Size];
-         if (mask) { size = Size; clear (); }
-      }
-      else { clear (); }
-   }
+//! \cond
+// Grows the mask to Size 32 bit blocks. Blocks past _size are always zero.
+dmz::Boolean
+dmz::Mask::_resize (const Int32 Size) {
 
-   void resize (const Int32 Size) {
+   if (Size > _capacity) {
 
-      if (!mask) { grow_buffer (Size); }
-      else if (Size > size) {
+      Int32 capacity (_capacity * 2);
+      if (capacity < Size) { capacity = Size; }
 
-         const Int32 OldSize (size);
-         UInt32 *oldMask (mask);
+      UInt32 *mask (new UInt32[capacity]);
 
-         mask = new UInt32[Size];
+      if (mask) {
 
-         if (mask) {
+         memcpy (mask, _mask, _size * sizeof (UInt32));
+         memset (mask + _size, '\0', (capacity - _size) * sizeof (UInt32));
 
-            size = Size;
-            clear ();
+         if (_mask != _local) { delete []_mask; }
 
-            memcpy (mask, oldMask, OldSize * sizeof (UInt32));
-            delete []oldMask; oldMask = 0;
-         }
-         else { mask = oldMask; }
+         _mask = mask;
+         _capacity = capacity;
       }
-      else {;} // do nothing
    }
-};
+
+   if ((Size > _size) && (Size <= _capacity)) { _size = Size; }
+
+   return Size <= _size;
+}
+//! \endcond
 
 
 /*!
 
 \brief Default constructor.
-\details No initial storage is allocated.
+\details No heap storage is allocated.
 
 */
-dmz::Mask::Mask () : _state (*(new State)) {;}
+dmz::Mask::Mask () : _size (0), _capacity (LocalSize), _mask (_local) {
+
+   memset (_local, '\0', sizeof (_local));
+}
 
 
 //! Copy constructor.
-dmz::Mask::Mask (const Mask &Value) : _state (*(new State)) { *this = Value; }
+dmz::Mask::Mask (const Mask &Value) : _size (0), _capacity (LocalSize), _mask (_local) {
+
+   memset (_local, '\0', sizeof (_local));
+   *this = Value;
+}
 
 
 /*!
@@ -81,7 +75,9 @@ number of bits specified by \a Shift.
 \param[in] Shift Number of bits to shift single bit in mask.
 
 */
-dmz::Mask::Mask (const Int32 Shift) : _state (*(new State)) {
+dmz::Mask::Mask (const Int32 Shift) : _size (0), _capacity (LocalSize), _mask (_local) {
+
+   memset (_local, '\0', sizeof (_local));
 
    if (Shift >= 0) { set_sub_mask (0, 0x01); *this << Shift; }
 }
@@ -96,14 +92,19 @@ the number of bits specified by \a Shift.
 \param[in] Value 32 bit mask to be shifted.
 
 */
-dmz::Mask::Mask (const Int32 Shift, const UInt32 Value) : _state (*(new State)) {
+dmz::Mask::Mask (const Int32 Shift, const UInt32 Value) :
+      _size (0),
+      _capacity (LocalSize),
+      _mask (_local) {
+
+   memset (_local, '\0', sizeof (_local));
 
    if (Shift >= 0) { set_sub_mask (0, Value); *this << Shift; }
 }
 
 
 //! Destructor. Deletes all allocated storage.
-dmz::Mask::~Mask () { delete &_state; }
+dmz::Mask::~Mask () { if (_mask != _local) { delete []_mask; _mask = 0; } }
 
 
 /*!
@@ -119,25 +120,17 @@ considered equal.
 dmz::Boolean
 dmz::Mask::operator== (const Mask &Value) const {
 
-   const Int32 MaxSize =
-      (_state.size > Value._state.size) ? _state.size : Value._state.size;
-
-   Boolean done (False);
-   Boolean result (True);
-   Int32 count (0);
-
-   while (!done) {
+   const Int32 MinSize ((_size < Value._size) ? _size : Value._size);
+   const UInt32 *Rest ((_size > MinSize) ? _mask : Value._mask);
+   const Int32 RestSize ((_size > MinSize) ? _size : Value._size);
+   const UInt32 *ValueMask (Value._mask);
 
-      if (((count < _state.size) ? _state.mask[count] : 0) !=
-            ((count < Value._state.size) ? Value._state.mask[count] : 0)) {
+   UInt32 bits (0);
 
-         done = True;
-         result = False;
-      }
-      else { count++; if (count >= MaxSize) { done = True; } }
-   }
+   for (Int32 ix = 0; !bits && (ix < MinSize); ix++) { bits = _mask[ix] ^ ValueMask[ix]; }
+   for (Int32 ix = MinSize; !bits && (ix < RestSize); ix++) { bits = Rest[ix]; }
 
-   return result;
+   return bits == 0;
 }
 
 
@@ -150,28 +143,7 @@ not the other.
 
 */
 dmz::Boolean
-dmz::Mask::operator!= (const Mask &Value) const {
-
-   const Int32 MaxSize =
-      (_state.size > Value._state.size) ? _state.size : Value._state.size;
-
-   Boolean done (False);
-   Boolean result (False);
-   Int32 count (0);
-
-   while (!done) {
-
-      if (((count < _state.size) ? _state.mask[count] : 0) !=
-            ((count < Value._state.size) ? Value._state.mask[count] : 0)) {
-
-         done = True;
-         result = True;
-      }
-      else { count++; if (count >= MaxSize) { done = True; } }
-   }
-
-   return result;
-}
+dmz::Mask::operator!= (const Mask &Value) const { return !(*this == Value); }
 
 
 /*!
@@ -185,14 +157,20 @@ dmz::Mask::operator!= (const Mask &Value) const {
 dmz::Mask &
 dmz::Mask::operator= (const Mask &Value) {
 
-   _state.grow_buffer (Value._state.size);
+   if (this != &Value) {
 
-   if (_state.mask && Value._state.mask) {
+      const Int32 OldSize (_size);
 
-      const Int32 MinSize (
-         (_state.size > Value._state.size) ? Value._state.size : _state.size);
+      _resize (Value._size);
 
-      memcpy (_state.mask, Value._state.mask, MinSize * sizeof (UInt32));
+      const Int32 CopySize ((_size < Value._size) ? _size : Value._size);
+
+      memcpy (_mask, Value._mask, CopySize * sizeof (UInt32));
+
+      if (OldSize > CopySize) {
+
+         memset (_mask + CopySize, '\0', (OldSize - CopySize) * sizeof (UInt32));
+      }
    }
 
    return *this;
@@ -207,20 +185,7 @@ storage has a bit set.
 
 */
 dmz::Boolean
-dmz::Mask::operator! () const {
-
-   Boolean result (True);
-   Int32 count (0);
-   Boolean done ((_state.size > 0) ? False : True);
-
-   while (!done) {
-
-      if (_state.mask[count]) { done = True; result = False; }
-      else { count++; if(count >= _state.size) { done = True; } }
-   }
-
-   return result;
-}
+dmz::Mask::operator! () const { return !is_set (); }
 
 
 /*!
@@ -234,13 +199,10 @@ dmz::Mask
 dmz::Mask::operator~ () const {
 
    Mask result (*this);
-   UInt32 *mask = result._state.mask;
-
-   if (mask) {
+   UInt32 *mask (result._mask);
+   const Int32 Size (result._size);
 
-      const Int32 Size = result._state.size;
-      for (Int32 ix = 0; ix < Size; ix++) { mask[ix] = ~mask[ix]; }
-   }
+   for (Int32 ix = 0; ix < Size; ix++) { mask[ix] = ~mask[ix]; }
 
    return result;
 }
@@ -256,32 +218,14 @@ dmz::Mask::operator~ () const {
 dmz::Mask &
 dmz::Mask::operator^= (const Mask &Value) {
 
-   if (Value._state.mask) {
-
-      const Int32 ValueSize (Value._state.size);
-      const UInt32 *ValueMask (Value._state.mask);
-      UInt32 *oldMask (_state.mask);
-      const Int32 OldSize (_state.size);
-      const Int32 Size = (ValueSize > OldSize) ? ValueSize : OldSize;
-
-      if (ValueSize > OldSize) {
-
-         _state.mask = 0;
-         _state.size = 0;
-         _state.grow_buffer (ValueSize);
-      }
-
-      if (_state.mask) {
-
-         for (Int32 ix = 0; ix < Size; ix++) {
+   if (this == &Value) { clear (); }
+   else if (_resize (Value._size)) {
 
-            _state.mask[ix] =
-               ((OldSize > ix) ? oldMask[ix] : 0) ^
-                  ((ValueSize > ix) ? ValueMask[ix] : 0);
-         }
-      }
+      const Int32 Size (Value._size);
+      const UInt32 *ValueMask (Value._mask);
+      UInt32 *mask (_mask);
 
-      if (_state.mask != oldMask) { delete []oldMask; }
+      for (Int32 ix = 0; ix < Size; ix++) { mask[ix] ^= ValueMask[ix]; }
    }
 
    return *this;
@@ -314,14 +258,13 @@ dmz::Mask::operator^ (const Mask &Value) const {
 dmz::Mask &
 dmz::Mask::operator&= (const Mask &Value) {
 
-   const Int32 Size (_state.size);
-   const Int32 ValueSize (Value._state.size);
-   const UInt32 *ValueMask = Value._state.mask;
+   const Int32 Size (_size);
+   const Int32 MinSize ((Size < Value._size) ? Size : Value._size);
+   const UInt32 *ValueMask (Value._mask);
+   UInt32 *mask (_mask);
 
-   for (Int32 ix = 0; ix < Size; ix++) {
-
-      _state.mask[ix] &= (ValueSize > ix) ? ValueMask[ix] : 0;
-   }
+   for (Int32 ix = 0; ix < MinSize; ix++) { mask[ix] &= ValueMask[ix]; }
+   for (Int32 ix = MinSize; ix < Size; ix++) { mask[ix] = 0; }
 
    return *this;
 }
@@ -353,32 +296,13 @@ dmz::Mask::operator& (const Mask &Value) const {
 dmz::Mask &
 dmz::Mask::operator|= (const Mask &Value) {
 
-   if (Value._state.mask) {
-
-      const Int32 ValueSize (Value._state.size);
-      const UInt32 *ValueMask (Value._state.mask);
-      UInt32 *oldMask (_state.mask);
-      const Int32 OldSize (_state.size);
-      const Int32 Size = (ValueSize > OldSize) ? ValueSize : OldSize;
-
-      if (ValueSize > OldSize) {
-
-         _state.mask = 0;
-         _state.size = 0;
-         _state.grow_buffer (ValueSize);
-      }
-
-      if (_state.mask) {
+   if ((this != &Value) && _resize (Value._size)) {
 
-         for (Int32 ix = 0; ix < Size; ix++) {
+      const Int32 Size (Value._size);
+      const UInt32 *ValueMask (Value._mask);
+      UInt32 *mask (_mask);
 
-            _state.mask[ix] =
-               ((OldSize > ix) ? oldMask[ix] : 0) |
-                  ((ValueSize > ix) ? ValueMask[ix] : 0);
-         }
-      }
-
-      if (_state.mask != oldMask) { delete []oldMask; }
+      for (Int32 ix = 0; ix < Size; ix++) { mask[ix] |= ValueMask[ix]; }
    }
 
    return *this;
@@ -411,47 +335,43 @@ dmz::Mask::operator| (const Mask &Value) const {
 dmz::Mask &
 dmz::Mask::operator<< (const Int32 Shift) {
 
-   if ((Shift > 0) && (_state.size >= 1)) {
-
-      Boolean done (False);
-      Int32 place (_state.size - 1);
-      Int32 found (-1);
+   Int32 found (_size - 1);
 
-      while (!done) {
+   while ((found >= 0) && !_mask[found]) { found--; }
 
-         if (_state.mask[place]) { found = place; done = True; }
-         else { place--; if (place < 0) { done = True; } }
-      }
+   if ((Shift > 0) && (found >= 0)) {
 
-      if (found >= 0) {
+      const Int32 Offset (Shift / 32);
+      const Int32 ElementShift (Shift % 32);
+      const Int32 OverflowShift (32 - ElementShift);
+      const Int32 OverflowSize (
+         (ElementShift && (_mask[found] >> OverflowShift)) ? 1 : 0);
+      const Int32 NewSize (OverflowSize + found + Offset + 1);
+      const Int32 OldSize (_size);
 
-         const Int32 Offset (Shift / 32);
-         const Int32 ElementShift (Shift % 32);
-         const Int32 OverflowShift (32 - ElementShift);
-         const UInt32 OverflowMask (0xffffffff << (OverflowShift));
-         const UInt32 OverflowSize (_state.mask[found] & OverflowMask ? 1 : 0);
-         const Int32 NewSize (OverflowSize + found + Offset + 1);
-         UInt32 *newMask (new UInt32[NewSize]);
+      if (_resize (NewSize)) {
 
-         if (newMask) {
+         UInt32 *mask (_mask);
 
-            memset (newMask, '\0', NewSize * sizeof (UInt32));
+         // Blocks are moved up so they are written from the top down.
+         for (Int32 ix = NewSize - 1; ix >= Offset; ix--) {
 
-            UInt32 prevOverflow (0);
+            const Int32 Source (ix - Offset);
+            UInt32 value ((Source <= found) ? (mask[Source] << ElementShift) : 0);
 
-            for (Int32 ix = 0; ix <= found; ix++) {
+            if (ElementShift && (Source > 0)) {
 
-               const UInt32 Value (_state.mask[ix] << ElementShift);
-               newMask[ix + Offset] = Value | prevOverflow;
-               prevOverflow = (_state.mask[ix] & OverflowMask) >> OverflowShift;
+               value |= mask[Source - 1] >> OverflowShift;
             }
 
-            if (prevOverflow) { newMask[found + Offset + 1] = prevOverflow; }
-
-            _state.size = NewSize;
-            delete []_state.mask; _state.mask = 0;
-            _state.mask = newMask;
+            mask[ix] = value;
          }
+
+         for (Int32 ix = 0; (ix < Offset) && (ix < NewSize); ix++) { mask[ix] = 0; }
+
+         for (Int32 ix = NewSize; ix < OldSize; ix++) { mask[ix] = 0; }
+
+         _size = NewSize;
       }
    }
 
@@ -470,54 +390,41 @@ dmz::Mask::operator<< (const Int32 Shift) {
 dmz::Mask &
 dmz::Mask::operator>> (const Int32 Shift) {
 
-   if ((Shift > 0) && (_state.size >= 1)) {
+   Int32 found (_size - 1);
 
-      Boolean done (False);
-      Int32 place (_state.size - 1);
-      Int32 found (-1);
-
-      while (!done) {
-
-         if (_state.mask[place]) { found = place; done = True; }
-         else { place--; if (place < 0) { done = True; } }
-      }
+   while ((found >= 0) && !_mask[found]) { found--; }
 
-      if (found >= 0) {
+   if ((Shift > 0) && (found >= 0)) {
 
-         const Int32 Offset (Shift / 32);
-         const Int32 ElementShift (Shift % 32);
-         const Int32 OverflowShift (32 - ElementShift);
-         const UInt32 OverflowMask (0xffffffff >> (OverflowShift));
-         const Int32 NewSize (found + 1 + (-Offset));
+      const Int32 Offset (Shift / 32);
+      const Int32 ElementShift (Shift % 32);
+      const Int32 OverflowShift (32 - ElementShift);
+      const Int32 NewSize (found + 1 - Offset);
+      UInt32 *mask (_mask);
 
-         if (NewSize > 0) {
+      if (NewSize > 0) {
 
-            UInt32 *newMask (new UInt32[NewSize]);
+         // Blocks are moved down so they are written from the bottom up.
+         for (Int32 ix = 0; ix < NewSize; ix++) {
 
-            if (newMask) {
+            const Int32 Source (ix + Offset);
+            UInt32 value (mask[Source] >> ElementShift);
 
-               memset (newMask, '\0', NewSize * sizeof (UInt32));
+            if (ElementShift && (Source < found)) {
 
-               UInt32 prevOverflow (0);
+               value |= mask[Source + 1] << OverflowShift;
+            }
 
-               for (Int32 ix = (NewSize - 1); ix >= 0; ix--) {
+            mask[ix] = value;
+         }
 
-                  const UInt32 Value (_state.mask[ix + Offset] >> ElementShift);
-                  newMask[ix] = Value | prevOverflow;
-                  prevOverflow =
-                     (_state.mask[ix + Offset] & OverflowMask) << OverflowShift;
-               }
+         for (Int32 ix = NewSize; ix < _size; ix++) { mask[ix] = 0; }
 
-               _state.size = NewSize;
-               delete []_state.mask; _state.mask = 0;
-               _state.mask = newMask;
-            }
-         }
-         else { memset (_state.mask, '\0', _state.size * sizeof (UInt32)); }
+         _size = NewSize;
       }
+      else { clear (); }
    }
 
-
    return *this;
 }
 
@@ -536,10 +443,9 @@ size of the dmz::Mask, the call is ignored. The internal storage is allocated in
 dmz::Boolean
 dmz::Mask::grow (const Int32 Size) {
 
-   Boolean result (False);
+   Boolean result (True);
 
-   if (Size > _state.size) { _state.resize (Size); result = (Size <= _state.size); }
-   else { result = True; }
+   if (Size > _size) { result = _resize (Size); }
 
    return result;
 }
@@ -552,7 +458,7 @@ dmz::Mask::grow (const Int32 Size) {
 
 */
 dmz::Int32
-dmz::Mask::get_size () const { return _state.size; }
+dmz::Mask::get_size () const { return _size; }
 
 
 /*!
@@ -571,11 +477,9 @@ dmz::Mask::set_sub_mask (const Int32 Offset, const UInt32 Value) {
 
    Boolean result (False);
 
-   _state.resize (Offset + 1);
-
-   if (_state.mask && (Offset < _state.size)) {
+   if ((Offset >= 0) && _resize (Offset + 1)) {
 
-      _state.mask[Offset] = Value;
+      _mask[Offset] = Value;
       result = True;
    }
 
@@ -594,18 +498,28 @@ dmz::Mask::set_sub_mask (const Int32 Offset, const UInt32 Value) {
 dmz::UInt32
 dmz::Mask::get_sub_mask (const Int32 Offset) const {
 
-   return (_state.mask && (Offset < _state.size)) ? _state.mask[Offset] : 0;
+   return ((Offset >= 0) && (Offset < _size)) ? _mask[Offset] : 0;
 }
 
 
 /*!
 
 \brief Deletes mask storage.
+\details The mask returns to using its inline storage.
 \return Returns a reference to self.
 
 */
 dmz::Mask &
-dmz::Mask::empty () { _state.empty (); return *this; }
+dmz::Mask::empty () {
+
+   if (_mask != _local) { delete []_mask; _mask = _local; }
+
+   _size = 0;
+   _capacity = LocalSize;
+   memset (_local, '\0', sizeof (_local));
+
+   return *this;
+}
 
 
 /*!
@@ -617,7 +531,11 @@ storage.
 
 */
 dmz::Mask &
-dmz::Mask::clear () { _state.clear (); return *this; }
+dmz::Mask::clear () {
+
+   memset (_mask, '\0', _size * sizeof (UInt32));
+   return *this;
+}
 
 
 /*!
@@ -629,21 +547,11 @@ dmz::Mask::clear () { _state.clear (); return *this; }
 dmz::Boolean
 dmz::Mask::is_set () const {
 
-   Boolean result (False);
+   UInt32 bits (0);
 
-   if (_state.mask) {
+   for (Int32 ix = 0; ix < _size; ix++) { bits |= _mask[ix]; }
 
-      Boolean done (False);
-      Int32 count (0);
-
-      while (!done) {
-
-         if (_state.mask[count]) { result = True; done = True; }
-         else { count++; if (count >= _state.size) { done = True; } }
-      }
-   }
-
-   return result;
+   return bits != 0;
 }
 
 
@@ -659,12 +567,10 @@ to accommodate the new bit.
 dmz::Mask &
 dmz::Mask::set_bit (const Int32 Bit) {
 
-   const div_t Result = div (int (Bit), 32);
-   Int32 Place (Result.quot);
-   Int32 Shift (Result.rem);
+   if ((Bit >= 0) && _resize ((Bit / 32) + 1)) {
 
-   _state.resize (Place + 1);
-   if (_state.mask && (Place < _state.size)) { _state.mask[Place] |= 0x1 << Shift; }
+      _mask[Bit / 32] |= UInt32 (0x01) << (Bit % 32);
+   }
 
    return *this;
 }
@@ -680,11 +586,10 @@ dmz::Mask::set_bit (const Int32 Bit) {
 dmz::Mask &
 dmz::Mask::unset_bit (const Int32 Bit) {
 
-   const div_t Result = div (int (Bit), 32);
-   Int32 Place (Result.quot);
-   Int32 Shift (Result.rem);
+   if ((Bit >= 0) && ((Bit / 32) < _size)) {
 
-   if (_state.mask && (Place < _state.size)) { _state.mask[Place] &= ~(0x1 << Shift); }
+      _mask[Bit / 32] &= ~(UInt32 (0x01) << (Bit % 32));
+   }
 
    return *this;
 }
@@ -700,13 +605,10 @@ dmz::Boolean
 dmz::Mask::get_bit (const Int32 Bit) const {
 
    Boolean result (False);
-   const div_t Result = div (int (Bit), 32);
-   Int32 Place (Result.quot);
-   Int32 Shift (Result.rem);
 
-   if (_state.mask && (Place < _state.size)) {
+   if ((Bit >= 0) && ((Bit / 32) < _size)) {
 
-      if (_state.mask[Place] & (0x01 << Shift)) { result = True; }
+      if (_mask[Bit / 32] & (UInt32 (0x01) << (Bit % 32))) { result = True; }
    }
 
    return result;
@@ -714,7 +616,6 @@ dmz::Mask::get_bit (const Int32 Bit) const {
 
 /*!
 
-\fn dmz::Mask::contains (const Mask &Value) const
 \brief Determines if the passed in mask is contained with in the mask.
 \details This function test if the passed in mask \a Value is contained with in the mask
 storage.
@@ -722,6 +623,20 @@ storage.
 \return Returns dmz::True if the passed in mask is contained in the mask storage.
 
 */
+dmz::Boolean
+dmz::Mask::contains (const Mask &Value) const {
+
+   const Int32 ValueSize (Value._size);
+   const Int32 MinSize ((_size < ValueSize) ? _size : ValueSize);
+   const UInt32 *ValueMask (Value._mask);
+   UInt32 missing (0);
+
+   for (Int32 ix = 0; ix < MinSize; ix++) { missing |= ValueMask[ix] & ~_mask[ix]; }
+   for (Int32 ix = MinSize; ix < ValueSize; ix++) { missing |= ValueMask[ix]; }
+
+   return missing == 0;
+}
+
 
 /*!
 
@@ -733,14 +648,12 @@ storage.
 dmz::Mask &
 dmz::Mask::unset (const Mask &Value) {
 
-   const Int32 Size (_state.size);
-   const Int32 ValueSize (Value._state.size);
-   const UInt32 *Mask = Value._state.mask;
-
-   for (Int32 ix = 0; ix < Size; ix++) {
+   const Int32 MinSize ((_size < Value._size) ? _size : Value._size);
+   const UInt32 *ValueMask (Value._mask);
+   UInt32 *mask (_mask);
 
-      _state.mask[ix] &= (ValueSize > ix) ? ~(Mask[ix]) : 0xFFFFFFFF;
-   }
+   if (this == &Value) { clear (); }
+   else { for (Int32 ix = 0; ix < MinSize; ix++) { mask[ix] &= ~ValueMask[ix]; } }
 
    return *this;
 }
@@ -43,12 +43,20 @@ namespace dmz {
          Mask &set_bit (const Int32 Bit);
          Mask &unset_bit (const Int32 Bit);
          Boolean get_bit (const Int32 Bit) const;
-         Boolean contains (const Mask &Value) const { return (*this & Value) == Value; }
+         Boolean contains (const Mask &Value) const;
          Mask &unset (const Mask &Value);
 
       protected:
-         struct State;
-         State &_state; //!< Internal state.
+         //! \cond
+         enum { LocalSize = 8 };
+
+         Boolean _resize (const Int32 Size);
+
+         Int32 _size;
+         Int32 _capacity;
+         UInt32 *_mask;
+         UInt32 _local[LocalSize];
+         //! \endcond
    };
 };
 
@@ -0,0 +1,486 @@
+#include <dmzNetExtPacketCodec.h>
+#include "dmzNetExtPacketCodecObjectNativeTest.h"
+#include <dmzObjectConsts.h>
+#include <dmzObjectModule.h>
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzSystem.h>
+#include <dmzSystemUnmarshal.h>
+#include <dmzTypesMatrix.h>
+#include <dmzTypesVector.h>
+
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+   // The system and object ids come before the object type size in each packet.
+   static const dmz::Int32 LocalTypeSizePlace (32);
+
+   // Error bounds of the quantized encodings used by the QuantCodec.
+   static const dmz::Float64 LocalFixedPrecision (0.01);
+   static const dmz::Float64 LocalFloat32Error (1.2e-7);
+   static const dmz::Float64 LocalQuatError (0.003);
+
+   static dmz::Float64
+   local_max_error (const dmz::Vector &Value1, const dmz::Vector &Value2) {
+
+      const dmz::Vector Diff (Value1 - Value2);
+
+      dmz::Float64 result (fabs (Diff.get_x ()));
+      if (fabs (Diff.get_y ()) > result) { result = fabs (Diff.get_y ()); }
+      if (fabs (Diff.get_z ()) > result) { result = fabs (Diff.get_z ()); }
+
+      return result;
+   }
+
+
+   static dmz::Float64
+   local_max_error (const dmz::Matrix &Value1, const dmz::Matrix &Value2) {
+
+      dmz::Float64 m1[9], m2[9];
+      Value1.to_array (m1);
+      Value2.to_array (m2);
+
+      dmz::Float64 result (0.0);
+
+      for (dmz::Int32 ix = 0; ix < 9; ix++) {
+
+         const dmz::Float64 Error (fabs (m1[ix] - m2[ix]));
+         if (Error > result) { result = Error; }
+      }
+
+      return result;
+   }
+
+
+   static dmz::Float64
+   local_max_abs (const dmz::Vector &Value) {
+
+      return local_max_error (Value, dmz::Vector ());
+   }
+};
+
+
+dmz::NetExtPacketCodecObjectNativeTest::NetExtPacketCodecObjectNativeTest (
+      const PluginInfo &Info,
+      Config &local,
+      Config &global) :
+      Plugin (Info),
+      TimeSlice (Info),
+      test (Info.get_name (), Info.get_context ()),
+      _time (Info),
+      _objMod (0),
+      _deltaCodec (0),
+      _quantCodec (0),
+      _defaultHandle (0),
+      _lnvHandle (0),
+      _scalarHandle (0),
+      _altOrientationHandle (0),
+      _altOrientationLNVHandle (0),
+      _frame (0),
+      _object (0),
+      _data (ByteOrderBigEndian) {
+
+   Definitions defs (Info.get_context ());
+
+   _defaultHandle = defs.create_named_handle (ObjectAttributeDefaultName);
+   _lnvHandle = defs.create_named_handle (ObjectAttributeLastNetworkValueName);
+   _scalarHandle = defs.create_named_handle ("Test_Scalar");
+   _altOrientationHandle = defs.create_named_handle ("Test_Matrix");
+
+   _altOrientationLNVHandle = defs.create_named_handle (
+      create_last_network_value_name ("Test_Matrix"));
+
+   _type = config_to_object_type ("type.name", local, Info.get_context ());
+
+   _deltaCodecName = config_to_string ("delta-codec.name", local);
+   _quantCodecName = config_to_string ("quant-codec.name", local);
+
+   create_uuid (_remoteSysID);
+   create_uuid (_remoteID);
+}
+
+
+dmz::NetExtPacketCodecObjectNativeTest::~NetExtPacketCodecObjectNativeTest () {;}
+
+
+// Plugin Interface
+void
+dmz::NetExtPacketCodecObjectNativeTest::discover_plugin (
+      const PluginDiscoverEnum Mode,
+      const Plugin *PluginPtr) {
+
+   if (Mode == PluginDiscoverAdd) {
+
+      if (!_objMod) { _objMod = ObjectModule::cast (PluginPtr); }
+
+      NetExtPacketCodecObject *codec (NetExtPacketCodecObject::cast (PluginPtr));
+
+      if (codec && (PluginPtr->get_plugin_name () == _deltaCodecName)) {
+
+         _deltaCodec = codec;
+      }
+      else if (codec && (PluginPtr->get_plugin_name () == _quantCodecName)) {
+
+         _quantCodec = codec;
+      }
+   }
+   else if (Mode == PluginDiscoverRemove) {
+
+      if (_objMod && (_objMod == ObjectModule::cast (PluginPtr))) { _objMod = 0; }
+
+      NetExtPacketCodecObject *codec (NetExtPacketCodecObject::cast (PluginPtr));
+
+      if (codec && (codec == _deltaCodec)) { _deltaCodec = 0; }
+      if (codec && (codec == _quantCodec)) { _quantCodec = 0; }
+   }
+}
+
+
+// TimeSlice Interface
+void
+dmz::NetExtPacketCodecObjectNativeTest::update_time_slice (const Float64 TimeDelta) {
+
+   _frame++;
+
+   if (_frame == 1) {
+
+      test.validate (_objMod != 0, "Object module discovered.");
+      test.validate (_deltaCodec != 0, "Delta codec discovered.");
+      test.validate (_quantCodec != 0, "Quantized codec discovered.");
+      test.validate (_type.get_handle () != 0, "Test object type found.");
+
+      if (_objMod && _deltaCodec && _quantCodec && _type.get_handle ()) {
+
+         _test_keyframe_then_delta ();
+      }
+      else { test.exit ("Test aborted"); }
+   }
+   else if (_frame == 2) {
+
+      _test_keyframe_interval ();
+      _test_quantized ();
+      test.exit ("Test completed");
+   }
+}
+
+
+// Encodes the object, replaces the system and object ids so that the packet is decoded
+// as an update from another host, and decodes it.
+dmz::Boolean
+dmz::NetExtPacketCodecObjectNativeTest::_round_trip (
+      NetExtPacketCodecObject &codec,
+      const Handle ObjectHandle,
+      const NetObjectEncodeEnum Mode,
+      const UUID &RemoteID) {
+
+   Boolean result (False);
+
+   _data.reset ();
+
+   if (codec.encode_object (ObjectHandle, Mode, _data) &&
+         (_data.get_length () > LocalTypeSizePlace)) {
+
+      Marshal ids (_data.get_byte_order ());
+      ids.set_next_uuid (_remoteSysID);
+      ids.set_next_uuid (RemoteID);
+      memcpy (_data.get_buffer (), ids.get_buffer (), LocalTypeSizePlace);
+
+      Unmarshal in (_data.get_byte_order ());
+      in.set_buffer (_data.get_length (), _data.get_buffer ());
+
+      Boolean isLoopback (True);
+      result = codec.decode (in, isLoopback) && !isLoopback;
+   }
+
+   return result;
+}
+
+
+// Returns the signed object type size of the last encoded packet. Negative sizes flag
+// a delta update.
+dmz::Int32
+dmz::NetExtPacketCodecObjectNativeTest::_type_size () {
+
+   Int32 result (0);
+
+   if (_data.get_length () > LocalTypeSizePlace) {
+
+      result = Int32 (Int8 (_data.get_buffer ()[LocalTypeSizePlace]));
+   }
+
+   return result;
+}
+
+
+void
+dmz::NetExtPacketCodecObjectNativeTest::_test_keyframe_then_delta () {
+
+   const Vector Position (10.0, 20.0, -30.0);
+   const Vector Velocity (1.0, 0.0, -2.0);
+   const Matrix Orientation (Vector (0.0, 1.0, 0.0), 0.5);
+   const Float64 Scalar (42.0);
+
+   _object = _objMod->create_object (_type, ObjectLocal);
+   _objMod->store_position (_object, _defaultHandle, Position);
+   _objMod->store_velocity (_object, _defaultHandle, Velocity);
+   _objMod->store_orientation (_object, _defaultHandle, Orientation);
+   _objMod->store_scalar (_object, _scalarHandle, Scalar);
+   _objMod->activate_object (_object);
+
+   test.validate (
+      _round_trip (*_deltaCodec, _object, NetObjectActivate, _remoteID),
+      "Activation packet decoded.");
+
+   const Int32 FullSize (_data.get_length ());
+   const Handle Remote (_objMod->lookup_handle_from_uuid (_remoteID));
+
+   test.validate (_type_size () > 0, "Activation packet is a keyframe.");
+   test.validate (Remote != 0, "Remote object created from keyframe.");
+
+   Vector position, velocity;
+   Matrix orientation;
+   Float64 scalar (0.0);
+
+   _objMod->lookup_position (Remote, _defaultHandle, position);
+   _objMod->lookup_velocity (Remote, _defaultHandle, velocity);
+   _objMod->lookup_orientation (Remote, _defaultHandle, orientation);
+   _objMod->lookup_scalar (Remote, _scalarHandle, scalar);
+
+   test.validate (
+      (position == Position) && (velocity == Velocity) &&
+         (orientation == Orientation) && (scalar == Scalar),
+      "Keyframe values decoded.");
+
+   // The receiver changes its copy of the velocity. A delta that does not carry the
+   // velocity must leave it alone.
+   const Vector RemoteVelocity (5.0, 5.0, 5.0);
+   const Vector NewPosition (11.0, 20.0, -30.0);
+
+   _objMod->store_velocity (Remote, _defaultHandle, RemoteVelocity);
+   _objMod->store_position (_object, _defaultHandle, NewPosition);
+
+   test.validate (
+      _round_trip (*_deltaCodec, _object, NetObjectUpdate, _remoteID),
+      "Delta packet decoded.");
+
+   const Int32 DeltaSize (_data.get_length ());
+
+   test.validate (_type_size () < 0, "Update inside the keyframe interval is a delta.");
+   test.validate (DeltaSize < FullSize, "Delta packet is smaller than the keyframe.");
+
+   _objMod->lookup_position (Remote, _defaultHandle, position);
+   _objMod->lookup_velocity (Remote, _defaultHandle, velocity);
+   _objMod->lookup_orientation (Remote, _defaultHandle, orientation);
+   _objMod->lookup_scalar (Remote, _scalarHandle, scalar);
+
+   test.validate (position == NewPosition, "Delta position decoded.");
+
+   test.validate (
+      (velocity == RemoteVelocity) && (orientation == Orientation) && (scalar == Scalar),
+      "Unchanged values are not carried by the delta.");
+
+   test.validate (
+      _round_trip (*_deltaCodec, _object, NetObjectUpdate, _remoteID) &&
+         (_type_size () < 0) && (_data.get_length () < DeltaSize),
+      "Delta without changes carries no values.");
+
+   UUID unknownID;
+   create_uuid (unknownID);
+
+   test.validate (
+      !_round_trip (*_deltaCodec, _object, NetObjectUpdate, unknownID) &&
+         !_objMod->lookup_handle_from_uuid (unknownID),
+      "Delta for an unknown object is ignored.");
+
+   // Moves past the keyframe interval before the next frame.
+   _time.set_frame_time (_time.get_frame_time () + 10.0);
+}
+
+
+void
+dmz::NetExtPacketCodecObjectNativeTest::_test_keyframe_interval () {
+
+   const Vector Position (12.0, 20.0, -30.0);
+   const Handle Remote (_objMod->lookup_handle_from_uuid (_remoteID));
+
+   _objMod->store_position (_object, _defaultHandle, Position);
+   _objMod->store_velocity (Remote, _defaultHandle, Vector (5.0, 5.0, 5.0));
+
+   test.validate (
+      _round_trip (*_deltaCodec, _object, NetObjectUpdate, _remoteID) &&
+         (_type_size () > 0),
+      "Update after the keyframe interval is a keyframe.");
+
+   Vector position, velocity;
+   _objMod->lookup_position (Remote, _defaultHandle, position);
+   _objMod->lookup_velocity (Remote, _defaultHandle, velocity);
+
+   test.validate (
+      (position == Position) && (velocity == Vector (1.0, 0.0, -2.0)),
+      "Keyframe restores every value.");
+
+   test.validate (
+      _round_trip (*_deltaCodec, _object, NetObjectUpdate, _remoteID) &&
+         (_type_size () < 0),
+      "Update after a keyframe is a delta.");
+
+   _round_trip (*_deltaCodec, _object, NetObjectDeactivate, _remoteID);
+
+   test.validate (
+      (_type_size () == 0) && !_objMod->lookup_handle_from_uuid (_remoteID),
+      "Deactivation destroys the remote object.");
+
+   _objMod->destroy_object (_object);
+   _object = 0;
+}
+
+
+// Every quantized value must decode within the error bound of its encoding and the
+// last network value stored by the sender must match what the receiver decodes.
+void
+dmz::NetExtPacketCodecObjectNativeTest::_test_quantized () {
+
+   const Float64 Pi (3.14159265358979323846);
+
+   const Vector Positions[] = {
+      Vector (1000.0, 0.0, -1000.0),
+      Vector (1234.567891, -0.004999, -987.654321),
+      Vector (-5000.123456, 3.33333333, 0.0049),
+      Vector (1000.005, 1.0e6 / 3.0, -1000.015),
+   };
+
+   const Vector Velocities[] = {
+      Vector (1.0 / 3.0, -123456.789, 1.0e-5),
+      Vector (0.1, 0.2, 0.3),
+      Vector (-7.0e3, 5.5e-3, 299792.458),
+      Vector (0.0, 0.0, 0.0),
+   };
+
+   // Rotations by more than pi have a negative w component and rotations close to two
+   // pi have a w component close to negative one.
+   const Matrix Orientations[] = {
+      Matrix (),
+      Matrix (Vector (0.0, 1.0, 0.0), 1.0e-4),
+      Matrix (Vector (1.0, 0.0, 0.0), -1.0e-3),
+      Matrix (Vector (1.0, 2.0, 3.0).normalize (), 1.0),
+      Matrix (Vector (0.0, 0.0, 1.0), Pi - 1.0e-3),
+      Matrix (Vector (1.0, -1.0, 0.5).normalize (), Pi + 0.5),
+      Matrix (Vector (-2.0, 1.0, 1.0).normalize (), 5.5),
+      Matrix (Vector (0.0, 1.0, 0.0), (2.0 * Pi) - 1.0e-4),
+   };
+
+   const Int32 Count (4);
+   const Int32 OrientationCount (8);
+
+   const Handle Object (_objMod->create_object (_type, ObjectLocal));
+   _objMod->activate_object (Object);
+
+   UUID remoteID;
+   create_uuid (remoteID);
+
+   Boolean decoded (_round_trip (*_quantCodec, Object, NetObjectActivate, remoteID));
+   const Handle Remote (_objMod->lookup_handle_from_uuid (remoteID));
+
+   Float64 positionError (0.0), velocityError (0.0);
+   Float64 quatError (0.0), matrix32Error (0.0);
+   Boolean lnvMatches (True);
+
+   for (Int32 ix = 0; (ix < OrientationCount) && Remote; ix++) {
+
+      const Vector &Position (Positions[ix % Count]);
+      const Vector &Velocity (Velocities[ix % Count]);
+      const Matrix &Orientation (Orientations[ix]);
+
+      _objMod->store_position (Object, _defaultHandle, Position);
+      _objMod->store_velocity (Object, _defaultHandle, Velocity);
+      _objMod->store_orientation (Object, _defaultHandle, Orientation);
+      _objMod->store_orientation (Object, _altOrientationHandle, Orientation);
+
+      if (!_round_trip (*_quantCodec, Object, NetObjectUpdate, remoteID)) {
+
+         decoded = False;
+      }
+
+      Vector position, velocity, lnvPosition, lnvVelocity;
+      Matrix orientation, altOrientation, lnvOrientation, lnvAltOrientation;
+
+      _objMod->lookup_position (Remote, _defaultHandle, position);
+      _objMod->lookup_velocity (Remote, _defaultHandle, velocity);
+      _objMod->lookup_orientation (Remote, _defaultHandle, orientation);
+      _objMod->lookup_orientation (Remote, _altOrientationHandle, altOrientation);
+
+      _objMod->lookup_position (Object, _lnvHandle, lnvPosition);
+      _objMod->lookup_velocity (Object, _lnvHandle, lnvVelocity);
+      _objMod->lookup_orientation (Object, _lnvHandle, lnvOrientation);
+      _objMod->lookup_orientation (Object, _altOrientationLNVHandle, lnvAltOrientation);
+
+      Float64 error (local_max_error (position, Position));
+      if (error > positionError) { positionError = error; }
+
+      // Float32 error is relative to the size of the largest component.
+      error = local_max_error (velocity, Velocity) /
+         (local_max_abs (Velocity) > 1.0 ? local_max_abs (Velocity) : 1.0);
+      if (error > velocityError) { velocityError = error; }
+
+      error = local_max_error (orientation, Orientation);
+      if (error > quatError) { quatError = error; }
+
+      error = local_max_error (altOrientation, Orientation);
+      if (error > matrix32Error) { matrix32Error = error; }
+
+      if ((lnvPosition != position) || (lnvVelocity != velocity) ||
+            (lnvOrientation != orientation) || (lnvAltOrientation != altOrientation)) {
+
+         lnvMatches = False;
+      }
+   }
+
+   test.validate (decoded && (Remote != 0), "Quantized packets decoded.");
+
+   // Fixed position, quaternion, float32 matrix, and float32 velocity.
+   const Int32 ValueSize (12 + 4 + 36 + 12);
+
+   test.validate (
+      _data.get_length () == (LocalTypeSizePlace + 1 + _type_size () + ValueSize),
+      "Quantized packet has the expected size.");
+
+   test.validate (
+      positionError <= ((LocalFixedPrecision * 0.5) + 1.0e-9),
+      "Fixed point position error is within half the precision.");
+
+   test.validate (
+      velocityError <= LocalFloat32Error,
+      "Float32 velocity error is within float32 precision.");
+
+   test.validate (
+      matrix32Error <= LocalFloat32Error,
+      "Float32 orientation error is within float32 precision.");
+
+   test.validate (
+      quatError <= LocalQuatError,
+      "Quaternion orientation error is within bounds.");
+
+   test.validate (lnvMatches, "Last network values match the decoded values.");
+
+   _round_trip (*_quantCodec, Object, NetObjectDeactivate, remoteID);
+   _objMod->destroy_object (Object);
+}
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetExtPacketCodecObjectNativeTest (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetExtPacketCodecObjectNativeTest (Info, local, global);
+}
+
+};
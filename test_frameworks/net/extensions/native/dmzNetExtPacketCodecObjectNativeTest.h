@@ -0,0 +1,73 @@
+#ifndef DMZ_NET_EXT_PACKET_CODEC_OBJECT_NATIVE_TEST_DOT_H
+#define DMZ_NET_EXT_PACKET_CODEC_OBJECT_NATIVE_TEST_DOT_H
+
+#include <dmzNetExtPacketCodec.h>
+#include <dmzRuntimeObjectType.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeTime.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzSystemMarshal.h>
+#include <dmzTestPluginUtil.h>
+#include <dmzTypesUUID.h>
+
+namespace dmz {
+
+   class Config;
+   class ObjectModule;
+
+   class NetExtPacketCodecObjectNativeTest :
+      public Plugin,
+      public TimeSlice {
+
+      public:
+         NetExtPacketCodecObjectNativeTest (
+            const PluginInfo &Info,
+            Config &local,
+            Config &global);
+         ~NetExtPacketCodecObjectNativeTest ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level) {;}
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr);
+
+         void update_time_slice (const Float64 TimeDelta);
+
+      protected:
+         Boolean _round_trip (
+            NetExtPacketCodecObject &codec,
+            const Handle ObjectHandle,
+            const NetObjectEncodeEnum Mode,
+            const UUID &RemoteID);
+
+         Int32 _type_size ();
+         void _test_keyframe_then_delta ();
+         void _test_keyframe_interval ();
+         void _test_quantized ();
+
+         TestPluginUtil test;
+         Time _time;
+         ObjectType _type;
+         ObjectModule *_objMod;
+         NetExtPacketCodecObject *_deltaCodec;
+         NetExtPacketCodecObject *_quantCodec;
+         String _deltaCodecName;
+         String _quantCodecName;
+         Handle _defaultHandle;
+         Handle _lnvHandle;
+         Handle _scalarHandle;
+         Handle _altOrientationHandle;
+         Handle _altOrientationLNVHandle;
+         Int32 _frame;
+         Handle _object;
+         UUID _remoteSysID;
+         UUID _remoteID;
+         Marshal _data;
+   };
+};
+
+#endif // DMZ_NET_EXT_PACKET_CODEC_OBJECT_NATIVE_TEST_DOT_H
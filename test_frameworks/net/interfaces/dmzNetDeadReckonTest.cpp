@@ -0,0 +1,137 @@
+#include <dmzNetDeadReckon.h>
+#include <dmzTest.h>
+#include <dmzTypesBase.h>
+#include <dmzTypesConsts.h>
+#include <dmzTypesMatrix.h>
+#include <dmzTypesVector.h>
+
+using namespace dmz;
+
+int
+main (int argc, char *argv[]) {
+
+   Test test ("dmzNetDeadReckonTest", argc, argv);
+
+   const Vector Up (0.0, 1.0, 0.0);
+   const Vector Right (1.0, 0.0, 0.0);
+   const Vector Left (-1.0, 0.0, 0.0);
+   const Vector Forward (0.0, 0.0, -1.0);
+
+   test.validate (
+      "Model names are converted.",
+      (string_to_net_dead_reckon_model ("static") == NetDeadReckonStatic) &&
+      (string_to_net_dead_reckon_model ("Velocity") == NetDeadReckonVelocity) &&
+      (string_to_net_dead_reckon_model ("acceleration") == NetDeadReckonAcceleration) &&
+      (string_to_net_dead_reckon_model ("ROTATION") == NetDeadReckonRotation) &&
+      (string_to_net_dead_reckon_model ("rotation-acceleration") ==
+         NetDeadReckonRotationAcceleration));
+
+   test.validate (
+      "DIS model names are converted.",
+      (string_to_net_dead_reckon_model ("fpw") == NetDeadReckonVelocity) &&
+      (string_to_net_dead_reckon_model ("fvw") == NetDeadReckonAcceleration) &&
+      (string_to_net_dead_reckon_model ("rpw") == NetDeadReckonRotation) &&
+      (string_to_net_dead_reckon_model ("RVW") == NetDeadReckonRotationAcceleration));
+
+   test.validate (
+      "Unknown model names return the default model.",
+      (string_to_net_dead_reckon_model ("") == NetDeadReckonVelocity) &&
+      (string_to_net_dead_reckon_model ("bogus", NetDeadReckonStatic) ==
+         NetDeadReckonStatic));
+
+   test.validate (
+      "Acceleration is only used by the acceleration models.",
+      !net_dead_reckon_uses_acceleration (NetDeadReckonStatic) &&
+      !net_dead_reckon_uses_acceleration (NetDeadReckonVelocity) &&
+      net_dead_reckon_uses_acceleration (NetDeadReckonAcceleration) &&
+      !net_dead_reckon_uses_acceleration (NetDeadReckonRotation) &&
+      net_dead_reckon_uses_acceleration (NetDeadReckonRotationAcceleration));
+
+   test.validate (
+      "Rotation is only used by the rotation models.",
+      !net_dead_reckon_uses_rotation (NetDeadReckonStatic) &&
+      !net_dead_reckon_uses_rotation (NetDeadReckonVelocity) &&
+      !net_dead_reckon_uses_rotation (NetDeadReckonAcceleration) &&
+      net_dead_reckon_uses_rotation (NetDeadReckonRotation) &&
+      net_dead_reckon_uses_rotation (NetDeadReckonRotationAcceleration));
+
+   const Vector Pos (10.0, -5.0, 2.0);
+   const Vector Vel (1.0, 2.0, -3.0);
+   const Vector Accel (0.5, 0.0, 4.0);
+   const Float64 Time (2.0);
+
+   test.validate (
+      "Static model does not move the position.",
+      (net_dead_reckon_position (NetDeadReckonStatic, Pos, Vel, Accel, Time) - Pos).
+         is_zero ());
+
+   const Vector VelPos (12.0, -1.0, -4.0);
+
+   test.validate (
+      "Velocity model ignores acceleration.",
+      (net_dead_reckon_position (NetDeadReckonVelocity, Pos, Vel, Accel, Time) -
+         VelPos).is_zero () &&
+      (net_dead_reckon_position (NetDeadReckonRotation, Pos, Vel, Accel, Time) -
+         VelPos).is_zero ());
+
+   const Vector AccelPos (13.0, -1.0, 4.0);
+
+   test.validate (
+      "Acceleration models add half the acceleration times the time squared.",
+      (net_dead_reckon_position (NetDeadReckonAcceleration, Pos, Vel, Accel, Time) -
+         AccelPos).is_zero () &&
+      (net_dead_reckon_position (
+         NetDeadReckonRotationAcceleration,
+         Pos,
+         Vel,
+         Accel,
+         Time) - AccelPos).is_zero ());
+
+   test.validate (
+      "Zero time returns the last known position.",
+      (net_dead_reckon_position (NetDeadReckonAcceleration, Pos, Vel, Accel, 0.0) -
+         Pos).is_zero ());
+
+   const Matrix Ori (Right, HalfPi64);
+   const Vector Spin (Up * 2.0);
+
+   test.validate (
+      "Non rotation models do not change the orientation.",
+      (net_dead_reckon_orientation (NetDeadReckonVelocity, Ori, Spin, Time) == Ori) &&
+      (net_dead_reckon_orientation (NetDeadReckonAcceleration, Ori, Spin, Time) ==
+         Ori));
+
+   test.validate (
+      "Zero angular velocity does not change the orientation.",
+      net_dead_reckon_orientation (NetDeadReckonRotation, Ori, Vector (), Time) == Ori);
+
+   Vector v (Forward);
+   net_dead_reckon_orientation (
+      NetDeadReckonRotation,
+      Matrix (),
+      Spin,
+      HalfPi64 / 2.0).transform_vector (v);
+
+   test.validate (
+      "Angular velocity magnitude is the rate of rotation.",
+      (v - Left).is_zero ());
+
+   // The orientation points forward up and its up backward. A world space spin about up
+   // leaves the forward vector alone and turns the up vector to the right.
+   const Matrix Spun (net_dead_reckon_orientation (
+      NetDeadReckonRotationAcceleration,
+      Ori,
+      Spin,
+      HalfPi64 / 2.0));
+
+   Vector forward (Forward);
+   Vector up (Up);
+   Spun.transform_vector (forward);
+   Spun.transform_vector (up);
+
+   test.validate (
+      "Angular velocity is applied in world space.",
+      (forward - Up).is_zero () && (up - Right).is_zero ());
+
+   return test.result ();
+}
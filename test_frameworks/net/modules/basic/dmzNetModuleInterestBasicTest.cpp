@@ -0,0 +1,237 @@
+#include "dmzNetModuleInterestBasicTest.h"
+#include <dmzNetModuleInterest.h>
+#include <dmzObjectConsts.h>
+#include <dmzObjectModule.h>
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzSystemMarshal.h>
+#include <dmzTypesVector.h>
+
+namespace {
+
+   // Frame header written by the packet plugin when framing version 1 is used.
+   static const dmz::UInt32 LocalFrameMagic (0x444D5A46);
+   static const dmz::UInt8 LocalFrameVersion (1);
+   static const dmz::UInt8 LocalFrameChannel (0x02);
+
+   static const dmz::UInt32 LocalChannelFlag (0x80000000);
+};
+
+
+dmz::NetModuleInterestBasicTest::NetModuleInterestBasicTest (
+      const PluginInfo &Info,
+      Config &local,
+      Config &global) :
+      Plugin (Info),
+      TimeSlice (Info),
+      NetModulePacketIO (Info),
+      NetModulePacketCodec (Info),
+      test (Info.get_name (), Info.get_context ()),
+      _objMod (0),
+      _interestMod (0),
+      _packetObs (0),
+      _defaultHandle (0),
+      _object (0),
+      _decodeCount (0) {
+
+   Definitions defs (Info.get_context ());
+
+   _defaultHandle = defs.create_named_handle (ObjectAttributeDefaultName);
+   _type = config_to_object_type ("type.name", local, Info.get_context ());
+}
+
+
+dmz::NetModuleInterestBasicTest::~NetModuleInterestBasicTest () {;}
+
+
+// Plugin Interface
+void
+dmz::NetModuleInterestBasicTest::discover_plugin (
+      const PluginDiscoverEnum Mode,
+      const Plugin *PluginPtr) {
+
+   if (Mode == PluginDiscoverAdd) {
+
+      if (!_objMod) { _objMod = ObjectModule::cast (PluginPtr); }
+      if (!_interestMod) { _interestMod = NetModuleInterest::cast (PluginPtr); }
+   }
+   else if (Mode == PluginDiscoverRemove) {
+
+      if (_objMod && (_objMod == ObjectModule::cast (PluginPtr))) { _objMod = 0; }
+
+      if (_interestMod && (_interestMod == NetModuleInterest::cast (PluginPtr))) {
+
+         _interestMod = 0;
+      }
+   }
+}
+
+
+// TimeSlice Interface
+void
+dmz::NetModuleInterestBasicTest::update_time_slice (const Float64 TimeDelta) {
+
+   test.validate (_objMod != 0, "Object module discovered.");
+   test.validate (_interestMod != 0, "Interest module discovered.");
+   test.validate (_packetObs != 0, "Packet plugin registered as a packet observer.");
+   test.validate (_type.get_handle () != 0, "Test object type found.");
+
+   if (_objMod && _interestMod && _packetObs && _type.get_handle ()) {
+
+      _test_unpositioned ();
+      _test_positioned ();
+      _test_channel_mapping ();
+
+      _objMod->destroy_object (_object);
+      _object = 0;
+
+      test.exit ("Test completed");
+   }
+   else { test.exit ("Test aborted"); }
+}
+
+
+// NetModulePacketIO Interface
+dmz::Boolean
+dmz::NetModuleInterestBasicTest::register_packet_observer (NetPacketObserver &obs) {
+
+   _packetObs = &obs;
+   return True;
+}
+
+
+dmz::Boolean
+dmz::NetModuleInterestBasicTest::release_packet_observer (NetPacketObserver &obs) {
+
+   Boolean result (False);
+
+   if (_packetObs == &obs) { _packetObs = 0; result = True; }
+
+   return result;
+}
+
+
+// NetModulePacketCodec Interface
+dmz::Boolean
+dmz::NetModuleInterestBasicTest::decode (Unmarshal &data, Boolean &isLoopback) {
+
+   _decodeCount++;
+   isLoopback = False;
+   return True;
+}
+
+
+// Sends a framed packet tagged with the channel to the packet plugin and returns
+// dmz::True if the packet was passed on to the codec.
+dmz::Boolean
+dmz::NetModuleInterestBasicTest::_deliver (const UInt32 Channel) {
+
+   const Int32 Count (_decodeCount);
+
+   Marshal data (ByteOrderBigEndian);
+   data.set_next_uint32 (LocalFrameMagic);
+   data.set_next_uint8 (LocalFrameVersion);
+   data.set_next_uint8 (Channel ? LocalFrameChannel : 0);
+   if (Channel) { data.set_next_uint32 (Channel); }
+   data.set_next_uint32 (0);
+
+   _packetObs->read_packet (data.get_length (), data.get_buffer ());
+
+   return _decodeCount > Count;
+}
+
+
+// Returns the channel the local object is tagged with at the given position.
+dmz::UInt32
+dmz::NetModuleInterestBasicTest::_channel (const Vector &Position) {
+
+   _objMod->store_position (_object, _defaultHandle, Position);
+   return _interestMod->lookup_object_channel (_object);
+}
+
+
+// A local object without a position must not stop remote traffic.
+void
+dmz::NetModuleInterestBasicTest::_test_unpositioned () {
+
+   _object = _objMod->create_object (_type, ObjectLocal);
+   _objMod->activate_object (_object);
+
+   test.validate (
+      !_interestMod->lookup_object_channel (_object),
+      "Object without a position has no channel.");
+
+   test.validate (_deliver (0), "Untagged packet delivered.");
+
+   test.validate (
+      _deliver (LocalChannelFlag | (100 << 15) | 100),
+      "Channel tagged packet delivered when no local object has a position.");
+}
+
+
+void
+dmz::NetModuleInterestBasicTest::_test_positioned () {
+
+   const UInt32 Channel (_channel (Vector (0.0, 0.0, 0.0)));
+
+   test.validate (Channel != 0, "Positioned object has a channel.");
+   test.validate (_deliver (Channel), "Packet in the area of interest delivered.");
+
+   test.validate (
+      _deliver (_channel (Vector (1500.0, 0.0, -1500.0))) &&
+         _deliver (_channel (Vector (0.0, 0.0, 0.0))),
+      "Packet in a neighboring cell delivered.");
+
+   test.validate (
+      !_deliver (LocalChannelFlag | (100 << 15) | 100),
+      "Packet outside the area of interest dropped.");
+
+   test.validate (_deliver (0), "Untagged packet delivered with an area of interest.");
+}
+
+
+// The X and Z cell coordinates use 15 bits each and are clamped to the signed range.
+void
+dmz::NetModuleInterestBasicTest::_test_channel_mapping () {
+
+   test.validate (
+      _channel (Vector (500.0, 0.0, 500.0)) == LocalChannelFlag,
+      "Origin cell maps to the empty channel coordinates.");
+
+   test.validate (
+      _channel (Vector (-500.0, 0.0, -500.0)) ==
+         (LocalChannelFlag | (0x7FFF << 15) | 0x7FFF),
+      "Negative cells use the same width for X and Z.");
+
+   test.validate (
+      _channel (Vector (1500.0, 0.0, -2500.0)) ==
+         (LocalChannelFlag | (1 << 15) | 0x7FFD),
+      "Cell coordinates map to the channel.");
+
+   test.validate (
+      _channel (Vector (1.0e15, 0.0, -1.0e15)) ==
+         (LocalChannelFlag | (0x3FFF << 15) | 0x4000),
+      "Far cells are clamped to the outermost cells.");
+
+   test.validate (
+      _channel (Vector (16383500.0, 0.0, -16384500.0)) ==
+         _channel (Vector (1.0e15, 0.0, -1.0e15)),
+      "Outermost cells do not wrap around.");
+}
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetModuleInterestBasicTest (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetModuleInterestBasicTest (Info, local, global);
+}
+
+};
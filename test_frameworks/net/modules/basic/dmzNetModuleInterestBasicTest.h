@@ -0,0 +1,91 @@
+#ifndef DMZ_NET_MODULE_INTEREST_BASIC_TEST_DOT_H
+#define DMZ_NET_MODULE_INTEREST_BASIC_TEST_DOT_H
+
+#include <dmzNetModulePacketCodec.h>
+#include <dmzNetModulePacketIO.h>
+#include <dmzRuntimeObjectType.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzTestPluginUtil.h>
+
+namespace dmz {
+
+   class Config;
+   class NetModuleInterest;
+   class ObjectModule;
+   class Vector;
+
+   // Stands in for both the packet I/O and the packet codec modules so that the test
+   // can feed packets to the packet plugin and count the ones that reach the codec.
+   class NetModuleInterestBasicTest :
+      public Plugin,
+      public TimeSlice,
+      public NetModulePacketIO,
+      public NetModulePacketCodec {
+
+      public:
+         NetModuleInterestBasicTest (
+            const PluginInfo &Info,
+            Config &local,
+            Config &global);
+         ~NetModuleInterestBasicTest ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level) {;}
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr);
+
+         // TimeSlice Interface
+         virtual void update_time_slice (const Float64 TimeDelta);
+
+         // NetModulePacketIO Interface
+         virtual Boolean register_packet_observer (NetPacketObserver &obs);
+         virtual Boolean release_packet_observer (NetPacketObserver &obs);
+         virtual Boolean write_packet (const Int32 Size, char *buffer) { return True; }
+
+         // NetModulePacketCodec Interface
+         virtual void get_supported_objects (ObjectTypeSet &objects) {;}
+         virtual void get_supported_events (EventTypeSet &events) {;}
+         virtual Boolean decode (Unmarshal &data, Boolean &isLoopback);
+
+         virtual Boolean register_object (
+            const Handle ObjectHandle,
+            const ObjectType &Type,
+            Marshal &outData) { return True; }
+
+         virtual Boolean encode_object (
+            const Handle ObjectHandle,
+            Marshal &outData) { return True; }
+
+         virtual Boolean release_object (
+            const Handle ObjectHandle,
+            Marshal &outData) { return True; }
+
+         virtual Boolean encode_event (
+            const EventType &Type,
+            const Handle EventHandle,
+            Marshal &data) { return True; }
+
+      protected:
+         Boolean _deliver (const UInt32 Channel);
+         UInt32 _channel (const Vector &Position);
+         void _test_unpositioned ();
+         void _test_positioned ();
+         void _test_channel_mapping ();
+
+         TestPluginUtil test;
+         ObjectType _type;
+         ObjectModule *_objMod;
+         NetModuleInterest *_interestMod;
+         NetPacketObserver *_packetObs;
+         Handle _defaultHandle;
+         Handle _object;
+         Int32 _decodeCount;
+   };
+};
+
+#endif // DMZ_NET_MODULE_INTEREST_BASIC_TEST_DOT_H
@@ -0,0 +1,431 @@
+#include "dmzNetModuleLocalDRBasicTest.h"
+#include <dmzNetModuleLocalDR.h>
+#include <dmzObjectConsts.h>
+#include <dmzObjectModule.h>
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzTypesConsts.h>
+#include <dmzTypesVector.h>
+
+#include <math.h>
+
+namespace {
+
+   // The test config allows one update for every tenth of a second of real time.
+   static const dmz::Int32 LocalObjectCount (5);
+   static const dmz::Float64 LocalBudgetStep (0.2);
+   static const dmz::Float64 LocalStep (0.05);
+   static const dmz::Int32 LocalMaxFrames (400);
+};
+
+
+dmz::NetModuleLocalDRBasicTest::NetModuleLocalDRBasicTest (
+      const PluginInfo &Info,
+      Config &local,
+      Config &global) :
+      Plugin (Info),
+      TimeSlice (Info),
+      test (Info.get_name (), Info.get_context ()),
+      _time (Info),
+      _objMod (0),
+      _drMod (0),
+      _defaultHandle (0),
+      _lnvHandle (0),
+      _clockTime (1.0),
+      _heartbeat (0.0),
+      _spread (0.0),
+      _stage (StageStart),
+      _frame (0),
+      _observer (0),
+      _near (0),
+      _far (0),
+      _sent (0),
+      _startTime (0.0),
+      _firstTime (0.0),
+      _secondTime (0.0) {
+
+   Definitions defs (Info.get_context ());
+
+   _defaultHandle = defs.create_named_handle (ObjectAttributeDefaultName);
+   _lnvHandle = defs.create_named_handle (ObjectAttributeLastNetworkValueName);
+   _type = config_to_object_type ("type.name", local, Info.get_context ());
+
+   _observerType = config_to_object_type (
+      "observer-type.name",
+      local,
+      Info.get_context ());
+
+   _accelType = config_to_object_type ("accel-type.name", local, Info.get_context ());
+
+   _heartbeat = config_to_float64 ("heartbeat.value", local, 5.0);
+   _spread = config_to_float64 ("heartbeat.spread", local, 0.5);
+}
+
+
+dmz::NetModuleLocalDRBasicTest::~NetModuleLocalDRBasicTest () {;}
+
+
+// Plugin Interface
+void
+dmz::NetModuleLocalDRBasicTest::discover_plugin (
+      const PluginDiscoverEnum Mode,
+      const Plugin *PluginPtr) {
+
+   if (Mode == PluginDiscoverAdd) {
+
+      if (!_objMod) { _objMod = ObjectModule::cast (PluginPtr); }
+      if (!_drMod) { _drMod = NetModuleLocalDR::cast (PluginPtr); }
+   }
+   else if (Mode == PluginDiscoverRemove) {
+
+      if (_objMod && (_objMod == ObjectModule::cast (PluginPtr))) { _objMod = 0; }
+      if (_drMod && (_drMod == NetModuleLocalDR::cast (PluginPtr))) { _drMod = 0; }
+   }
+}
+
+
+// TimeSlice Interface
+// Each stage runs across several frames because the frame time only advances between
+// frames. The frame time follows the fake frame clock installed by the test.
+void
+dmz::NetModuleLocalDRBasicTest::update_time_slice (const Float64 TimeDelta) {
+
+   _frame++;
+
+   if (_stage == StageStart) {
+
+      test.validate (_objMod != 0, "Object module discovered.");
+      test.validate (_drMod != 0, "Local dead reckoning module discovered.");
+      test.validate (_type.get_handle () != 0, "Test object type found.");
+      test.validate (_observerType.get_handle () != 0, "Observer object type found.");
+      test.validate (_accelType.get_handle () != 0, "Acceleration object type found.");
+
+      if (_objMod && _drMod && _type && _observerType && _accelType) {
+
+         _time.set_frame_clock (this);
+         _start_budget ();
+      }
+      else { test.exit ("Test aborted"); }
+   }
+   else if (_frame > LocalMaxFrames) {
+
+      test.validate (False, "Test finished before the frame limit.");
+      _stage = StageDone;
+   }
+   else if (_stage == StageBudget) { _test_budget (); }
+   else if (_stage == StageHeartbeat) { _test_heartbeat (); }
+   else if (_stage == StageModel) { _test_model (); }
+   else if (_stage == StageObserver) { _test_observer (); }
+
+   if (_stage == StageDone) {
+
+      _time.set_frame_clock (0);
+      test.exit ("Test completed");
+   }
+}
+
+
+dmz::Handle
+dmz::NetModuleLocalDRBasicTest::_create_object (
+      const ObjectType &Type,
+      const ObjectLocalityEnum Locality) {
+
+   const Handle Object (_objMod->create_object (Type, Locality));
+
+   // Every object starts out as if its first packet was just sent.
+   _objMod->store_time_stamp (Object, _lnvHandle, _time.get_frame_time ());
+   _objMod->activate_object (Object);
+
+   return Object;
+}
+
+
+// Asks the module if the object should be sent and, like the codec, stamps the last
+// network value when it is.
+dmz::Boolean
+dmz::NetModuleLocalDRBasicTest::_update (const Handle ObjectHandle) {
+
+   const Boolean Result (_drMod->update_object (ObjectHandle));
+
+   if (Result) {
+
+      _objMod->store_time_stamp (ObjectHandle, _lnvHandle, _time.get_frame_time ());
+   }
+
+   return Result;
+}
+
+
+dmz::Int32
+dmz::NetModuleLocalDRBasicTest::_update (const HandleContainer &Objects) {
+
+   Int32 result (0);
+
+   HandleContainerIterator it;
+   Handle object (0);
+
+   while (Objects.get_next (it, object)) { if (_update (object)) { result++; } }
+
+   return result;
+}
+
+
+// Makes the heartbeat of every object overdue.
+void
+dmz::NetModuleLocalDRBasicTest::_overdue (const HandleContainer &Objects) {
+
+   HandleContainerIterator it;
+   Handle object (0);
+
+   while (Objects.get_next (it, object)) {
+
+      _objMod->store_time_stamp (object, _lnvHandle, _time.get_frame_time () - 10.0);
+   }
+}
+
+
+void
+dmz::NetModuleLocalDRBasicTest::_destroy (const HandleContainer &Objects) {
+
+   HandleContainerIterator it;
+   Handle object (0);
+
+   while (Objects.get_next (it, object)) { _objMod->destroy_object (object); }
+}
+
+
+// New objects must not bypass the budget and deferred objects must still be sent when
+// the frame time is paused.
+void
+dmz::NetModuleLocalDRBasicTest::_start_budget () {
+
+   _time.set_time_factor (0.0);
+
+   for (Int32 ix = 0; ix < LocalObjectCount; ix++) {
+
+      _objects.add (_create_object (_type, ObjectLocal));
+   }
+
+   _overdue (_objects);
+   _startTime = _time.get_frame_time ();
+   _sent = _update (_objects);
+
+   test.validate (_sent == 1, "New objects are limited by the budget.");
+
+   _clockTime += LocalBudgetStep;
+   _stage = StageBudget;
+}
+
+
+void
+dmz::NetModuleLocalDRBasicTest::_test_budget () {
+
+   _sent += _update (_objects);
+
+   if (_sent >= LocalObjectCount) {
+
+      test.validate (
+         (_sent == LocalObjectCount) && (_frame == LocalObjectCount) &&
+            (_time.get_frame_time () == _startTime),
+         "Deferred objects are sent one per frame while the frame time is paused.");
+
+      _overdue (_objects);
+
+      test.validate (
+         _update (_objects) == 0,
+         "Nothing is sent once the budget is spent.");
+
+      _destroy (_objects);
+      _objects.clear ();
+
+      _time.set_time_factor (1.0);
+      _clockTime += LocalStep;
+      _stage = StageHeartbeat;
+      _start_heartbeat ();
+   }
+   else { _clockTime += LocalBudgetStep; }
+}
+
+
+// Only the first heartbeat of an object is moved forward by the spread.
+void
+dmz::NetModuleLocalDRBasicTest::_start_heartbeat () {
+
+   _observer = 0;
+   _near = 0;
+   _far = 0;
+   _firstTime = 0.0;
+   _secondTime = 0.0;
+}
+
+
+void
+dmz::NetModuleLocalDRBasicTest::_test_heartbeat () {
+
+   if (!_near) {
+
+      // The time factor set by the budget stage is in effect from this frame on.
+      _near = _create_object (_type, ObjectLocal);
+      _startTime = _time.get_frame_time ();
+   }
+
+   if (_update (_near)) {
+
+      if (!_firstTime) { _firstTime = _time.get_frame_time (); }
+      else { _secondTime = _time.get_frame_time (); }
+   }
+
+   if (_secondTime) {
+
+      // Same phase the heartbeat rule gives each object.
+      const Float64 Offset (
+         _heartbeat * _spread *
+            Float64 ((UInt32 (_near) * 2654435761u) >> 16) / 65536.0);
+
+      const Float64 FirstInterval (_firstTime - _startTime);
+      const Float64 SecondInterval (_secondTime - _firstTime);
+      const Float64 Error (LocalStep + 1.0e-6);
+
+      test.validate (
+         (FirstInterval >= (_heartbeat - Offset - 1.0e-6)) &&
+            (FirstInterval <= (_heartbeat - Offset + Error)),
+         "First heartbeat is moved forward by the spread.");
+
+      test.validate (
+         (SecondInterval >= (_heartbeat - 1.0e-6)) &&
+            (SecondInterval <= (_heartbeat + Error)),
+         "Later heartbeats keep the full interval.");
+
+      _objMod->destroy_object (_near);
+      _near = 0;
+
+      _stage = StageModel;
+      _start_model ();
+   }
+
+   _clockTime += LocalStep;
+}
+
+
+// The position error used to rank objects must use the dead reckoning model of the
+// object type. The accelerating object is exactly where the remote side puts it while a
+// velocity only guess would place it far away.
+void
+dmz::NetModuleLocalDRBasicTest::_start_model () {
+
+   _far = _create_object (_accelType, ObjectLocal);
+   _near = _create_object (_accelType, ObjectLocal);
+
+   // Registers both objects with the module before their heartbeats are due.
+   _update (_far);
+   _update (_near);
+
+   _clockTime += 1.0;
+}
+
+
+void
+dmz::NetModuleLocalDRBasicTest::_test_model () {
+
+   const Float64 Age (_heartbeat + 1.0);
+   const Float64 Stamp (_time.get_frame_time () - Age);
+   const Vector Accel (10.0, 0.0, 0.0);
+
+   _objMod->store_time_stamp (_far, _lnvHandle, Stamp);
+   _objMod->store_position (_far, _lnvHandle, Vector ());
+   _objMod->store_velocity (_far, _lnvHandle, Vector ());
+   _objMod->store_acceleration (_far, _lnvHandle, Accel);
+   _objMod->store_position (_far, _defaultHandle, Accel * (0.5 * Age * Age));
+
+   _objMod->store_time_stamp (_near, _lnvHandle, Stamp);
+   _objMod->store_position (_near, _lnvHandle, Vector ());
+   _objMod->store_velocity (_near, _lnvHandle, Vector ());
+   _objMod->store_position (_near, _defaultHandle, Vector (1.0, 0.0, 0.0));
+
+   const Boolean AccelSent (_update (_far));
+   const Boolean SkewedSent (_update (_near));
+
+   test.validate (
+      SkewedSent && !AccelSent,
+      "Position error is dead reckoned with the model of the object type.");
+
+   _objMod->destroy_object (_far);
+   _objMod->destroy_object (_near);
+   _far = _near = 0;
+
+   _stage = StageObserver;
+   _start_observer ();
+}
+
+
+// When only one update fits the budget, the object near a remote observer goes first.
+// Local objects of the observer type closer to it must not hide the remote observer.
+void
+dmz::NetModuleLocalDRBasicTest::_start_observer () {
+
+   _observer = _create_object (_observerType, ObjectRemote);
+   _objMod->store_position (_observer, _defaultHandle, Vector (5000.0, 0.0, 10.0));
+
+   for (Int32 ix = 0; ix < 8; ix++) {
+
+      const Float64 Angle (Float64 (ix) * Pi64 / 4.0);
+      const Handle Local (_create_object (_observerType, ObjectLocal));
+
+      _objMod->store_position (
+         Local,
+         _defaultHandle,
+         Vector (5000.0 + (5.0 * cos (Angle)), 0.0, 5.0 * sin (Angle)));
+
+      _localObservers.add (Local);
+   }
+
+   _far = _create_object (_type, ObjectLocal);
+   _near = _create_object (_type, ObjectLocal);
+
+   _objMod->store_position (_far, _defaultHandle, Vector (5000.0, 0.0, 2000.0));
+   _objMod->store_position (_near, _defaultHandle, Vector (5000.0, 0.0, 0.0));
+
+   // Registers both objects with the module before their heartbeats are due.
+   _update (_far);
+   _update (_near);
+
+   // Both heartbeats are due next frame but the budget only refills one packet.
+   _clockTime += _heartbeat + 1.0;
+}
+
+
+void
+dmz::NetModuleLocalDRBasicTest::_test_observer () {
+
+   const Boolean FarSent (_update (_far));
+   const Boolean NearSent (_update (_near));
+
+   test.validate (NearSent && !FarSent, "Object near an observer is sent first.");
+
+   _objMod->destroy_object (_far);
+   _objMod->destroy_object (_near);
+   _objMod->destroy_object (_observer);
+   _far = _near = _observer = 0;
+
+   _destroy (_localObservers);
+   _localObservers.clear ();
+
+   _stage = StageDone;
+}
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetModuleLocalDRBasicTest (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetModuleLocalDRBasicTest (Info, local, global);
+}
+
+};
@@ -0,0 +1,99 @@
+#ifndef DMZ_NET_MODULE_LOCAL_DR_BASIC_TEST_DOT_H
+#define DMZ_NET_MODULE_LOCAL_DR_BASIC_TEST_DOT_H
+
+#include <dmzObjectConsts.h>
+#include <dmzRuntimeObjectType.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeTime.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzTestPluginUtil.h>
+#include <dmzTypesHandleContainer.h>
+
+namespace dmz {
+
+   class Config;
+   class NetModuleLocalDR;
+   class ObjectModule;
+
+   class NetModuleLocalDRBasicTest :
+      public Plugin,
+      public TimeSlice,
+      public FrameClock {
+
+      public:
+         NetModuleLocalDRBasicTest (
+            const PluginInfo &Info,
+            Config &local,
+            Config &global);
+         ~NetModuleLocalDRBasicTest ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level) {;}
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr);
+
+         // TimeSlice Interface
+         virtual void update_time_slice (const Float64 TimeDelta);
+
+         // FrameClock Interface
+         virtual Float64 get_frame_clock_time () { return _clockTime; }
+         virtual void frame_clock_sleep (const Float64 Time) {;}
+         virtual void frame_clock_yield () {;}
+
+      protected:
+         Handle _create_object (
+            const ObjectType &Type,
+            const ObjectLocalityEnum Locality);
+         Boolean _update (const Handle ObjectHandle);
+         Int32 _update (const HandleContainer &Objects);
+         void _overdue (const HandleContainer &Objects);
+         void _destroy (const HandleContainer &Objects);
+         void _start_budget ();
+         void _test_budget ();
+         void _start_heartbeat ();
+         void _test_heartbeat ();
+         void _start_model ();
+         void _test_model ();
+         void _start_observer ();
+         void _test_observer ();
+
+         enum StageEnum {
+            StageStart,
+            StageBudget,
+            StageHeartbeat,
+            StageModel,
+            StageObserver,
+            StageDone
+         };
+
+         TestPluginUtil test;
+         Time _time;
+         ObjectType _type;
+         ObjectType _observerType;
+         ObjectType _accelType;
+         ObjectModule *_objMod;
+         NetModuleLocalDR *_drMod;
+         Handle _defaultHandle;
+         Handle _lnvHandle;
+         Float64 _clockTime;
+         Float64 _heartbeat;
+         Float64 _spread;
+         StageEnum _stage;
+         Int32 _frame;
+         HandleContainer _objects;
+         HandleContainer _localObservers;
+         Handle _observer;
+         Handle _near;
+         Handle _far;
+         Int32 _sent;
+         Float64 _startTime;
+         Float64 _firstTime;
+         Float64 _secondTime;
+   };
+};
+
+#endif // DMZ_NET_MODULE_LOCAL_DR_BASIC_TEST_DOT_H
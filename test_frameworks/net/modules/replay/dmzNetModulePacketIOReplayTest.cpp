@@ -0,0 +1,348 @@
+#include "dmzNetModulePacketIOReplayTest.h"
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeLoadPlugins.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzRuntimePluginInfo.h>
+#include <dmzSystemFile.h>
+#include <dmzSystemMarshal.h>
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+   static const dmz::Int32 LocalSizes[] = { 1, 17, 300, 1500, 64 };
+   static const dmz::Int32 LocalPacketCount (sizeof (LocalSizes) / sizeof (dmz::Int32));
+   static const dmz::Int32 LocalMaxSize (1500);
+   static const dmz::Int32 LocalFileHeaderSize (8);
+   static const dmz::Int32 LocalRecordHeaderSize (12);
+   // Frames each replay is given to deliver the whole file.
+   static const dmz::Int32 LocalReplayFrames (3);
+   static const dmz::Int32 LocalMaxFrames (100);
+
+   static char
+   local_byte (const dmz::Int32 Packet, const dmz::Int32 Index) {
+
+      return char ((Packet * 31 + Index) & 0xFF);
+   }
+
+   static void
+   local_fill (const dmz::Int32 Packet, char *buffer) {
+
+      for (dmz::Int32 ix = 0; ix < LocalSizes[Packet]; ix++) {
+
+         buffer[ix] = local_byte (Packet, ix);
+      }
+   }
+};
+
+
+dmz::NetModulePacketIOReplayTest::NetModulePacketIOReplayTest (
+      const PluginInfo &Info,
+      Config &local,
+      Config &global) :
+      Plugin (Info),
+      TimeSlice (Info),
+      NetModulePacketIO (Info),
+      NetPacketObserver (Info),
+      test (Info.get_name (), Info.get_context ()),
+      _log (Info),
+      _local (local),
+      _global (global),
+      _container (Info.get_context (), &_log),
+      _replayMod (0),
+      _packetObs (0),
+      _stage (StageCapture),
+      _frame (0),
+      _startFrame (0),
+      _received (0),
+      _match (True) {
+
+   _captureFile = config_to_string ("file.capture", local);
+   _truncatedFile = config_to_string ("file.truncated", local);
+   _corruptFile = config_to_string ("file.corrupt", local);
+}
+
+
+dmz::NetModulePacketIOReplayTest::~NetModulePacketIOReplayTest () { _unload (); }
+
+
+// TimeSlice Interface
+void
+dmz::NetModulePacketIOReplayTest::update_time_slice (const Float64 TimeDelta) {
+
+   _frame++;
+
+   if (_stage == StageCapture) {
+
+      _capture ();
+      _start_replay ("clean", StageClean);
+   }
+   else if (_frame > LocalMaxFrames) {
+
+      test.validate (False, "Test finished before the frame limit.");
+      _unload ();
+      _stage = StageDone;
+   }
+   else if ((_frame - _startFrame) >= LocalReplayFrames) {
+
+      if (_stage == StageClean) {
+
+         _test_replay ("clean");
+         _start_replay ("truncated", StageTruncated);
+      }
+      else if (_stage == StageTruncated) {
+
+         _test_replay ("truncated");
+         _start_replay ("corrupt", StageCorrupt);
+      }
+      else if (_stage == StageCorrupt) {
+
+         _test_replay ("corrupt");
+         _stage = StageDone;
+      }
+   }
+
+   if (_stage == StageDone) {
+
+      remove_file (_captureFile);
+      remove_file (_truncatedFile);
+      remove_file (_corruptFile);
+
+      test.exit ("Test completed");
+   }
+}
+
+
+// NetModulePacketIO Interface
+dmz::Boolean
+dmz::NetModulePacketIOReplayTest::register_packet_observer (NetPacketObserver &obs) {
+
+   Boolean result (False);
+
+   if (!_packetObs) { _packetObs = &obs; result = True; }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::NetModulePacketIOReplayTest::release_packet_observer (NetPacketObserver &obs) {
+
+   Boolean result (False);
+
+   if (_packetObs == &obs) { _packetObs = 0; result = True; }
+
+   return result;
+}
+
+
+// NetPacketObserver Interface
+void
+dmz::NetModulePacketIOReplayTest::read_packet (const Int32 Size, char *buffer) {
+
+   if ((_received < LocalPacketCount) && (Size == LocalSizes[_received]) && buffer) {
+
+      for (Int32 ix = 0; ix < Size; ix++) {
+
+         if (buffer[ix] != local_byte (_received, ix)) { _match = False; }
+      }
+   }
+   else { _match = False; }
+
+   _received++;
+}
+
+
+dmz::Boolean
+dmz::NetModulePacketIOReplayTest::_load (const String &Scope) {
+
+   Boolean result (False);
+
+   Config pluginList;
+
+   if (_local.lookup_all_config (Scope + ".plugin-list.plugin", pluginList)) {
+
+      Config init;
+      _global.lookup_all_config_merged ("dmz", init);
+
+      result = load_plugins (
+         get_plugin_runtime_context (),
+         pluginList,
+         init,
+         _global,
+         _container,
+         &_log);
+
+      _container.discover_plugins ();
+      _container.discover_external_plugin (this);
+      _container.init_plugins ();
+      _container.start_plugins ();
+   }
+
+   return result;
+}
+
+
+void
+dmz::NetModulePacketIOReplayTest::_unload () {
+
+   if (_replayMod) { _replayMod->release_packet_observer (*this); _replayMod = 0; }
+
+   _container.remove_external_plugin (this);
+   _container.stop_plugins ();
+   _container.shutdown_plugins ();
+   _container.remove_plugins ();
+   _container.delete_plugins ();
+}
+
+
+// The capture plugin observes this plugin as its packet I/O module. Unloading the
+// capture plugin closes the capture file.
+void
+dmz::NetModulePacketIOReplayTest::_capture () {
+
+   test.validate (_load ("capture"), "Capture plugin loaded.");
+   test.validate (_packetObs != 0, "Capture plugin registered as a packet observer.");
+
+   Int32 expectedSize (LocalFileHeaderSize);
+
+   if (_packetObs) {
+
+      char buffer[LocalMaxSize];
+
+      for (Int32 ix = 0; ix < LocalPacketCount; ix++) {
+
+         local_fill (ix, buffer);
+         _packetObs->read_packet (LocalSizes[ix], buffer);
+         expectedSize += LocalRecordHeaderSize + LocalSizes[ix];
+      }
+   }
+
+   _unload ();
+
+   test.validate (_packetObs == 0, "Capture plugin released the packet I/O module.");
+
+   test.validate (
+      get_file_size (_captureFile) == UInt64 (expectedSize),
+      "Capture file contains every packet.");
+
+   // Trailing record that claims more bytes than remain in the file.
+   _write_damaged (_truncatedFile, 1000, 10);
+
+   // Trailing record with a size that does not fit in a signed 32 bit packet size.
+   _write_damaged (_corruptFile, 0xFFFFFFFF, 10);
+}
+
+
+// Writes a copy of the capture file followed by a record of Size bytes of which only
+// Available bytes are present.
+void
+dmz::NetModulePacketIOReplayTest::_write_damaged (
+      const String &FileName,
+      const UInt32 Size,
+      const Int32 Available) {
+
+   const Int32 Length (Int32 (get_file_size (_captureFile)));
+
+   char *data (Length > 0 ? new char[Length] : 0);
+
+   FILE *file (data ? open_file (_captureFile, "rb") : 0);
+
+   Boolean read (False);
+
+   if (file) {
+
+      read = (read_file (file, Length, data) == Length);
+      close_file (file);
+      file = 0;
+   }
+
+   if (read) { file = open_file (FileName, "wb"); }
+
+   Boolean written (False);
+
+   if (file) {
+
+      Marshal header (ByteOrderLittleEndian);
+      header.set_next_float64 (0.0);
+      header.set_next_uint32 (Size);
+
+      char filler[LocalMaxSize];
+      memset (filler, 0, Available);
+
+      written =
+         (fwrite (data, Length, 1, file) == 1) &&
+         (fwrite (header.get_buffer (), LocalRecordHeaderSize, 1, file) == 1) &&
+         (fwrite (filler, Available, 1, file) == 1);
+
+      close_file (file);
+      file = 0;
+   }
+
+   if (data) { delete []data; data = 0; }
+
+   test.validate (written, "Damaged capture file written.");
+}
+
+
+void
+dmz::NetModulePacketIOReplayTest::_start_replay (
+      const String &Scope,
+      const StageEnum Stage) {
+
+   _received = 0;
+   _match = True;
+   _startFrame = _frame;
+   _stage = Stage;
+
+   test.validate (_load (Scope), "Replay module loaded.");
+
+   RuntimeIterator it;
+   Plugin *ptr (_container.get_first (it));
+
+   while (ptr && !_replayMod) {
+
+      _replayMod = NetModulePacketIO::cast (ptr);
+      ptr = _container.get_next (it);
+   }
+
+   test.validate (_replayMod != 0, "Replay module discovered.");
+
+   if (_replayMod) {
+
+      test.validate (
+         _replayMod->register_packet_observer (*this),
+         "Registered with replay module.");
+   }
+}
+
+
+void
+dmz::NetModulePacketIOReplayTest::_test_replay (const String &Name) {
+
+   String msg ("Every captured packet replayed from the ");
+   msg << Name << " file.";
+
+   test.validate (_received == LocalPacketCount, msg);
+
+   msg.flush () << "Replayed packets from the " << Name << " file match the capture.";
+
+   test.validate (_match, msg);
+
+   _unload ();
+}
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzNetModulePacketIOReplayTest (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::NetModulePacketIOReplayTest (Info, local, global);
+}
+
+};
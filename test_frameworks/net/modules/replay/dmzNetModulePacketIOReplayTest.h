@@ -0,0 +1,88 @@
+#ifndef DMZ_NET_MODULE_PACKET_IO_REPLAY_TEST_DOT_H
+#define DMZ_NET_MODULE_PACKET_IO_REPLAY_TEST_DOT_H
+
+#include <dmzNetModulePacketIO.h>
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeLog.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimePluginContainer.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzTestPluginUtil.h>
+#include <dmzTypesString.h>
+
+namespace dmz {
+
+   // Stands in for the packet I/O module observed by the capture plugin and observes
+   // the replay module. Both are loaded in to their own plugin containers so that the
+   // capture file is closed before the replay module maps it.
+   class NetModulePacketIOReplayTest :
+      public Plugin,
+      public TimeSlice,
+      public NetModulePacketIO,
+      public NetPacketObserver {
+
+      public:
+         NetModulePacketIOReplayTest (
+            const PluginInfo &Info,
+            Config &local,
+            Config &global);
+         ~NetModulePacketIOReplayTest ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level) {;}
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr) {;}
+
+         // TimeSlice Interface
+         virtual void update_time_slice (const Float64 TimeDelta);
+
+         // NetModulePacketIO Interface
+         virtual Boolean register_packet_observer (NetPacketObserver &obs);
+         virtual Boolean release_packet_observer (NetPacketObserver &obs);
+         virtual Boolean write_packet (const Int32 Size, char *buffer) { return True; }
+
+         // NetPacketObserver Interface
+         virtual void read_packet (const Int32 Size, char *buffer);
+
+      protected:
+         enum StageEnum {
+            StageCapture,
+            StageClean,
+            StageTruncated,
+            StageCorrupt,
+            StageDone
+         };
+
+         Boolean _load (const String &Scope);
+         void _unload ();
+         void _capture ();
+         void _write_damaged (
+            const String &FileName,
+            const UInt32 Size,
+            const Int32 Available);
+         void _start_replay (const String &Scope, const StageEnum Stage);
+         void _test_replay (const String &Name);
+
+         TestPluginUtil test;
+         Log _log;
+         Config _local;
+         Config _global;
+         PluginContainer _container;
+         NetModulePacketIO *_replayMod;
+         NetPacketObserver *_packetObs;
+         StageEnum _stage;
+         Int32 _frame;
+         String _captureFile;
+         String _truncatedFile;
+         String _corruptFile;
+         Int32 _startFrame;
+         Int32 _received;
+         Boolean _match;
+   };
+};
+
+#endif // DMZ_NET_MODULE_PACKET_IO_REPLAY_TEST_DOT_H
@@ -1,7 +1,20 @@
+#include <dmzObjectAttributeMasks.h>
+#include <dmzObjectConsts.h>
 #include <dmzObjectModule.h>
 #include "dmzObjectModuleBasicTest.h"
 #include <dmzRuntimeConfig.h>
+#include <dmzRuntimeConfigToTypesBase.h>
+#include <dmzRuntimeData.h>
+#include <dmzRuntimeDefinitions.h>
 #include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzTypesMatrix.h>
+#include <dmzTypesVector.h>
+
+namespace {
+
+   // Enough objects to force the attribute columns to reallocate.
+   static const dmz::Int32 LocalGrowCount (4096);
+};
 
 
 dmz::ObjectModuleBasicTest::ObjectModuleBasicTest (
@@ -10,10 +23,35 @@ dmz::ObjectModuleBasicTest::ObjectModuleBasicTest (
       Config &global) :
       Plugin (Info),
       TimeSlice (Info),
+      MessageObserver (Info),
       ObjectObserverUtil (Info, local),
       test (Info.get_name (), Info.get_context ()),
-      _objMod (0) {
+      _objMod (0),
+      _defaultHandle (0),
+      _altHandle (0),
+      _queuedHandle (0),
+      _queuedUpdates (0),
+      _coalesce (False),
+      _frame (0),
+      _coalesceObj (0),
+      _positionUpdates (0),
+      _lastPrevPositionExists (False),
+      _growColumns (False) {
+
+   Definitions defs (Info.get_context ());
+
+   _defaultHandle = defs.create_named_handle (ObjectAttributeDefaultName);
+   _altHandle = defs.create_named_handle ("Test_Alternate_Attribute");
+   _type = defs.get_root_object_type ();
 
+   _coalesce = config_to_boolean ("coalesce.value", local, False);
+
+   if (_coalesce) {
+
+      _queuedHandle = defs.create_named_handle ("queued");
+      defs.create_message ("Object_Update_Stats_Message", _statsMsg);
+      subscribe_to_message (_statsMsg);
+   }
 }
 
 
@@ -24,7 +62,438 @@ dmz::ObjectModuleBasicTest::~ObjectModuleBasicTest () {;}
 void
 dmz::ObjectModuleBasicTest::update_time_slice (const Float64 TimeDelta) {
 
-   test.exit ("Test completed");
+   _frame++;
+
+   if (_frame == 1) {
+
+      _objMod = get_object_module ();
+
+      test.validate (_objMod != 0, "Object module discovered.");
+
+      if (_objMod) {
+
+         _test_attribute_columns ();
+
+         if (!_coalesce) {
+
+            _test_batch_attributes ();
+            _test_create_objects ();
+            _test_dump_column_growth ();
+         }
+      }
+   }
+
+   if (_objMod && _coalesce) { _test_coalesced_updates (); }
+   else { test.exit ("Test completed"); }
+}
+
+
+// Message Observer Interface
+void
+dmz::ObjectModuleBasicTest::receive_message (
+      const Message &Type,
+      const UInt32 MessageSendId,
+      const Handle TargetObserverHandle,
+      const Data *InData,
+      Data *outData) {
+
+   Int32 value (0);
+
+   if ((Type == _statsMsg) && InData && InData->lookup_int32 (_queuedHandle, 0, value)) {
+
+      _queuedUpdates += value;
+   }
+}
+
+
+// Object Observer Interface
+void
+dmz::ObjectModuleBasicTest::update_object_position (
+      const UUID &Identity,
+      const Handle ObjectHandle,
+      const Handle AttributeHandle,
+      const Vector &Value,
+      const Vector *PreviousValue) {
+
+   // Creating objects from inside the callback grows the attribute columns.
+   if (_growColumns && _objMod) {
+
+      _growColumns = False;
+
+      for (Int32 ix = 0; ix < LocalGrowCount; ix++) {
+
+         const Handle Obj (_objMod->create_object (_type, ObjectLocal));
+         _objMod->store_position (Obj, _defaultHandle, Vector (ix, 0.0, 0.0));
+         _growObjects.add (Obj);
+      }
+   }
+
+   _positionUpdates++;
+   _lastPosition = Value;
+   _lastPrevPositionExists = (PreviousValue != 0);
+   if (PreviousValue) { _lastPrevPosition = *PreviousValue; }
+
+   // Storing from inside an observer callback queues an update in the object module.
+   if (_coalesce && _objMod) {
+
+      _objMod->store_flag (
+         ObjectHandle,
+         _altHandle,
+         !_objMod->lookup_flag (ObjectHandle, _altHandle));
+   }
+}
+
+
+void
+dmz::ObjectModuleBasicTest::_test_attribute_columns () {
+
+   const Vector Pos1 (1.0, 2.0, 3.0);
+   const Vector Pos2 (4.0, 5.0, 6.0);
+   const Vector Pos3 (7.0, 8.0, 9.0);
+   const Matrix Ori (Vector (0.0, 1.0, 0.0), 1.0);
+
+   const Handle Obj1 (_objMod->create_object (_type, ObjectLocal));
+   const Handle Obj2 (_objMod->create_object (_type, ObjectLocal));
+
+   test.validate (Obj1 && Obj2 && (Obj1 != Obj2), "Created two objects.");
+
+   _objMod->activate_object (Obj1);
+   _objMod->activate_object (Obj2);
+
+   _objMod->store_position (Obj1, _defaultHandle, Pos1);
+   _objMod->store_position (Obj2, _defaultHandle, Pos2);
+   _objMod->store_position (Obj1, _altHandle, Pos3);
+   _objMod->store_orientation (Obj2, _defaultHandle, Ori);
+   _objMod->store_flag (Obj1, _altHandle, True);
+   _objMod->store_scalar (Obj2, _altHandle, 42.0);
+
+   Vector pos;
+   Matrix ori;
+   Float64 scalar (0.0);
+
+   test.validate (
+      _objMod->lookup_position (Obj1, _defaultHandle, pos) && (pos == Pos1),
+      "Lookup position of first object.");
+
+   test.validate (
+      _objMod->lookup_position (Obj2, _defaultHandle, pos) && (pos == Pos2),
+      "Lookup position of second object.");
+
+   test.validate (
+      _objMod->lookup_position (Obj1, _altHandle, pos) && (pos == Pos3),
+      "Lookup alternate position of first object.");
+
+   test.validate (
+      !_objMod->lookup_position (Obj2, _altHandle, pos),
+      "Unset alternate position is not found.");
+
+   test.validate (
+      _objMod->lookup_orientation (Obj2, _defaultHandle, ori) && (ori == Ori) &&
+         !_objMod->lookup_orientation (Obj1, _defaultHandle, ori),
+      "Lookup orientation.");
+
+   test.validate (
+      _objMod->lookup_flag (Obj1, _altHandle) && !_objMod->lookup_flag (Obj2, _altHandle),
+      "Lookup flag.");
+
+   test.validate (
+      _objMod->lookup_scalar (Obj2, _altHandle, scalar) && (scalar == 42.0),
+      "Lookup scalar.");
+
+   _objMod->remove_attribute (Obj1, _altHandle, ObjectPositionMask);
+
+   test.validate (
+      !_objMod->lookup_position (Obj1, _altHandle, pos) &&
+         _objMod->lookup_flag (Obj1, _altHandle),
+      "Remove attribute only removes the requested attribute type.");
+
+   const Handle Clone (_objMod->clone_object (Obj2, ObjectIgnoreLinks));
+
+   test.validate (
+      Clone && _objMod->lookup_position (Clone, _defaultHandle, pos) && (pos == Pos2) &&
+         _objMod->lookup_orientation (Clone, _defaultHandle, ori) && (ori == Ori),
+      "Clone copies attributes.");
+
+   _objMod->destroy_object (Obj1);
+
+   const Handle Obj3 (_objMod->create_object (_type, ObjectLocal));
+
+   test.validate (
+      Obj3 && !_objMod->lookup_position (Obj3, _defaultHandle, pos) &&
+         !_objMod->lookup_flag (Obj3, _altHandle),
+      "Recycled object does not inherit attributes.");
+
+   HandleContainer list;
+   list.add (Obj2);
+   list.add (Obj3);
+   list.add (Clone);
+
+   for (Int32 ix = 0; ix < 512; ix++) {
+
+      const Handle Obj (_objMod->create_object (_type, ObjectLocal));
+      _objMod->store_position (Obj, _defaultHandle, Vector (ix, ix, ix));
+      list.add (Obj);
+   }
+
+   test.validate (
+      _objMod->lookup_position (Obj2, _defaultHandle, pos) && (pos == Pos2),
+      "Column growth retains values.");
+
+   HandleContainerIterator it;
+   Handle obj (0);
+
+   while (list.get_next (it, obj)) { _objMod->destroy_object (obj); }
+}
+
+
+void
+dmz::ObjectModuleBasicTest::_test_batch_attributes () {
+
+   const Int32 Count (4);
+
+   HandleContainer list;
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      const Handle Obj (_objMod->create_object (_type, ObjectLocal));
+      _objMod->activate_object (Obj);
+      list.add (Obj);
+   }
+
+   Vector positions[Count];
+   Vector velocities[Count];
+   Boolean valid[Count];
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      positions[ix].set_xyz (ix, ix * 2.0, ix * 3.0);
+      velocities[ix].set_xyz (ix * 10.0, 0.0, 0.0);
+      valid[ix] = (ix != 2);
+   }
+
+   activate_default_object_attribute (ObjectPositionMask);
+   _positionUpdates = 0;
+
+   test.validate (
+      (_objMod->store_positions (list, _defaultHandle, positions) == Count) &&
+         (_positionUpdates == Count),
+      "Batch store of positions notifies observers once per object.");
+
+   _positionUpdates = 0;
+
+   test.validate (
+      (_objMod->store_positions (list, _defaultHandle, positions) == Count) &&
+         (_positionUpdates == 0),
+      "Batch store of unchanged positions does not notify observers.");
+
+   Vector moved[Count];
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      moved[ix] = positions[ix] + Vector (1.0, 0.0, 0.0);
+   }
+
+   _positionUpdates = 0;
+
+   test.validate (
+      (_objMod->store_positions (list, _defaultHandle, moved) == Count) &&
+         (_positionUpdates == Count) && _lastPrevPositionExists &&
+         (_lastPrevPosition == positions[Count - 1]) &&
+         (_objMod->store_positions (list, _defaultHandle, positions) == Count) &&
+         (_lastPosition == positions[Count - 1]) &&
+         (_lastPrevPosition == moved[Count - 1]),
+      "Batch store reports previous values.");
+
+   HandleContainer fresh;
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      const Handle Obj (_objMod->create_object (_type, ObjectLocal));
+      _objMod->activate_object (Obj);
+      fresh.add (Obj);
+   }
+
+   _positionUpdates = 0;
+
+   test.validate (
+      (_objMod->store_positions (fresh, _defaultHandle, positions) == Count) &&
+         (_positionUpdates == Count) && !_lastPrevPositionExists,
+      "Batch store of new attributes reports no previous value.");
+
+   HandleContainerIterator freshIt;
+   Handle freshObj (0);
+
+   while (fresh.get_next (freshIt, freshObj)) { _objMod->destroy_object (freshObj); }
+
+   deactivate_default_object_attribute (ObjectPositionMask);
+
+   test.validate (
+      _objMod->store_velocities (list, _defaultHandle, velocities, valid) == (Count - 1),
+      "Batch store of velocities skips invalid elements.");
+
+   Vector values[Count];
+   Boolean found[Count];
+
+   Boolean match (
+      _objMod->lookup_positions (list, _defaultHandle, values, found) == Count);
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      if (!found[ix] || (values[ix] != positions[ix])) { match = False; }
+   }
+
+   test.validate (match, "Batch lookup of positions.");
+
+   match = (_objMod->lookup_velocities (list, _defaultHandle, values, found) ==
+      (Count - 1));
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      if (found[ix] != valid[ix]) { match = False; }
+      else if (found[ix] && (values[ix] != velocities[ix])) { match = False; }
+   }
+
+   test.validate (match, "Batch lookup of velocities reports missing attributes.");
+
+   test.validate (
+      _objMod->lookup_positions (list, _altHandle, values) == 0,
+      "Batch lookup of unset attribute finds nothing.");
+
+   HandleContainerIterator it;
+   Handle obj (0);
+
+   while (list.get_next (it, obj)) { _objMod->destroy_object (obj); }
+}
+
+
+void
+dmz::ObjectModuleBasicTest::_test_create_objects () {
+
+   const Int32 Count (100);
+
+   HandleContainer list;
+
+   test.validate (
+      (_objMod->create_objects (_type, ObjectRemote, Count, list) == Count) &&
+         (list.get_count () == Count),
+      "Bulk create of objects returns unique handles.");
+
+   HandleContainerIterator it;
+   Handle obj (0);
+   Boolean match (True);
+
+   while (list.get_next (it, obj)) {
+
+      if (!_objMod->is_object (obj) ||
+            (_objMod->lookup_object_type (obj) != _type) ||
+            (_objMod->lookup_locality (obj) != ObjectRemote) ||
+            !_objMod->activate_object (obj)) { match = False; }
+   }
+
+   test.validate (match, "Bulk created objects have the requested type and locality.");
+
+   const ObjectType EmptyType;
+   HandleContainer empty;
+
+   test.validate (
+      !_objMod->create_objects (EmptyType, ObjectLocal, Count, empty) &&
+         !empty.get_count (),
+      "Bulk create of objects with an empty type fails.");
+
+   it.reset ();
+
+   while (list.get_next (it, obj)) { _objMod->destroy_object (obj); }
+
+   test.validate (
+      !_objMod->is_object (list.get_first ()),
+      "Bulk created objects are destroyed.");
+}
+
+
+void
+dmz::ObjectModuleBasicTest::_test_dump_column_growth () {
+
+   const Vector Pos (5.0, 6.0, 7.0);
+
+   const Handle Obj (_objMod->create_object (_type, ObjectLocal));
+   _objMod->store_position (Obj, _defaultHandle, Pos);
+   _objMod->activate_object (Obj);
+
+   _lastPosition = Vector ();
+   _growColumns = True;
+
+   _objMod->dump_all_object_attributes (Obj, *this);
+
+   test.validate (
+      !_growColumns && (_growObjects.get_count () == LocalGrowCount) &&
+         (_lastPosition == Pos),
+      "Dumped attribute value is valid after an observer grows the column.");
+
+   HandleContainerIterator it;
+   Handle obj (0);
+
+   while (_growObjects.get_next (it, obj)) { _objMod->destroy_object (obj); }
+
+   _growObjects.clear ();
+   _objMod->destroy_object (Obj);
+}
+
+
+void
+dmz::ObjectModuleBasicTest::_test_coalesced_updates () {
+
+   // The object module's time slice runs after this one so coalesced updates stored
+   // during a frame are received by the start of the next frame.
+   const Vector Pos1 (1.0, 0.0, 0.0);
+   const Vector Pos2 (2.0, 0.0, 0.0);
+   const Vector Pos3 (3.0, 0.0, 0.0);
+   const Vector Pos4 (4.0, 0.0, 0.0);
+
+   if (_frame == 1) {
+
+      activate_default_object_attribute (ObjectPositionMask);
+
+      _coalesceObj = _objMod->create_object (_type, ObjectLocal);
+      _objMod->activate_object (_coalesceObj);
+
+      _positionUpdates = 0;
+      _objMod->store_position (_coalesceObj, _defaultHandle, Pos1);
+
+      test.validate (_positionUpdates == 0, "Coalesced update is not sent immediately.");
+   }
+   else if (_frame == 2) {
+
+      test.validate (
+         (_positionUpdates == 1) && (_lastPosition == Pos1) && !_lastPrevPositionExists,
+         "Coalesced update of new attribute sent without previous value.");
+
+      _positionUpdates = 0;
+      _objMod->store_position (_coalesceObj, _defaultHandle, Pos2);
+      _objMod->store_position (_coalesceObj, _defaultHandle, Pos3);
+      _objMod->store_position (_coalesceObj, _defaultHandle, Pos4);
+   }
+   else if (_frame == 3) {
+
+      test.validate (
+         (_positionUpdates == 1) && (_lastPosition == Pos4) &&
+            _lastPrevPositionExists && (_lastPrevPosition == Pos1),
+         "Multiple stores in a frame are coalesced into a single update.");
+
+      test.validate (_queuedUpdates > 0, "Update stats report queued observer updates.");
+
+      _positionUpdates = 0;
+      _objMod->store_position (_coalesceObj, _defaultHandle, Pos2);
+      _objMod->destroy_object (_coalesceObj);
+
+      test.validate (
+         (_positionUpdates == 1) && (_lastPosition == Pos2) &&
+            (_lastPrevPosition == Pos4),
+         "Pending coalesced update is sent when object is destroyed.");
+
+      deactivate_default_object_attribute (ObjectPositionMask);
+
+      test.exit ("Test completed");
+   }
 }
 
 
@@ -1,10 +1,14 @@
 #ifndef DMZ_OBJECT_MODULE_BASIC_TEST_DOT_H
 #define DMZ_OBJECT_MODULE_BASIC_TEST_DOT_H
 
+#include <dmzRuntimeMessaging.h>
+#include <dmzRuntimeObjectType.h>
 #include <dmzRuntimePlugin.h>
 #include <dmzRuntimeTimeSlice.h>
 #include <dmzTestPluginUtil.h>
 #include <dmzObjectObserverUtil.h>
+#include <dmzTypesHandleContainer.h>
+#include <dmzTypesVector.h>
 
 namespace dmz {
 
@@ -14,6 +18,7 @@ namespace dmz {
    class ObjectModuleBasicTest :
       public Plugin,
       public TimeSlice,
+      public MessageObserver,
       protected ObjectObserverUtil {
 
       public:
@@ -34,9 +39,46 @@ namespace dmz {
 
          void update_time_slice (const Float64 TimeDelta);
 
+         // Message Observer Interface
+         virtual void receive_message (
+            const Message &Type,
+            const UInt32 MessageSendId,
+            const Handle TargetObserverHandle,
+            const Data *InData,
+            Data *outData);
+
+         // Object Observer Interface
+         virtual void update_object_position (
+            const UUID &Identity,
+            const Handle ObjectHandle,
+            const Handle AttributeHandle,
+            const Vector &Value,
+            const Vector *PreviousValue);
+
       protected:
+         void _test_attribute_columns ();
+         void _test_batch_attributes ();
+         void _test_create_objects ();
+         void _test_dump_column_growth ();
+         void _test_coalesced_updates ();
+
          TestPluginUtil test;
+         ObjectType _type;
          ObjectModule *_objMod;
+         Handle _defaultHandle;
+         Handle _altHandle;
+         Handle _queuedHandle;
+         Message _statsMsg;
+         Int32 _queuedUpdates;
+         Boolean _coalesce;
+         Int32 _frame;
+         Handle _coalesceObj;
+         Int32 _positionUpdates;
+         Vector _lastPosition;
+         Vector _lastPrevPosition;
+         Boolean _lastPrevPositionExists;
+         Boolean _growColumns;
+         HandleContainer _growObjects;
    };
 };
 
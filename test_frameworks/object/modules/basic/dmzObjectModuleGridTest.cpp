@@ -0,0 +1,393 @@
+#include <dmzObjectAttributeMasks.h>
+#include <dmzObjectConsts.h>
+#include <dmzObjectModule.h>
+#include <dmzObjectModuleGrid.h>
+#include "dmzObjectModuleGridTest.h"
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimePluginFactoryLinkSymbol.h>
+#include <dmzTypesVector.h>
+
+static const dmz::Int32 ClusterSide (20);
+static const dmz::Int32 AirCount (20);
+static const dmz::Int32 ObjectCount ((ClusterSide * ClusterSide) + AirCount + 1);
+static const dmz::Float64 Spacing (5.0);
+static const dmz::Vector ClusterOrigin (1000.0, 0.0, 1000.0);
+static const dmz::Vector FarPosition (5000000.0, 100.0, -5000000.0);
+
+
+dmz::ObjectModuleGridTest::ObjectModuleGridTest (
+      const PluginInfo &Info,
+      Config &local,
+      Config &global) :
+      Plugin (Info),
+      TimeSlice (Info),
+      ObjectObserverGrid (Info),
+      ObjectObserverUtil (Info, local),
+      test (Info.get_name (), Info.get_context ()),
+      _objMod (0),
+      _grid (0),
+      _defaultHandle (0),
+      _count (0),
+      _objects (0),
+      _positions (0),
+      _enterCount (0),
+      _exitCount (0) {
+
+   Definitions defs (Info.get_context ());
+
+   _defaultHandle = defs.create_named_handle (ObjectAttributeDefaultName);
+   _type = defs.get_root_object_type ();
+
+   _objects = new Handle[ObjectCount];
+   _positions = new Vector[ObjectCount];
+}
+
+
+dmz::ObjectModuleGridTest::~ObjectModuleGridTest () {
+
+   delete []_objects; _objects = 0;
+   delete []_positions; _positions = 0;
+}
+
+
+// Plugin Interface
+void
+dmz::ObjectModuleGridTest::discover_plugin (
+      const PluginDiscoverEnum Mode,
+      const Plugin *PluginPtr) {
+
+   if (Mode == PluginDiscoverAdd) {
+
+      if (!_grid) { _grid = ObjectModuleGrid::cast (PluginPtr); }
+   }
+   else if (Mode == PluginDiscoverRemove) {
+
+      if (_grid && (_grid == ObjectModuleGrid::cast (PluginPtr))) { _grid = 0; }
+   }
+}
+
+
+// TimeSlice Interface
+void
+dmz::ObjectModuleGridTest::update_time_slice (const Float64 TimeDelta) {
+
+   _objMod = get_object_module ();
+
+   test.validate (_objMod != 0, "Object module discovered.");
+   test.validate (_grid != 0, "Object grid module discovered.");
+
+   if (_objMod && _grid) {
+
+      _test_find_objects ();
+      _test_find_nearest_objects ();
+      _test_observer ();
+      _test_rebalance ();
+   }
+
+   test.exit ("Test completed");
+}
+
+
+// ObjectObserverGrid Interface
+void
+dmz::ObjectModuleGridTest::update_object_grid_state (
+      const ObjectGridStateEnum State,
+      const Handle ObjectHandle,
+      const ObjectType &Type,
+      const Vector &Position) {
+
+   if (State == ObjectGridStateEnter) {
+
+      _enterCount++;
+      _inside.add (ObjectHandle);
+   }
+   else if (State == ObjectGridStateExit) {
+
+      _exitCount++;
+      _inside.remove (ObjectHandle);
+   }
+}
+
+
+dmz::Handle
+dmz::ObjectModuleGridTest::_create (const Vector &Pos) {
+
+   const Handle Obj (_objMod->create_object (_type, ObjectLocal));
+
+   if (Obj) {
+
+      _objMod->activate_object (Obj);
+      _objMod->store_position (Obj, _defaultHandle, Pos);
+
+      _objects[_count] = Obj;
+      _positions[_count] = Pos;
+      _count++;
+   }
+
+   return Obj;
+}
+
+
+void
+dmz::ObjectModuleGridTest::_move (const Int32 Index, const Vector &Pos) {
+
+   _positions[Index] = Pos;
+   _objMod->store_position (_objects[Index], _defaultHandle, Pos);
+}
+
+
+dmz::Int32
+dmz::ObjectModuleGridTest::_count_inside (const Sphere &Space) {
+
+   Int32 result (0);
+
+   for (Int32 ix = 0; ix < _count; ix++) {
+
+      if (_objects[ix] && Space.contains_point (_positions[ix])) { result++; }
+   }
+
+   return result;
+}
+
+
+dmz::Boolean
+dmz::ObjectModuleGridTest::_find (const Sphere &Space, Int32 &count) {
+
+   HandleContainer found;
+   _grid->find_objects (Space, found);
+
+   Boolean result (True);
+   Float64 last (0.0);
+   count = 0;
+
+   HandleContainerIterator it;
+   Handle obj (0);
+
+   while (found.get_next (it, obj)) {
+
+      Vector pos;
+      _objMod->lookup_position (obj, _defaultHandle, pos);
+
+      const Float64 Distance ((pos - Space.get_origin ()).magnitude_squared ());
+
+      if (!Space.contains_point (pos) || (Distance < last)) { result = False; }
+
+      last = Distance;
+      count++;
+   }
+
+   return result;
+}
+
+
+void
+dmz::ObjectModuleGridTest::_test_find_objects () {
+
+   for (Int32 ix = 0; ix < ClusterSide; ix++) {
+
+      for (Int32 jy = 0; jy < ClusterSide; jy++) {
+
+         _create (ClusterOrigin + Vector (ix * Spacing, 0.0, jy * Spacing));
+      }
+   }
+
+   for (Int32 ix = 0; ix < AirCount; ix++) {
+
+      _create (ClusterOrigin + Vector (ix * Spacing, 3000.0, ix * Spacing));
+   }
+
+   const Handle Far (_create (FarPosition));
+
+   test.validate (_count == ObjectCount, "Created grid test objects.");
+
+   const Sphere Ground (ClusterOrigin + Vector (50.0, 0.0, 50.0), 30.0);
+   Int32 count (0);
+
+   test.validate (
+      _find (Ground, count),
+      "Found objects are sorted and contained in the search volume.");
+
+   test.validate (
+      (count > 0) && (count == _count_inside (Ground)),
+      "Found every object in a dense area.");
+
+   const Sphere Air (ClusterOrigin + Vector (0.0, 3000.0, 0.0), 40.0);
+
+   test.validate (
+      _find (Air, count) && (count == _count_inside (Air)) && (count < AirCount),
+      "Found airborne objects above a dense area.");
+
+   HandleContainer found;
+   _grid->find_objects (Ground, found, 0, 0, False);
+
+   test.validate (
+      found.get_count () == _count_inside (Ground),
+      "Found every object in a dense area without sorting.");
+
+   found.clear ();
+   _grid->find_objects (Sphere (FarPosition, 10.0), found);
+
+   test.validate (
+      (found.get_count () == 1) && found.contains (Far),
+      "Found object far outside of the populated area.");
+}
+
+
+void
+dmz::ObjectModuleGridTest::_test_find_nearest_objects () {
+
+   const Vector Origin (ClusterOrigin + Vector (52.0, 1.0, 47.0));
+   const Int32 Nearest (7);
+
+   HandleContainer found;
+   _grid->find_nearest_objects (Origin, Nearest, 100.0, found);
+
+   Boolean sorted (True);
+   Float64 last (0.0);
+   Int32 closer (0);
+
+   HandleContainerIterator it;
+   Handle obj (0);
+
+   while (found.get_next (it, obj)) {
+
+      Vector pos;
+      _objMod->lookup_position (obj, _defaultHandle, pos);
+      const Float64 Distance ((pos - Origin).magnitude_squared ());
+      if (Distance < last) { sorted = False; }
+      last = Distance;
+   }
+
+   for (Int32 ix = 0; ix < _count; ix++) {
+
+      if ((_positions[ix] - Origin).magnitude_squared () < last) { closer++; }
+   }
+
+   test.validate (
+      (found.get_count () == Nearest) && sorted && (closer < Nearest),
+      "Found the nearest objects in order.");
+
+   found.clear ();
+   _grid->find_nearest_objects (Origin, Nearest, 3.0, found);
+
+   test.validate (
+      found.get_count () == _count_inside (Sphere (Origin, 3.0)),
+      "Nearest objects limited by radius.");
+
+   found.clear ();
+   _grid->find_nearest_objects (FarPosition + Vector (0.0, 0.0, 100.0), 3, 1000.0, found);
+
+   test.validate (
+      (found.get_count () == 1) && found.contains (_objects[_count - 1]),
+      "Nearest objects limited by available objects.");
+
+   found.clear ();
+   _grid->find_nearest_objects (Origin, 0, 100.0, found);
+
+   test.validate (found.get_count () == 0, "No objects found when count is zero.");
+}
+
+
+void
+dmz::ObjectModuleGridTest::_test_observer () {
+
+   _volume.set_origin (ClusterOrigin);
+   _volume.set_radius (20.0);
+
+   const Int32 Expected (_count_inside (_volume));
+
+   test.validate (
+      _grid->register_object_observer_grid (*this) &&
+         (_enterCount == Expected) && (_inside.get_count () == Expected),
+      "Observer notified of objects inside its volume.");
+
+   Int32 inside (-1);
+
+   for (Int32 ix = 0; (inside < 0) && (ix < _count); ix++) {
+
+      if (_volume.contains_point (_positions[ix])) { inside = ix; }
+   }
+
+   _enterCount = _exitCount = 0;
+   _move (inside, Vector (-2000000.0, 0.0, 0.0));
+
+   test.validate (
+      (_exitCount == 1) && !_inside.contains (_objects[inside]),
+      "Observer notified of object leaving its volume.");
+
+   _move (inside, ClusterOrigin);
+
+   test.validate (
+      (_enterCount == 1) && _inside.contains (_objects[inside]),
+      "Observer notified of object entering its volume.");
+
+   _volume.set_origin (FarPosition);
+   _enterCount = _exitCount = 0;
+   _grid->update_object_observer_grid (*this);
+
+   test.validate (
+      (_exitCount == Expected) && (_enterCount == 1) && (_inside.get_count () == 1),
+      "Observer notified when its volume moves.");
+
+   _grid->release_object_observer_grid (*this);
+   _inside.clear ();
+}
+
+
+void
+dmz::ObjectModuleGridTest::_test_rebalance () {
+
+   const Sphere Ground (ClusterOrigin + Vector (50.0, 0.0, 50.0), 30.0);
+   const Int32 ClusterCount (ClusterSide * ClusterSide);
+
+   for (Int32 ix = 0; ix < ClusterCount; ix += 2) {
+
+      _move (ix, _positions[ix] + Vector (0.0, 0.0, 20000.0));
+   }
+
+   Int32 count (0);
+
+   test.validate (
+      _find (Ground, count) && (count == _count_inside (Ground)),
+      "Found objects after half of a dense area moved away.");
+
+   for (Int32 ix = 1; ix < ClusterCount; ix += 2) {
+
+      _objMod->destroy_object (_objects[ix]);
+      _objects[ix] = 0;
+   }
+
+   test.validate (
+      _find (Ground, count) && (count == 0) && (_count_inside (Ground) == 0),
+      "Found no objects after a dense area was emptied.");
+
+   const Sphere Everything (Vector (0.0, 0.0, 0.0), 100000000.0);
+
+   test.validate (
+      _find (Everything, count) && (count == _count_inside (Everything)),
+      "Found all remaining objects.");
+
+   for (Int32 ix = 0; ix < _count; ix++) {
+
+      if (_objects[ix]) { _objMod->destroy_object (_objects[ix]); _objects[ix] = 0; }
+   }
+
+   test.validate (
+      _find (Everything, count) && (count == 0),
+      "No objects found after all objects destroyed.");
+}
+
+
+extern "C" {
+
+DMZ_PLUGIN_FACTORY_LINK_SYMBOL dmz::Plugin *
+create_dmzObjectModuleGridTest (
+      const dmz::PluginInfo &Info,
+      dmz::Config &local,
+      dmz::Config &global) {
+
+   return new dmz::ObjectModuleGridTest (Info, local, global);
+}
+
+};
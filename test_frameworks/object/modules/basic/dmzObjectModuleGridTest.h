@@ -0,0 +1,78 @@
+#ifndef DMZ_OBJECT_MODULE_GRID_TEST_DOT_H
+#define DMZ_OBJECT_MODULE_GRID_TEST_DOT_H
+
+#include <dmzObjectObserverGrid.h>
+#include <dmzObjectObserverUtil.h>
+#include <dmzRuntimeObjectType.h>
+#include <dmzRuntimePlugin.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzTestPluginUtil.h>
+#include <dmzTypesHandleContainer.h>
+#include <dmzTypesSphere.h>
+#include <dmzTypesVector.h>
+
+namespace dmz {
+
+   class Config;
+   class ObjectModule;
+   class ObjectModuleGrid;
+
+   class ObjectModuleGridTest :
+      public Plugin,
+      public TimeSlice,
+      public ObjectObserverGrid,
+      protected ObjectObserverUtil {
+
+      public:
+         ObjectModuleGridTest (
+            const PluginInfo &Info,
+            Config &local,
+            Config &global);
+         ~ObjectModuleGridTest ();
+
+         // Plugin Interface
+         virtual void update_plugin_state (
+            const PluginStateEnum State,
+            const UInt32 Level) {;}
+
+         virtual void discover_plugin (
+            const PluginDiscoverEnum Mode,
+            const Plugin *PluginPtr);
+
+         void update_time_slice (const Float64 TimeDelta);
+
+         // ObjectObserverGrid Interface
+         virtual const Volume &get_observer_volume () { return _volume; }
+
+         virtual void update_object_grid_state (
+            const ObjectGridStateEnum State,
+            const Handle ObjectHandle,
+            const ObjectType &Type,
+            const Vector &Position);
+
+      protected:
+         Handle _create (const Vector &Pos);
+         void _move (const Int32 Index, const Vector &Pos);
+         Int32 _count_inside (const Sphere &Space);
+         Boolean _find (const Sphere &Space, Int32 &count);
+         void _test_find_objects ();
+         void _test_find_nearest_objects ();
+         void _test_observer ();
+         void _test_rebalance ();
+
+         TestPluginUtil test;
+         ObjectType _type;
+         ObjectModule *_objMod;
+         ObjectModuleGrid *_grid;
+         Handle _defaultHandle;
+         Int32 _count;
+         Handle *_objects;
+         Vector *_positions;
+         Sphere _volume;
+         HandleContainer _inside;
+         Int32 _enterCount;
+         Int32 _exitCount;
+   };
+};
+
+#endif // DMZ_OBJECT_MODULE_GRID_TEST_DOT_H
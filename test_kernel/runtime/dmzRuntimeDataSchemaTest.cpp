@@ -0,0 +1,161 @@
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeConfigWrite.h>
+#include <dmzRuntimeData.h>
+#include <dmzRuntimeDataSchema.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimeInit.h>
+#include <dmzSystem.h>
+#include <dmzTest.h>
+
+#include <stddef.h> // for offsetof
+#include <string.h> // for memcpy
+
+using namespace dmz;
+
+namespace {
+
+struct InputStruct {
+
+   Float64 axis[2];
+   UInt32 buttons;
+   Float32 scale;
+   Int64 time;
+};
+
+};
+
+
+int
+main (int argc, char *argv[]) {
+
+   Test test ("dmzRuntimeDataSchemaTest", argc, argv);
+   RuntimeContext *context (test.rt.get_context ());
+
+   Definitions defs (context, &(test.log));
+
+   const Int32 AxisOffset (offsetof (InputStruct, axis));
+   const Int32 ButtonsOffset (offsetof (InputStruct, buttons));
+   const Int32 ScaleOffset (offsetof (InputStruct, scale));
+   const Int32 TimeOffset (offsetof (InputStruct, time));
+
+   DataSchema schema (context, &(test.log));
+
+   test.validate (
+      "Adding fields with struct offsets",
+      (schema.add_field ("axis", BaseTypeFloat64, 2, AxisOffset) == 0) &&
+      (schema.add_field ("buttons", BaseTypeUInt32, 1, ButtonsOffset) == 1) &&
+      (schema.add_field ("scale", BaseTypeFloat32, 1, ScaleOffset) == 2) &&
+      (schema.add_field ("time", BaseTypeInt64, 1, TimeOffset) == 3));
+
+   test.validate (
+      "Rejecting invalid fields",
+      (schema.add_field ("axis", BaseTypeFloat64) < 0) &&
+      (schema.add_field ("name", BaseTypeString) < 0) &&
+      (schema.add_field ("bad", BaseTypeFloat64, 0) < 0) &&
+      (schema.add_field ("misaligned", BaseTypeFloat64, 1, 3) < 0) &&
+      (schema.get_field_count () == 4));
+
+   test.validate (
+      "Looking up fields",
+      (schema.lookup_field ("scale") == 2) &&
+      (schema.lookup_field ("unknown") == -1) &&
+      (schema.get_field_handle (0) == defs.lookup_named_handle ("axis")) &&
+      (schema.get_field_type (1) == BaseTypeUInt32) &&
+      (schema.get_field_element_count (0) == 2) &&
+      (schema.get_field_offset (3) == TimeOffset) &&
+      (schema.get_size () == Int32 (TimeOffset + sizeof (Int64))));
+
+   InputStruct input;
+   input.axis[0] = 0.5;
+   input.axis[1] = -0.25;
+   input.buttons = 5;
+   input.scale = 2.0f;
+   input.time = 1234567890123ll;
+
+   Data data;
+
+   test.validate ("Writing layout to Data", schema.write_data (&input, data));
+
+   Float64 axis (0.0);
+   UInt32 buttons (0);
+   Float32 scale (0.0f);
+   Int64 time (0);
+
+   test.validate (
+      "Data written from layout is readable by name",
+      data.lookup_float64 (defs.lookup_named_handle ("axis"), 1, axis) &&
+         (axis == -0.25) &&
+         data.lookup_uint32 (defs.lookup_named_handle ("buttons"), 0, buttons) &&
+         (buttons == 5) &&
+         data.lookup_float32 (defs.lookup_named_handle ("scale"), 0, scale) &&
+         (scale == 2.0f) &&
+         data.lookup_int64 (defs.lookup_named_handle ("time"), 0, time) &&
+         (time == 1234567890123ll) &&
+         (data.get_attribute_count () == 4));
+
+   InputStruct output = { { 0.0, 0.0 }, 0, 0.0f, 0 };
+
+   test.validate (
+      "Reading Data in to layout",
+      schema.read_data (data, &output) &&
+         (output.axis[0] == 0.5) && (output.axis[1] == -0.25) &&
+         (output.buttons == 5) && (output.scale == 2.0f) &&
+         (output.time == 1234567890123ll));
+
+   Data converted;
+   converted.store_int32 (defs.lookup_named_handle ("axis"), 0, 3);
+   converted.store_int32 (defs.lookup_named_handle ("axis"), 1, -4);
+   converted.store_string (defs.lookup_named_handle ("buttons"), 0, "7");
+   converted.store_float64 (defs.lookup_named_handle ("scale"), 0, 1.5);
+
+   test.validate (
+      "Reading converts attributes of other types",
+      schema.read_field (0, converted, &output) &&
+         (output.axis[0] == 3.0) && (output.axis[1] == -4.0) &&
+         schema.read_field (1, converted, &output) && (output.buttons == 7) &&
+         schema.read_field (2, converted, &output) && (output.scale == 1.5f));
+
+   test.validate (
+      "Reading fails when a field is missing",
+      !schema.read_data (converted, &output));
+
+   Config schemaConfig ("schema");
+   Config field ("field");
+   field.store_attribute ("name", "position");
+   field.store_attribute ("type", "float64");
+   field.store_attribute ("count", "3");
+   schemaConfig.add_config (field);
+   Config flag ("field");
+   flag.store_attribute ("name", "active");
+   flag.store_attribute ("type", "boolean");
+   schemaConfig.add_config (flag);
+
+   DataSchema configSchema (context, &(test.log));
+
+   test.validate (
+      "Adding fields from Config",
+      configSchema.add_fields (schemaConfig) &&
+         (configSchema.get_field_count () == 2) &&
+         (configSchema.get_field_offset (1) == 24) &&
+         (configSchema.get_size () == 28));
+
+   char buffer[28];
+   Float64 position[3] = { 1.0, 2.0, 3.0 };
+   UInt32 active (1);
+   memcpy (buffer, position, sizeof (position));
+   memcpy (buffer + 24, &active, sizeof (active));
+
+   Data configData;
+   Boolean activeValue (False);
+
+   test.validate (
+      "Writing layout defined in Config",
+      configSchema.write_data (buffer, configData) &&
+         configData.lookup_boolean (
+            defs.lookup_named_handle ("active"), 0, activeValue) &&
+         activeValue &&
+         (configData.lookup_attribute_element_count (
+            defs.lookup_named_handle ("position")) == 3));
+
+   return test.result ();
+}
@@ -1,6 +1,7 @@
 #include <dmzRuntimeData.h>
 #include <dmzRuntimeDefinitions.h>
 #include <dmzRuntimeInit.h>
+#include <dmzRuntimeIterator.h>
 #include <dmzSystem.h>
 #include <dmzTest.h>
 
@@ -130,5 +131,132 @@ main (int argc, char *argv[]) {
       "Returned Float64 contains correct value",
       TestFloat64Value == float64Value);
 
+   Data copy (data);
+
+   test.validate (
+      "Copied data is equal to the original",
+      (copy == data) && (copy.get_attribute_count () == data.get_attribute_count ()));
+
+   test.validate (
+      "Storing new values in the copy",
+      copy.store_string (StringHandle, 0, "Copy Value") &&
+         copy.store_int32 (Int32Handle, 0, 42));
+
+   test.validate (
+      "Changing the copy does not change the original",
+      data.lookup_string (StringHandle, 0, stringValue) &&
+         (stringValue == TestStringValue) &&
+         data.lookup_int32 (Int32Handle, 0, int32Value) &&
+         (int32Value == TestInt32Value) &&
+         (copy != data));
+
+   test.validate (
+      "Copy contains the new values",
+      copy.lookup_string (StringHandle, 0, stringValue) &&
+         (stringValue == "Copy Value") &&
+         copy.lookup_int32 (Int32Handle, 0, int32Value) &&
+         (int32Value == 42));
+
+   Data assigned;
+   assigned = copy;
+   copy.clear ();
+
+   test.validate (
+      "Clearing a copy does not clear the assigned data",
+      !copy && (assigned.get_attribute_count () == data.get_attribute_count ()) &&
+         assigned.lookup_string (StringHandle, 0, stringValue) &&
+         (stringValue == "Copy Value"));
+
+   test.validate (
+      "Storing string elements out of order",
+      assigned.store_string (StringHandle, 3, "Three") &&
+         (assigned.lookup_attribute_element_count (StringHandle) == 4) &&
+         assigned.lookup_string (StringHandle, 1, stringValue) &&
+         (stringValue == "") &&
+         assigned.lookup_string (StringHandle, 3, stringValue) &&
+         (stringValue == "Three") &&
+         !assigned.lookup_string (StringHandle, 4, stringValue));
+
+   const Handle VectorHandle (defs.create_named_handle ("vector"));
+   const Handle MatrixHandle (defs.create_named_handle ("matrix"));
+   const Handle MaskHandle (defs.create_named_handle ("mask"));
+
+   const Vector TestVector (1.0, 2.0, 3.0);
+   const Matrix TestMatrix (Vector (0.0, 1.0, 0.0), 0.5);
+   Mask testMask;
+   testMask.set_bit (3);
+   testMask.set_bit (70);
+
+   Vector vectorValue;
+   Matrix matrixValue;
+   Mask maskValue;
+
+   test.validate (
+      "Storing and looking up Vectors",
+      data.store_vector (VectorHandle, 0, TestVector) &&
+         data.store_vector (VectorHandle, 5, -TestVector) &&
+         data.lookup_vector (VectorHandle, 0, vectorValue) &&
+         (vectorValue == TestVector) &&
+         data.lookup_vector (VectorHandle, 5, vectorValue) &&
+         (vectorValue == -TestVector) &&
+         data.lookup_vector (VectorHandle, 3, vectorValue) &&
+         vectorValue.is_zero () &&
+         (data.lookup_attribute_element_count (VectorHandle) == 18));
+
+   test.validate (
+      "Storing and looking up Matrix",
+      data.store_matrix (MatrixHandle, 1, TestMatrix) &&
+         data.lookup_matrix (MatrixHandle, 1, matrixValue) &&
+         (matrixValue == TestMatrix));
+
+   test.validate (
+      "Storing and looking up Mask",
+      data.store_mask (MaskHandle, testMask) &&
+         data.lookup_mask (MaskHandle, maskValue) &&
+         (maskValue == testMask));
+
+   Data many;
+   const Int32 ManyCount (40);
+
+   for (Int32 ix = 0; ix < ManyCount; ix++) {
+
+      many.store_int32 (ix + 1000, 0, ix);
+      many.store_string (ix + 2000, 0, String::number (ix));
+   }
+
+   Boolean manyFound (many.get_attribute_count () == (ManyCount * 2));
+
+   for (Int32 ix = 0; manyFound && (ix < ManyCount); ix++) {
+
+      manyFound = many.lookup_int32 (ix + 1000, 0, int32Value) && (int32Value == ix) &&
+         many.lookup_string (ix + 2000, 0, stringValue) &&
+         (stringValue == String::number (ix));
+   }
+
+   test.validate ("Storing and looking up many attributes", manyFound);
+
+   RuntimeIterator it;
+   Int32 iterCount (0);
+
+   for (
+         Handle handle = many.get_first_attribute (it);
+         handle;
+         handle = many.get_next_attribute (it)) { iterCount++; }
+
+   test.validate ("Iterating over all attributes", iterCount == (ManyCount * 2));
+
+   Data manyCopy (many);
+   manyCopy.store_int32 (1000, 0, -1);
+
+   test.validate (
+      "Changing a copy with many attributes",
+      many.lookup_int32 (1000, 0, int32Value) && (int32Value == 0) &&
+         manyCopy.lookup_int32 (1000, 0, int32Value) && (int32Value == -1) &&
+         manyCopy.lookup_string (2039, 0, stringValue) && (stringValue == "39"));
+
+   manyCopy.store_int32 (1000, 0, 0);
+
+   test.validate ("Restored copy is equal to the original", manyCopy == many);
+
    return test.result ();
 }
@@ -290,5 +290,95 @@ main (int argc, char *argv[]) {
    // </validate child iterator functions>
    // ============================================================================ //
 
+   // <validate type hierarchy tests>
+
+   const Int32 Depth (32);
+   Config deepConfig ("runtime");
+   String parentName (CatName);
+
+   for (Int32 ix = 0; ix < Depth; ix++) {
+
+      const String Name (String ("deep") + String::number (ix));
+      Config typeConfig ("event-type");
+      typeConfig.store_attribute ("name", Name);
+      typeConfig.store_attribute ("parent", parentName);
+      deepConfig.add_config (typeConfig);
+      parentName = Name;
+   }
+
+   runtime_init (deepConfig, context, &(test.log));
+
+   EventType deepest (parentName, context);
+   EventType middle ("deep15", context);
+   EventType upper ("deep14", context);
+
+   test.validate (
+      "test is_of_type on a deep hierarchy",
+      deepest && middle && upper &&
+      deepest.is_of_type (anotherCat) &&
+      deepest.is_of_type (middle) &&
+      deepest.is_of_type (deepest) &&
+      middle.is_of_type (upper) &&
+      !upper.is_of_type (middle) &&
+      !middle.is_of_type (deepest) &&
+      !deepest.is_of_type (anotherCaracal) &&
+      !anotherCaracal.is_of_type (middle));
+
+   EventTypeSet typeSet;
+   typeSet.add_event_type (middle);
+   typeSet.add_event_type (anotherCaracal);
+
+   test.validate (
+      "test EventTypeSet contains_type",
+      typeSet.contains_type (deepest) &&
+      typeSet.contains_type (middle) &&
+      typeSet.contains_type (anotherCaracal) &&
+      !typeSet.contains_type (aServal) &&
+      !typeSet.contains_type (anotherCat) &&
+      !typeSet.contains_type (upper) &&
+      !typeSet.contains_type (shouldBeNothing));
+
+   Config leafConfig ("runtime");
+   Config leafType ("event-type");
+   leafType.store_attribute ("name", "deepLeaf");
+   leafType.store_attribute ("parent", "deep20");
+   leafConfig.add_config (leafType);
+   Config kittenType ("event-type");
+   kittenType.store_attribute ("name", "kitten");
+   kittenType.store_attribute ("parent", CaracalName);
+   leafConfig.add_config (kittenType);
+
+   runtime_init (leafConfig, context, &(test.log));
+
+   EventType leaf ("deepLeaf", context);
+   EventType kitten ("kitten", context);
+
+   test.validate (
+      "test is_of_type after defining new types",
+      leaf && kitten &&
+      leaf.is_of_type (middle) &&
+      !leaf.is_of_type (deepest) &&
+      !deepest.is_of_type (leaf) &&
+      kitten.is_of_type (anotherCat) &&
+      !kitten.is_of_type (aServal) &&
+      deepest.is_of_type (upper));
+
+   test.validate (
+      "test EventTypeSet contains_type after defining new types",
+      typeSet.contains_type (leaf) &&
+      typeSet.contains_type (kitten) &&
+      typeSet.contains_type (deepest));
+
+   typeSet.remove_event_type (middle);
+
+   test.validate (
+      "test EventTypeSet contains_type after removing a type",
+      !typeSet.contains_type (leaf) &&
+      !typeSet.contains_type (deepest) &&
+      typeSet.contains_type (kitten));
+
+   // </validate type hierarchy tests>
+   // ============================================================================ //
+
    return test.result ();
 }
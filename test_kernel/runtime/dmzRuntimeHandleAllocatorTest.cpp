@@ -0,0 +1,90 @@
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimeHandle.h>
+#include <dmzRuntimeHandleAllocator.h>
+#include <dmzTest.h>
+
+using namespace dmz;
+
+int
+main (int argc, char *argv[]) {
+
+   Test test ("dmzRuntimeHandleAllocatorTest", argc, argv);
+
+   HandleAllocator *allocator (new HandleAllocator (1, 1, 100));
+
+   const Handle Named (allocator->get_next_handle ("Named"));
+   const Handle Anonymous (allocator->get_next_handle ());
+
+   test.validate (
+      "Allocating named and anonymous handles",
+      (Named == 1) && (Anonymous == 2) &&
+      (allocator->lookup_info (Named) == "Named") &&
+      (allocator->lookup_info (Anonymous) == "Anonymous.2"));
+
+   Handle block[10];
+
+   for (Int32 ix = 0; ix < 10; ix++) { block[ix] = allocator->get_next_handle (); }
+
+   test.validate (
+      "Allocating many anonymous handles",
+      (block[0] == 3) && (block[9] == 12) &&
+      (allocator->lookup_info (block[5]) == "Anonymous.8"));
+
+   test.validate (
+      "Requesting an allocated handle returns a new handle",
+      (allocator->request_handle (Named, "Again") == 13) &&
+      (allocator->request_handle (50) == 50) &&
+      (allocator->request_handle (500) == 14));
+
+   test.validate (
+      "Releasing anonymous and named handles",
+      allocator->release_handle (Anonymous) &&
+      allocator->release_handle (Named) &&
+      !allocator->release_handle (Anonymous) &&
+      !allocator->lookup_info (Anonymous));
+
+   HandleAllocator *wrap (new HandleAllocator (4, 1, 5));
+
+   test.validate (
+      "Released handles are reused when the allocator wraps",
+      (wrap->get_next_handle () == 4) &&
+      (wrap->get_next_handle () == 5) &&
+      (wrap->get_next_handle () == 1) &&
+      wrap->release_handle (4) &&
+      (wrap->get_next_handle () == 2) &&
+      (wrap->get_next_handle () == 3) &&
+      (wrap->get_next_handle () == 4));
+
+   test.validate ("Full allocator returns zero", !wrap->get_next_handle ());
+
+   wrap->unref (); wrap = 0;
+
+   RuntimeContext *context (test.rt.get_context ());
+
+   RuntimeHandle *named (new RuntimeHandle ("Named.Runtime.Handle", context));
+   RuntimeHandle *anonymous (new RuntimeHandle (context));
+
+   Definitions defs (context);
+
+   test.validate (
+      "Anonymous runtime handle is unique",
+      anonymous->get_runtime_handle () &&
+      (anonymous->get_runtime_handle () != named->get_runtime_handle ()) &&
+      (named->get_handle_info () == "Named.Runtime.Handle") &&
+      (anonymous->get_handle_info () ==
+         defs.lookup_runtime_name (anonymous->get_runtime_handle ())));
+
+   delete named; named = 0;
+   delete anonymous; anonymous = 0;
+
+   RuntimeHandle local (allocator);
+
+   test.validate (
+      "Anonymous handle from an allocator",
+      (local.get_runtime_handle () == 15) &&
+      (local.get_handle_info () == "Anonymous.15"));
+
+   allocator->unref (); allocator = 0;
+
+   return test.result ();
+}
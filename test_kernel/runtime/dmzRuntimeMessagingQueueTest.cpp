@@ -0,0 +1,278 @@
+#include <dmzRuntimeConfig.h>
+#include <dmzRuntimeData.h>
+#include <dmzRuntimeDefinitions.h>
+#include <dmzRuntimeInit.h>
+#include <dmzRuntimeLog.h>
+#include <dmzRuntimeMessaging.h>
+#include <dmzSystem.h>
+#include <dmzSystemSpinLock.h>
+#include <dmzSystemThread.h>
+#include <dmzTest.h>
+#include <dmzTypesBase.h>
+
+using namespace dmz;
+
+static const Int32 ProducerCount (8);
+static const UInt32 MessageCount (20000);
+
+class producer : public ThreadFunction {
+
+   public:
+      const Message Type;
+      const Handle ThreadHandle;
+      const Handle SequenceHandle;
+      const UInt32 Id;
+      const UInt32 Count;
+      SpinLock lock;
+      Boolean done;
+
+      producer (
+            const Message &TheType,
+            const Handle TheThreadHandle,
+            const Handle TheSequenceHandle,
+            const UInt32 TheId,
+            const UInt32 TheCount) :
+            Type (TheType),
+            ThreadHandle (TheThreadHandle),
+            SequenceHandle (TheSequenceHandle),
+            Id (TheId),
+            Count (TheCount),
+            done (False) {;}
+
+      Boolean is_done () {
+
+         lock.lock (); const Boolean Result (done); lock.unlock ();
+         return Result;
+      }
+
+      virtual void run_thread_function () {
+
+         Data data;
+
+         for (UInt32 ix = 0; ix < Count; ix++) {
+
+            data.store_uint32 (ThreadHandle, 0, Id);
+            data.store_uint32 (SequenceHandle, 0, ix);
+            Type.send (&data);
+         }
+
+         lock.lock (); done = True; lock.unlock ();
+      }
+};
+
+
+class consumer : public MessageObserver {
+
+   public:
+      const Handle ThreadHandle;
+      const Handle SequenceHandle;
+      UInt32 received;
+      UInt32 outOfOrder;
+      UInt32 badData;
+      Int32 last[ProducerCount];
+
+      consumer (
+            const Handle TheThreadHandle,
+            const Handle TheSequenceHandle,
+            RuntimeContext *context) :
+            MessageObserver (0, "consumer", context),
+            ThreadHandle (TheThreadHandle),
+            SequenceHandle (TheSequenceHandle),
+            received (0),
+            outOfOrder (0),
+            badData (0) { reset (); }
+
+      void reset () {
+
+         received = outOfOrder = badData = 0;
+         for (Int32 ix = 0; ix < ProducerCount; ix++) { last[ix] = -1; }
+      }
+
+      virtual void receive_message (
+            const Message &Type,
+            const UInt32 MessageSendHandle,
+            const Handle TargetObserverHandle,
+            const Data *InData,
+            Data *outData) {
+
+         UInt32 id (0), seq (0);
+
+         if (InData &&
+               InData->lookup_uint32 (ThreadHandle, 0, id) &&
+               InData->lookup_uint32 (SequenceHandle, 0, seq) &&
+               (id < UInt32 (ProducerCount))) {
+
+            if (Int32 (seq) <= last[id]) { outOfOrder++; }
+            last[id] = Int32 (seq);
+            received++;
+         }
+         else { badData++; }
+      }
+};
+
+
+class dropLog : public LogObserver {
+
+   public:
+      UInt32 warnings;
+
+      dropLog (RuntimeContext *context) : LogObserver (context), warnings (0) {;}
+
+      virtual void store_log_message (
+            const String &LogName,
+            const LogLevelEnum Level,
+            const String &Message) {
+
+         Int32 index (0);
+
+         if ((Level == LogLevelWarn) &&
+               Message.find_sub ("Delayed message queue is full", index)) {
+
+            warnings++;
+         }
+      }
+};
+
+
+static Boolean
+run_producers (
+      Test &test,
+      const Message &Type,
+      const Handle ThreadHandle,
+      const Handle SequenceHandle,
+      const Boolean Drain) {
+
+   producer *list[ProducerCount];
+
+   for (Int32 ix = 0; ix < ProducerCount; ix++) {
+
+      list[ix] = new producer (
+         Type, ThreadHandle, SequenceHandle, UInt32 (ix), MessageCount);
+   }
+
+   Boolean result (True);
+
+   for (Int32 ix = 0; ix < ProducerCount; ix++) {
+
+      if (!create_thread (*(list[ix]))) { result = False; list[ix]->done = True; }
+   }
+
+   Boolean running (True);
+
+   while (running) {
+
+      if (Drain) { test.rt.update_time_slice (); }
+      else { sleep (0.001); }
+
+      running = False;
+
+      for (Int32 ix = 0; ix < ProducerCount; ix++) {
+
+         if (!list[ix]->is_done ()) { running = True; }
+      }
+   }
+
+   test.rt.update_time_slice ();
+
+   // Give the threads a chance to return from run_thread_function.
+   sleep (0.05);
+
+   for (Int32 ix = 0; ix < ProducerCount; ix++) { delete list[ix]; list[ix] = 0; }
+
+   return result;
+}
+
+
+int
+main (int argc, char *argv[]) {
+
+   Test test ("dmzRuntimeMessagingQueueTest", argc, argv);
+
+   RuntimeContext *context (test.rt.get_context ());
+
+   Definitions defs (context);
+
+   Message type;
+   defs.create_message ("Queue_Test_Message", type);
+   const Handle ThreadHandle (defs.create_named_handle ("thread"));
+   const Handle SequenceHandle (defs.create_named_handle ("sequence"));
+
+   consumer obs (ThreadHandle, SequenceHandle, context);
+   obs.subscribe_to_message (type);
+
+   dropLog logObs (context);
+   logObs.attach_log_observer ();
+
+   const UInt32 Total (UInt32 (ProducerCount) * MessageCount);
+
+   MessageQueueStats start;
+
+   test.validate (
+      "Message queue stats found",
+      get_message_queue_stats (context, start) && (start.size > 0));
+
+   test.validate (
+      "Producer threads created",
+      run_producers (test, type, ThreadHandle, SequenceHandle, True));
+
+   MessageQueueStats stats;
+   get_message_queue_stats (context, stats);
+
+   test.validate (
+      "All delayed messages either received or dropped",
+      (UInt64 (obs.received) + stats.dropped) == UInt64 (Total));
+
+   test.validate (
+      "Delayed messages received in order per thread",
+      (obs.outOfOrder == 0) && (obs.badData == 0));
+
+   test.validate ("Sent count matches received count", stats.sent == obs.received);
+   test.validate ("Delayed message queue is empty", stats.count == 0);
+   test.validate ("Peak queue depth recorded", stats.peak > 0);
+   test.validate ("Peak queue depth within queue size", stats.peak <= stats.size);
+
+   Config runtimeConfig ("runtime");
+   Config queueConfig ("message-queue");
+   queueConfig.store_attribute ("size", "16");
+   queueConfig.store_attribute ("retry", "0");
+   runtimeConfig.add_config (queueConfig);
+   runtime_init (runtimeConfig, context, &(test.log));
+
+   get_message_queue_stats (context, start);
+
+   test.validate ("Message queue resized from runtime config", start.size == 16);
+
+   obs.reset ();
+
+   test.validate (
+      "Producer threads created without draining queue",
+      run_producers (test, type, ThreadHandle, SequenceHandle, False));
+
+   get_message_queue_stats (context, stats);
+
+   const UInt64 Dropped (stats.dropped - start.dropped);
+
+   test.validate ("Only queue size messages received", obs.received == 16);
+
+   test.validate (
+      "Messages dropped when queue is full",
+      (UInt64 (obs.received) + Dropped) == UInt64 (Total));
+
+   test.validate ("Back pressure counted", stats.full > start.full);
+
+   test.rt.update_time_slice ();
+
+   test.validate (
+      "First dropped message logged once",
+      (Dropped > 1) && (logObs.warnings == 1));
+
+   test.validate ("Peak queue depth reached resized queue size", stats.peak >= 16);
+
+   test.validate (
+      "Messages received in order when queue is full",
+      (obs.outOfOrder == 0) && (obs.badData == 0));
+
+   logObs.detach_log_observer ();
+
+   return test.result ();
+}
@@ -0,0 +1,236 @@
+#include <dmzRuntimeTime.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzTest.h>
+#include <dmzTypesBase.h>
+#include <dmzTypesMath.h>
+
+using namespace dmz;
+
+static const Int32 FrameCount (50);
+
+// All times are powers of two so that the fake clock accumulates them exactly.
+static const Float64 Frequency (64.0);
+static const Float64 FrameLength (1.0 / Frequency);
+static const Float64 SpinTime (1.0 / 1024.0);
+static const Float64 YieldStep (1.0 / 16384.0);
+static const Float64 MaxSpinWindow (0.005);
+
+class fakeClock : public FrameClock {
+
+   public:
+      Float64 now;
+      Float64 oversleep;
+      UInt32 sleepCount;
+      UInt32 yieldCount;
+
+      fakeClock () : now (1.0), oversleep (0.0), sleepCount (0), yieldCount (0) {;}
+
+      void reset_counts () { sleepCount = yieldCount = 0; }
+
+      virtual Float64 get_frame_clock_time () { return now; }
+
+      virtual void frame_clock_sleep (const Float64 Time) {
+
+         if (Time > 0.0) { now += Time; }
+         now += oversleep;
+         sleepCount++;
+      }
+
+      virtual void frame_clock_yield () { now += YieldStep; yieldCount++; }
+};
+
+
+class loadSlice : public TimeSlice {
+
+   public:
+      fakeClock &clock;
+      Float64 load;
+
+      loadSlice (RuntimeContext *context, fakeClock &theClock) :
+            TimeSlice (0, context),
+            clock (theClock),
+            load (0.0) {;}
+
+      virtual void update_time_slice (const Float64 DeltaTime) { clock.now += load; }
+};
+
+
+static UInt64
+local_histogram_total (const FrameStats &Stats) {
+
+   UInt64 result (0);
+   for (Int32 ix = 0; ix < FrameJitterBucketCount; ix++) {
+
+      result += Stats.jitter[ix];
+   }
+
+   return result;
+}
+
+
+static void
+local_run_frames (Test &test, const Int32 Count) {
+
+   for (Int32 ix = 0; ix < Count; ix++) { test.rt.update_time_slice (); }
+}
+
+
+int
+main (int argc, char *argv[]) {
+
+   Test test ("dmzRuntimeTimePacingTest", argc, argv);
+
+   RuntimeContext *context (test.rt.get_context ());
+
+   Time time (context);
+   fakeClock clock;
+   loadSlice slice (context, clock);
+
+   time.set_frame_clock (&clock);
+
+   test.validate ("Frame clock set", time.get_frame_clock () == &clock);
+
+   time.set_target_frame_frequency (Frequency);
+   time.set_frame_pacing (FramePacingHybrid);
+   time.set_frame_spin_time (SpinTime);
+
+   // The first frame is not measured.
+   local_run_frames (test, FrameCount + 1);
+
+   FrameStats stats;
+   time.get_frame_stats (stats);
+
+   test.validate (
+      "Hybrid frame pacing mode set",
+      (time.get_frame_pacing () == FramePacingHybrid) &&
+         is_zero64 (time.get_frame_spin_time () - SpinTime));
+
+   test.validate ("Frames counted", stats.frames == UInt64 (FrameCount));
+
+   test.validate (
+      "Target period reported",
+      is_zero64 (stats.targetPeriod - FrameLength));
+
+   test.validate (
+      "Hybrid pacing hits the target period with an accurate sleep",
+      (stats.minPeriod == FrameLength) && (stats.maxPeriod == FrameLength) &&
+         (stats.averagePeriod == FrameLength) && (stats.maxJitter == 0.0));
+
+   test.validate ("No overruns without load", stats.overruns == 0);
+
+   test.validate (
+      "Jitter histogram counts every frame in the first bucket",
+      (local_histogram_total (stats) == stats.frames) &&
+         (stats.jitter[0] == stats.frames));
+
+   test.validate (
+      "Busy wait window stays at the spin time with an accurate sleep",
+      stats.spinTime == SpinTime);
+
+   test.validate (
+      "Busy wait yields for the whole spin window",
+      clock.yieldCount == UInt32 ((FrameCount + 1) * (SpinTime / YieldStep)));
+
+   // A sleep that wakes up late grows the window so that the target is still met.
+   time.reset_frame_stats ();
+   clock.reset_counts ();
+   clock.oversleep = 2.0 * SpinTime;
+
+   local_run_frames (test, FrameCount + 1);
+
+   time.get_frame_stats (stats);
+
+   test.validate (
+      "Busy wait window grows when the sleep wakes up late",
+      (stats.spinTime > clock.oversleep) && (stats.spinTime <= MaxSpinWindow));
+
+   test.validate ("No overruns with a late sleep", stats.overruns == 0);
+
+   test.validate (
+      "Late sleep is absorbed by the busy wait after the first frame",
+      (stats.lastPeriod >= FrameLength) &&
+         (stats.lastPeriod < (FrameLength + YieldStep)));
+
+   // The window never grows past the cap however late the sleep is.
+   clock.oversleep = 4.0 * MaxSpinWindow;
+
+   local_run_frames (test, FrameCount + 1);
+
+   time.get_frame_stats (stats);
+
+   test.validate (
+      "Busy wait window is capped",
+      is_zero64 (stats.spinTime - MaxSpinWindow));
+
+   time.set_frame_spin_time (1.0);
+   clock.oversleep = 0.0;
+
+   local_run_frames (test, 1);
+
+   test.validate (
+      "Spin time is capped",
+      is_zero64 (time.get_frame_spin_time () - MaxSpinWindow));
+
+   // A frame that takes longer than the target is counted and not paced.
+   time.set_frame_spin_time (SpinTime);
+   time.reset_frame_stats ();
+   slice.load = 1.5 * FrameLength;
+
+   local_run_frames (test, FrameCount + 1);
+
+   clock.reset_counts ();
+
+   local_run_frames (test, FrameCount);
+
+   time.get_frame_stats (stats);
+
+   test.validate (
+      "Frame stats reset",
+      stats.frames == UInt64 ((FrameCount * 2) + 1));
+
+   // The frame that sets the load is still paced.
+   test.validate ("Overruns counted", stats.overruns == UInt64 (FrameCount * 2));
+
+   test.validate (
+      "Overrun period is the frame load",
+      (stats.maxPeriod == slice.load) && (stats.lastPeriod == slice.load));
+
+   test.validate (
+      "Overrun frames do not wait",
+      (clock.sleepCount == 0) && (clock.yieldCount == 0));
+
+   time.set_frame_pacing (FramePacingSleep);
+   time.reset_frame_stats ();
+   slice.load = 0.0;
+
+   local_run_frames (test, FrameCount + 1);
+
+   clock.reset_counts ();
+
+   local_run_frames (test, FrameCount);
+
+   time.get_frame_stats (stats);
+
+   test.validate (
+      "Sleep frame pacing mode set",
+      (time.get_frame_pacing () == FramePacingSleep) && is_zero64 (stats.spinTime));
+
+   test.validate (
+      "Sleep pacing frames counted",
+      (stats.frames == UInt64 ((FrameCount * 2) + 1)) &&
+         (local_histogram_total (stats) == stats.frames));
+
+   test.validate (
+      "Sleep pacing does not busy wait",
+      (clock.sleepCount == UInt32 (FrameCount)) && (clock.yieldCount == 0));
+
+   test.validate (
+      "Sleep pacing hits the target period with an accurate sleep",
+      stats.lastPeriod == FrameLength);
+
+   time.set_frame_clock (0);
+
+   test.validate ("Frame clock removed", !time.get_frame_clock ());
+
+   return test.result ();
+}
@@ -0,0 +1,187 @@
+#include <dmzRuntimeTime.h>
+#include <dmzRuntimeTimeSlice.h>
+#include <dmzSystem.h>
+#include <dmzSystemSpinLock.h>
+#include <dmzTest.h>
+#include <dmzTypesBase.h>
+
+using namespace dmz;
+
+static const Int32 SliceCount (8);
+static const Handle SharedResource (1);
+
+struct trackerStruct {
+
+   SpinLock lock;
+   Int32 active;
+   Int32 peak;
+   Int32 calls;
+   Int32 sharedActive;
+   Int32 sharedPeak;
+
+   trackerStruct () { reset (); }
+
+   void reset () { active = peak = calls = sharedActive = sharedPeak = 0; }
+
+   Int32 get_calls () {
+
+      lock.lock (); const Int32 Result (calls); lock.unlock ();
+      return Result;
+   }
+};
+
+
+class workSlice : public TimeSlice {
+
+   public:
+      trackerStruct &tracker;
+      Boolean shared;
+
+      workSlice (trackerStruct &theTracker, RuntimeContext *context) :
+            TimeSlice (0, context),
+            tracker (theTracker),
+            shared (False) {;}
+
+      // The slices are allocated with new and deleted through workSlice pointers.
+      virtual ~workSlice () {;}
+
+      virtual void update_time_slice (const Float64 DeltaTime) {
+
+         tracker.lock.lock ();
+         tracker.active++;
+         if (tracker.active > tracker.peak) { tracker.peak = tracker.active; }
+
+         if (shared) {
+
+            tracker.sharedActive++;
+
+            if (tracker.sharedActive > tracker.sharedPeak) {
+
+               tracker.sharedPeak = tracker.sharedActive;
+            }
+         }
+         tracker.lock.unlock ();
+
+         sleep (0.02);
+
+         tracker.lock.lock ();
+         tracker.active--;
+         if (shared) { tracker.sharedActive--; }
+         tracker.calls++;
+         tracker.lock.unlock ();
+      }
+};
+
+
+class barrierSlice : public TimeSlice {
+
+   public:
+      trackerStruct &tracker;
+      Int32 callsSeen;
+
+      barrierSlice (trackerStruct &theTracker, RuntimeContext *context) :
+            TimeSlice (0, context),
+            tracker (theTracker),
+            callsSeen (-1) {;}
+
+      virtual void update_time_slice (const Float64 DeltaTime) {
+
+         callsSeen = tracker.get_calls ();
+      }
+};
+
+
+int
+main (int argc, char *argv[]) {
+
+   Test test ("dmzRuntimeTimeSliceSchedulerTest", argc, argv);
+
+   RuntimeContext *context (test.rt.get_context ());
+
+   trackerStruct tracker;
+   workSlice *list[SliceCount];
+
+   for (Int32 ix = 0; ix < SliceCount; ix++) {
+
+      list[ix] = new workSlice (tracker, context);
+      list[ix]->set_time_slice_thread_safe (True);
+   }
+
+   barrierSlice barrier (tracker, context);
+
+   test.validate (
+      "Time slice flagged as thread safe",
+      list[0]->is_time_slice_thread_safe () && !barrier.is_time_slice_thread_safe ());
+
+   Time time (context);
+
+   test.rt.update_time_slice ();
+
+   test.validate (
+      "Time slices run serially without worker threads",
+      (tracker.calls == SliceCount) && (tracker.peak == 1));
+
+   test.validate (
+      "Barrier time slice invoked after preceding time slices",
+      barrier.callsSeen == SliceCount);
+
+   time.set_time_slice_thread_count (4);
+   tracker.reset ();
+
+   const Float64 StartTime (get_time ());
+   test.rt.update_time_slice ();
+   const Float64 ParallelTime (get_time () - StartTime);
+
+   test.validate (
+      "Worker threads started",
+      time.get_time_slice_thread_count () == 4);
+
+   test.validate (
+      "Thread safe time slices run in parallel",
+      (tracker.calls == SliceCount) && (tracker.peak > 1));
+
+   test.validate (
+      "Parallel frame faster than serial frame",
+      ParallelTime < (Float64 (SliceCount) * 0.02));
+
+   test.validate (
+      "Barrier time slice waits for parallel stage",
+      barrier.callsSeen == SliceCount);
+
+   for (Int32 ix = 0; ix < SliceCount; ix += 2) {
+
+      list[ix]->shared = True;
+      list[ix]->add_time_slice_write (SharedResource);
+   }
+
+   list[1]->add_time_slice_read (SharedResource);
+
+   tracker.reset ();
+   test.rt.update_time_slice ();
+
+   test.validate (
+      "Time slices writing the same resource are not run in parallel",
+      (tracker.calls == SliceCount) && (tracker.sharedPeak == 1));
+
+   for (Int32 ix = 0; ix < SliceCount; ix++) { list[ix]->clear_time_slice_resources (); }
+
+   tracker.reset ();
+   test.rt.update_time_slice ();
+
+   test.validate (
+      "Cleared resources allow parallel stage",
+      (tracker.calls == SliceCount) && (tracker.sharedPeak > 1));
+
+   time.set_time_slice_thread_count (0);
+   tracker.reset ();
+   test.rt.update_time_slice ();
+
+   test.validate (
+      "Worker threads stopped",
+      (time.get_time_slice_thread_count () == 0) &&
+         (tracker.calls == SliceCount) && (tracker.peak == 1));
+
+   for (Int32 ix = 0; ix < SliceCount; ix++) { delete list[ix]; list[ix] = 0; }
+
+   return test.result ();
+}
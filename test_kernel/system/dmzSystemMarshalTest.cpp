@@ -2,6 +2,7 @@
 #include <dmzSystemMarshal.h>
 #include <dmzSystemUnmarshal.h>
 #include <dmzTest.h>
+#include <dmzTypesVector.h>
 
 using namespace dmz;
 
@@ -67,6 +68,114 @@ main (int argc, char *argv[]) {
      (out.get_next_float32 () == V9) &&
      (out.get_next_float64 () == V10));
 
+   const Int32 Count (100);
+   UInt32 uint32Array[Count];
+   Float64 float64Array[Count];
+   Vector vectorArray[Count];
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      uint32Array[ix] = UInt32 (0x01020304 + ix);
+      float64Array[ix] = Float64 (ix) * 1.5;
+      vectorArray[ix].set_xyz (ix, ix + 0.25, ix + 0.5);
+   }
+
+   const ByteOrderEnum Order[2] = { ByteOrderBigEndian, ByteOrderLittleEndian };
+
+   for (Int32 order = 0; order < 2; order++) {
+
+      Marshal arrayIn (Order[order]);
+      arrayIn.set_next_uint32_array (Count, uint32Array);
+      arrayIn.set_next_float64_array (Count, float64Array);
+      arrayIn.set_next_vector_array (Count, vectorArray);
+      arrayIn.set_next_vector32_array (Count, vectorArray);
+      arrayIn.set_next_uint32 (V7);
+
+      const char *Raw (arrayIn.get_buffer ());
+
+      test.validate (
+         "Array data is marshalled in the requested byte order",
+         (Order[order] == ByteOrderBigEndian) ?
+            ((Raw[0] == 0x01) && (Raw[3] == 0x04)) :
+            ((Raw[0] == 0x04) && (Raw[3] == 0x01)));
+
+      Unmarshal arrayOut (Order[order]);
+      arrayOut.set_buffer (arrayIn.get_length (), arrayIn.get_buffer ());
+
+      UInt32 uint32Result[Count];
+      Float64 float64Result[Count];
+      Vector vectorResult[Count];
+      Vector vector32Result[Count];
+
+      Boolean match (
+         arrayOut.get_next_uint32_array (Count, uint32Result) &&
+         arrayOut.get_next_float64_array (Count, float64Result) &&
+         arrayOut.get_next_vector_array (Count, vectorResult) &&
+         arrayOut.get_next_vector32_array (Count, vector32Result));
+
+      for (Int32 ix = 0; match && (ix < Count); ix++) {
+
+         match = (uint32Result[ix] == uint32Array[ix]) &&
+            (float64Result[ix] == float64Array[ix]) &&
+            (vectorResult[ix] == vectorArray[ix]) &&
+            (vector32Result[ix] == vectorArray[ix]);
+      }
+
+      test.validate ("Array data is unmarshalled correctly", match);
+
+      const Int32 Place (arrayOut.get_place ());
+      char *view (arrayOut.get_next_buffer (sizeof (UInt32)));
+
+      test.validate (
+         "Buffer section is returned in place",
+         (view == arrayIn.get_buffer () + Place) &&
+         (arrayOut.get_place () == arrayOut.get_length ()));
+
+      test.validate (
+         "Reading past the end of the buffer fails",
+         !arrayOut.get_next_buffer (1) &&
+         !arrayOut.get_next_uint32_array (1, uint32Result));
+   }
+
+   // Each count wraps to a small size when multiplied by the size of its values.
+   const Int32 HostileUInt32Count (0x40000001);
+   const Int32 HostileVector32Count (0x15555556);
+   const Int32 HostileVectorCount (0x0AAAAAAB);
+
+   Marshal hostileIn (ByteOrderBigEndian);
+   hostileIn.set_next_uint32 (V7);
+   hostileIn.set_next_uint32 (V7);
+
+   const Int32 HostileLength (hostileIn.get_length ());
+
+   hostileIn.set_next_uint32_array (HostileUInt32Count, uint32Array);
+   hostileIn.set_next_vector32_array (HostileVector32Count, vectorArray);
+   hostileIn.set_next_vector_array (HostileVectorCount, vectorArray);
+
+   test.validate (
+      "Arrays with a hostile count are not marshalled",
+      hostileIn.get_length () == HostileLength);
+
+   Unmarshal hostileOut (ByteOrderBigEndian);
+   hostileOut.set_buffer (hostileIn.get_length (), hostileIn.get_buffer ());
+
+   UInt32 uint32Result[Count];
+   Vector vectorResult[Count];
+
+   test.validate (
+      "Arrays with a hostile count are not unmarshalled",
+      !hostileOut.get_next_uint32_array (HostileUInt32Count, uint32Result) &&
+      !hostileOut.get_next_uint32_array (-1, uint32Result) &&
+      !hostileOut.get_next_vector32_array (HostileVector32Count, vectorResult) &&
+      !hostileOut.get_next_vector_array (HostileVectorCount, vectorResult) &&
+      (hostileOut.get_place () == 0));
+
+   hostileOut.get_next_uint32 ();
+
+   test.validate (
+      "Buffer section with a hostile size is not returned",
+      !hostileOut.get_next_buffer (MaxInt32) && (hostileOut.get_place () == 4));
+
    return test.result ();
 }
 
@@ -0,0 +1,243 @@
+#include <dmzSystem.h>
+#include <dmzTypesHashTableHandleTemplate.h>
+#include <dmzTypesHashTableStringTemplate.h>
+#include <dmzTypesString.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace dmz;
+
+namespace {
+
+// Each run is repeated and the fastest time is kept so that the numbers are not
+// dominated by other processes on the machine.
+struct ResultStruct {
+
+   const char *name;
+   Int32 count;
+   Float64 best;
+};
+
+static const Int32 LocalResultCount (11);
+
+static ResultStruct localResults[LocalResultCount] = {
+   { "Handle insert", 0, 0.0 },
+   { "Handle lookup hit", 0, 0.0 },
+   { "Handle lookup hit random", 0, 0.0 },
+   { "Handle lookup miss", 0, 0.0 },
+   { "Handle iterate", 0, 0.0 },
+   { "Handle remove and store", 0, 0.0 },
+   { "Handle remove", 0, 0.0 },
+   { "String insert", 0, 0.0 },
+   { "String lookup hit", 0, 0.0 },
+   { "String iterate", 0, 0.0 },
+   { "String remove and store", 0, 0.0 },
+};
+
+
+static void
+record_result (const Int32 Which, const Int32 Count, const Float64 Time) {
+
+   ResultStruct &result = localResults[Which];
+
+   if (!result.count || (Time < result.best)) { result.best = Time; }
+   result.count = Count;
+}
+
+
+static void
+print_results () {
+
+   for (Int32 ix = 0; ix < LocalResultCount; ix++) {
+
+      const ResultStruct &Result = localResults[ix];
+
+      printf (
+         "%-28s %10.3f ms %10.2f M ops/s\n",
+         Result.name,
+         Result.best * 1000.0,
+         (Result.best > 0.0) ?
+            (Float64 (Result.count) / Result.best) / 1000000.0 : 0.0);
+   }
+}
+
+
+static void
+run_handle_benchmark (const Int32 Count, const Int32 Passes, const Handle *Order) {
+
+   HashTableHandleTemplate<Int32> table;
+   Int32 value (1);
+   Int32 found (0);
+
+   Float64 start (get_time ());
+
+   for (Int32 ix = 1; ix <= Count; ix++) { table.store (Handle (ix), &value); }
+
+   record_result (0, Count, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 pass = 0; pass < Passes; pass++) {
+
+      for (Int32 ix = 1; ix <= Count; ix++) {
+
+         if (table.lookup (Handle (ix))) { found++; }
+      }
+   }
+
+   record_result (1, Count * Passes, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 pass = 0; pass < Passes; pass++) {
+
+      for (Int32 ix = 0; ix < Count; ix++) {
+
+         if (table.lookup (Order[ix])) { found++; }
+      }
+   }
+
+   record_result (2, Count * Passes, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 pass = 0; pass < Passes; pass++) {
+
+      for (Int32 ix = 1; ix <= Count; ix++) {
+
+         if (table.lookup (Handle (ix + Count))) { found++; }
+      }
+   }
+
+   record_result (3, Count * Passes, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 pass = 0; pass < Passes; pass++) {
+
+      HashTableHandleIterator it;
+
+      while (table.get_next (it)) { found++; }
+   }
+
+   record_result (4, Count * Passes, get_time () - start);
+
+   // Remove and store half of the table repeatedly, as objects being created and
+   // destroyed would.
+   start = get_time ();
+
+   for (Int32 pass = 0; pass < Passes; pass++) {
+
+      for (Int32 ix = 1; ix <= Count; ix += 2) { table.remove (Handle (ix)); }
+      for (Int32 ix = 1; ix <= Count; ix += 2) { table.store (Handle (ix), &value); }
+   }
+
+   record_result (5, Count * Passes, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 ix = 1; ix <= Count; ix++) { table.remove (Handle (ix)); }
+
+   record_result (6, Count, get_time () - start);
+
+   if (found < 0) { printf ("%d\n", found); }
+}
+
+
+static void
+run_string_benchmark (const Int32 Count, const Int32 Passes, const String *Keys) {
+
+   HashTableStringTemplate<Int32> table;
+   Int32 value (1);
+   Int32 found (0);
+
+   Float64 start (get_time ());
+
+   for (Int32 ix = 0; ix < Count; ix++) { table.store (Keys[ix], &value); }
+
+   record_result (7, Count, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 pass = 0; pass < Passes; pass++) {
+
+      for (Int32 ix = 0; ix < Count; ix++) {
+
+         if (table.lookup (Keys[ix])) { found++; }
+      }
+   }
+
+   record_result (8, Count * Passes, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 pass = 0; pass < Passes; pass++) {
+
+      HashTableStringIterator it;
+
+      while (table.get_next (it)) { found++; }
+   }
+
+   record_result (9, Count * Passes, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 pass = 0; pass < Passes; pass++) {
+
+      for (Int32 ix = 0; ix < Count; ix += 2) { table.remove (Keys[ix]); }
+      for (Int32 ix = 0; ix < Count; ix += 2) { table.store (Keys[ix], &value); }
+   }
+
+   record_result (10, Count * Passes, get_time () - start);
+
+   if (found < 0) { printf ("%d\n", found); }
+}
+
+};
+
+
+int
+main (int argc, char *argv[]) {
+
+   const Int32 Count ((argc > 1) ? atoi (argv[1]) : 100000);
+   const Int32 Passes ((argc > 2) ? atoi (argv[2]) : 10);
+   const Int32 Repeats ((argc > 3) ? atoi (argv[3]) : 5);
+
+   printf (
+      "Hash table benchmark: %d elements, %d passes, best of %d\n",
+      Count,
+      Passes,
+      Repeats);
+
+   Handle *order (new Handle[Count]);
+   String *keys (new String[Count]);
+
+   srand (1);
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      order[ix] = Handle (ix + 1);
+      keys[ix].flush () << "Object_Attribute_" << ix;
+   }
+
+   for (Int32 ix = Count - 1; ix > 0; ix--) {
+
+      const Int32 Place (rand () % (ix + 1));
+      const Handle Tmp (order[ix]);
+      order[ix] = order[Place];
+      order[Place] = Tmp;
+   }
+
+   for (Int32 ix = 0; ix < Repeats; ix++) {
+
+      run_handle_benchmark (Count, Passes, order);
+      run_string_benchmark (Count, Passes, keys);
+   }
+
+   print_results ();
+
+   delete []order; order = 0;
+   delete []keys; keys = 0;
+
+   return 0;
+}
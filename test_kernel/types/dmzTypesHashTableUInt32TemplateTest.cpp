@@ -407,6 +407,88 @@ main (int argc, char *argv[]) {
 
    // </validate iterator functions>
    // ============================================================================ //
+   // <validate remove and store churn>
+
+   HashTableUInt32Template<String> churnTable;
+   Boolean churnOk (True);
+
+   for (UInt32 ix = 1; ix <= 1000; ix++) {
+
+      if (!churnTable.store (ix, &dataStringFish)) { churnOk = False; }
+   }
+
+   for (UInt32 ix = 1; ix <= 1000; ix++) {
+
+      if ((ix % 2) && (churnTable.remove (ix) != &dataStringFish)) { churnOk = False; }
+   }
+
+   for (UInt32 ix = 1001; ix <= 20000; ix++) {
+
+      if (!churnTable.store (ix, &dataStringBeans)) { churnOk = False; }
+      if (churnTable.remove (ix) != &dataStringBeans) { churnOk = False; }
+   }
+
+   for (UInt32 ix = 1; ix <= 1000; ix++) {
+
+      String *ptr (churnTable.lookup (ix));
+
+      if ((ix % 2) ? (ptr != 0) : (ptr != &dataStringFish)) { churnOk = False; }
+   }
+
+   test.validate (
+      "HashTableUInt32Template repeated store and remove keeps remaining elements.",
+      churnOk && (churnTable.get_count () == 500) && (churnTable.get_size () == 1024));
+
+   HashTableUInt32Iterator churnIt;
+   UInt32 lastKey (0);
+   Int32 churnCount (0);
+   churnOk = True;
+
+   while (churnTable.get_next (churnIt)) {
+
+      const UInt32 Key (churnIt.get_hash_key ());
+
+      if (Key <= lastKey) { churnOk = False; }
+      lastKey = Key;
+      churnCount++;
+
+      churnTable.remove (Key);
+   }
+
+   test.validate (
+      "HashTableUInt32Template remove current element while iterating.",
+      churnOk && (churnCount == 500) && (churnTable.get_count () == 0));
+
+   for (UInt32 ix = 1; ix <= 500; ix++) { churnTable.store (ix, &dataStringFish); }
+
+   HashTableUInt32Iterator reuseIt;
+   UInt32 nextKey (1001);
+   lastKey = 0;
+   churnCount = 0;
+   churnOk = True;
+
+   while (churnTable.get_next (reuseIt) == &dataStringFish) {
+
+      const UInt32 Key (reuseIt.get_hash_key ());
+
+      if (Key != (lastKey + 1)) { churnOk = False; }
+      lastKey = Key;
+      churnCount++;
+
+      // The removed element is reused by a later store so the iterator must not
+      // restart or follow the links of the reused element.
+      churnTable.remove (Key);
+      if (!churnTable.store (nextKey, &dataStringBeans)) { churnOk = False; }
+      nextKey++;
+   }
+
+   test.validate (
+      "HashTableUInt32Template store and remove while iterating visits each element once.",
+      churnOk && (churnCount == 500) && (churnTable.get_count () == 500) &&
+      (churnTable.get_size () == 1024));
+
+   // </validate remove and store churn>
+   // ============================================================================ //
    // <validate HashTableLock>
 
    // ?
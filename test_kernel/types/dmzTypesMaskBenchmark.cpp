@@ -0,0 +1,132 @@
+#include <dmzSystem.h>
+#include <dmzTypesMask.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace dmz;
+
+namespace {
+
+static void
+print_result (const char *Name, const Int32 Count, const Float64 Time) {
+
+   printf (
+      "%-28s %10.3f ms %10.2f M ops/s\n",
+      Name,
+      Time * 1000.0,
+      (Time > 0.0) ? (Float64 (Count) / Time) / 1000000.0 : 0.0);
+}
+
+
+static void
+run_mask_benchmark (const char *Name, const Int32 Bits, const Int32 Count) {
+
+   Mask state;
+   Mask flag;
+   Mask other;
+
+   for (Int32 ix = 0; ix < Bits; ix += 3) { state.set_bit (ix); }
+   for (Int32 ix = 0; ix < Bits; ix += 7) { other.set_bit (ix); }
+   flag.set_bit (Bits - 1);
+
+   Int32 found (0);
+
+   printf ("%s (%d bits)\n", Name, Bits);
+
+   Float64 start (get_time ());
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      Mask copy (state);
+      if (copy.is_set ()) { found++; }
+   }
+
+   print_result ("Copy", Count, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      Mask value (state);
+      value &= other;
+      if (value) { found++; }
+   }
+
+   print_result ("Copy and AND assign", Count, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      if ((state | other) != state) { found++; }
+   }
+
+   print_result ("OR", Count, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      if ((state ^ other) == other) { found++; }
+   }
+
+   print_result ("XOR", Count, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      if ((~state).get_bit (1)) { found++; }
+   }
+
+   print_result ("NOT", Count, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      if (state.contains (flag)) { found++; }
+      if (state.contains (other)) { found++; }
+   }
+
+   print_result ("Contains", Count * 2, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      if (state == other) { found++; }
+   }
+
+   print_result ("Equal", Count, get_time () - start);
+
+   start = get_time ();
+
+   for (Int32 ix = 0; ix < Count; ix++) {
+
+      Mask value;
+      value.set_bit (ix % Bits);
+      if (value.get_bit (ix % Bits)) { found++; }
+   }
+
+   print_result ("Construct and set bit", Count, get_time () - start);
+
+   if (found < 0) { printf ("%d\n", found); }
+}
+
+};
+
+
+int
+main (int argc, char *argv[]) {
+
+   const Int32 Count ((argc > 1) ? atoi (argv[1]) : 1000000);
+
+   printf ("Mask benchmark: %d operations\n", Count);
+
+   run_mask_benchmark ("Small mask", 64, Count);
+   run_mask_benchmark ("Full inline mask", 256, Count);
+   run_mask_benchmark ("Large mask", 1024, Count);
+
+   return 0;
+}
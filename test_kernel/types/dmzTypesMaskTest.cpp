@@ -217,6 +217,48 @@ main (int argc, char *argv[]) {
       "Identical masks contain each other.",
       testMask6.contains (testMask7));
 
+   Mask largeMask;
+   largeMask.set_bit (3);
+   largeMask.set_bit (255);
+   Mask largeCopy (largeMask);
+   largeMask.set_bit (1000);
+
+   test.validate (
+      "Mask grows past inline storage.",
+      (largeMask.get_size () == 32) &&
+      largeMask.get_bit (3) && largeMask.get_bit (255) && largeMask.get_bit (1000) &&
+      (largeCopy.get_size () == 8) && !largeCopy.get_bit (1000) &&
+      largeMask.contains (largeCopy) && !largeCopy.contains (largeMask));
+
+   largeCopy = largeMask;
+   largeCopy.unset_bit (1000);
+   largeMask &= largeCopy;
+
+   test.validate (
+      "Mask operators on large masks.",
+      !largeMask.get_bit (1000) && (largeMask == largeCopy) &&
+      ((largeMask ^ largeCopy) == zeroMask) &&
+      (~largeMask).get_bit (1000) && !(~largeMask).get_bit (255));
+
+   Mask shiftMask (0, 0x80000001);
+   shiftMask << 64;
+   Mask shiftResult;
+   shiftResult.set_sub_mask (2, 0x80000001);
+
+   test.validate ("Mask << operator by whole blocks", shiftMask == shiftResult);
+
+   shiftMask >> 64;
+
+   test.validate (
+      "Mask >> operator by whole blocks",
+      (shiftMask == Mask (0, 0x80000001)) && (shiftMask.get_size () == 1));
+
+   largeMask.empty ();
+   test.validate (
+      "Mask empty () returns to inline storage.",
+      !largeMask.get_size () && !largeMask.is_set () &&
+      largeMask.set_bit (40).get_bit (40));
+
    return test.result ();
 }
 